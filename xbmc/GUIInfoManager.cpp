@@ -1004,6 +1004,62 @@ const infomap player_times[] =   {{ "seektime",         PLAYER_SEEKTIME },
 ///     @skinning_v17 **[New Infolabel]** \link Player_Process_audiobitspersample `Player.Process(audiobitspersample)`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Player.Process(frametime)`</b>,
+///                  \anchor Player_Process_frametime
+///                  _string_,
+///     @return The median time between frames of the currently playing game, in milliseconds.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_frametime `Player.Process(frametime)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(frametimep99)`</b>,
+///                  \anchor Player_Process_frametimep99
+///                  _string_,
+///     @return The 99th percentile of the time between frames of the currently playing game, in milliseconds.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_frametimep99 `Player.Process(frametimep99)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(emulationtime)`</b>,
+///                  \anchor Player_Process_emulationtime
+///                  _string_,
+///     @return The median time the game client spends emulating a frame, in milliseconds.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_emulationtime `Player.Process(emulationtime)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(audiodelay)`</b>,
+///                  \anchor Player_Process_audiodelay
+///                  _string_,
+///     @return The median amount of audio queued for playback by the currently playing game, in milliseconds.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_audiodelay `Player.Process(audiodelay)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(droppedframes)`</b>,
+///                  \anchor Player_Process_droppedframes
+///                  _string_,
+///     @return The number of frames of the currently playing game which missed their deadline in the last 10 seconds.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_droppedframes `Player.Process(droppedframes)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(duplicatedframes)`</b>,
+///                  \anchor Player_Process_duplicatedframes
+///                  _string_,
+///     @return The number of times a frame of the currently playing game was shown again in the last 10 seconds.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_duplicatedframes `Player.Process(duplicatedframes)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(videothreading)`</b>,
+///                  \anchor Player_Process_videothreading
+///                  _string_,
+///     @return The threading of the software video decoder of the currently playing video, e.g. "frame x4". Empty for hardware decoders.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Player_Process_videothreading `Player.Process(videothreading)`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -1021,7 +1077,14 @@ const infomap player_process[] =
   { "audiodecoder", PLAYER_PROCESS_AUDIODECODER },
   { "audiochannels", PLAYER_PROCESS_AUDIOCHANNELS },
   { "audiosamplerate", PLAYER_PROCESS_AUDIOSAMPLERATE },
-  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE }
+  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE },
+  { "frametime", PLAYER_PROCESS_FRAMETIME },
+  { "frametimep99", PLAYER_PROCESS_FRAMETIMEP99 },
+  { "emulationtime", PLAYER_PROCESS_EMULATIONTIME },
+  { "audiodelay", PLAYER_PROCESS_AUDIODELAY },
+  { "droppedframes", PLAYER_PROCESS_DROPPEDFRAMES },
+  { "duplicatedframes", PLAYER_PROCESS_DUPLICATEDFRAMES },
+  { "videothreading", PLAYER_PROCESS_VIDEOTHREADING }
 };
 
 /// \page modules__infolabels_boolean_conditions
@@ -3817,6 +3880,16 @@ const infomap videoplayer[] =    {{ "title",            VIDEOPLAYER_TITLE },
 ///     @skinning_v18 **[New Infolabel]** \link RetroPlayer_VideoRotation `RetroPlayer.VideoRotation`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`RetroPlayer.RunAhead`</b>,
+///                  \anchor RetroPlayer_RunAhead
+///                  _integer_,
+///     @return The number of frames the currently-playing game is emulated
+///     ahead of the displayed frame to reduce input latency, or 0 if
+///     run-ahead is disabled.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link RetroPlayer_RunAhead `RetroPlayer.RunAhead`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -3825,6 +3898,7 @@ const infomap retroplayer[] =
   { "videofilter",            RETROPLAYER_VIDEO_FILTER},
   { "stretchmode",            RETROPLAYER_STRETCH_MODE},
   { "videorotation",          RETROPLAYER_VIDEO_ROTATION},
+  { "runahead",               RETROPLAYER_RUN_AHEAD},
 };
 
 /// \page modules__infolabels_boolean_conditions
@@ -10338,6 +10412,28 @@ std::string CGUIInfoManager::GetLabel(int info, int contextWindow, std::string *
   return strLabel;
 }
 
+bool CGUIInfoManager::IsLabelVersioned(int info) const
+{
+  if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
+    return CGUIInfoProviders::IsLabelVersioned(m_multiInfo[info - MULTI_INFO_START]);
+  else if ((info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END) ||
+           (info >= LISTITEM_START && info <= LISTITEM_END))
+    return false;
+
+  return CGUIInfoProviders::IsLabelVersioned(CGUIInfo(info));
+}
+
+bool CGUIInfoManager::GetLabelVersion(unsigned int &version, int info, int contextWindow) const
+{
+  if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
+    return m_infoProviders.GetLabelVersion(version, contextWindow, m_multiInfo[info - MULTI_INFO_START]);
+  else if ((info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END) ||
+           (info >= LISTITEM_START && info <= LISTITEM_END))
+    return false;
+
+  return m_infoProviders.GetLabelVersion(version, contextWindow, CGUIInfo(info));
+}
+
 bool CGUIInfoManager::GetInt(int &value, int info, int contextWindow, const CGUIListItem *item /* = nullptr */) const
 {
   if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
@@ -93,6 +93,20 @@ public:
 
   std::string GetLabel(int info, int contextWindow = 0, std::string *fallback = nullptr) const;
   std::string GetImage(int info, int contextWindow, std::string *fallback = nullptr);
+  /*! \brief Get the version of an info label
+   \param version [out] the version, which changes whenever the label or image of the info may have changed
+   \param info id of info
+   \param contextWindow the context in which to evaluate the info (currently windows)
+   \return true if the info is versioned, false if its value has to be polled
+   \sa GetLabel, GetImage
+   */
+  bool GetLabelVersion(unsigned int &version, int info, int contextWindow = 0) const;
+  /*! \brief Whether an info label may be versioned
+   Only these need to be checked with GetLabelVersion, all others are polled.
+   \param info id of info
+   \sa GetLabelVersion
+   */
+  bool IsLabelVersioned(int info) const;
   bool GetInt(int &value, int info, int contextWindow = 0, const CGUIListItem *item = nullptr) const;
   bool GetBool(int condition, int contextWindow = 0, const CGUIListItem *item = nullptr);
 
@@ -8,16 +8,31 @@
 
 #include "GUILargeTextureManager.h"
 
+#include "Application.h"
+#include "ServiceBroker.h"
 #include "TextureCache.h"
+#include "filesystem/DownloadScheduler.h"
 #include "guilib/Texture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
 #include "utils/JobManager.h"
 #include "utils/TimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
 #include <cassert>
 
+namespace
+{
+// upper bound for concurrent decode jobs. CJobManager only starts a normal priority job while
+// fewer than GetMaxWorkers(PRIORITY_NORMAL) = 4 jobs of any priority are processing, so this
+// shares that budget with all other users of the job manager rather than reserving workers.
+constexpr int MAX_DECODE_JOBS = 4;
+}
+
 CImageLoader::CImageLoader(const std::string &path, const bool useCache):
   m_path(path)
 {
@@ -32,6 +47,10 @@ CImageLoader::~CImageLoader()
 
 bool CImageLoader::DoWork()
 {
+  // the image was released before the job got a worker
+  if (m_cancelled)
+    return false;
+
   bool needsChecking = false;
   std::string loadPath;
 
@@ -40,7 +59,7 @@ bool CImageLoader::DoWork()
     return false;
 
   if (m_use_cache)
-    loadPath = CTextureCache::GetInstance().CheckCachedImage(texturePath, needsChecking);
+    loadPath = CTextureCache::GetInstance().CheckCachedImage(texturePath, needsChecking, true);
   else
     loadPath = texturePath;
 
@@ -48,9 +67,22 @@ bool CImageLoader::DoWork()
   {
     // direct route - load the image
     auto start = std::chrono::steady_clock::now();
-    m_texture =
-        CTexture::LoadFromFile(loadPath, CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth(),
-                               CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight());
+    const unsigned int width = CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth();
+    const unsigned int height = CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight();
+
+    if (XFILE::CDownloadScheduler::CanSchedule(loadPath))
+    {
+      // uncached remote image, the user is waiting for it
+      XFILE::HTTPResponse response;
+      if (XFILE::CDownloadScheduler::GetInstance().Get(loadPath,
+                                                       XFILE::CDownloadScheduler::Lane::UI,
+                                                       response))
+        m_texture = CTexture::LoadFromFileInMemory(
+            reinterpret_cast<unsigned char*>(const_cast<char*>(response.body.data())),
+            response.body.size(), response.mimeType, width, height);
+    }
+    else
+      m_texture = CTexture::LoadFromFile(loadPath, width, height);
 
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -164,9 +196,70 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
     }
   }
 
+  for (listIterator it = m_decoded.begin(); it != m_decoded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      if (firstRequest)
+        image->AddRef();
+      if (!image->GetTexture().size())
+      { // decoding failed
+        m_decoded.erase(it);
+        m_allocated.push_back(image);
+        return false;
+      }
+      if (!UploadImage(image))
+        return true; // out of upload budget for this frame, try again next frame
+      m_decoded.erase(it);
+      m_allocated.push_back(image);
+      texture = image->GetTexture();
+      return true;
+    }
+  }
+
   if (firstRequest)
     QueueImage(path, useCache);
+  else
+  {
+    // visible controls request their image every frame until it's loaded
+    for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
+    {
+      if (it->image->GetPath() == path)
+      {
+        it->requestTime = CTimeUtils::GetFrameTime();
+        break;
+      }
+    }
+  }
+
+  return true;
+}
 
+bool CGUILargeTextureManager::UploadImage(CLargeTexture* image)
+{
+  // uploads need the GL/DX context, which is only current on the application thread.
+  // Other callers leave the upload to the first render of the texture.
+  if (!g_application.IsCurrentThread())
+    return true;
+
+  const unsigned int frameTime = CTimeUtils::GetFrameTime();
+  if (frameTime != m_uploadFrameTime)
+  {
+    m_uploadFrameTime = frameTime;
+    m_uploadsThisFrame = 0;
+  }
+
+  const int maxUploads = CServiceBroker::GetSettingsComponent()
+                             ->GetAdvancedSettings()
+                             ->m_guiLargeTextureUploadsPerFrame;
+  if (maxUploads > 0 && m_uploadsThisFrame >= static_cast<unsigned int>(maxUploads))
+    return false;
+
+  for (CTexture* texture : image->GetTexture().m_textures)
+    texture->LoadToGPU();
+
+  m_uploadsThisFrame++;
   return true;
 }
 
@@ -183,15 +276,32 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
       return;
     }
   }
+  for (listIterator it = m_decoded.begin(); it != m_decoded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      // never uploaded, so there's no point in keeping it around
+      if (image->DecrRef(true))
+        m_decoded.erase(it);
+      return;
+    }
+  }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    unsigned int id = it->first;
-    CLargeTexture *image = it->second;
+    unsigned int id = it->jobID;
+    CLargeTexture *image = it->image;
     if (image->GetPath() == path && image->DecrRef(true))
     {
-      // cancel this job
-      CJobManager::GetInstance().CancelJob(id);
+      // cancel this job. It keeps its decode slot until OnJobComplete, as CJobManager::CancelJob
+      // would drop the callback of a job that is already running.
+      if (id)
+      {
+        it->loader->m_cancelled = true;
+        m_cancelledJobs.push_back(id);
+      }
       m_queued.erase(it);
+      StartQueuedJobs();
       return;
     }
   }
@@ -206,7 +316,7 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    CLargeTexture *image = it->second;
+    CLargeTexture *image = it->image;
     if (image->GetPath() == path)
     {
       image->AddRef();
@@ -215,9 +325,32 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
   }
 
   // queue the item
-  CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
-  m_queued.emplace_back(jobID, image);
+  m_queued.push_back({0, nullptr, new CLargeTexture(path), useCache, CTimeUtils::GetFrameTime()});
+  StartQueuedJobs();
+}
+
+void CGUILargeTextureManager::StartQueuedJobs()
+{
+  const unsigned int maxJobs =
+      std::max(1, std::min(CServiceBroker::GetCPUInfo()->GetCPUCount(), MAX_DECODE_JOBS));
+
+  while (m_runningJobs < maxJobs)
+  {
+    // images requested in the latest frame are on screen, items that were scrolled past stopped
+    // requesting theirs. Among those requested in the same frame the newest goes first.
+    auto next = m_queued.rend();
+    for (auto it = m_queued.rbegin(); it != m_queued.rend(); ++it)
+    {
+      if (!it->jobID && (next == m_queued.rend() || it->requestTime > next->requestTime))
+        next = it;
+    }
+    if (next == m_queued.rend())
+      break;
+
+    next->loader = new CImageLoader(next->image->GetPath(), next->useCache);
+    next->jobID = CJobManager::GetInstance().AddJob(next->loader, this, CJob::PRIORITY_NORMAL);
+    m_runningJobs++;
+  }
 }
 
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
@@ -226,15 +359,26 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    if (it->first == jobID)
+    if (it->jobID == jobID)
     { // found our job
       CImageLoader *loader = static_cast<CImageLoader*>(job);
-      CLargeTexture *image = it->second;
+      CLargeTexture *image = it->image;
       image->SetTexture(loader->m_texture);
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
-      m_allocated.push_back(image);
+      m_decoded.push_back(image);
+      m_runningJobs--;
+      StartQueuedJobs();
       return;
     }
   }
+
+  // a cancelled job, its texture is freed with the job
+  auto it = std::find(m_cancelledJobs.begin(), m_cancelledJobs.end(), jobID);
+  if (it != m_cancelledJobs.end())
+  {
+    m_cancelledJobs.erase(it);
+    m_runningJobs--;
+    StartQueuedJobs();
+  }
 }
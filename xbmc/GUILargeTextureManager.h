@@ -12,6 +12,7 @@
 #include "threads/CriticalSection.h"
 #include "utils/Job.h"
 
+#include <atomic>
 #include <utility>
 #include <vector>
 
@@ -37,6 +38,7 @@ public:
   bool          m_use_cache; ///< Whether or not to use any caching with this image
   std::string    m_path; ///< path of image to load
   CTexture* m_texture; ///< Texture object to load the image into \sa CTexture.
+  std::atomic<bool> m_cancelled{false}; ///< Set when the image is released before it is loaded
 };
 
 /*!
@@ -46,6 +48,14 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Images are decoded and scaled by a bounded number of concurrent CImageLoader jobs.  Visible
+ controls request their image every frame until it's loaded, so the images requested most
+ recently are decoded first and items that were scrolled past wait.  Decoded images are uploaded
+ to the GPU when they are next requested, limited to a number of uploads per frame.
+
+ Only images that don't come with the skin are loaded here.  Skin textures are loaded
+ synchronously by CGUITextureManager, as controls need their size when they are laid out.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
@@ -74,7 +84,8 @@ public:
    \param texture texture object to hold the resulting texture
    \param orientation orientation of resulting texture
    \param firstRequest true if this is the first time we are requesting this texture
-   \return true if the image exists, else false.
+   \return true if the image exists, else false.  The texture may still be empty if the image is
+   being decoded or the upload budget for this frame has been used up.
    \sa CGUITextureArray and CGUITexture
    */
   bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true);
@@ -129,10 +140,36 @@ private:
 
   void QueueImage(const std::string &path, bool useCache = true);
 
-  std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  /*!
+   \brief Start decode jobs for queued images while there are free decode slots.
+   The most recently requested images are started first.
+   */
+  void StartQueuedJobs();
+
+  /*!
+   \brief Upload a decoded image to the GPU, if the upload budget for this frame allows it.
+   \return true if the image has been uploaded (or can't be uploaded from this thread), else false
+   */
+  bool UploadImage(CLargeTexture* image);
+
+  struct QueuedImage
+  {
+    unsigned int jobID; ///< decode job, 0 while waiting for a free decode slot
+    CImageLoader* loader; ///< owned by CJobManager, valid until OnJobComplete
+    CLargeTexture* image;
+    bool useCache;
+    unsigned int requestTime; ///< frame time of the latest request of the image
+  };
+
+  std::vector<QueuedImage> m_queued;
+  std::vector<CLargeTexture *> m_decoded; ///< images decoded but not yet uploaded
   std::vector<CLargeTexture *> m_allocated;
+  std::vector<unsigned int> m_cancelledJobs; ///< released images whose job hasn't completed yet
+  unsigned int m_runningJobs = 0; ///< decode jobs including cancelled ones, until they complete
+  unsigned int m_uploadFrameTime = 0;
+  unsigned int m_uploadsThisFrame = 0;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
-  typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
+  typedef std::vector<QueuedImage>::iterator queueIterator;
 
   CCriticalSection m_listSection;
 };
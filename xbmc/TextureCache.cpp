@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "TextureCacheJob.h"
 #include "URL.h"
+#include "filesystem/DownloadScheduler.h"
 #include "filesystem/File.h"
 #include "guilib/Texture.h"
 #include "profiles/ProfileManager.h"
@@ -42,6 +43,10 @@ void CTextureCache::Initialize()
   CSingleLock lock(m_databaseSection);
   if (!m_database.IsOpen())
     m_database.Open();
+
+  // create .dds copies of images cached before they were enabled
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCacheDDS)
+    AddJob(new CTextureDDSJob());
 }
 
 void CTextureCache::Deinitialize()
@@ -99,13 +104,23 @@ bool CTextureCache::CanCacheImageURL(const CURL &url)
           StringUtils::StartsWith(url.GetUserName(), "video_");
 }
 
-std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsRecaching)
+std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsRecaching, bool preferDDS /* = false */)
 {
   CTextureDetails details;
   std::string path(GetCachedImage(url, details, true));
   needsRecaching = !details.hash.empty();
   if (!path.empty())
+  {
+    if (preferDDS && details.ddsversion == DDS_VERSION &&
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCacheDDS)
+    {
+      // the .dds may have been removed from the cache folder while the database still lists it
+      const std::string ddsPath = URIUtils::ReplaceExtension(path, ".dds");
+      if (XFILE::CFile::Exists(ddsPath))
+        return ddsPath;
+    }
     return path;
+  }
   return "";
 }
 
@@ -123,8 +138,11 @@ void CTextureCache::BackgroundCacheImage(const std::string &url)
   if (path.empty())
     return;
 
+  // start downloading remote images now, the jobs are processed one at a time
+  CDownloadScheduler::GetInstance().Prefetch(path);
+
   // needs (re)caching
-  AddJob(new CTextureCacheJob(path, details.hash));
+  AddJob(new CTextureCacheJob(path, details.hash, CDownloadScheduler::Lane::SCAN));
 }
 
 std::string CTextureCache::CacheImage(const std::string& image,
@@ -300,6 +318,9 @@ void CTextureCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
 {
   if (strcmp(job->GetType(), kJobTypeCacheImage) == 0)
     OnCachingComplete(success, static_cast<CTextureCacheJob*>(job));
+  else if (strcmp(job->GetType(), kJobTypeDDSCompress) == 0 && success &&
+           static_cast<CTextureDDSJob*>(job)->m_hasMore)
+    AddJob(new CTextureDDSJob(static_cast<CTextureDDSJob*>(job)->m_lastID));
   return CJobQueue::OnJobComplete(jobID, success, job);
 }
 
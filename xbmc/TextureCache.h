@@ -38,6 +38,11 @@ public:
    */
   static CTextureCache &GetInstance();
 
+  /*! \brief Version of the .dds copies of cached images, bump when their layout changes
+   so that existing copies are recreated.
+   */
+  static constexpr unsigned int DDS_VERSION = 1;
+
   /*! \brief Initialize the texture cache
    */
   void Initialize();
@@ -53,10 +58,11 @@ public:
 
    \param image url of the image to check
    \param needsRecaching [out] whether the image needs recaching.
+   \param preferDDS return the .dds version of the cached image if an up to date one exists
    \return cached url of this image
    \sa GetCachedImage
    */
-  std::string CheckCachedImage(const std::string &image, bool &needsRecaching);
+  std::string CheckCachedImage(const std::string &image, bool &needsRecaching, bool preferDDS = false);
 
   /*! \brief Cache image (if required) using a background job
 
@@ -9,6 +9,7 @@
 #include "TextureCacheJob.h"
 #include "ServiceBroker.h"
 #include "TextureCache.h"
+#include "XBDateTime.h"
 #include "guilib/Texture.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -24,11 +25,12 @@
 #include "music/tags/MusicInfoTag.h"
 
 #include <inttypes.h>
+#include <memory>
 
-CTextureCacheJob::CTextureCacheJob(const std::string &url, const std::string &oldHash):
-  m_url(url),
-  m_oldHash(oldHash),
-  m_cachePath(CTextureCache::GetCacheFile(m_url))
+CTextureCacheJob::CTextureCacheJob(const std::string& url,
+                                   const std::string& oldHash,
+                                   XFILE::CDownloadScheduler::Lane lane)
+  : m_url(url), m_oldHash(oldHash), m_cachePath(CTextureCache::GetCacheFile(m_url)), m_lane(lane)
 {
 }
 
@@ -70,14 +72,22 @@ bool CTextureCacheJob::CacheTexture(CTexture** out_texture)
 
   m_details.updateable = additional_info != "music" && UpdateableURL(image);
 
+  // remote images are downloaded once through the scheduler, instead of separate requests to
+  // stat and load them
+  XFILE::HTTPResponse response;
+  const bool download = XFILE::CDownloadScheduler::CanSchedule(image);
+  if (download && !XFILE::CDownloadScheduler::GetInstance().Get(image, m_lane, response))
+    return false;
+
   // generate the hash
-  m_details.hash = GetImageHash(image);
+  m_details.hash = download ? GetImageHash(response) : GetImageHash(image);
   if (m_details.hash.empty())
     return false;
   else if (m_details.hash == m_oldHash)
     return true;
 
-  CTexture* texture = LoadImage(image, width, height, additional_info, true);
+  CTexture* texture = download ? LoadImage(response, width, height, additional_info)
+                               : LoadImage(image, width, height, additional_info, true);
   if (texture)
   {
     if (texture->HasAlpha())
@@ -85,13 +95,18 @@ bool CTextureCacheJob::CacheTexture(CTexture** out_texture)
     else
       m_details.file = m_cachePath + ".jpg";
 
+    std::string ddsFile;
+    if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCacheDDS)
+      ddsFile = CTextureCache::GetCachedPath(m_cachePath + ".dds");
+
     CLog::Log(LOGDEBUG, "{} image '{}' to '{}':", m_oldHash.empty() ? "Caching" : "Recaching",
               CURL::GetRedacted(image), m_details.file);
 
-    if (CPicture::CacheTexture(texture, width, height, CTextureCache::GetCachedPath(m_details.file), scalingAlgorithm))
+    if (CPicture::CacheTexture(texture, width, height, CTextureCache::GetCachedPath(m_details.file), scalingAlgorithm, ddsFile))
     {
       m_details.width = width;
       m_details.height = height;
+      m_details.ddsversion = ddsFile.empty() ? 0 : CTextureCache::DDS_VERSION;
       if (out_texture) // caller wants the texture
         *out_texture = texture;
       else
@@ -212,6 +227,31 @@ CTexture* CTextureCacheJob::LoadImage(const std::string& image,
   return texture;
 }
 
+CTexture* CTextureCacheJob::LoadImage(const XFILE::HTTPResponse& response,
+                                      unsigned int width,
+                                      unsigned int height,
+                                      const std::string& additional_info)
+{
+  // Validate file URL to see if it is an image
+  CFileItem file(response.url, false);
+  file.SetMimeType(response.mimeType);
+  if (!(file.IsPicture() && !(file.IsZIP() || file.IsRAR() || file.IsCBR() || file.IsCBZ() ))
+      && !StringUtils::StartsWithNoCase(file.GetMimeType(), "image/") && !StringUtils::EqualsNoCase(file.GetMimeType(), "application/octet-stream")) // ignore non-pictures
+    return NULL;
+
+  CTexture* texture = CTexture::LoadFromFileInMemory(
+      reinterpret_cast<unsigned char*>(const_cast<char*>(response.body.data())),
+      response.body.size(), response.mimeType, width, height);
+  if (!texture)
+    return NULL;
+
+  // see LoadImage() above
+  if (additional_info == "flipped")
+    texture->SetOrientation(texture->GetOrientation() ^ 1);
+
+  return texture;
+}
+
 bool CTextureCacheJob::UpdateableURL(const std::string &url) const
 {
   // we don't constantly check online images
@@ -241,6 +281,84 @@ std::string CTextureCacheJob::GetImageHash(const std::string &url)
   return "";
 }
 
+std::string CTextureCacheJob::GetImageHash(const XFILE::HTTPResponse& response)
+{
+  time_t time = 0;
+  const CDateTime lastModified = CDateTime::FromRFC1123DateTime(response.lastModified);
+  if (lastModified.IsValid())
+    lastModified.GetAsTime(time);
+
+  if (time || !response.body.empty())
+    return StringUtils::Format("d{}s{}", static_cast<int64_t>(time), response.body.size());
+
+  return "BADHASH";
+}
+
+bool CTextureDDSJob::operator==(const CJob* job) const
+{
+  return strcmp(job->GetType(), GetType()) == 0;
+}
+
+bool CTextureDDSJob::DoWork()
+{
+  static const unsigned int batchSize = 50;
+
+  std::vector<CTextureDetails> textures;
+  {
+    CTextureDatabase db;
+    if (!db.Open() ||
+        !db.GetTexturesWithoutDDS(CTextureCache::DDS_VERSION, m_lastID, batchSize, textures))
+      return false;
+  }
+
+  std::vector<CTextureDetails> converted;
+  std::vector<CTextureDetails> failed;
+  unsigned int i = 0;
+  for (; i < textures.size(); i++)
+  {
+    if (ShouldCancel(i, textures.size()))
+      break;
+
+    CTextureDetails& details = textures[i];
+    const std::string cachedFile = CTextureCache::GetCachedPath(details.file);
+    std::unique_ptr<CTexture> texture(CTexture::LoadFromFile(cachedFile, 0, 0, true));
+    if (!texture || texture->GetFormat() != XB_FMT_A8R8G8B8)
+    {
+      CLog::Log(LOGDEBUG, "{} - unable to load cached image '{}'", __FUNCTION__, cachedFile);
+      failed.push_back(details);
+    }
+    else if (CPicture::CreateThumbnailFromSurface(texture->GetPixels(), texture->GetWidth(),
+                                                  texture->GetHeight(), texture->GetPitch(),
+                                                  URIUtils::ReplaceExtension(cachedFile, ".dds")))
+    {
+      details.ddsversion = CTextureCache::DDS_VERSION;
+      converted.push_back(details);
+    }
+    else
+    {
+      failed.push_back(details);
+    }
+  }
+
+  CTextureDatabase db;
+  if ((!converted.empty() || !failed.empty()) && db.Open())
+  {
+    db.BeginTransaction();
+    for (const auto& details : converted)
+      db.SetDDSVersion(details.id, details.ddsversion);
+    // so unreadable images aren't tried again by the next run
+    for (const auto& details : failed)
+      db.SetDDSFailed(details.id, CTextureCache::DDS_VERSION);
+    db.CommitTransaction();
+  }
+
+  // continue after the last texture that was processed, even if recording its state failed
+  if (i > 0)
+    m_lastID = textures[i - 1].id;
+  m_hasMore = i == batchSize;
+  return true;
+}
+
 CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
 {
 }
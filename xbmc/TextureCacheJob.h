@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "filesystem/DownloadScheduler.h"
 #include "pictures/PictureScalingAlgorithm.h"
 #include "utils/Job.h"
 
@@ -29,6 +30,7 @@ public:
     id = -1;
     width = height = 0;
     updateable = false;
+    ddsversion = 0;
   };
   bool operator==(const CTextureDetails &right) const
   {
@@ -42,6 +44,7 @@ public:
   unsigned int width;
   unsigned int height;
   bool         updateable;
+  unsigned int ddsversion; ///< version of the .dds copy of the cached image, 0 if there is none
 };
 
 /*!
@@ -53,7 +56,9 @@ public:
 class CTextureCacheJob : public CJob
 {
 public:
-  CTextureCacheJob(const std::string &url, const std::string &oldHash = "");
+  CTextureCacheJob(const std::string& url,
+                   const std::string& oldHash = "",
+                   XFILE::CDownloadScheduler::Lane lane = XFILE::CDownloadScheduler::Lane::UI);
   ~CTextureCacheJob() override;
 
   const char* GetType() const override { return kJobTypeCacheImage; };
@@ -80,6 +85,14 @@ private:
    */
   static std::string GetImageHash(const std::string &url);
 
+  /*! \brief retrieve a hash for a downloaded image
+   Combines the size and Last-Modified date of the response, matching the hash of the same image
+   when it is stat'ed
+   \param response the downloaded image
+   \return a hash string for this image
+   */
+  static std::string GetImageHash(const XFILE::HTTPResponse& response);
+
   /*! \brief Check whether a given URL represents an image that can be updated
    We currently don't check http:// and https:// URLs for updates, under the assumption that
    a image URL is much more likely to be static and the actual image at the URL is unlikely
@@ -116,7 +129,41 @@ private:
                              const std::string& additional_info,
                              bool requirePixels = false);
 
+  /*! \brief Load a downloaded image at a given target size and orientation.
+   \param response the downloaded image.
+   \param width the desired maximum width.
+   \param height the desired maximum height.
+   \param additional_info extra info for loading, such as whether to flip horizontally.
+   \return a pointer to a CTexture object, NULL if failed.
+   \sa LoadImage
+   */
+  static CTexture* LoadImage(const XFILE::HTTPResponse& response,
+                             unsigned int width,
+                             unsigned int height,
+                             const std::string& additional_info);
+
   std::string    m_cachePath;
+  XFILE::CDownloadScheduler::Lane m_lane; ///< lane to download remote images in
+};
+
+/* \brief Job class for creating .dds copies of previously cached textures
+ Used when the texture cache is switched to keeping GPU ready copies of cached images, converts
+ a batch of cached images per run.
+ */
+class CTextureDDSJob : public CJob
+{
+public:
+  /*!
+   \param lastID id of the last texture converted by the previous run, the batch starts after it
+   */
+  explicit CTextureDDSJob(int lastID = 0) : m_lastID(lastID) {}
+
+  const char* GetType() const override { return kJobTypeDDSCompress; };
+  bool operator==(const CJob *job) const override;
+  bool DoWork() override;
+
+  int m_lastID; ///< id of the last texture of the batch
+  bool m_hasMore = false; ///< whether more cached images are waiting to be converted
 };
 
 /* \brief Job class for storing the use count of textures
@@ -154,7 +154,7 @@ void CTextureDatabase::CreateTables()
   m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
 
   CLog::Log(LOGINFO, "create sizes table, index,  and trigger");
-  m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
+  m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text, ddsversion integer)");
 
   CLog::Log(LOGINFO, "create path table");
   m_pDS->exec("CREATE TABLE path (id integer primary key, url text, type text, texture text)\n");
@@ -226,6 +226,10 @@ void CTextureDatabase::UpdateTables(int version)
     m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
     m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
   }
+  if (version < 14)
+  { // version of the .dds copy of cached images
+    m_pDS->exec("ALTER TABLE sizes ADD ddsversion integer");
+  }
 }
 
 bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
@@ -243,7 +247,7 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
     if (!m_pDS)
       return false;
 
-    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
+    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height, ddsversion FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
     m_pDS->query(sql);
     if (!m_pDS->eof())
     { // have some information
@@ -255,6 +259,7 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
         details.hash = m_pDS->fv(3).get_asString();
       details.width = m_pDS->fv(4).get_asInt();
       details.height = m_pDS->fv(5).get_asInt();
+      details.ddsversion = m_pDS->fv(6).get_asInt();
       m_pDS->close();
       return true;
     }
@@ -340,7 +345,7 @@ bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDe
     int textureID = (int)m_pDS->lastinsertid();
 
     // set the size information
-    sql = PrepareSQL("INSERT INTO sizes (idtexture, size, usecount, lastusetime, width, height) VALUES(%u, 1, 1, CURRENT_TIMESTAMP, %u, %u)", textureID, details.width, details.height);
+    sql = PrepareSQL("INSERT INTO sizes (idtexture, size, usecount, lastusetime, width, height, ddsversion) VALUES(%u, 1, 1, CURRENT_TIMESTAMP, %u, %u, %u)", textureID, details.width, details.height, details.ddsversion);
     m_pDS->exec(sql);
   }
   catch (...)
@@ -350,6 +355,52 @@ bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDe
   return true;
 }
 
+bool CTextureDatabase::GetTexturesWithoutDDS(unsigned int version, int afterID, unsigned int limit, std::vector<CTextureDetails> &textures)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    // failed conversions are stored as the negated version, so both are retried after a version bump
+    std::string sql = PrepareSQL("SELECT id, cachedurl, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) "
+                                 "WHERE texture.id > %i AND (sizes.ddsversion IS NULL OR ABS(sizes.ddsversion) < %u) "
+                                 "ORDER BY texture.id LIMIT %u", afterID, version, limit);
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      CTextureDetails details;
+      details.id = m_pDS->fv(0).get_asInt();
+      details.file = m_pDS->fv(1).get_asString();
+      details.width = m_pDS->fv(2).get_asInt();
+      details.height = m_pDS->fv(3).get_asInt();
+      textures.push_back(details);
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{}, failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CTextureDatabase::SetDDSVersion(int textureID, unsigned int version)
+{
+  std::string sql = PrepareSQL("UPDATE sizes SET ddsversion=%u WHERE idtexture=%i AND size=1", version, textureID);
+  return ExecuteQuery(sql);
+}
+
+bool CTextureDatabase::SetDDSFailed(int textureID, unsigned int version)
+{
+  std::string sql = PrepareSQL("UPDATE sizes SET ddsversion=%i WHERE idtexture=%i AND size=1", -static_cast<int>(version), textureID);
+  return ExecuteQuery(sql);
+}
+
 bool CTextureDatabase::ClearCachedTexture(const std::string &url, std::string &cacheFile)
 {
   std::string id = GetSingleValue(PrepareSQL("select id from texture where url='%s'", url.c_str()));
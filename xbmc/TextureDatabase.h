@@ -106,6 +106,31 @@ public:
 
   bool GetTextures(CVariant &items, const Filter &filter);
 
+  /*! \brief Get cached textures without an up to date .dds copy, in order of their id
+   Textures whose conversion failed with the current version are skipped.
+   \param version the current version of .dds copies
+   \param afterID only return textures with a larger id, to continue after the previous batch
+   \param limit maximum number of textures to return
+   \param textures [out] id, cached file and size of the textures
+   \return true if the query succeeded, false otherwise
+   */
+  bool GetTexturesWithoutDDS(unsigned int version, int afterID, unsigned int limit, std::vector<CTextureDetails> &textures);
+
+  /*! \brief Record the version of the .dds copy of a cached texture
+   \param textureID id of the texture
+   \param version version of the .dds copy
+   \return true if successful, false otherwise
+   */
+  bool SetDDSVersion(int textureID, unsigned int version);
+
+  /*! \brief Record that a cached texture couldn't be converted to a .dds copy
+   It isn't tried again until the version of .dds copies changes.
+   \param textureID id of the texture
+   \param version version of the .dds copy that failed
+   \return true if successful, false otherwise
+   */
+  bool SetDDSFailed(int textureID, unsigned int version);
+
   // rule creation
   CDatabaseQueryRule *CreateRule() const override;
   CDatabaseQueryRuleCombination *CreateCombination() const override;
@@ -120,6 +145,6 @@ protected:
   void CreateTables() override;
   void CreateAnalytics() override;
   void UpdateTables(int version) override;
-  int GetSchemaVersion() const override { return 13; };
+  int GetSchemaVersion() const override { return 14; };
   const char *GetBaseDBName() const override { return "Textures"; };
 };
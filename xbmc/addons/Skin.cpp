@@ -147,6 +147,8 @@ bool CSkinSettingBool::SerializeSetting(TiXmlElement* element) const
   return true;
 }
 
+std::atomic<unsigned int> CSkinInfo::m_settingsVersion{0};
+
 CSkinInfo::CSkinInfo(
     const AddonInfoPtr& addonInfo,
     const RESOLUTION_INFO& resolution /* = RESOLUTION_INFO() */)
@@ -600,6 +602,7 @@ void CSkinInfo::SetString(int setting, const std::string &label)
   if (it != m_strings.end())
   {
     it->second->value = label;
+    m_settingsVersion++;
     m_settingsUpdateHandler->TriggerSave();
     return;
   }
@@ -644,6 +647,7 @@ void CSkinInfo::SetBool(int setting, bool set)
   if (it != m_bools.end())
   {
     it->second->value = set;
+    m_settingsVersion++;
     m_settingsUpdateHandler->TriggerSave();
     return;
   }
@@ -660,6 +664,7 @@ void CSkinInfo::Reset(const std::string &setting)
     if (StringUtils::EqualsNoCase(setting, it.second->name))
     {
       it.second->value.clear();
+      m_settingsVersion++;
       m_settingsUpdateHandler->TriggerSave();
       return;
     }
@@ -671,6 +676,7 @@ void CSkinInfo::Reset(const std::string &setting)
     if (StringUtils::EqualsNoCase(setting, it.second->name))
     {
       it.second->value = false;
+      m_settingsVersion++;
       m_settingsUpdateHandler->TriggerSave();
       return;
     }
@@ -686,6 +692,7 @@ void CSkinInfo::Reset()
   for (auto& it : m_strings)
     it.second->value.clear();
 
+  m_settingsVersion++;
   m_settingsUpdateHandler->TriggerSave();
 }
 
@@ -752,6 +759,7 @@ bool CSkinInfo::SettingsFromXML(const CXBMCTinyXML &doc, bool loadDefaults /* =
 
   m_strings.clear();
   m_bools.clear();
+  m_settingsVersion++;
 
   int number = 0;
   std::set<CSkinSettingPtr> settings = ParseSettings(rootElement);
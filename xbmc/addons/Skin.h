@@ -12,6 +12,7 @@
 #include "guilib/GUIIncludes.h" // needed for the GUIInclude member
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 
+#include <atomic>
 #include <map>
 #include <set>
 #include <utility>
@@ -202,6 +203,11 @@ public:
   void Reset(const std::string &setting);
   void Reset();
 
+  /*! \brief Get the version of the skin settings
+   The version changes whenever a skin string or bool is set, reset or loaded.
+   */
+  static unsigned int GetSettingsVersion() { return m_settingsVersion; }
+
   static std::set<CSkinSettingPtr> ParseSettings(const TiXmlElement* rootElement);
 
   void OnPreInstall() override;
@@ -230,6 +236,7 @@ private:
   std::map<int, CSkinSettingStringPtr> m_strings;
   std::map<int, CSkinSettingBoolPtr> m_bools;
   std::unique_ptr<CSkinSettingUpdateHandler> m_settingsUpdateHandler;
+  static std::atomic<unsigned int> m_settingsVersion;
 };
 
 } /*namespace ADDON*/
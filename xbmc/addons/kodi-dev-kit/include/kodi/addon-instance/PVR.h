@@ -1380,6 +1380,43 @@ public:
   }
   //----------------------------------------------------------------------------
 
+  //============================================================================
+  /// @brief Get the changes of the EPG for a channel since a previous call.
+  ///
+  /// Lets Kodi keep its EPG in sync without fetching the complete time frame
+  /// of every channel over and over again.
+  ///
+  /// @param[in] channelUid The UID of the channel to get the EPG changes for.
+  /// @param[in] start Get changed events after this time (UTC).
+  /// @param[in] end Get changed events before this time (UTC).
+  /// @param[in] sinceToken The token returned by the previous call for this
+  ///                       channel. If empty, all events in the given time
+  ///                       frame must be transferred.
+  /// @param[out] newToken An opaque token identifying the state of the
+  ///                      backend's EPG data after this call, at most
+  ///                      @ref EPG_SYNC_TOKEN_STRING_LENGTH - 1 chars long.
+  ///                      Could be a change counter or a last modified time.
+  /// @param[out] results List where created, updated and deleted events
+  ///                     become transferred and given to Kodi
+  /// @return @ref PVR_ERROR_NO_ERROR if the changes have been fetched successfully,
+  ///         @ref PVR_ERROR_INVALID_PARAMETERS if the changes since the given
+  ///         token are not available anymore. Kodi then asks for all events
+  ///         by passing an empty token.
+  ///
+  /// @remarks Optional. If not implemented, Kodi uses @ref GetEPGForChannel()
+  ///          to fetch the complete time frame.
+  ///
+  virtual PVR_ERROR GetEPGChangesForChannel(int channelUid,
+                                            time_t start,
+                                            time_t end,
+                                            const std::string& sinceToken,
+                                            std::string& newToken,
+                                            kodi::addon::PVREPGTagChangesResultSet& results)
+  {
+    return PVR_ERROR_NOT_IMPLEMENTED;
+  }
+  //----------------------------------------------------------------------------
+
   //============================================================================
   /// @brief Check if the given EPG tag can be recorded.
   ///
@@ -2751,6 +2788,8 @@ private:
     m_instanceData->toAddon->SetSpeed = ADDON_SetSpeed;
     m_instanceData->toAddon->FillBuffer = ADDON_FillBuffer;
     m_instanceData->toAddon->GetStreamTimes = ADDON_GetStreamTimes;
+    //--==----==----==----==----==----==----==----==----==----==----==----==----==
+    m_instanceData->toAddon->GetEPGChangesForChannel = ADDON_GetEPGChangesForChannel;
   }
 
   inline static PVR_ERROR ADDON_GetCapabilities(const AddonInstance_PVR* instance,
@@ -2968,6 +3007,27 @@ private:
         ->GetEPGForChannel(channelUid, start, end, result);
   }
 
+  inline static PVR_ERROR ADDON_GetEPGChangesForChannel(const AddonInstance_PVR* instance,
+                                                        ADDON_HANDLE handle,
+                                                        int channelUid,
+                                                        time_t start,
+                                                        time_t end,
+                                                        const char* sinceToken,
+                                                        char* newToken,
+                                                        int memSize)
+  {
+    PVREPGTagChangesResultSet result(instance, handle);
+    std::string token;
+    PVR_ERROR err = static_cast<CInstancePVRClient*>(instance->toAddon->addonInstance)
+                        ->GetEPGChangesForChannel(channelUid, start, end, sinceToken, token, result);
+    if (err == PVR_ERROR_NO_ERROR)
+    {
+      strncpy(newToken, token.c_str(), memSize - 1);
+      newToken[memSize - 1] = '\0';
+    }
+    return err;
+  }
+
   inline static PVR_ERROR ADDON_IsEPGTagRecordable(const AddonInstance_PVR* instance,
                                                    const EPG_TAG* tag,
                                                    bool* isRecordable)
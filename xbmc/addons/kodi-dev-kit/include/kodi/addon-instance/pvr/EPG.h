@@ -494,6 +494,50 @@ private:
 ///@}
 //------------------------------------------------------------------------------
 
+//==============================================================================
+/// @defgroup cpp_kodi_addon_pvr_Defs_epg_PVREPGTagChangesResultSet class PVREPGTagChangesResultSet
+/// @ingroup cpp_kodi_addon_pvr_Defs_epg_PVREPGTag
+/// @brief **PVR add-on EPG change transfer class**\n
+/// To transfer the content of @ref kodi::addon::CInstancePVRClient::GetEPGChangesForChannel().
+///
+/// @note This becomes only be used on addon call above, not usable outside on
+/// addon itself.
+///@{
+class PVREPGTagChangesResultSet
+{
+public:
+  /*! \cond PRIVATE */
+  PVREPGTagChangesResultSet() = delete;
+  PVREPGTagChangesResultSet(const AddonInstance_PVR* instance, ADDON_HANDLE handle)
+    : m_instance(instance), m_handle(handle)
+  {
+  }
+  /*! \endcond */
+
+  /// @addtogroup cpp_kodi_addon_pvr_Defs_epg_PVREPGTagChangesResultSet
+  ///@{
+
+  /// @brief To add and give a changed event from addon to Kodi on related call.
+  ///
+  /// @param[in] tag The to transferred data. For deleted events, only unique
+  ///                broadcast id and start time are used.
+  /// @param[in] newState The @ref cpp_kodi_addon_pvr_Defs_epg_EPG_EVENT_STATE "state"
+  ///                     of the event.
+  void Add(const kodi::addon::PVREPGTag& tag, EPG_EVENT_STATE newState)
+  {
+    m_instance->toKodi->TransferEpgEntryChange(m_instance->toKodi->kodiInstance, m_handle,
+                                               tag.GetTag(), newState);
+  }
+
+  ///@}
+
+private:
+  const AddonInstance_PVR* m_instance = nullptr;
+  const ADDON_HANDLE m_handle;
+};
+///@}
+//------------------------------------------------------------------------------
+
 } /* namespace addon */
 } /* namespace kodi */
 
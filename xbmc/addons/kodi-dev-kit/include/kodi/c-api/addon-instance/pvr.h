@@ -130,6 +130,10 @@ extern "C"
     //--==----==----==----==----==----==----==----==----==----==----==----==----==
     // New functions becomes added below and can be on another API change (where
     // breaks min API version) moved up.
+    void (*TransferEpgEntryChange)(void* kodiInstance,
+                                   const ADDON_HANDLE handle,
+                                   const struct EPG_TAG* epgentry,
+                                   enum EPG_EVENT_STATE newState);
   } AddonToKodiFuncTable_PVR;
 
   /*!
@@ -316,6 +320,14 @@ extern "C"
     //--==----==----==----==----==----==----==----==----==----==----==----==----==
     // New functions becomes added below and can be on another API change (where
     // breaks min API version) moved up.
+    enum PVR_ERROR(__cdecl* GetEPGChangesForChannel)(const struct AddonInstance_PVR*,
+                                                     ADDON_HANDLE,
+                                                     int,
+                                                     time_t,
+                                                     time_t,
+                                                     const char*,
+                                                     char*,
+                                                     int);
   } KodiToAddonFuncTable_PVR;
 
   typedef struct AddonInstance_PVR
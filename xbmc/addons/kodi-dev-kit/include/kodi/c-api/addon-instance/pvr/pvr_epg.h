@@ -590,6 +590,15 @@ extern "C"
   #define EPG_TIMEFRAME_UNLIMITED -1
   //----------------------------------------------------------------------------
 
+  //============================================================================
+  /// @ingroup cpp_kodi_addon_pvr_Defs_epg
+  /// @brief Max length of the change token returned by
+  /// @ref kodi::addon::CInstancePVRClient::GetEPGChangesForChannel(), including
+  /// the terminating zero.
+  ///
+  #define EPG_SYNC_TOKEN_STRING_LENGTH 256
+  //----------------------------------------------------------------------------
+
   //============================================================================
   /// @defgroup cpp_kodi_addon_pvr_Defs_epg_EPG_EVENT_STATE enum EPG_EVENT_STATE
   /// @ingroup cpp_kodi_addon_pvr_Defs_epg
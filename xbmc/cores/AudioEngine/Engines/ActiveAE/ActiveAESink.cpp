@@ -15,6 +15,7 @@
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "utils/EndianSwap.h"
 #include "utils/MemUtils.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -1027,7 +1028,10 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
   while (frames > 0)
   {
     maxFrames = std::min(frames, m_sinkFormat.m_frames);
-    written = m_sink->AddPackets(buffer, maxFrames, totalFrames - frames);
+    {
+      PLAYBACK_TRACE_SCOPE("audio", "CActiveAESink::AddPackets");
+      written = m_sink->AddPackets(buffer, maxFrames, totalFrames - frames);
+    }
     if (written == 0)
     {
       CThread::Sleep(
@@ -50,6 +50,12 @@ void CDataCacheCore::Reset()
     m_contentInfo.m_chapters.clear();
     m_contentInfo.m_cutList.clear();
   }
+
+  {
+    CSingleLock lock(m_startSection);
+
+    m_startInfo = {};
+  }
 }
 
 bool CDataCacheCore::HasAVInfoChanges()
@@ -96,6 +102,20 @@ bool CDataCacheCore::IsVideoHwDecoder()
   return m_playerVideoInfo.isHwDecoder;
 }
 
+void CDataCacheCore::SetVideoDecoderThreading(std::string threading)
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  m_playerVideoInfo.decoderThreading = std::move(threading);
+}
+
+std::string CDataCacheCore::GetVideoDecoderThreading()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderThreading;
+}
+
 
 void CDataCacheCore::SetVideoDeintMethod(std::string method)
 {
@@ -246,6 +266,20 @@ int CDataCacheCore::GetAudioBitsPerSample()
   return m_playerAudioInfo.bitsPerSample;
 }
 
+void CDataCacheCore::SetAudioDelay(float delayMs)
+{
+  CSingleLock lock(m_audioPlayerSection);
+
+  m_playerAudioInfo.delayMs = delayMs;
+}
+
+float CDataCacheCore::GetAudioDelay()
+{
+  CSingleLock lock(m_audioPlayerSection);
+
+  return m_playerAudioInfo.delayMs;
+}
+
 void CDataCacheCore::SetCutList(const std::vector<EDL::Cut>& cutList)
 {
   CSingleLock lock(m_contentSection);
@@ -284,6 +318,86 @@ bool CDataCacheCore::IsRenderClockSync()
   return m_renderInfo.m_isClockSync;
 }
 
+void CDataCacheCore::SetDemuxerOpenTime(float openTimeMs, bool probeCached)
+{
+  CSingleLock lock(m_startSection);
+
+  m_startInfo.m_demuxerOpenTimeMs = openTimeMs;
+  m_startInfo.m_probeCached = probeCached;
+}
+
+float CDataCacheCore::GetDemuxerOpenTime()
+{
+  CSingleLock lock(m_startSection);
+
+  return m_startInfo.m_demuxerOpenTimeMs;
+}
+
+bool CDataCacheCore::IsDemuxerProbeCached()
+{
+  CSingleLock lock(m_startSection);
+
+  return m_startInfo.m_probeCached;
+}
+
+void CDataCacheCore::SetFrameTimes(float frameTimeMs, float frameTimeP99Ms)
+{
+  CSingleLock lock(m_renderSection);
+
+  m_renderInfo.m_frameTimeMs = frameTimeMs;
+  m_renderInfo.m_frameTimeP99Ms = frameTimeP99Ms;
+}
+
+float CDataCacheCore::GetFrameTime()
+{
+  CSingleLock lock(m_renderSection);
+
+  return m_renderInfo.m_frameTimeMs;
+}
+
+float CDataCacheCore::GetFrameTimeP99()
+{
+  CSingleLock lock(m_renderSection);
+
+  return m_renderInfo.m_frameTimeP99Ms;
+}
+
+void CDataCacheCore::SetEmulationTime(float emulationTimeMs)
+{
+  CSingleLock lock(m_renderSection);
+
+  m_renderInfo.m_emulationTimeMs = emulationTimeMs;
+}
+
+float CDataCacheCore::GetEmulationTime()
+{
+  CSingleLock lock(m_renderSection);
+
+  return m_renderInfo.m_emulationTimeMs;
+}
+
+void CDataCacheCore::SetFrameDrops(int droppedFrames, int duplicatedFrames)
+{
+  CSingleLock lock(m_renderSection);
+
+  m_renderInfo.m_droppedFrames = droppedFrames;
+  m_renderInfo.m_duplicatedFrames = duplicatedFrames;
+}
+
+int CDataCacheCore::GetDroppedFrames()
+{
+  CSingleLock lock(m_renderSection);
+
+  return m_renderInfo.m_droppedFrames;
+}
+
+int CDataCacheCore::GetDuplicatedFrames()
+{
+  CSingleLock lock(m_renderSection);
+
+  return m_renderInfo.m_duplicatedFrames;
+}
+
 // player states
 void CDataCacheCore::SetStateSeeking(bool active)
 {
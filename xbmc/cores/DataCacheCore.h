@@ -35,6 +35,8 @@ public:
   void SetVideoDecoderName(std::string name, bool isHw);
   std::string GetVideoDecoderName();
   bool IsVideoHwDecoder();
+  void SetVideoDecoderThreading(std::string threading);
+  std::string GetVideoDecoderThreading();
   void SetVideoDeintMethod(std::string method);
   std::string GetVideoDeintMethod();
   void SetVideoPixelFormat(std::string pixFormat);
@@ -58,6 +60,8 @@ public:
   int GetAudioSampleRate();
   void SetAudioBitsPerSample(int bitsPerSample);
   int GetAudioBitsPerSample();
+  void SetAudioDelay(float delayMs);
+  float GetAudioDelay();
 
   // content info
   void SetCutList(const std::vector<EDL::Cut>& cutList);
@@ -65,9 +69,22 @@ public:
   void SetChapters(const std::vector<std::pair<std::string, int64_t>>& chapters);
   std::vector<std::pair<std::string, int64_t>> GetChapters() const;
 
+  // start info
+  void SetDemuxerOpenTime(float openTimeMs, bool probeCached);
+  float GetDemuxerOpenTime();
+  bool IsDemuxerProbeCached();
+
   // render info
   void SetRenderClockSync(bool enabled);
   bool IsRenderClockSync();
+  void SetFrameTimes(float frameTimeMs, float frameTimeP99Ms);
+  float GetFrameTime();
+  float GetFrameTimeP99();
+  void SetEmulationTime(float emulationTimeMs);
+  float GetEmulationTime();
+  void SetFrameDrops(int droppedFrames, int duplicatedFrames);
+  int GetDroppedFrames();
+  int GetDuplicatedFrames();
 
   // player states
   void SetStateSeeking(bool active);
@@ -134,6 +151,7 @@ protected:
   {
     std::string decoderName;
     bool isHwDecoder;
+    std::string decoderThreading;
     std::string deintMethod;
     std::string pixFormat;
     std::string stereoMode;
@@ -150,6 +168,7 @@ protected:
     std::string channels;
     int sampleRate;
     int bitsPerSample;
+    float delayMs;
   } m_playerAudioInfo;
 
   mutable CCriticalSection m_contentSection;
@@ -159,10 +178,22 @@ protected:
     std::vector<std::pair<std::string, int64_t>> m_chapters; // name and position for chapters
   } m_contentInfo;
 
+  CCriticalSection m_startSection;
+  struct SStartInfo
+  {
+    float m_demuxerOpenTimeMs;
+    bool m_probeCached;
+  } m_startInfo = {};
+
   CCriticalSection m_renderSection;
   struct SRenderInfo
   {
     bool m_isClockSync;
+    float m_frameTimeMs;
+    float m_frameTimeP99Ms;
+    float m_emulationTimeMs;
+    int m_droppedFrames;
+    int m_duplicatedFrames;
   } m_renderInfo;
 
   CCriticalSection m_stateSection;
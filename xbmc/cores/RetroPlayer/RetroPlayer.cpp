@@ -215,7 +215,7 @@ bool CRetroPlayer::CloseFile(bool reopen /* = false */)
   {
     std::string savePath = m_playback->CreateSavestate();
     if (!savePath.empty())
-      CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Saved state to {}", CURL::GetRedacted(savePath));
+      CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Saving state to {}", CURL::GetRedacted(savePath));
     else
       CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Failed to save state at close");
   }
@@ -552,7 +552,8 @@ void CRetroPlayer::CreatePlayback(bool bRestoreState)
   {
     m_playback->Deinitialize();
     m_playback.reset(new CReversiblePlayback(m_gameClient.get(), m_gameClient->GetFrameRate(),
-                                             m_gameClient->GetSerializeSize()));
+                                             m_gameClient->GetSerializeSize(),
+                                             &m_processInfo->GetFrameTelemetry()));
   }
   else
     ResetPlayback();
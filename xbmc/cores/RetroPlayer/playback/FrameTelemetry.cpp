@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FrameTelemetry.h"
+
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace KODI;
+using namespace RETRO;
+
+CFrameTelemetry::CFrameTelemetry(size_t capacity /* = DEFAULT_CAPACITY */)
+  : m_frames(std::max(capacity, static_cast<size_t>(1)))
+{
+}
+
+void CFrameTelemetry::Reset()
+{
+  CSingleLock lock(m_mutex);
+
+  m_nextFrame = 0;
+  m_frameCount = 0;
+  m_pending = FrameTelemetry{};
+}
+
+void CFrameTelemetry::SetRenderSubmitTime(double renderSubmitMs)
+{
+  CSingleLock lock(m_mutex);
+
+  m_pending.renderSubmitMs = renderSubmitMs;
+}
+
+void CFrameTelemetry::SetAudioDelay(double audioDelayMs)
+{
+  CSingleLock lock(m_mutex);
+
+  m_pending.audioDelayMs = audioDelayMs;
+}
+
+void CFrameTelemetry::AddDroppedFrame()
+{
+  CSingleLock lock(m_mutex);
+
+  m_pending.droppedFrames++;
+}
+
+void CFrameTelemetry::AddDuplicatedFrame()
+{
+  CSingleLock lock(m_mutex);
+
+  m_pending.duplicatedFrames++;
+}
+
+void CFrameTelemetry::AddFrame(FrameTelemetry frame)
+{
+  CSingleLock lock(m_mutex);
+
+  frame.renderSubmitMs += m_pending.renderSubmitMs;
+  frame.audioDelayMs = std::max(frame.audioDelayMs, m_pending.audioDelayMs);
+  frame.droppedFrames += m_pending.droppedFrames;
+  frame.duplicatedFrames += m_pending.duplicatedFrames;
+  m_pending = FrameTelemetry{};
+
+  m_frames[m_nextFrame] = frame;
+  m_nextFrame = (m_nextFrame + 1) % m_frames.size();
+  m_frameCount = std::min(m_frameCount + 1, m_frames.size());
+}
+
+std::vector<FrameTelemetry> CFrameTelemetry::GetFrames() const
+{
+  std::vector<FrameTelemetry> frames;
+
+  CSingleLock lock(m_mutex);
+
+  frames.reserve(m_frameCount);
+
+  const size_t firstFrame = (m_nextFrame + m_frames.size() - m_frameCount) % m_frames.size();
+  for (size_t i = 0; i < m_frameCount; i++)
+    frames.emplace_back(m_frames[(firstFrame + i) % m_frames.size()]);
+
+  return frames;
+}
+
+FrameTelemetryStats CFrameTelemetry::GetStats() const
+{
+  FrameTelemetryStats stats;
+
+  const std::vector<FrameTelemetry> frames = GetFrames();
+  if (frames.empty())
+    return stats;
+
+  std::vector<double> frameIntervals;
+  std::vector<double> emulationTimes;
+  std::vector<double> renderSubmitTimes;
+  std::vector<double> audioDelays;
+
+  frameIntervals.reserve(frames.size());
+  emulationTimes.reserve(frames.size());
+  renderSubmitTimes.reserve(frames.size());
+  audioDelays.reserve(frames.size());
+
+  for (const FrameTelemetry& frame : frames)
+  {
+    // The first frame after starting or resuming has no interval
+    if (frame.frameIntervalMs > 0.0)
+      frameIntervals.emplace_back(frame.frameIntervalMs);
+    emulationTimes.emplace_back(frame.emulationMs);
+    renderSubmitTimes.emplace_back(frame.renderSubmitMs);
+    audioDelays.emplace_back(frame.audioDelayMs);
+
+    stats.droppedFrames += frame.droppedFrames;
+    stats.duplicatedFrames += frame.duplicatedFrames;
+  }
+
+  stats.frameCount = static_cast<unsigned int>(frames.size());
+  stats.frameIntervalP50Ms = GetPercentile(frameIntervals, 50.0);
+  stats.frameIntervalP95Ms = GetPercentile(frameIntervals, 95.0);
+  stats.frameIntervalP99Ms = GetPercentile(frameIntervals, 99.0);
+  stats.frameIntervalMaxMs = GetPercentile(frameIntervals, 100.0);
+  stats.emulationP50Ms = GetPercentile(emulationTimes, 50.0);
+  stats.emulationP99Ms = GetPercentile(emulationTimes, 99.0);
+  stats.renderSubmitP99Ms = GetPercentile(renderSubmitTimes, 99.0);
+  stats.audioDelayP50Ms = GetPercentile(audioDelays, 50.0);
+
+  return stats;
+}
+
+double CFrameTelemetry::GetPercentile(std::vector<double>& values, double percentile)
+{
+  if (values.empty())
+    return 0.0;
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+
+  // Nearest rank
+  size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * values.size()));
+  if (rank > 0)
+    rank--;
+
+  auto it = values.begin() + rank;
+  std::nth_element(values.begin(), it, values.end());
+
+  return *it;
+}
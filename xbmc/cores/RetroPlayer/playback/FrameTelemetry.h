@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <stddef.h>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Timing of a single frame of the game loop
+ */
+struct FrameTelemetry
+{
+  double frameIntervalMs = 0.0; // Time since the previous frame started
+  double emulationMs = 0.0; // Time spent running the game client for this frame
+  double renderSubmitMs = 0.0; // Time spent submitting the video frame
+  double waitMs = 0.0; // Time spent sleeping until the next frame
+  double audioDelayMs = 0.0; // Audio queued for playback when the frame was submitted
+  unsigned int droppedFrames = 0; // Frames missed since the previous frame
+  unsigned int duplicatedFrames = 0; // Times the previous frame was shown again
+};
+
+/*!
+ * \brief Summary of the frames in the telemetry buffer
+ */
+struct FrameTelemetryStats
+{
+  unsigned int frameCount = 0;
+  double frameIntervalP50Ms = 0.0;
+  double frameIntervalP95Ms = 0.0;
+  double frameIntervalP99Ms = 0.0;
+  double frameIntervalMaxMs = 0.0;
+  double emulationP50Ms = 0.0;
+  double emulationP99Ms = 0.0;
+  double renderSubmitP99Ms = 0.0;
+  double audioDelayP50Ms = 0.0;
+  unsigned int droppedFrames = 0;
+  unsigned int duplicatedFrames = 0;
+};
+
+/*!
+ * \brief Ring buffer of per-frame timing of the game loop
+ *
+ * The game loop adds a record after each frame. Values measured elsewhere
+ * while the frame runs, such as the time to submit the video frame or the
+ * audio delay, are collected first and attached to the next record.
+ *
+ * All functions are thread safe.
+ */
+class CFrameTelemetry
+{
+public:
+  /*!
+   * \brief Create a telemetry buffer
+   *
+   * \param capacity The number of frames to keep
+   */
+  explicit CFrameTelemetry(size_t capacity = DEFAULT_CAPACITY);
+
+  /*!
+   * \brief Remove all frames and pending values
+   */
+  void Reset();
+
+  /*!
+   * \brief Record the time spent submitting the video frame of the running frame
+   */
+  void SetRenderSubmitTime(double renderSubmitMs);
+
+  /*!
+   * \brief Record the audio delay when the audio of the running frame was submitted
+   */
+  void SetAudioDelay(double audioDelayMs);
+
+  /*!
+   * \brief Record a frame which could not be presented
+   */
+  void AddDroppedFrame();
+
+  /*!
+   * \brief Record a render pass which repeated the previous frame
+   */
+  void AddDuplicatedFrame();
+
+  /*!
+   * \brief Add the timing of a frame
+   *
+   * Pending values recorded since the previous frame are added to the timing.
+   */
+  void AddFrame(FrameTelemetry frame);
+
+  /*!
+   * \brief Get the frames in the buffer, oldest first
+   */
+  std::vector<FrameTelemetry> GetFrames() const;
+
+  /*!
+   * \brief Get a summary of the frames in the buffer
+   */
+  FrameTelemetryStats GetStats() const;
+
+  /*!
+   * \brief Get a percentile of a set of values
+   *
+   * \param values The values, reordered by this function
+   * \param percentile The percentile, in the range [0, 100]
+   *
+   * \return The percentile, or 0.0 if there are no values
+   */
+  static double GetPercentile(std::vector<double>& values, double percentile);
+
+  // 10 seconds at 60 fps
+  static constexpr size_t DEFAULT_CAPACITY = 600;
+
+private:
+  // Ring buffer
+  std::vector<FrameTelemetry> m_frames;
+  size_t m_nextFrame = 0;
+  size_t m_frameCount = 0;
+
+  // Values for the running frame
+  FrameTelemetry m_pending;
+
+  mutable CCriticalSection m_mutex;
+};
+} // namespace RETRO
+} // namespace KODI
@@ -8,6 +8,8 @@
 
 #include "GameLoop.h"
 
+#include "FrameTelemetry.h"
+
 #include <chrono>
 #include <cmath>
 
@@ -18,10 +20,13 @@ using namespace std::chrono_literals;
 #define DEFAULT_FPS 60 // In case fps is 0 (shouldn't happen)
 #define FOREVER_MS (7 * 24 * 60 * 60 * 1000) // 1 week is large enough
 
-CGameLoop::CGameLoop(IGameLoopCallback* callback, double fps)
+CGameLoop::CGameLoop(IGameLoopCallback* callback,
+                     double fps,
+                     CFrameTelemetry* telemetry /* = nullptr */)
   : CThread("GameLoop"),
     m_callback(callback),
     m_fps(fps ? fps : DEFAULT_FPS),
+    m_telemetry(telemetry),
     m_speedFactor(0.0),
     m_lastFrameMs(0.0),
     m_adjustTime(0.0)
@@ -64,15 +69,20 @@ void CGameLoop::Process(void)
     if (m_speedFactor == 0.0)
     {
       m_lastFrameMs = 0.0;
+      m_lastFrameStartMs = 0.0;
       m_sleepEvent.Wait(5000ms);
     }
     else
     {
+      const double frameStartMs = NowMs();
+
       if (m_speedFactor > 0.0)
         m_callback->FrameEvent();
       else if (m_speedFactor < 0.0)
         m_callback->RewindEvent();
 
+      const double emulationMs = NowMs() - frameStartMs;
+
       if (m_lastFrameMs > 0.0)
       {
         m_lastFrameMs += FrameTimeMs();
@@ -84,6 +94,8 @@ void CGameLoop::Process(void)
         m_adjustTime = 0.0;
       }
 
+      const double waitStartMs = NowMs();
+
       // Calculate sleep time
       double sleepTimeMs = SleepTimeMs();
 
@@ -98,10 +110,35 @@ void CGameLoop::Process(void)
         // Speed may have changed, update sleep time
         sleepTimeMs = SleepTimeMs();
       }
+
+      if (m_telemetry != nullptr)
+        AddTelemetry(frameStartMs, emulationMs, NowMs() - waitStartMs);
     }
   }
 }
 
+void CGameLoop::AddTelemetry(double frameStartMs, double emulationMs, double waitMs)
+{
+  FrameTelemetry frame;
+
+  frame.emulationMs = emulationMs;
+  frame.waitMs = waitMs;
+
+  if (m_lastFrameStartMs > 0.0)
+  {
+    frame.frameIntervalMs = frameStartMs - m_lastFrameStartMs;
+
+    // Count the frame periods that passed without a new frame
+    const double missedFrames = std::round(frame.frameIntervalMs / FrameTimeMs()) - 1.0;
+    if (missedFrames > 0.0)
+      frame.droppedFrames = static_cast<unsigned int>(missedFrames);
+  }
+
+  m_lastFrameStartMs = frameStartMs;
+
+  m_telemetry->AddFrame(frame);
+}
+
 double CGameLoop::FrameTimeMs() const
 {
   if (m_speedFactor != 0.0)
@@ -33,10 +33,19 @@ public:
   virtual void RewindEvent() = 0;
 };
 
+class CFrameTelemetry;
+
 class CGameLoop : protected CThread
 {
 public:
-  CGameLoop(IGameLoopCallback* callback, double fps);
+  /*!
+   * \brief Create a game loop
+   *
+   * \param callback The callback invoked for every frame
+   * \param fps The frame rate of the game
+   * \param telemetry If not null, receives the timing of every frame
+   */
+  CGameLoop(IGameLoopCallback* callback, double fps, CFrameTelemetry* telemetry = nullptr);
 
   ~CGameLoop() override;
 
@@ -53,6 +62,15 @@ protected:
   // implementation of CThread
   void Process() override;
 
+  /*!
+   * \brief Add the timing of a frame to the telemetry
+   *
+   * \param frameStartMs The time the frame started, from the clock of NowMs()
+   * \param emulationMs The time spent running the game client
+   * \param waitMs The time spent sleeping until the next frame
+   */
+  void AddTelemetry(double frameStartMs, double emulationMs, double waitMs);
+
 private:
   double FrameTimeMs() const;
   double SleepTimeMs() const;
@@ -60,8 +78,10 @@ private:
 
   IGameLoopCallback* const m_callback;
   const double m_fps;
+  CFrameTelemetry* const m_telemetry;
   std::atomic<double> m_speedFactor;
   double m_lastFrameMs;
+  double m_lastFrameStartMs = 0.0;
   mutable double m_adjustTime;
   CEvent m_sleepEvent;
 };
@@ -11,27 +11,44 @@
 #include "ServiceBroker.h"
 #include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
+#include "cores/RetroPlayer/savestates/SavestateWriter.h"
 #include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
 #include "games/GameServices.h"
 #include "games/GameSettings.h"
 #include "games/addons/GameClient.h"
+#include "settings/GameSettings.h"
+#include "settings/MediaSettings.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/MathUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
+#include <vector>
 
 using namespace KODI;
 using namespace RETRO;
 
 #define REWIND_FACTOR 0.25 // Rewind at 25% of gameplay speed
 
+namespace
+{
+// How long to wait for pending savestates to be written
+constexpr auto SAVESTATE_TIMEOUT = std::chrono::seconds(10);
+} // namespace
+
 CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient,
                                          double fps,
-                                         size_t serializeSize)
+                                         size_t serializeSize,
+                                         CFrameTelemetry* telemetry /* = nullptr */)
   : m_gameClient(gameClient),
-    m_gameLoop(this, fps),
+    m_gameLoop(this, fps, telemetry),
     m_savestateDatabase(new CSavestateDatabase),
+    m_savestateWriter(new CSavestateWriter),
+    m_runAhead(new CRunAhead(*this)),
     m_totalFrameCount(0),
     m_pastFrameCount(0),
     m_futureFrameCount(0),
@@ -41,12 +58,23 @@ CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient,
 {
   UpdateMemoryStream();
 
+  // Run-ahead is remembered per game
+  CGameSettings& currentSettings = CMediaSettings::GetInstance().GetCurrentGameSettings();
+  currentSettings.SetRunAheadFrames(CMediaSettings::GetInstance().GetGameRunAheadFrames(
+      m_gameClient->ID(), URIUtils::GetFileName(m_gameClient->GetGamePath())));
+  currentSettings.NotifyObservers(ObservableMessageSettingsChanged);
+  UpdateRunAhead();
+
   GAME::CGameSettings& gameSettings = CServiceBroker::GetGameServices().GameSettings();
   gameSettings.RegisterObserver(this);
+
+  currentSettings.RegisterObserver(this);
 }
 
 CReversiblePlayback::~CReversiblePlayback()
 {
+  CMediaSettings::GetInstance().GetCurrentGameSettings().UnregisterObserver(this);
+
   GAME::CGameSettings& gameSettings = CServiceBroker::GetGameServices().GameSettings();
   gameSettings.UnregisterObserver(this);
 
@@ -143,25 +171,34 @@ std::string CReversiblePlayback::CreateSavestate()
   savestate->SetGameClientID(gameClientId);
   savestate->SetGameClientVersion(gameClientVersion);
 
-  uint8_t* memoryData = savestate->GetMemoryBuffer(memorySize);
+  // Only snapshot the memory here, compression and writing happen in the background
+  std::vector<uint8_t> memoryData = m_savestateWriter->AcquireBuffer(memorySize);
 
   {
     CSingleLock lock(m_mutex);
     if (m_memoryStream && m_memoryStream->CurrentFrame() != nullptr)
     {
-      std::memcpy(memoryData, m_memoryStream->CurrentFrame(), memorySize);
+      std::memcpy(memoryData.data(), m_memoryStream->CurrentFrame(), memorySize);
     }
     else
     {
       lock.Leave();
-      if (!m_gameClient->Serialize(memoryData, memorySize))
+      if (!m_gameClient->Serialize(memoryData.data(), memorySize))
         return "";
     }
   }
 
-  savestate->Finalize();
-
-  if (!m_savestateDatabase->AddSavestate(m_gameClient->GetGamePath(), *savestate))
+  // Writing completes in the background, the writer logs the result.
+  // LoadSavestate() waits for pending writes, so the path can be used as soon
+  // as the savestate is queued.
+  m_savestateWriter->Write(m_gameClient->GetGamePath(), std::move(savestate),
+                           std::move(memoryData),
+                           [this](const std::string&, bool success) {
+                             m_savestateFailed = !success;
+                           });
+
+  // Report a failed write on the next savestate, as the caller doesn't wait for it
+  if (m_savestateFailed)
     return "";
 
   return m_gameClient->GetGamePath();
@@ -177,21 +214,29 @@ bool CReversiblePlayback::LoadSavestate(const std::string& path)
 
   bool bSuccess = false;
 
+  // Savestates may still be in the process of being written
+  if (!m_savestateWriter->Flush(SAVESTATE_TIMEOUT))
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Timed out waiting for savestates to be written");
+
   std::unique_ptr<ISavestate> savestate = m_savestateDatabase->CreateSavestate();
   if (m_savestateDatabase->GetSavestate(path, *savestate) &&
       savestate->GetMemorySize() == memorySize)
   {
+    std::vector<uint8_t> memoryData(memorySize);
+    if (!savestate->GetMemory(memoryData.data(), memorySize))
+      return false;
+
     {
       CSingleLock lock(m_mutex);
       if (m_memoryStream)
       {
         m_memoryStream->SetFrameCounter(savestate->TimestampFrames());
-        std::memcpy(m_memoryStream->BeginFrame(), savestate->GetMemoryData(), memorySize);
+        std::memcpy(m_memoryStream->BeginFrame(), memoryData.data(), memorySize);
         m_memoryStream->SubmitFrame();
       }
     }
 
-    if (m_gameClient->Deserialize(savestate->GetMemoryData(), memorySize))
+    if (m_gameClient->Deserialize(memoryData.data(), memorySize))
     {
       m_totalFrameCount = savestate->TimestampFrames();
       bSuccess = true;
@@ -203,9 +248,18 @@ bool CReversiblePlayback::LoadSavestate(const std::string& path)
 
 void CReversiblePlayback::FrameEvent()
 {
-  m_gameClient->RunFrame();
+  const unsigned int runAheadFrames = m_runAheadFrames;
 
-  AddFrame();
+  if (runAheadFrames > 0)
+  {
+    RunAhead(runAheadFrames);
+  }
+  else
+  {
+    m_gameClient->RunFrame();
+
+    AddFrame();
+  }
 }
 
 void CReversiblePlayback::RewindEvent()
@@ -231,6 +285,44 @@ void CReversiblePlayback::AddFrame()
   m_totalFrameCount++;
 }
 
+void CReversiblePlayback::RunAhead(unsigned int frames)
+{
+  CSingleLock lock(m_mutex);
+
+  const bool bSuccess = m_runAhead->RunFrames(frames, m_memoryStream.get());
+
+  if (m_memoryStream)
+    UpdatePlaybackStats();
+
+  m_totalFrameCount++;
+
+  if (!bSuccess)
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[PLAYBACK]: Failed to run ahead, disabling run-ahead");
+    m_runAheadFrames = 0;
+  }
+}
+
+void CReversiblePlayback::RunFrame(bool bPresentAudio, bool bPresentVideo)
+{
+  m_gameClient->RunFrame(bPresentAudio, bPresentVideo);
+}
+
+size_t CReversiblePlayback::GetStateSize() const
+{
+  return m_gameClient->SerializeSize();
+}
+
+bool CReversiblePlayback::SerializeState(uint8_t* data, size_t size)
+{
+  return m_gameClient->Serialize(data, size);
+}
+
+bool CReversiblePlayback::DeserializeState(const uint8_t* data, size_t size)
+{
+  return m_gameClient->Deserialize(data, size);
+}
+
 void CReversiblePlayback::RewindFrames(uint64_t frames)
 {
   CSingleLock lock(m_mutex);
@@ -278,8 +370,16 @@ void CReversiblePlayback::Notify(const Observable& obs, const ObservableMessage
   switch (msg)
   {
     case ObservableMessageSettingsChanged:
-      UpdateMemoryStream();
+    {
+      if (&obs == &CMediaSettings::GetInstance().GetCurrentGameSettings())
+      {
+        UpdateRunAhead();
+        SaveRunAhead();
+      }
+      else
+        UpdateMemoryStream();
       break;
+    }
     default:
       break;
   }
@@ -314,6 +414,13 @@ void CReversiblePlayback::UpdateMemoryStream()
     {
       m_memoryStream->SetMaxFrameCount(frameCount);
     }
+
+    const size_t memorySize = static_cast<size_t>(gameSettings.MaxRewindMemoryMB()) * 1024 * 1024;
+
+    if (m_memoryStream->MaxMemorySize() != memorySize)
+    {
+      m_memoryStream->SetMaxMemorySize(memorySize);
+    }
   }
   else
   {
@@ -327,3 +434,29 @@ void CReversiblePlayback::UpdateMemoryStream()
     m_cacheTimeMs = 0;
   }
 }
+
+void CReversiblePlayback::UpdateRunAhead()
+{
+  unsigned int runAheadFrames = 0;
+
+  // Run-ahead restores the state every frame, so the game client must support
+  // serialization
+  if (m_gameClient->SerializeSize() > 0)
+    runAheadFrames = CMediaSettings::GetInstance().GetCurrentGameSettings().RunAheadFrames();
+
+  if (runAheadFrames != m_runAheadFrames)
+  {
+    CLog::Log(LOGDEBUG, "RetroPlayer[PLAYBACK]: Running {} frame(s) ahead", runAheadFrames);
+    m_runAheadFrames = runAheadFrames;
+  }
+}
+
+void CReversiblePlayback::SaveRunAhead()
+{
+  const unsigned int runAheadFrames =
+      CMediaSettings::GetInstance().GetCurrentGameSettings().RunAheadFrames();
+
+  if (CMediaSettings::GetInstance().SetGameRunAheadFrames(
+          m_gameClient->ID(), URIUtils::GetFileName(m_gameClient->GetGamePath()), runAheadFrames))
+    CServiceBroker::GetSettingsComponent()->GetSettings()->Save();
+}
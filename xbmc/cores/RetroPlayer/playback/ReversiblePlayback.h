@@ -10,9 +10,11 @@
 
 #include "GameLoop.h"
 #include "IPlayback.h"
+#include "RunAhead.h"
 #include "threads/CriticalSection.h"
 #include "utils/Observer.h"
 
+#include <atomic>
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
@@ -26,13 +28,21 @@ class CGameClient;
 
 namespace RETRO
 {
+class CFrameTelemetry;
 class CSavestateDatabase;
+class CSavestateWriter;
 class IMemoryStream;
 
-class CReversiblePlayback : public IPlayback, public IGameLoopCallback, public Observer
+class CReversiblePlayback : public IPlayback,
+                            public IGameLoopCallback,
+                            public IRunAheadCallback,
+                            public Observer
 {
 public:
-  CReversiblePlayback(GAME::CGameClient* gameClient, double fps, size_t serializeSize);
+  CReversiblePlayback(GAME::CGameClient* gameClient,
+                      double fps,
+                      size_t serializeSize,
+                      CFrameTelemetry* telemetry = nullptr);
 
   ~CReversiblePlayback() override;
 
@@ -55,15 +65,24 @@ public:
   void FrameEvent() override;
   void RewindEvent() override;
 
+  // implementation of IRunAheadCallback
+  void RunFrame(bool bPresentAudio, bool bPresentVideo) override;
+  size_t GetStateSize() const override;
+  bool SerializeState(uint8_t* data, size_t size) override;
+  bool DeserializeState(const uint8_t* data, size_t size) override;
+
   // implementation of Observer
   void Notify(const Observable& obs, const ObservableMessage msg) override;
 
 private:
   void AddFrame();
+  void RunAhead(unsigned int frames);
   void RewindFrames(uint64_t frames);
   void AdvanceFrames(uint64_t frames);
   void UpdatePlaybackStats();
   void UpdateMemoryStream();
+  void UpdateRunAhead();
+  void SaveRunAhead();
 
   // Construction parameter
   GAME::CGameClient* const m_gameClient;
@@ -73,8 +92,14 @@ private:
   std::unique_ptr<IMemoryStream> m_memoryStream;
   CCriticalSection m_mutex;
 
+  // Run-ahead functionality
+  std::unique_ptr<CRunAhead> m_runAhead;
+  std::atomic<unsigned int> m_runAheadFrames{0};
+
   // Savestate functionality
   std::unique_ptr<CSavestateDatabase> m_savestateDatabase;
+  std::atomic<bool> m_savestateFailed{false}; // Set by the writer, so declared before it
+  std::unique_ptr<CSavestateWriter> m_savestateWriter;
 
   // Playback stats
   uint64_t m_totalFrameCount;
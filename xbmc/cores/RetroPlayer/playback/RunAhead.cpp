@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2016-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RunAhead.h"
+
+#include "cores/RetroPlayer/streams/memory/IMemoryStream.h"
+
+using namespace KODI;
+using namespace RETRO;
+
+CRunAhead::CRunAhead(IRunAheadCallback& callback) : m_callback(callback)
+{
+}
+
+bool CRunAhead::RunFrames(unsigned int frames, IMemoryStream* memoryStream)
+{
+  // Run the real frame, its audio is heard but its video is never shown
+  m_callback.RunFrame(true, false);
+
+  // Save the real state
+  const uint8_t* state = nullptr;
+  size_t stateSize = 0;
+
+  if (memoryStream != nullptr)
+  {
+    if (m_callback.SerializeState(memoryStream->BeginFrame(), memoryStream->FrameSize()))
+    {
+      memoryStream->SubmitFrame();
+
+      state = memoryStream->CurrentFrame();
+      stateSize = memoryStream->FrameSize();
+    }
+  }
+  else
+  {
+    m_state.resize(m_callback.GetStateSize());
+    if (m_callback.SerializeState(m_state.data(), m_state.size()))
+    {
+      state = m_state.data();
+      stateSize = m_state.size();
+    }
+  }
+
+  if (state == nullptr)
+    return false;
+
+  // Run the speculative frames silently and show only the last one
+  for (unsigned int i = 1; i <= frames; i++)
+    m_callback.RunFrame(false, i == frames);
+
+  // Return to the real state for the next frame
+  return m_callback.DeserializeState(state, stateSize);
+}
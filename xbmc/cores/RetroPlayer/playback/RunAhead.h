@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2016-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+class IMemoryStream;
+
+class IRunAheadCallback
+{
+public:
+  virtual ~IRunAheadCallback() = default;
+
+  /*!
+   * \brief Emulate a frame
+   *
+   * \param bPresentAudio False to drop the audio of the frame
+   * \param bPresentVideo False to drop the video of the frame
+   */
+  virtual void RunFrame(bool bPresentAudio, bool bPresentVideo) = 0;
+
+  /*!
+   * \brief The size of the emulator state
+   */
+  virtual size_t GetStateSize() const = 0;
+
+  /*!
+   * \brief Save the emulator state
+   */
+  virtual bool SerializeState(uint8_t* data, size_t size) = 0;
+
+  /*!
+   * \brief Restore the emulator state
+   */
+  virtual bool DeserializeState(const uint8_t* data, size_t size) = 0;
+};
+
+/*!
+ * \brief Emulates frames ahead of the shown frame to hide input latency
+ *
+ * Each frame, the real frame is emulated with its audio and its state is
+ * saved. Then the given number of frames is emulated with audio suppressed,
+ * and only the last of these is shown. The saved state is restored before the
+ * next real frame.
+ */
+class CRunAhead
+{
+public:
+  explicit CRunAhead(IRunAheadCallback& callback);
+
+  /*!
+   * \brief Run a real frame followed by the speculative frames
+   *
+   * \param frames The number of speculative frames, must be at least 1
+   * \param memoryStream The rewind buffer, or nullptr if rewinding is disabled.
+   *        The real state is added to it, so run-ahead costs no extra
+   *        serialization when rewinding is enabled.
+   *
+   * \return True if the real state was saved and restored, false if it
+   *         couldn't be saved. Only the real frame has run then.
+   */
+  bool RunFrames(unsigned int frames, IMemoryStream* memoryStream);
+
+private:
+  IRunAheadCallback& m_callback;
+
+  // Holds the real state if there's no rewind buffer
+  std::vector<uint8_t> m_state;
+};
+} // namespace RETRO
+} // namespace KODI
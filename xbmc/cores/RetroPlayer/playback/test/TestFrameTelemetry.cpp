@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/playback/FrameTelemetry.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+FrameTelemetry CreateFrame(double frameIntervalMs, double emulationMs)
+{
+  FrameTelemetry frame;
+  frame.frameIntervalMs = frameIntervalMs;
+  frame.emulationMs = emulationMs;
+  return frame;
+}
+} // namespace
+
+TEST(TestFrameTelemetry, Empty)
+{
+  CFrameTelemetry telemetry;
+
+  EXPECT_TRUE(telemetry.GetFrames().empty());
+
+  const FrameTelemetryStats stats = telemetry.GetStats();
+  EXPECT_EQ(stats.frameCount, 0u);
+  EXPECT_EQ(stats.frameIntervalP99Ms, 0.0);
+}
+
+TEST(TestFrameTelemetry, RingBuffer)
+{
+  CFrameTelemetry telemetry(4);
+
+  for (unsigned int i = 1; i <= 6; i++)
+    telemetry.AddFrame(CreateFrame(static_cast<double>(i), 1.0));
+
+  // Only the newest frames are kept, oldest first
+  const std::vector<FrameTelemetry> frames = telemetry.GetFrames();
+  ASSERT_EQ(frames.size(), 4u);
+  EXPECT_EQ(frames[0].frameIntervalMs, 3.0);
+  EXPECT_EQ(frames[3].frameIntervalMs, 6.0);
+
+  telemetry.Reset();
+  EXPECT_TRUE(telemetry.GetFrames().empty());
+}
+
+TEST(TestFrameTelemetry, PendingValues)
+{
+  CFrameTelemetry telemetry;
+
+  telemetry.SetRenderSubmitTime(0.5);
+  telemetry.SetAudioDelay(40.0);
+  telemetry.AddDroppedFrame();
+  telemetry.AddDuplicatedFrame();
+  telemetry.AddDuplicatedFrame();
+  telemetry.AddFrame(CreateFrame(16.0, 2.0));
+
+  // Pending values only belong to the frame that was running
+  telemetry.AddFrame(CreateFrame(16.0, 2.0));
+
+  const std::vector<FrameTelemetry> frames = telemetry.GetFrames();
+  ASSERT_EQ(frames.size(), 2u);
+
+  EXPECT_EQ(frames[0].renderSubmitMs, 0.5);
+  EXPECT_EQ(frames[0].audioDelayMs, 40.0);
+  EXPECT_EQ(frames[0].droppedFrames, 1u);
+  EXPECT_EQ(frames[0].duplicatedFrames, 2u);
+
+  EXPECT_EQ(frames[1].renderSubmitMs, 0.0);
+  EXPECT_EQ(frames[1].droppedFrames, 0u);
+  EXPECT_EQ(frames[1].duplicatedFrames, 0u);
+
+  const FrameTelemetryStats stats = telemetry.GetStats();
+  EXPECT_EQ(stats.droppedFrames, 1u);
+  EXPECT_EQ(stats.duplicatedFrames, 2u);
+}
+
+TEST(TestFrameTelemetry, Percentiles)
+{
+  CFrameTelemetry telemetry;
+
+  // 98 regular frames and 2 slow frames
+  for (unsigned int i = 0; i < 98; i++)
+    telemetry.AddFrame(CreateFrame(16.0, 1.0));
+  telemetry.AddFrame(CreateFrame(33.0, 10.0));
+  telemetry.AddFrame(CreateFrame(50.0, 20.0));
+
+  const FrameTelemetryStats stats = telemetry.GetStats();
+  EXPECT_EQ(stats.frameCount, 100u);
+  EXPECT_EQ(stats.frameIntervalP50Ms, 16.0);
+  EXPECT_EQ(stats.frameIntervalP95Ms, 16.0);
+  EXPECT_EQ(stats.frameIntervalP99Ms, 33.0);
+  EXPECT_EQ(stats.frameIntervalMaxMs, 50.0);
+  EXPECT_EQ(stats.emulationP50Ms, 1.0);
+  EXPECT_EQ(stats.emulationP99Ms, 10.0);
+}
+
+TEST(TestFrameTelemetry, GetPercentile)
+{
+  std::vector<double> values{5.0, 1.0, 4.0, 2.0, 3.0};
+
+  EXPECT_EQ(CFrameTelemetry::GetPercentile(values, 0.0), 1.0);
+  EXPECT_EQ(CFrameTelemetry::GetPercentile(values, 50.0), 3.0);
+  EXPECT_EQ(CFrameTelemetry::GetPercentile(values, 100.0), 5.0);
+
+  std::vector<double> empty;
+  EXPECT_EQ(CFrameTelemetry::GetPercentile(empty, 50.0), 0.0);
+}
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/playback/FrameTelemetry.h"
+#include "cores/RetroPlayer/playback/GameLoop.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+using namespace std::chrono_literals;
+
+namespace
+{
+/*!
+ * \brief Game client stub which spends a fixed time emulating each frame
+ */
+class CStubGameClient : public IGameLoopCallback
+{
+public:
+  CStubGameClient(std::chrono::microseconds emulationTime,
+                  unsigned int frameCount,
+                  CFrameTelemetry& telemetry)
+    : m_emulationTime(emulationTime), m_frameCount(frameCount), m_telemetry(telemetry)
+  {
+  }
+
+  // implementation of IGameLoopCallback
+  void FrameEvent() override
+  {
+    // Busy wait like an emulator, sleeping would hide scheduling jitter
+    const auto end = std::chrono::steady_clock::now() + m_emulationTime;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+
+    m_telemetry.SetRenderSubmitTime(0.1);
+    m_telemetry.SetAudioDelay(40.0);
+
+    if (++m_framesRun == m_frameCount)
+      m_doneEvent.Set();
+  }
+
+  void RewindEvent() override {}
+
+  bool WaitForFrames() { return m_doneEvent.Wait(30s); }
+
+private:
+  const std::chrono::microseconds m_emulationTime;
+  const unsigned int m_frameCount;
+  CFrameTelemetry& m_telemetry;
+  std::atomic<unsigned int> m_framesRun{0};
+  CEvent m_doneEvent;
+};
+
+/*!
+ * \brief Game loop which isn't started, so that the test can add frames with
+ *        the times of a synthetic clock
+ */
+class CTestGameLoop : public CGameLoop
+{
+public:
+  CTestGameLoop(IGameLoopCallback* callback, double fps, CFrameTelemetry* telemetry)
+    : CGameLoop(callback, fps, telemetry)
+  {
+  }
+
+  using CGameLoop::AddTelemetry;
+};
+
+unsigned int GetEnvironment(const char* name, unsigned int defaultValue)
+{
+  const char* value = std::getenv(name);
+  if (value != nullptr && std::atoi(value) > 0)
+    return static_cast<unsigned int>(std::atoi(value));
+
+  return defaultValue;
+}
+} // namespace
+
+TEST(TestGameLoop, Telemetry)
+{
+  CFrameTelemetry telemetry;
+  CStubGameClient gameClient(0us, 0, telemetry);
+  CTestGameLoop gameLoop(&gameClient, 50.0, &telemetry);
+  gameLoop.SetSpeed(1.0);
+
+  // Frames at 50 fps take 20 ms, the frame at 110 ms comes two periods late
+  for (double frameStartMs : {10.0, 30.0, 50.0, 69.0, 110.0, 129.0})
+    gameLoop.AddTelemetry(frameStartMs, 2.0, 15.0);
+
+  const std::vector<FrameTelemetry> frames = telemetry.GetFrames();
+  ASSERT_EQ(frames.size(), 6u);
+
+  // The first frame has no previous frame to measure from
+  EXPECT_EQ(frames[0].frameIntervalMs, 0.0);
+  EXPECT_EQ(frames[0].droppedFrames, 0u);
+  EXPECT_EQ(frames[1].frameIntervalMs, 20.0);
+  EXPECT_EQ(frames[3].frameIntervalMs, 19.0);
+  EXPECT_EQ(frames[3].droppedFrames, 0u);
+  EXPECT_EQ(frames[4].frameIntervalMs, 41.0);
+  EXPECT_EQ(frames[4].droppedFrames, 1u);
+  EXPECT_EQ(frames[5].emulationMs, 2.0);
+  EXPECT_EQ(frames[5].waitMs, 15.0);
+
+  const FrameTelemetryStats stats = telemetry.GetStats();
+  EXPECT_EQ(stats.frameCount, 6u);
+  EXPECT_EQ(stats.frameIntervalP50Ms, 20.0);
+  EXPECT_EQ(stats.frameIntervalMaxMs, 41.0);
+  EXPECT_EQ(stats.droppedFrames, 1u);
+}
+
+TEST(TestGameLoop, TelemetryFastForward)
+{
+  CFrameTelemetry telemetry;
+  CStubGameClient gameClient(0us, 0, telemetry);
+  CTestGameLoop gameLoop(&gameClient, 50.0, &telemetry);
+
+  // Frames take 10 ms at twice the speed, and 20 ms are a dropped frame
+  gameLoop.SetSpeed(2.0);
+  for (double frameStartMs : {0.0, 10.0, 20.0, 40.0})
+    gameLoop.AddTelemetry(frameStartMs, 1.0, 8.0);
+
+  const std::vector<FrameTelemetry> frames = telemetry.GetFrames();
+  ASSERT_EQ(frames.size(), 4u);
+  EXPECT_EQ(frames[2].droppedFrames, 0u);
+  EXPECT_EQ(frames[3].droppedFrames, 1u);
+}
+
+/*!
+ * \brief Run the game loop headless with a stub game client and record the
+ *        frame pacing as test properties
+ *
+ * Disabled by default, as it measures the host. Run it with
+ * --gtest_also_run_disabled_tests and --gtest_output=xml to get the
+ * results. For a meaningful measurement, set KODI_GAMELOOP_FPS,
+ * KODI_GAMELOOP_FRAMES and KODI_GAMELOOP_EMULATION_US, e.g. 60, 3600 and 4000
+ * for a minute of a demanding core.
+ */
+TEST(TestGameLoop, DISABLED_HeadlessFramePacing)
+{
+  const unsigned int fps = GetEnvironment("KODI_GAMELOOP_FPS", 120);
+  const unsigned int frameCount = GetEnvironment("KODI_GAMELOOP_FRAMES", 60);
+  const unsigned int emulationUs = GetEnvironment("KODI_GAMELOOP_EMULATION_US", 1000);
+
+  CFrameTelemetry telemetry(frameCount);
+  CStubGameClient gameClient(std::chrono::microseconds(emulationUs), frameCount, telemetry);
+
+  CGameLoop gameLoop(&gameClient, static_cast<double>(fps), &telemetry);
+  gameLoop.Start();
+  gameLoop.SetSpeed(1.0);
+
+  ASSERT_TRUE(gameClient.WaitForFrames());
+
+  gameLoop.Stop();
+
+  const FrameTelemetryStats stats = telemetry.GetStats();
+
+  ::testing::Test::RecordProperty("fps", fps);
+  ::testing::Test::RecordProperty("frames", stats.frameCount);
+  ::testing::Test::RecordProperty("frameTimeP50Ms", std::to_string(stats.frameIntervalP50Ms));
+  ::testing::Test::RecordProperty("frameTimeP95Ms", std::to_string(stats.frameIntervalP95Ms));
+  ::testing::Test::RecordProperty("frameTimeP99Ms", std::to_string(stats.frameIntervalP99Ms));
+  ::testing::Test::RecordProperty("frameTimeMaxMs", std::to_string(stats.frameIntervalMaxMs));
+  ::testing::Test::RecordProperty("emulationP50Ms", std::to_string(stats.emulationP50Ms));
+  ::testing::Test::RecordProperty("emulationP99Ms", std::to_string(stats.emulationP99Ms));
+  ::testing::Test::RecordProperty("droppedFrames", stats.droppedFrames);
+
+  ASSERT_EQ(stats.frameCount, frameCount);
+
+  const double frameTimeMs = 1000.0 / fps;
+  const double emulationMs = emulationUs / 1000.0;
+
+  // Loose bounds, the host may be loaded while testing
+  EXPECT_GE(stats.emulationP50Ms, emulationMs);
+  EXPECT_GT(stats.frameIntervalP50Ms, frameTimeMs * 0.5);
+  EXPECT_LT(stats.frameIntervalP50Ms, frameTimeMs * 2.0);
+  EXPECT_EQ(stats.renderSubmitP99Ms, 0.1);
+  EXPECT_EQ(stats.audioDelayP50Ms, 40.0);
+}
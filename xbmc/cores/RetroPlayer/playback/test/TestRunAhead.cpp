@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/playback/RunAhead.h"
+#include "cores/RetroPlayer/streams/memory/BasicMemoryStream.h"
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+struct Frame
+{
+  uint32_t state; // The emulator state the frame started from
+  bool bPresentAudio;
+  bool bPresentVideo;
+};
+
+/*!
+ * \brief Emulator whose state is a frame counter
+ */
+class CTestEmulator : public IRunAheadCallback
+{
+public:
+  void RunFrame(bool bPresentAudio, bool bPresentVideo) override
+  {
+    frames.push_back({state, bPresentAudio, bPresentVideo});
+    state++;
+  }
+
+  size_t GetStateSize() const override { return sizeof(state); }
+
+  bool SerializeState(uint8_t* data, size_t size) override
+  {
+    if (!bCanSerialize || size != sizeof(state))
+      return false;
+
+    std::memcpy(data, &state, sizeof(state));
+    return true;
+  }
+
+  bool DeserializeState(const uint8_t* data, size_t size) override
+  {
+    if (size != sizeof(state))
+      return false;
+
+    std::memcpy(&state, data, sizeof(state));
+    return true;
+  }
+
+  uint32_t state = 0;
+  bool bCanSerialize = true;
+  std::vector<Frame> frames;
+};
+} // namespace
+
+TEST(TestRunAhead, StepsOneRealFrame)
+{
+  CTestEmulator emulator;
+  CRunAhead runAhead(emulator);
+
+  ASSERT_TRUE(runAhead.RunFrames(2, nullptr));
+
+  // The real frame is heard, only the last speculative frame is shown
+  ASSERT_EQ(3u, emulator.frames.size());
+  EXPECT_EQ(0u, emulator.frames[0].state);
+  EXPECT_TRUE(emulator.frames[0].bPresentAudio);
+  EXPECT_FALSE(emulator.frames[0].bPresentVideo);
+  EXPECT_EQ(1u, emulator.frames[1].state);
+  EXPECT_FALSE(emulator.frames[1].bPresentAudio);
+  EXPECT_FALSE(emulator.frames[1].bPresentVideo);
+  EXPECT_EQ(2u, emulator.frames[2].state);
+  EXPECT_FALSE(emulator.frames[2].bPresentAudio);
+  EXPECT_TRUE(emulator.frames[2].bPresentVideo);
+
+  // The emulator is back at the state after the real frame
+  EXPECT_EQ(1u, emulator.state);
+}
+
+TEST(TestRunAhead, AdvancesOneFramePerCall)
+{
+  CTestEmulator emulator;
+  CRunAhead runAhead(emulator);
+
+  for (unsigned int i = 0; i < 10; i++)
+    ASSERT_TRUE(runAhead.RunFrames(4, nullptr));
+
+  EXPECT_EQ(10u, emulator.state);
+  EXPECT_EQ(50u, emulator.frames.size());
+
+  // Every call starts from the real state of the previous one
+  for (unsigned int i = 0; i < 10; i++)
+    EXPECT_EQ(i, emulator.frames[i * 5].state);
+}
+
+TEST(TestRunAhead, SavesToRewindBuffer)
+{
+  CTestEmulator emulator;
+  CRunAhead runAhead(emulator);
+
+  CBasicMemoryStream memoryStream;
+  memoryStream.Init(emulator.GetStateSize(), 1);
+
+  ASSERT_TRUE(runAhead.RunFrames(1, &memoryStream));
+  ASSERT_TRUE(runAhead.RunFrames(1, &memoryStream));
+
+  // The rewind buffer holds the real state, not a speculative one
+  ASSERT_NE(nullptr, memoryStream.CurrentFrame());
+  uint32_t state;
+  std::memcpy(&state, memoryStream.CurrentFrame(), sizeof(state));
+  EXPECT_EQ(2u, state);
+  EXPECT_EQ(2u, emulator.state);
+}
+
+TEST(TestRunAhead, FailsWithoutState)
+{
+  CTestEmulator emulator;
+  emulator.bCanSerialize = false;
+  CRunAhead runAhead(emulator);
+
+  EXPECT_FALSE(runAhead.RunFrames(2, nullptr));
+
+  // Only the real frame has run
+  ASSERT_EQ(1u, emulator.frames.size());
+  EXPECT_EQ(1u, emulator.state);
+}
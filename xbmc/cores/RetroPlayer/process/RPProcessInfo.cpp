@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "cores/DataCacheCore.h"
 #include "cores/RetroPlayer/buffers/RenderBufferManager.h"
+#include "cores/RetroPlayer/playback/FrameTelemetry.h"
 #include "cores/RetroPlayer/rendering/RenderContext.h"
 #include "settings/DisplaySettings.h"
 #include "settings/MediaSettings.h"
@@ -40,7 +41,8 @@ CRPProcessInfo::CRPProcessInfo(std::string platformName)
                                        CServiceBroker::GetWinSystem(),
                                        CServiceBroker::GetWinSystem()->GetGfxContext(),
                                        CDisplaySettings::GetInstance(),
-                                       CMediaSettings::GetInstance()))
+                                       CMediaSettings::GetInstance())),
+    m_frameTelemetry(new CFrameTelemetry)
 {
   for (auto& rendererFactory : m_rendererFactories)
   {
@@ -167,7 +169,13 @@ void CRPProcessInfo::ResetInfo()
     m_dataCache->SetGuiRender(true); //! @todo
     m_dataCache->SetVideoRender(false); //! @todo
     m_dataCache->SetPlayTimes(0, 0, 0, 0);
+    m_dataCache->SetFrameTimes(0.0f, 0.0f);
+    m_dataCache->SetEmulationTime(0.0f);
+    m_dataCache->SetAudioDelay(0.0f);
+    m_dataCache->SetFrameDrops(0, 0);
   }
+
+  m_frameTelemetry->Reset();
 }
 
 bool CRPProcessInfo::HasScalingMethod(SCALINGMETHOD scalingMethod) const
@@ -241,3 +249,27 @@ void CRPProcessInfo::SetPlayTimes(time_t start, int64_t current, int64_t min, in
   if (m_dataCache != nullptr)
     m_dataCache->SetPlayTimes(start, current, min, max);
 }
+
+//******************************************************************************
+// frame pacing
+//******************************************************************************
+void CRPProcessInfo::UpdateFrameStats()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastFrameStatsUpdate < std::chrono::seconds(1))
+    return;
+
+  m_lastFrameStatsUpdate = now;
+
+  if (m_dataCache != nullptr)
+  {
+    const FrameTelemetryStats stats = m_frameTelemetry->GetStats();
+
+    m_dataCache->SetFrameTimes(static_cast<float>(stats.frameIntervalP50Ms),
+                               static_cast<float>(stats.frameIntervalP99Ms));
+    m_dataCache->SetEmulationTime(static_cast<float>(stats.emulationP50Ms));
+    m_dataCache->SetAudioDelay(static_cast<float>(stats.audioDelayP50Ms));
+    m_dataCache->SetFrameDrops(static_cast<int>(stats.droppedFrames),
+                               static_cast<int>(stats.duplicatedFrames));
+  }
+}
@@ -12,6 +12,7 @@
 #include "cores/RetroPlayer/RetroPlayerTypes.h"
 #include "threads/CriticalSection.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@ namespace KODI
 {
 namespace RETRO
 {
+class CFrameTelemetry;
 class CRenderBufferManager;
 class CRenderContext;
 class CRenderSettings;
@@ -164,6 +166,24 @@ public:
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   ///}
 
+  /// @name Frame pacing
+  ///{
+
+  /*!
+   * \brief Get the per-frame timing of the game loop
+   */
+  CFrameTelemetry& GetFrameTelemetry() { return *m_frameTelemetry; }
+
+  /*!
+   * \brief Publish a summary of the frame timing to the data cache
+   *
+   * The summary is only recalculated once per second. Call from the render
+   * thread.
+   */
+  void UpdateFrameStats();
+
+  ///}
+
 protected:
   /*!
    * \brief Constructor
@@ -195,6 +215,10 @@ private:
   // Rendering parameters
   std::unique_ptr<CRenderContext> m_renderContext;
   SCALINGMETHOD m_defaultScalingMethod = SCALINGMETHOD::AUTO;
+
+  // Frame pacing parameters
+  std::unique_ptr<CFrameTelemetry> m_frameTelemetry;
+  std::chrono::steady_clock::time_point m_lastFrameStatsUpdate;
 };
 
 } // namespace RETRO
@@ -9,6 +9,7 @@
 #include "RPRenderManager.h"
 
 #include "RenderContext.h"
+#include "RenderPixelConverter.h"
 #include "RenderSettings.h"
 #include "RenderTranslator.h"
 #include "cores/RetroPlayer/buffers/IRenderBuffer.h"
@@ -17,6 +18,7 @@
 #include "cores/RetroPlayer/guibridge/GUIGameSettings.h"
 #include "cores/RetroPlayer/guibridge/GUIRenderTargetFactory.h"
 #include "cores/RetroPlayer/guibridge/IGUIRenderSettings.h"
+#include "cores/RetroPlayer/playback/FrameTelemetry.h"
 #include "cores/RetroPlayer/process/RPProcessInfo.h"
 #include "cores/RetroPlayer/rendering/VideoRenderers/RPBaseRenderer.h"
 #include "threads/SingleLock.h"
@@ -30,6 +32,7 @@ extern "C"
 }
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
 using namespace KODI;
@@ -120,8 +123,19 @@ bool CRPRenderManager::GetVideoBuffer(
   if (m_pendingBuffers.empty())
     return false;
 
-  //! @todo Handle multiple buffers
-  IRenderBuffer* renderBuffer = m_pendingBuffers.at(0);
+  // Prefer a buffer in the format of the game client, otherwise the first
+  // buffer is used and its format is reported. Other pending buffers are
+  // filled from this buffer when the frame is added.
+  auto it = std::find_if(m_pendingBuffers.begin(), m_pendingBuffers.end(),
+                         [this](const IRenderBuffer* buffer) {
+                           return buffer->GetFormat() == m_format;
+                         });
+
+  // Keep the buffer written by the game client in front
+  if (it != m_pendingBuffers.end())
+    std::iter_swap(m_pendingBuffers.begin(), it);
+
+  IRenderBuffer* renderBuffer = m_pendingBuffers.front();
 
   format = renderBuffer->GetFormat();
   data = renderBuffer->GetMemory();
@@ -143,19 +157,39 @@ void CRPRenderManager::AddFrame(const uint8_t* data,
   if (data == nullptr || size == 0 || width == 0 || height == 0)
     return;
 
+  const auto submitStart = std::chrono::steady_clock::now();
+
   // Get render buffers to copy the frame into
   std::vector<IRenderBuffer*> renderBuffers;
 
-  // Check pending buffers
-  for (IRenderBuffer* buffer : m_pendingBuffers)
+  // Check if the game client wrote into the pending buffer
+  IRenderBuffer* zeroCopyBuffer = nullptr;
+  if (!m_pendingBuffers.empty() && m_pendingBuffers.front()->GetMemory() == data)
   {
-    if (buffer->GetMemory() == data)
+    zeroCopyBuffer = m_pendingBuffers.front();
+
+    // Fill the buffers of other visible renderers from the zero-copy buffer
+    for (auto it = m_pendingBuffers.begin() + 1; it != m_pendingBuffers.end(); ++it)
     {
-      buffer->Acquire();
-      renderBuffers.emplace_back(buffer);
+      IRenderBuffer* renderBuffer = *it;
+      CopyFrame(renderBuffer, zeroCopyBuffer->GetFormat(), data, size, width, height);
+      renderBuffer->Acquire();
+      renderBuffers.emplace_back(renderBuffer);
     }
   }
 
+  // Cache frame if it arrived after being paused. This reads the frame, so it
+  // must happen before the memory of the zero-copy buffer is released.
+  if (m_speed == 0.0)
+    CacheFrame(data, size, width, height);
+
+  if (zeroCopyBuffer != nullptr)
+  {
+    zeroCopyBuffer->ReleaseMemory();
+    zeroCopyBuffer->Acquire();
+    renderBuffers.emplace_back(zeroCopyBuffer);
+  }
+
   // If we aren't submitting a zero-copy frame, copy into render buffer now
   if (renderBuffers.empty())
   {
@@ -187,34 +221,44 @@ void CRPRenderManager::AddFrame(const uint8_t* data,
     // Apply rotation to render buffers
     for (auto renderBuffer : m_renderBuffers)
       renderBuffer->SetRotation(orientationDegCCW);
+  }
 
-    // Cache frame if it arrived after being paused
-    if (m_speed == 0.0)
-    {
-      std::vector<uint8_t> cachedFrame = std::move(m_cachedFrame);
+  m_frameCount++;
 
-      if (!m_bHasCachedFrame)
-      {
-        // In this case, cachedFrame is definitely empty (see invariant for
-        // m_bHasCachedFrame). Otherwise, cachedFrame may be empty if the frame
-        // is being copied in the rendering thread. In that case, we would want
-        // to leave cached frame empty to avoid caching another frame.
+  const std::chrono::duration<double, std::milli> submitTime =
+      std::chrono::steady_clock::now() - submitStart;
+  m_processInfo.GetFrameTelemetry().SetRenderSubmitTime(submitTime.count());
+}
 
-        cachedFrame.resize(size);
-        m_bHasCachedFrame = true;
-      }
+void CRPRenderManager::CacheFrame(const uint8_t* data,
+                                  size_t size,
+                                  unsigned int width,
+                                  unsigned int height)
+{
+  CSingleLock lock(m_bufferMutex);
 
-      if (!cachedFrame.empty())
-      {
-        {
-          CSingleExit exit(m_bufferMutex);
-          std::memcpy(cachedFrame.data(), data, size);
-        }
-        m_cachedFrame = std::move(cachedFrame);
-        m_cachedWidth = width;
-        m_cachedHeight = height;
-      }
+  std::vector<uint8_t> cachedFrame = std::move(m_cachedFrame);
+
+  if (!m_bHasCachedFrame)
+  {
+    // In this case, cachedFrame is definitely empty (see invariant for
+    // m_bHasCachedFrame). Otherwise, cachedFrame may be empty if the frame
+    // is being copied in the rendering thread. In that case, we would want
+    // to leave cached frame empty to avoid caching another frame.
+
+    cachedFrame.resize(size);
+    m_bHasCachedFrame = true;
+  }
+
+  if (!cachedFrame.empty())
+  {
+    {
+      CSingleExit exit(m_bufferMutex);
+      std::memcpy(cachedFrame.data(), data, size);
     }
+    m_cachedFrame = std::move(cachedFrame);
+    m_cachedWidth = width;
+    m_cachedHeight = height;
   }
 }
 
@@ -247,7 +291,15 @@ void CRPRenderManager::FrameMove()
   {
     for (auto& renderer : m_renderers)
       renderer->FrameMove();
+
+    // At normal speed, every render pass should show a new frame
+    const uint64_t frameCount = m_frameCount;
+    if (frameCount == m_lastRenderedFrameCount && m_speed == 1.0)
+      m_processInfo.GetFrameTelemetry().AddDuplicatedFrame();
+    m_lastRenderedFrameCount = frameCount;
   }
+
+  m_processInfo.UpdateFrameStats();
 }
 
 void CRPRenderManager::CheckFlush()
@@ -629,13 +681,15 @@ void CRPRenderManager::CopyFrame(IRenderBuffer* renderBuffer,
     const unsigned int targetStride =
         static_cast<unsigned int>(renderBuffer->GetFrameSize() / renderBuffer->GetHeight());
 
-    if (m_format == renderBuffer->GetFormat())
+    const AVPixelFormat targetFormat = renderBuffer->GetFormat();
+
+    if (format == targetFormat)
     {
       if (sourceStride == targetStride)
         std::memcpy(target, source, size);
       else
       {
-        const unsigned int widthBytes = CRenderTranslator::TranslateWidthToBytes(width, m_format);
+        const unsigned int widthBytes = CRenderTranslator::TranslateWidthToBytes(width, format);
         if (widthBytes > 0)
         {
           for (unsigned int i = 0; i < height; i++)
@@ -643,12 +697,18 @@ void CRPRenderManager::CopyFrame(IRenderBuffer* renderBuffer,
         }
       }
     }
+    else if (width == renderBuffer->GetWidth() && height == renderBuffer->GetHeight() &&
+             CRenderPixelConverter::IsSupported(format, targetFormat))
+    {
+      CRenderPixelConverter::Convert(format, source, sourceStride, targetFormat, target,
+                                     targetStride, width, height);
+    }
     else
     {
-      SwsContext*& scalerContext = m_scalers[renderBuffer->GetFormat()];
+      SwsContext*& scalerContext = m_scalers[targetFormat];
       scalerContext = sws_getCachedContext(
           scalerContext, width, height, format, renderBuffer->GetWidth(), renderBuffer->GetHeight(),
-          renderBuffer->GetFormat(), SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+          targetFormat, SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
 
       if (scalerContext != nullptr)
       {
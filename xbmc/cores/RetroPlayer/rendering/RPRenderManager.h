@@ -173,6 +173,9 @@ private:
 
   /*!
    * \brief Utility function to copy a frame and rescale pixels if necessary
+   *
+   * Frames of the same size are converted with CRenderPixelConverter if it
+   * supports the formats, otherwise swscale is used.
    */
   void CopyFrame(IRenderBuffer* renderBuffer,
                  AVPixelFormat format,
@@ -181,6 +184,11 @@ private:
                  unsigned int width,
                  unsigned int height);
 
+  /*!
+   * \brief Keep a copy of a frame that arrived while paused
+   */
+  void CacheFrame(const uint8_t* data, size_t size, unsigned int width, unsigned int height);
+
   CRenderVideoSettings GetEffectiveSettings(const IGUIRenderSettings* settings) const;
 
   void CheckFlush();
@@ -200,7 +208,7 @@ private:
 
   // Render resources
   std::set<std::shared_ptr<CRPBaseRenderer>> m_renderers;
-  std::vector<IRenderBuffer*> m_pendingBuffers; // Only access from game thread
+  std::vector<IRenderBuffer*> m_pendingBuffers; // Only access from game thread, zero-copy first
   std::vector<IRenderBuffer*> m_renderBuffers;
   std::map<AVPixelFormat, SwsContext*> m_scalers;
   std::vector<uint8_t> m_cachedFrame;
@@ -225,6 +233,10 @@ private:
   // Playback parameters
   std::atomic<double> m_speed = {1.0};
 
+  // Telemetry parameters
+  std::atomic<uint64_t> m_frameCount = {0}; // Number of frames added
+  uint64_t m_lastRenderedFrameCount = 0; // Only access from render thread
+
   // Synchronization parameters
   CCriticalSection m_stateMutex;
   CCriticalSection m_bufferMutex;
@@ -0,0 +1,236 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RenderPixelConverter.h"
+
+#include <cstring>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(HAS_NEON) && (defined(__aarch64__) || defined(__arm__))
+#include <arm_neon.h>
+#define RP_PIXEL_CONVERTER_NEON
+#endif
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// The native endian formats of the game clients match the byte order of
+// BGRA only on little endian hosts
+constexpr bool IS_LITTLE_ENDIAN = (AV_PIX_FMT_0RGB32 == AV_PIX_FMT_BGR0);
+
+constexpr uint32_t ALPHA_MASK = 0xFF000000;
+
+enum class SourceFormat
+{
+  NONE,
+  XRGB8888,
+  RGB565,
+  RGB555,
+};
+
+SourceFormat GetSourceFormat(AVPixelFormat format)
+{
+  switch (format)
+  {
+    case AV_PIX_FMT_0RGB32:
+      return SourceFormat::XRGB8888;
+    case AV_PIX_FMT_RGB565:
+      return SourceFormat::RGB565;
+    case AV_PIX_FMT_RGB555:
+      return SourceFormat::RGB555;
+    default:
+      break;
+  }
+
+  return SourceFormat::NONE;
+}
+
+bool IsTargetFormat(AVPixelFormat format)
+{
+  // BGR0 ignores the alpha channel, so it can be set like for BGRA
+  return format == AV_PIX_FMT_BGRA || format == AV_PIX_FMT_BGR0;
+}
+
+inline uint32_t ExpandRGB565(uint16_t pixel)
+{
+  const uint32_t r = ((pixel >> 8) & 0xF8) | (pixel >> 13);
+  const uint32_t g = ((pixel >> 3) & 0xFC) | ((pixel >> 9) & 0x03);
+  const uint32_t b = ((pixel << 3) & 0xF8) | ((pixel >> 2) & 0x07);
+
+  return ALPHA_MASK | (r << 16) | (g << 8) | b;
+}
+
+inline uint32_t ExpandRGB555(uint16_t pixel)
+{
+  const uint32_t r = ((pixel >> 7) & 0xF8) | ((pixel >> 12) & 0x07);
+  const uint32_t g = ((pixel >> 2) & 0xF8) | ((pixel >> 7) & 0x07);
+  const uint32_t b = ((pixel << 3) & 0xF8) | ((pixel >> 2) & 0x07);
+
+  return ALPHA_MASK | (r << 16) | (g << 8) | b;
+}
+
+void ConvertRowXRGB8888(const uint8_t* source, uint8_t* target, unsigned int width)
+{
+  unsigned int x = 0;
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  const __m128i alpha = _mm_set1_epi32(static_cast<int>(ALPHA_MASK));
+  for (; x + 4 <= width; x += 4)
+  {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + x * 4), _mm_or_si128(pixels, alpha));
+  }
+#elif defined(RP_PIXEL_CONVERTER_NEON)
+  const uint32x4_t alpha = vdupq_n_u32(ALPHA_MASK);
+  for (; x + 4 <= width; x += 4)
+  {
+    const uint32x4_t pixels = vreinterpretq_u32_u8(vld1q_u8(source + x * 4));
+    vst1q_u8(target + x * 4, vreinterpretq_u8_u32(vorrq_u32(pixels, alpha)));
+  }
+#endif
+
+  for (; x < width; x++)
+  {
+    uint32_t pixel;
+    std::memcpy(&pixel, source + x * 4, sizeof(pixel));
+    pixel |= ALPHA_MASK;
+    std::memcpy(target + x * 4, &pixel, sizeof(pixel));
+  }
+}
+
+template<bool bGreen6>
+void ConvertRow16(const uint8_t* source, uint8_t* target, unsigned int width)
+{
+  unsigned int x = 0;
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  const __m128i mask_f8 = _mm_set1_epi16(0xF8);
+  const __m128i mask_fc = _mm_set1_epi16(0xFC);
+  const __m128i mask_07 = _mm_set1_epi16(0x07);
+  const __m128i mask_03 = _mm_set1_epi16(0x03);
+  const __m128i alpha = _mm_set1_epi16(static_cast<short>(0xFF00));
+
+  // 8 pixels per iteration
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 2));
+
+    __m128i r;
+    __m128i g;
+    if (bGreen6)
+    {
+      r = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(p, 8), mask_f8), _mm_srli_epi16(p, 13));
+      g = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(p, 3), mask_fc),
+                       _mm_and_si128(_mm_srli_epi16(p, 9), mask_03));
+    }
+    else
+    {
+      r = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(p, 7), mask_f8),
+                       _mm_and_si128(_mm_srli_epi16(p, 12), mask_07));
+      g = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(p, 2), mask_f8),
+                       _mm_and_si128(_mm_srli_epi16(p, 7), mask_07));
+    }
+    const __m128i b = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(p, 3), mask_f8),
+                                   _mm_and_si128(_mm_srli_epi16(p, 2), mask_07));
+
+    // Interleave to B, G, R, A bytes
+    const __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+    const __m128i ra = _mm_or_si128(r, alpha);
+
+    __m128i* dst = reinterpret_cast<__m128i*>(target + x * 4);
+    _mm_storeu_si128(dst, _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(bg, ra));
+  }
+#elif defined(RP_PIXEL_CONVERTER_NEON)
+  const uint8x8_t alpha = vdup_n_u8(0xFF);
+
+  // 8 pixels per iteration
+  for (; x + 8 <= width; x += 8)
+  {
+    const uint16x8_t p = vreinterpretq_u16_u8(vld1q_u8(source + x * 2));
+
+    uint16x8_t r;
+    uint16x8_t g;
+    if (bGreen6)
+    {
+      r = vorrq_u16(vandq_u16(vshrq_n_u16(p, 8), vdupq_n_u16(0xF8)), vshrq_n_u16(p, 13));
+      g = vorrq_u16(vandq_u16(vshrq_n_u16(p, 3), vdupq_n_u16(0xFC)),
+                    vandq_u16(vshrq_n_u16(p, 9), vdupq_n_u16(0x03)));
+    }
+    else
+    {
+      r = vorrq_u16(vandq_u16(vshrq_n_u16(p, 7), vdupq_n_u16(0xF8)),
+                    vandq_u16(vshrq_n_u16(p, 12), vdupq_n_u16(0x07)));
+      g = vorrq_u16(vandq_u16(vshrq_n_u16(p, 2), vdupq_n_u16(0xF8)),
+                    vandq_u16(vshrq_n_u16(p, 7), vdupq_n_u16(0x07)));
+    }
+    const uint16x8_t b = vorrq_u16(vandq_u16(vshlq_n_u16(p, 3), vdupq_n_u16(0xF8)),
+                                   vandq_u16(vshrq_n_u16(p, 2), vdupq_n_u16(0x07)));
+
+    uint8x8x4_t bgra;
+    bgra.val[0] = vmovn_u16(b);
+    bgra.val[1] = vmovn_u16(g);
+    bgra.val[2] = vmovn_u16(r);
+    bgra.val[3] = alpha;
+    vst4_u8(target + x * 4, bgra);
+  }
+#endif
+
+  for (; x < width; x++)
+  {
+    uint16_t pixel;
+    std::memcpy(&pixel, source + x * 2, sizeof(pixel));
+    const uint32_t expanded = bGreen6 ? ExpandRGB565(pixel) : ExpandRGB555(pixel);
+    std::memcpy(target + x * 4, &expanded, sizeof(expanded));
+  }
+}
+} // namespace
+
+bool CRenderPixelConverter::IsSupported(AVPixelFormat sourceFormat, AVPixelFormat targetFormat)
+{
+  return IS_LITTLE_ENDIAN && GetSourceFormat(sourceFormat) != SourceFormat::NONE &&
+         IsTargetFormat(targetFormat);
+}
+
+bool CRenderPixelConverter::Convert(AVPixelFormat sourceFormat,
+                                    const uint8_t* source,
+                                    size_t sourceStride,
+                                    AVPixelFormat targetFormat,
+                                    uint8_t* target,
+                                    size_t targetStride,
+                                    unsigned int width,
+                                    unsigned int height)
+{
+  if (!IsSupported(sourceFormat, targetFormat))
+    return false;
+
+  void (*convertRow)(const uint8_t*, uint8_t*, unsigned int) = nullptr;
+
+  switch (GetSourceFormat(sourceFormat))
+  {
+    case SourceFormat::XRGB8888:
+      convertRow = ConvertRowXRGB8888;
+      break;
+    case SourceFormat::RGB565:
+      convertRow = ConvertRow16<true>;
+      break;
+    case SourceFormat::RGB555:
+      convertRow = ConvertRow16<false>;
+      break;
+    default:
+      return false;
+  }
+
+  for (unsigned int y = 0; y < height; y++)
+    convertRow(source + sourceStride * y, target + targetStride * y, width);
+
+  return true;
+}
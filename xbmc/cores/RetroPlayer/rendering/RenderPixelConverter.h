@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libavutil/pixfmt.h>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Fast pixel format conversion for the common game client formats
+ *
+ * Game clients output 0RGB8888, RGB565 or 0RGB1555, while GUI textures and
+ * the Windows renderer expect BGRA. This class converts between them with
+ * SSE2 or NEON where available, avoiding the overhead of a generic swscale
+ * context for the most frequent case.
+ *
+ * Only conversion is supported, not scaling. Use swscale for everything else.
+ */
+class CRenderPixelConverter
+{
+public:
+  /*!
+   * \brief Check if a conversion can be performed by this class
+   *
+   * \param sourceFormat The pixel format of the source frame
+   * \param targetFormat The pixel format of the target frame
+   *
+   * \return True if Convert() supports the conversion, false otherwise
+   */
+  static bool IsSupported(AVPixelFormat sourceFormat, AVPixelFormat targetFormat);
+
+  /*!
+   * \brief Convert a frame to a different pixel format
+   *
+   * The source and target frames must have the same dimensions.
+   *
+   * \param sourceFormat The pixel format of the source frame
+   * \param source The pixels of the source frame
+   * \param sourceStride The size of a row of the source frame, in bytes
+   * \param targetFormat The pixel format of the target frame
+   * \param target The pixels of the target frame
+   * \param targetStride The size of a row of the target frame, in bytes
+   * \param width The width of the frame, in pixels
+   * \param height The height of the frame, in pixels
+   *
+   * \return True if the frame was converted, false if the conversion isn't
+   *         supported
+   */
+  static bool Convert(AVPixelFormat sourceFormat,
+                      const uint8_t* source,
+                      size_t sourceStride,
+                      AVPixelFormat targetFormat,
+                      uint8_t* target,
+                      size_t targetStride,
+                      unsigned int width,
+                      unsigned int height);
+};
+} // namespace RETRO
+} // namespace KODI
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/rendering/RenderPixelConverter.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// Odd width to exercise both the vectorized loop and the remainder
+constexpr unsigned int WIDTH = 37;
+constexpr unsigned int HEIGHT = 5;
+
+// Expand a color channel of the given bit depth to 8 bits
+uint32_t Expand(uint32_t value, unsigned int bits)
+{
+  return (value << (8 - bits)) | (value >> (2 * bits - 8));
+}
+
+uint32_t ReferenceBGRA(AVPixelFormat format, const uint8_t* pixel)
+{
+  switch (format)
+  {
+    case AV_PIX_FMT_0RGB32:
+    {
+      uint32_t value;
+      std::memcpy(&value, pixel, sizeof(value));
+      return 0xFF000000 | value;
+    }
+    case AV_PIX_FMT_RGB565:
+    {
+      uint16_t value;
+      std::memcpy(&value, pixel, sizeof(value));
+      return 0xFF000000 | Expand((value >> 11) & 0x1F, 5) << 16 |
+             Expand((value >> 5) & 0x3F, 6) << 8 | Expand(value & 0x1F, 5);
+    }
+    case AV_PIX_FMT_RGB555:
+    {
+      uint16_t value;
+      std::memcpy(&value, pixel, sizeof(value));
+      return 0xFF000000 | Expand((value >> 10) & 0x1F, 5) << 16 |
+             Expand((value >> 5) & 0x1F, 5) << 8 | Expand(value & 0x1F, 5);
+    }
+    default:
+      break;
+  }
+  return 0;
+}
+
+unsigned int GetBytesPerPixel(AVPixelFormat format)
+{
+  return format == AV_PIX_FMT_0RGB32 ? 4 : 2;
+}
+} // namespace
+
+class TestRenderPixelConverter : public ::testing::TestWithParam<AVPixelFormat>
+{
+};
+
+TEST_P(TestRenderPixelConverter, ConvertToBGRA)
+{
+  const AVPixelFormat sourceFormat = GetParam();
+
+  if (!CRenderPixelConverter::IsSupported(sourceFormat, AV_PIX_FMT_BGRA))
+    return; // Big endian host
+
+  const unsigned int bpp = GetBytesPerPixel(sourceFormat);
+
+  // Padded strides, like render buffers with alignment
+  const size_t sourceStride = WIDTH * bpp + 6;
+  const size_t targetStride = WIDTH * 4 + 12;
+
+  std::mt19937 random(1234);
+  std::vector<uint8_t> source(sourceStride * HEIGHT);
+  for (uint8_t& byte : source)
+    byte = static_cast<uint8_t>(random());
+
+  std::vector<uint8_t> target(targetStride * HEIGHT, 0x5A);
+
+  ASSERT_TRUE(CRenderPixelConverter::Convert(sourceFormat, source.data(), sourceStride,
+                                             AV_PIX_FMT_BGRA, target.data(), targetStride, WIDTH,
+                                             HEIGHT));
+
+  for (unsigned int y = 0; y < HEIGHT; y++)
+  {
+    for (unsigned int x = 0; x < WIDTH; x++)
+    {
+      const uint8_t* sourcePixel = source.data() + y * sourceStride + x * bpp;
+      const uint8_t* targetPixel = target.data() + y * targetStride + x * 4;
+
+      const uint32_t expected = ReferenceBGRA(sourceFormat, sourcePixel);
+
+      // BGRA is a byte order, compare bytes
+      EXPECT_EQ(targetPixel[0], expected & 0xFF) << "x=" << x << " y=" << y;
+      EXPECT_EQ(targetPixel[1], (expected >> 8) & 0xFF) << "x=" << x << " y=" << y;
+      EXPECT_EQ(targetPixel[2], (expected >> 16) & 0xFF) << "x=" << x << " y=" << y;
+      EXPECT_EQ(targetPixel[3], 0xFF) << "x=" << x << " y=" << y;
+    }
+
+    // Row padding must not be touched
+    for (size_t i = WIDTH * 4; i < targetStride; i++)
+      EXPECT_EQ(target[y * targetStride + i], 0x5A);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(RetroPlayer,
+                         TestRenderPixelConverter,
+                         ::testing::Values(AV_PIX_FMT_0RGB32, AV_PIX_FMT_RGB565, AV_PIX_FMT_RGB555));
+
+TEST(TestRenderPixelConverterFormats, Unsupported)
+{
+  EXPECT_FALSE(CRenderPixelConverter::IsSupported(AV_PIX_FMT_0RGB32, AV_PIX_FMT_RGB565));
+  EXPECT_FALSE(CRenderPixelConverter::IsSupported(AV_PIX_FMT_YUV420P, AV_PIX_FMT_BGRA));
+
+  uint8_t pixel[4] = {};
+  EXPECT_FALSE(CRenderPixelConverter::Convert(AV_PIX_FMT_RGB565, pixel, sizeof(pixel),
+                                              AV_PIX_FMT_RGB555, pixel, sizeof(pixel), 1, 1));
+}
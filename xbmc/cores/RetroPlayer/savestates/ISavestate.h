@@ -11,6 +11,7 @@
 #include "SavestateTypes.h"
 #include "XBDateTime.h"
 
+#include <memory>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -98,13 +99,28 @@ public:
   ///{
   /*!
    * \brief A pointer to the internal memory (SRAM) of the frame
+   *
+   * \return The memory, or nullptr if the memory is compressed
+   *
+   * \sa GetMemory()
    */
   virtual const uint8_t* GetMemoryData() const = 0;
 
   /*!
-   * \brief The size of the memory region returned by GetMemoryData()
+   * \brief The uncompressed size of the internal memory
    */
   virtual size_t GetMemorySize() const = 0;
+
+  /*!
+   * \brief Copy the internal memory to the given buffer, decompressing it if
+   *        necessary
+   *
+   * \param buffer The buffer to copy to
+   * \param size The size of the buffer, must be equal to GetMemorySize()
+   *
+   * \return True if the memory was copied, false otherwise
+   */
+  virtual bool GetMemory(uint8_t* buffer, size_t size) const = 0;
   ///}
 
   // Build flatbuffer by setting individual fields
@@ -118,12 +134,21 @@ public:
   virtual void SetGameClientID(const std::string& gameClient) = 0;
   virtual void SetGameClientVersion(const std::string& gameClient) = 0;
   virtual uint8_t* GetMemoryBuffer(size_t size) = 0;
+  virtual void SetCompressedMemory(const uint8_t* data, size_t size) = 0;
   virtual void Finalize() = 0;
 
   /*!
    * \brief Take ownership and initialize the flatbuffer with the given vector
    */
   virtual bool Deserialize(std::vector<uint8_t> data) = 0;
+
+  /*!
+   * \brief Initialize the flatbuffer with the given memory, e.g. a mapped file
+   *
+   * \param data The memory, kept alive as long as this savestate uses it
+   * \param size The size of the memory
+   */
+  virtual bool Deserialize(std::shared_ptr<const uint8_t> data, size_t size) = 0;
 };
 } // namespace RETRO
 } // namespace KODI
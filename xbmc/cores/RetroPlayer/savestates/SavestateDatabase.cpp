@@ -14,9 +14,70 @@
 #include "filesystem/File.h"
 #include "utils/log.h"
 
+#if defined(TARGET_POSIX)
+#include "filesystem/SpecialProtocol.h"
+#include "platform/posix/utils/FileHandle.h"
+#include "platform/posix/utils/Mmap.h"
+#include "utils/URIUtils.h"
+
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
 using namespace KODI;
 using namespace RETRO;
 
+namespace
+{
+#if defined(TARGET_POSIX)
+/*!
+ * \brief Map a savestate on a local file system into memory
+ *
+ * This avoids reading and copying large savestates, as the memory is
+ * decompressed or copied straight from the page cache.
+ *
+ * \return The mapped savestate, or empty if the savestate isn't local or
+ *         can't be mapped
+ */
+std::shared_ptr<const uint8_t> MapSavestate(const std::string& savestatePath, size_t& size)
+{
+  using namespace UTILS::POSIX;
+
+  if (!URIUtils::IsHD(savestatePath))
+    return {};
+
+  const std::string localPath = CSpecialProtocol::TranslatePath(savestatePath);
+
+  CFileHandle fd(open(localPath.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!fd)
+    return {};
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    return {};
+
+  try
+  {
+    const size_t length = static_cast<size_t>(fileStat.st_size);
+    auto mapping = std::make_shared<CMmap>(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    size = length;
+
+    // The mapping stays valid after closing the file
+    return std::shared_ptr<const uint8_t>(mapping, static_cast<const uint8_t*>(mapping->Data()));
+  }
+  catch (const std::system_error& e)
+  {
+    CLog::Log(LOGDEBUG, "Failed to map savestate {}: {}", CURL::GetRedacted(savestatePath),
+              e.what());
+  }
+
+  return {};
+}
+#endif
+} // namespace
+
 CSavestateDatabase::CSavestateDatabase() = default;
 
 std::unique_ptr<ISavestate> CSavestateDatabase::CreateSavestate()
@@ -36,19 +97,39 @@ bool CSavestateDatabase::AddSavestate(const std::string& gamePath, const ISavest
 
   CLog::Log(LOGDEBUG, "Saving savestate to {}", CURL::GetRedacted(savestatePath));
 
+  // Write to a temporary file first, so that a savestate being loaded or
+  // mapped is never truncated and a failed write doesn't destroy it
+  const std::string tempPath = savestatePath + ".tmp";
+
   const uint8_t* data = nullptr;
   size_t size = 0;
   if (save.Serialize(data, size))
   {
     XFILE::CFile file;
-    if (file.OpenForWrite(savestatePath))
+    if (file.OpenForWrite(tempPath, true))
     {
       const ssize_t written = file.Write(data, size);
+      file.Close();
+
       if (written == static_cast<ssize_t>(size))
       {
-        CLog::Log(LOGDEBUG, "Wrote savestate of {} bytes", size);
-        bSuccess = true;
+        // Not all platforms replace existing files on rename
+        if (!XFILE::CFile::Rename(tempPath, savestatePath))
+        {
+          XFILE::CFile::Delete(savestatePath);
+          bSuccess = XFILE::CFile::Rename(tempPath, savestatePath);
+        }
+        else
+          bSuccess = true;
+
+        if (bSuccess)
+          CLog::Log(LOGDEBUG, "Wrote savestate of {} bytes", size);
+        else
+          CLog::Log(LOGERROR, "Failed to replace savestate");
       }
+
+      if (!bSuccess)
+        XFILE::CFile::Delete(tempPath);
     }
     else
       CLog::Log(LOGERROR, "Failed to open savestate for writing");
@@ -65,6 +146,13 @@ bool CSavestateDatabase::GetSavestate(const std::string& gamePath, ISavestate& s
 
   CLog::Log(LOGDEBUG, "Loading savestate from {}", CURL::GetRedacted(savestatePath));
 
+#if defined(TARGET_POSIX)
+  size_t mappedSize = 0;
+  std::shared_ptr<const uint8_t> mappedData = MapSavestate(savestatePath, mappedSize);
+  if (mappedData)
+    return save.Deserialize(std::move(mappedData), mappedSize);
+#endif
+
   std::vector<uint8_t> savestateData;
 
   XFILE::CFile savestateFile;
@@ -11,12 +11,43 @@
 #include "savestate_generated.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include <lzo/lzo1x.h>
+
 using namespace KODI;
 using namespace RETRO;
 
 namespace
 {
-const uint8_t SCHEMA_VERSION = 1;
+const uint8_t SCHEMA_VERSION = 2;
+
+/*!
+ * \brief The oldest schema version that can be read
+ *
+ * Version 2 only added fields, so version 1 savestates are still valid.
+ */
+const uint8_t MIN_SCHEMA_VERSION = 1;
+
+/*!
+ * \brief The size of the independently compressed memory blocks
+ *
+ * Small enough to keep the compression buffers in cache, large enough for a
+ * good compression ratio.
+ */
+const size_t COMPRESSION_BLOCK_SIZE = 256 * 1024;
+
+/*!
+ * \brief Size of the block header holding the compressed block size
+ */
+const size_t COMPRESSION_HEADER_SIZE = sizeof(uint32_t);
+
+bool InitializeCompression()
+{
+  static const bool bInitialized = (lzo_init() == LZO_E_OK);
+  return bInitialized;
+}
 
 /*!
  * \brief The initial size of the FlatBuffer's memory buffer
@@ -73,17 +104,20 @@ CSavestateFlatBuffer::~CSavestateFlatBuffer() = default;
 void CSavestateFlatBuffer::Reset()
 {
   m_builder.reset(new flatbuffers::FlatBufferBuilder(INITIAL_FLATBUFFER_SIZE));
-  m_data.clear();
+  m_data.reset();
+  m_dataSize = 0;
   m_savestate = nullptr;
+  m_memoryCompressed = false;
+  m_memorySize = 0;
 }
 
 bool CSavestateFlatBuffer::Serialize(const uint8_t*& data, size_t& size) const
 {
-  // Check if savestate was deserialized from vector or built with FlatBuffers
-  if (!m_data.empty())
+  // Check if savestate was deserialized from memory or built with FlatBuffers
+  if (m_data)
   {
-    data = m_data.data();
-    size = m_data.size();
+    data = m_data.get();
+    size = m_dataSize;
   }
   else
   {
@@ -220,7 +254,8 @@ void CSavestateFlatBuffer::SetGameClientVersion(const std::string& gameClientVer
 
 const uint8_t* CSavestateFlatBuffer::GetMemoryData() const
 {
-  if (m_savestate != nullptr && m_savestate->memory_data())
+  if (m_savestate != nullptr && m_savestate->memory_data() &&
+      m_savestate->memory_compression() == MemoryCompression_None)
     return m_savestate->memory_data()->data();
 
   return nullptr;
@@ -229,21 +264,138 @@ const uint8_t* CSavestateFlatBuffer::GetMemoryData() const
 size_t CSavestateFlatBuffer::GetMemorySize() const
 {
   if (m_savestate != nullptr && m_savestate->memory_data())
+  {
+    if (m_savestate->memory_compression() != MemoryCompression_None)
+      return static_cast<size_t>(m_savestate->memory_size());
+
     return m_savestate->memory_data()->size();
+  }
 
   return 0;
 }
 
+bool CSavestateFlatBuffer::GetMemory(uint8_t* buffer, size_t size) const
+{
+  if (size != GetMemorySize() || size == 0)
+    return false;
+
+  const flatbuffers::Vector<uint8_t>* memoryData = m_savestate->memory_data();
+
+  switch (m_savestate->memory_compression())
+  {
+    case MemoryCompression_None:
+    {
+      std::memcpy(buffer, memoryData->data(), size);
+      return true;
+    }
+    case MemoryCompression_LZO:
+      break;
+    default:
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Unknown memory compression {}",
+                static_cast<int>(m_savestate->memory_compression()));
+      return false;
+  }
+
+  const size_t blockSize = m_savestate->memory_block_size();
+  if (blockSize == 0 || !InitializeCompression())
+    return false;
+
+  // Decompress block by block, straight from the (mapped) savestate
+  const uint8_t* data = memoryData->data();
+  const uint8_t* dataEnd = data + memoryData->size();
+
+  for (size_t offset = 0; offset < size; offset += blockSize)
+  {
+    const size_t uncompressedSize = std::min(blockSize, size - offset);
+
+    if (static_cast<size_t>(dataEnd - data) < COMPRESSION_HEADER_SIZE)
+      return false;
+
+    const size_t compressedSize = flatbuffers::ReadScalar<uint32_t>(data);
+    data += COMPRESSION_HEADER_SIZE;
+
+    if (static_cast<size_t>(dataEnd - data) < compressedSize)
+      return false;
+
+    if (compressedSize == uncompressedSize)
+    {
+      std::memcpy(buffer + offset, data, uncompressedSize);
+    }
+    else
+    {
+      lzo_uint decompressedSize = static_cast<lzo_uint>(uncompressedSize);
+      if (lzo1x_decompress_safe(data, static_cast<lzo_uint>(compressedSize), buffer + offset,
+                                &decompressedSize, nullptr) != LZO_E_OK ||
+          decompressedSize != uncompressedSize)
+      {
+        CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to decompress memory at offset {}",
+                  offset);
+        return false;
+      }
+    }
+
+    data += compressedSize;
+  }
+
+  return true;
+}
+
 uint8_t* CSavestateFlatBuffer::GetMemoryBuffer(size_t size)
 {
   uint8_t* memoryBuffer = nullptr;
 
   m_memoryDataOffset.reset(
       new VectorOffset{m_builder->CreateUninitializedVector(size, &memoryBuffer)});
+  m_memoryCompressed = false;
+  m_memorySize = size;
 
   return memoryBuffer;
 }
 
+void CSavestateFlatBuffer::SetCompressedMemory(const uint8_t* data, size_t size)
+{
+  if (!InitializeCompression())
+  {
+    std::memcpy(GetMemoryBuffer(size), data, size);
+    return;
+  }
+
+  // Worst case expansion of incompressible data, see lzo1x.h
+  const size_t maxCompressedBlockSize =
+      COMPRESSION_BLOCK_SIZE + COMPRESSION_BLOCK_SIZE / 16 + 64 + 3;
+  const size_t blockCount = (size + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+
+  std::vector<uint8_t> compressed(blockCount * (COMPRESSION_HEADER_SIZE + maxCompressedBlockSize));
+  std::vector<uint8_t> workMemory(LZO1X_1_MEM_COMPRESS);
+
+  size_t compressedSize = 0;
+  for (size_t offset = 0; offset < size; offset += COMPRESSION_BLOCK_SIZE)
+  {
+    const size_t blockSize = std::min(COMPRESSION_BLOCK_SIZE, size - offset);
+
+    uint8_t* header = compressed.data() + compressedSize;
+    uint8_t* block = header + COMPRESSION_HEADER_SIZE;
+
+    lzo_uint blockCompressedSize = static_cast<lzo_uint>(maxCompressedBlockSize);
+    if (lzo1x_1_compress(data + offset, static_cast<lzo_uint>(blockSize), block,
+                         &blockCompressedSize, workMemory.data()) != LZO_E_OK ||
+        blockCompressedSize >= blockSize)
+    {
+      // Store incompressible blocks as-is
+      std::memcpy(block, data + offset, blockSize);
+      blockCompressedSize = static_cast<lzo_uint>(blockSize);
+    }
+
+    flatbuffers::WriteScalar<uint32_t>(header, static_cast<uint32_t>(blockCompressedSize));
+    compressedSize += COMPRESSION_HEADER_SIZE + blockCompressedSize;
+  }
+
+  m_memoryDataOffset.reset(
+      new VectorOffset{m_builder->CreateVector(compressed.data(), compressedSize)});
+  m_memoryCompressed = true;
+  m_memorySize = size;
+}
+
 void CSavestateFlatBuffer::Finalize()
 {
   // Helper class to build the nested Savestate table
@@ -297,6 +449,14 @@ void CSavestateFlatBuffer::Finalize()
     m_memoryDataOffset.reset();
   }
 
+  if (m_memoryCompressed)
+  {
+    savestateBuilder.add_memory_compression(MemoryCompression_LZO);
+    savestateBuilder.add_memory_block_size(static_cast<uint32_t>(COMPRESSION_BLOCK_SIZE));
+  }
+
+  savestateBuilder.add_memory_size(m_memorySize);
+
   auto savestate = savestateBuilder.Finish();
   FinishSavestateBuffer(*m_builder, savestate);
 
@@ -305,20 +465,31 @@ void CSavestateFlatBuffer::Finalize()
 
 bool CSavestateFlatBuffer::Deserialize(std::vector<uint8_t> data)
 {
-  flatbuffers::Verifier verifier(data.data(), data.size());
+  // Keep the vector alive as long as its data is in use
+  auto vector = std::make_shared<std::vector<uint8_t>>(std::move(data));
+  const size_t size = vector->size();
+
+  return Deserialize(std::shared_ptr<const uint8_t>(vector, vector->data()), size);
+}
+
+bool CSavestateFlatBuffer::Deserialize(std::shared_ptr<const uint8_t> data, size_t size)
+{
+  flatbuffers::Verifier verifier(data.get(), size);
   if (VerifySavestateBuffer(verifier))
   {
-    const Savestate* savestate = GetSavestate(data.data());
+    const Savestate* savestate = GetSavestate(data.get());
 
-    if (savestate->version() != SCHEMA_VERSION)
+    if (savestate->version() < MIN_SCHEMA_VERSION || savestate->version() > SCHEMA_VERSION)
     {
-      CLog::Log(LOGERROR, "RetroPlayer[SAVE): Schema version {} not supported, must be version {}",
-                savestate->version(), SCHEMA_VERSION);
+      CLog::Log(LOGERROR,
+                "RetroPlayer[SAVE): Schema version {} not supported, must be version {} to {}",
+                savestate->version(), MIN_SCHEMA_VERSION, SCHEMA_VERSION);
     }
     else
     {
       m_data = std::move(data);
-      m_savestate = GetSavestate(m_data.data());
+      m_dataSize = size;
+      m_savestate = savestate;
       return true;
     }
   }
@@ -46,6 +46,7 @@ public:
   std::string GameClientVersion() const override;
   const uint8_t* GetMemoryData() const override;
   size_t GetMemorySize() const override;
+  bool GetMemory(uint8_t* buffer, size_t size) const override;
   void SetType(SAVE_TYPE type) override;
   void SetSlot(uint8_t slot) override;
   void SetLabel(const std::string& label) override;
@@ -56,8 +57,10 @@ public:
   void SetGameClientID(const std::string& gameClient) override;
   void SetGameClientVersion(const std::string& gameClient) override;
   uint8_t* GetMemoryBuffer(size_t size) override;
+  void SetCompressedMemory(const uint8_t* data, size_t size) override;
   void Finalize() override;
   bool Deserialize(std::vector<uint8_t> data) override;
+  bool Deserialize(std::shared_ptr<const uint8_t> data, size_t size) override;
 
 private:
   /*!
@@ -70,9 +73,10 @@ private:
   /*!
    * \brief System memory storage (for deserializing savestates)
    *
-   * This memory is used when deserializing from a vector.
+   * This memory is used when deserializing from a vector or a mapped file.
    */
-  std::vector<uint8_t> m_data;
+  std::shared_ptr<const uint8_t> m_data;
+  size_t m_dataSize = 0;
 
   /*!
    * \brief FlatBuffer struct used for accessing data
@@ -93,6 +97,8 @@ private:
   std::unique_ptr<StringOffset> m_emulatorAddonIdOffset;
   std::unique_ptr<StringOffset> m_emulatorVersionOffset;
   std::unique_ptr<VectorOffset> m_memoryDataOffset;
+  bool m_memoryCompressed = false;
+  uint64_t m_memorySize = 0;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -0,0 +1,215 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SavestateWriter.h"
+
+#include "ISavestate.h"
+#include "SavestateDatabase.h"
+#include "URL.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+/*!
+ * \brief The maximum number of savestates compressed and written at once
+ */
+constexpr unsigned int MAX_JOBS = 2;
+
+/*!
+ * \brief The maximum number of snapshot buffers kept for reuse
+ */
+constexpr size_t MAX_POOLED_BUFFERS = MAX_JOBS + 1;
+
+/*!
+ * \brief How long the destructor waits for the savestates to be written
+ */
+constexpr auto DESTROY_TIMEOUT = std::chrono::seconds(10);
+
+bool AddSavestate(const std::string& gamePath, const ISavestate& save)
+{
+  CSavestateDatabase savestateDatabase;
+  return savestateDatabase.AddSavestate(gamePath, save);
+}
+} // namespace
+
+CSavestateWriter::CSavestateWriter() : CSavestateWriter(AddSavestate)
+{
+}
+
+CSavestateWriter::CSavestateWriter(WriteFunction writeFunction)
+  : m_writeQueue(std::make_shared<WriteQueue>(std::move(writeFunction)))
+{
+}
+
+CSavestateWriter::~CSavestateWriter()
+{
+  if (!Flush(DESTROY_TIMEOUT))
+  {
+    CSingleLock lock(m_writeQueue->mutex);
+
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Timed out writing savestates, discarding {}",
+              m_writeQueue->requests.size());
+
+    // Running jobs finish the savestate they're writing, jobs that haven't
+    // started yet find no request
+    m_writeQueue->requests.clear();
+    m_writeQueue->queue.clear();
+    m_writeQueue->discarded = true;
+  }
+}
+
+std::vector<uint8_t> CSavestateWriter::AcquireBuffer(size_t size)
+{
+  std::vector<uint8_t> buffer;
+
+  {
+    CSingleLock lock(m_writeQueue->mutex);
+
+    auto& bufferPool = m_writeQueue->bufferPool;
+    auto it = std::find_if(bufferPool.begin(), bufferPool.end(),
+                           [size](const std::vector<uint8_t>& pooledBuffer) {
+                             return pooledBuffer.capacity() >= size;
+                           });
+    if (it != bufferPool.end())
+    {
+      buffer = std::move(*it);
+      bufferPool.erase(it);
+    }
+  }
+
+  buffer.resize(size);
+
+  return buffer;
+}
+
+void CSavestateWriter::WriteQueue::ReleaseBuffer(std::vector<uint8_t> buffer)
+{
+  if (bufferPool.size() < MAX_POOLED_BUFFERS)
+    bufferPool.emplace_back(std::move(buffer));
+}
+
+void CSavestateWriter::Write(const std::string& gamePath,
+                             std::unique_ptr<ISavestate> savestate,
+                             std::vector<uint8_t> memory,
+                             CompletionFunction onWritten)
+{
+  CSingleLock lock(m_writeQueue->mutex);
+
+  // Replace a savestate of the same game that is still waiting
+  auto it = m_writeQueue->requests.find(gamePath);
+  if (it != m_writeQueue->requests.end())
+  {
+    CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Replacing unwritten savestate for {}",
+              CURL::GetRedacted(gamePath));
+    m_writeQueue->ReleaseBuffer(std::move(it->second.memory));
+    it->second = {std::move(savestate), std::move(memory), std::move(onWritten)};
+    return;
+  }
+
+  m_writeQueue->requests.emplace(
+      gamePath, WriteRequest{std::move(savestate), std::move(memory), std::move(onWritten)});
+  m_writeQueue->idleEvent.Reset();
+
+  // Savestates of the same game are written one at a time
+  if (m_writeQueue->jobCount < MAX_JOBS &&
+      m_writeQueue->writing.find(gamePath) == m_writeQueue->writing.end())
+  {
+    m_writeQueue->jobCount++;
+    m_writeQueue->writing.insert(gamePath);
+
+    std::shared_ptr<WriteQueue> writeQueue = m_writeQueue;
+    CJobManager::GetInstance().Submit([writeQueue, gamePath]() { Process(writeQueue, gamePath); },
+                                      CJob::PRIORITY_NORMAL);
+  }
+  else
+  {
+    m_writeQueue->queue.push_back(gamePath);
+  }
+}
+
+bool CSavestateWriter::Flush(std::chrono::milliseconds timeout)
+{
+  return m_writeQueue->idleEvent.Wait(timeout);
+}
+
+void CSavestateWriter::Process(const std::shared_ptr<WriteQueue>& writeQueue, std::string gamePath)
+{
+  while (true)
+  {
+    WriteRequest request;
+    {
+      CSingleLock lock(writeQueue->mutex);
+
+      // The request is gone if the writer discarded it
+      auto it = writeQueue->requests.find(gamePath);
+      if (it != writeQueue->requests.end())
+      {
+        request = std::move(it->second);
+        writeQueue->requests.erase(it);
+      }
+    }
+
+    bool bSuccess = false;
+    if (request.savestate)
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      request.savestate->SetCompressedMemory(request.memory.data(), request.memory.size());
+      request.savestate->Finalize();
+
+      bSuccess = writeQueue->writeFunction(gamePath, *request.savestate);
+      if (bSuccess)
+      {
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Wrote savestate for {} in {} ms",
+                  CURL::GetRedacted(gamePath), duration.count());
+      }
+      else
+      {
+        CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to write savestate for {}",
+                  CURL::GetRedacted(gamePath));
+      }
+    }
+
+    CSingleLock lock(writeQueue->mutex);
+
+    if (request.savestate)
+    {
+      if (request.onWritten && !writeQueue->discarded)
+        request.onWritten(gamePath, bSuccess);
+      writeQueue->ReleaseBuffer(std::move(request.memory));
+    }
+    writeQueue->writing.erase(gamePath);
+
+    // Continue with the next waiting game that isn't being written by another job
+    auto next = std::find_if(writeQueue->queue.begin(), writeQueue->queue.end(),
+                             [&writeQueue](const std::string& path) {
+                               return writeQueue->writing.find(path) ==
+                                      writeQueue->writing.end();
+                             });
+    if (next == writeQueue->queue.end())
+    {
+      if (--writeQueue->jobCount == 0)
+        writeQueue->idleEvent.Set();
+      break;
+    }
+
+    gamePath = *next;
+    writeQueue->queue.erase(next);
+    writeQueue->writing.insert(gamePath);
+  }
+}
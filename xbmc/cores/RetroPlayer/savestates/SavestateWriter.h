@@ -0,0 +1,158 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+class ISavestate;
+
+/*!
+ * \brief Writes savestates in the background
+ *
+ * The caller only snapshots the memory of the game client into a pooled
+ * buffer. Compression and writing are performed by jobs, of which no more
+ * than a fixed number run at once.
+ *
+ * If a savestate is submitted for a game which already has a savestate
+ * waiting to be written, the waiting savestate is replaced, as only the
+ * newest savestate of a game is kept anyway.
+ *
+ * Writing never blocks the caller. Completion is reported by a callback
+ * that is invoked from the job once the savestate has been written.
+ *
+ * The jobs share the queue with the writer, so a job that is still running
+ * when the writer is destroyed doesn't access freed memory.
+ */
+class CSavestateWriter
+{
+public:
+  /*!
+   * \brief Write a savestate of a game, returning true on success
+   */
+  using WriteFunction = std::function<bool(const std::string& gamePath, const ISavestate& save)>;
+
+  /*!
+   * \brief Called from the job after writing a savestate of a game
+   *
+   * The callback is invoked with the writer's lock held, so it must not call
+   * back into the writer.
+   */
+  using CompletionFunction = std::function<void(const std::string& gamePath, bool success)>;
+
+  /*!
+   * \brief Create a writer that adds savestates to the savestate database
+   */
+  CSavestateWriter();
+
+  /*!
+   * \brief Create a writer that writes savestates with the given function
+   */
+  explicit CSavestateWriter(WriteFunction writeFunction);
+
+  /*!
+   * \brief Destroy the writer
+   *
+   * Waits a limited time for the submitted savestates to be written. Those
+   * that haven't been started by then are discarded, and no completion
+   * callbacks are invoked afterwards.
+   */
+  ~CSavestateWriter();
+
+  /*!
+   * \brief Get a buffer for a snapshot of the memory of the game client
+   *
+   * \param size The size of the memory
+   *
+   * \return A buffer of the given size
+   */
+  std::vector<uint8_t> AcquireBuffer(size_t size);
+
+  /*!
+   * \brief Compress and write a savestate in the background
+   *
+   * \param gamePath The path of the game the savestate belongs to
+   * \param savestate The savestate, with all properties but the memory set
+   * \param memory The memory of the game client, from AcquireBuffer()
+   * \param onWritten Called once the savestate has been written, or writing
+   *        it failed. Not called if the savestate is replaced before it's
+   *        written.
+   */
+  void Write(const std::string& gamePath,
+             std::unique_ptr<ISavestate> savestate,
+             std::vector<uint8_t> memory,
+             CompletionFunction onWritten = nullptr);
+
+  /*!
+   * \brief Wait until all submitted savestates have been written
+   *
+   * \param timeout The maximum time to wait
+   *
+   * \return True if no savestates are left to write, false on timeout
+   */
+  bool Flush(std::chrono::milliseconds timeout);
+
+private:
+  struct WriteRequest
+  {
+    std::unique_ptr<ISavestate> savestate;
+    std::vector<uint8_t> memory;
+    CompletionFunction onWritten;
+  };
+
+  struct WriteQueue
+  {
+    explicit WriteQueue(WriteFunction writeFunction) : writeFunction(std::move(writeFunction)) {}
+
+    void ReleaseBuffer(std::vector<uint8_t> buffer);
+
+    const WriteFunction writeFunction;
+
+    // Requests waiting to be written, by game path
+    std::map<std::string, WriteRequest> requests;
+
+    // Game paths of the requests waiting for a job, in order of submission
+    std::deque<std::string> queue;
+
+    // Game paths of the savestates being written
+    std::set<std::string> writing;
+
+    // Number of running jobs
+    unsigned int jobCount = 0;
+
+    // Snapshot buffers for reuse
+    std::vector<std::vector<uint8_t>> bufferPool;
+
+    // Set when the writer is destroyed before the jobs finished
+    bool discarded = false;
+
+    CCriticalSection mutex;
+    CEvent idleEvent{true, true};
+  };
+
+  static void Process(const std::shared_ptr<WriteQueue>& writeQueue, std::string gamePath);
+
+  const std::shared_ptr<WriteQueue> m_writeQueue;
+};
+} // namespace RETRO
+} // namespace KODI
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "cores/RetroPlayer/savestates/SavestateFlatBuffer.h"
+#include "savestate_generated.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// Three compression blocks, the last one partial
+constexpr size_t MEMORY_SIZE = 600 * 1024;
+
+std::vector<uint8_t> CreateMemory()
+{
+  std::vector<uint8_t> memory(MEMORY_SIZE);
+
+  // The first block compresses well, the others are noise
+  for (size_t i = 0; i < 256 * 1024; i++)
+    memory[i] = static_cast<uint8_t>(i / 1024);
+
+  uint32_t state = 12345;
+  for (size_t i = 256 * 1024; i < memory.size(); i++)
+  {
+    state = state * 1103515245 + 12345;
+    memory[i] = static_cast<uint8_t>(state >> 24);
+  }
+
+  return memory;
+}
+
+std::vector<uint8_t> Serialize(const ISavestate& savestate)
+{
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  EXPECT_TRUE(savestate.Serialize(data, size));
+  return std::vector<uint8_t>(data, data + size);
+}
+
+void SetProperties(ISavestate& savestate)
+{
+  savestate.SetType(SAVE_TYPE::AUTO);
+  savestate.SetLabel("label");
+  savestate.SetGameFileName("game.sfc");
+  savestate.SetTimestampFrames(1234);
+  savestate.SetTimestampWallClock(20.5);
+  savestate.SetGameClientID("game.libretro.test");
+  savestate.SetGameClientVersion("1.2.3");
+}
+} // namespace
+
+TEST(TestSavestateFlatBuffer, RoundTripCompressed)
+{
+  const std::vector<uint8_t> memory = CreateMemory();
+
+  CSavestateFlatBuffer savestate;
+  SetProperties(savestate);
+  savestate.SetCompressedMemory(memory.data(), memory.size());
+  savestate.Finalize();
+
+  const std::vector<uint8_t> data = Serialize(savestate);
+  EXPECT_LT(data.size(), memory.size());
+
+  CSavestateFlatBuffer loaded;
+  ASSERT_TRUE(loaded.Deserialize(data));
+
+  EXPECT_EQ(SAVE_TYPE::AUTO, loaded.Type());
+  EXPECT_EQ("label", loaded.Label());
+  EXPECT_EQ("game.sfc", loaded.GameFileName());
+  EXPECT_EQ(1234u, loaded.TimestampFrames());
+  EXPECT_DOUBLE_EQ(20.5, loaded.TimestampWallClock());
+  EXPECT_EQ("game.libretro.test", loaded.GameClientID());
+  EXPECT_EQ("1.2.3", loaded.GameClientVersion());
+
+  // Compressed memory can only be copied out
+  EXPECT_EQ(nullptr, loaded.GetMemoryData());
+  ASSERT_EQ(memory.size(), loaded.GetMemorySize());
+
+  std::vector<uint8_t> loadedMemory(loaded.GetMemorySize());
+  ASSERT_TRUE(loaded.GetMemory(loadedMemory.data(), loadedMemory.size()));
+  EXPECT_EQ(memory, loadedMemory);
+}
+
+TEST(TestSavestateFlatBuffer, RoundTripUncompressed)
+{
+  const std::vector<uint8_t> memory = CreateMemory();
+
+  CSavestateFlatBuffer savestate;
+  SetProperties(savestate);
+  std::copy(memory.begin(), memory.end(), savestate.GetMemoryBuffer(memory.size()));
+  savestate.Finalize();
+
+  CSavestateFlatBuffer loaded;
+  ASSERT_TRUE(loaded.Deserialize(Serialize(savestate)));
+
+  ASSERT_NE(nullptr, loaded.GetMemoryData());
+  ASSERT_EQ(memory.size(), loaded.GetMemorySize());
+  EXPECT_EQ(memory, std::vector<uint8_t>(loaded.GetMemoryData(),
+                                         loaded.GetMemoryData() + loaded.GetMemorySize()));
+
+  std::vector<uint8_t> loadedMemory(loaded.GetMemorySize());
+  ASSERT_TRUE(loaded.GetMemory(loadedMemory.data(), loadedMemory.size()));
+  EXPECT_EQ(memory, loadedMemory);
+}
+
+TEST(TestSavestateFlatBuffer, LoadsVersion1)
+{
+  const std::vector<uint8_t> memory = CreateMemory();
+
+  // Version 1 savestates have no compression fields
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto label = builder.CreateString("label");
+  auto memoryData = builder.CreateVector(memory.data(), memory.size());
+
+  SavestateBuilder savestateBuilder(builder);
+  savestateBuilder.add_version(1);
+  savestateBuilder.add_label(label);
+  savestateBuilder.add_memory_data(memoryData);
+  FinishSavestateBuffer(builder, savestateBuilder.Finish());
+
+  CSavestateFlatBuffer loaded;
+  ASSERT_TRUE(loaded.Deserialize(std::vector<uint8_t>(
+      builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize())));
+
+  EXPECT_EQ("label", loaded.Label());
+  ASSERT_EQ(memory.size(), loaded.GetMemorySize());
+
+  std::vector<uint8_t> loadedMemory(loaded.GetMemorySize());
+  ASSERT_TRUE(loaded.GetMemory(loadedMemory.data(), loadedMemory.size()));
+  EXPECT_EQ(memory, loadedMemory);
+}
+
+TEST(TestSavestateFlatBuffer, RejectsWrongMemorySize)
+{
+  const std::vector<uint8_t> memory = CreateMemory();
+
+  CSavestateFlatBuffer savestate;
+  savestate.SetCompressedMemory(memory.data(), memory.size());
+  savestate.Finalize();
+
+  std::vector<uint8_t> loadedMemory(memory.size() - 1);
+  EXPECT_FALSE(savestate.GetMemory(loadedMemory.data(), loadedMemory.size()));
+}
+
+TEST(TestSavestateFlatBuffer, RejectsTruncatedMemory)
+{
+  const std::vector<uint8_t> memory = CreateMemory();
+
+  CSavestateFlatBuffer savestate;
+  SetProperties(savestate);
+  savestate.SetCompressedMemory(memory.data(), memory.size());
+  savestate.Finalize();
+
+  std::vector<uint8_t> data = Serialize(savestate);
+  data.resize(data.size() / 2);
+
+  CSavestateFlatBuffer loaded;
+  EXPECT_FALSE(loaded.Deserialize(std::move(data)));
+}
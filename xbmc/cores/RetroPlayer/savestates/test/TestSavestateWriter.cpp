@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/savestates/SavestateFlatBuffer.h"
+#include "cores/RetroPlayer/savestates/SavestateWriter.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr auto TIMEOUT = std::chrono::seconds(10);
+
+const std::string GAME_1 = "special://temp/game1.sfc";
+const std::string GAME_2 = "special://temp/game2.sfc";
+
+/*!
+ * \brief Records the written savestates, optionally blocking the writes
+ */
+class CTestTarget
+{
+public:
+  CSavestateWriter::WriteFunction GetWriteFunction()
+  {
+    return [this](const std::string& gamePath, const ISavestate& save) {
+      m_startedEvent.Set();
+      m_releaseEvent.Wait();
+
+      std::vector<uint8_t> memory(save.GetMemorySize());
+      if (!memory.empty() && !save.GetMemory(memory.data(), memory.size()))
+        return false;
+
+      CSingleLock lock(m_mutex);
+      m_written.push_back({gamePath, save.Label(), std::move(memory)});
+      return m_success;
+    };
+  }
+
+  struct Savestate
+  {
+    std::string gamePath;
+    std::string label;
+    std::vector<uint8_t> memory;
+  };
+
+  void Block() { m_releaseEvent.Reset(); }
+  void Release() { m_releaseEvent.Set(); }
+  bool WaitStarted() { return m_startedEvent.Wait(TIMEOUT); }
+  void SetSuccess(bool success) { m_success = success; }
+
+  std::vector<Savestate> Written()
+  {
+    CSingleLock lock(m_mutex);
+    return m_written;
+  }
+
+private:
+  CCriticalSection m_mutex;
+  CEvent m_startedEvent;
+  CEvent m_releaseEvent{true, true};
+  std::vector<Savestate> m_written;
+  bool m_success = true;
+};
+
+/*!
+ * \brief Records the completion of the savestates written by a writer
+ */
+class CTestCompletion
+{
+public:
+  CSavestateWriter::CompletionFunction GetCompletionFunction()
+  {
+    return [this](const std::string& gamePath, bool success) {
+      CSingleLock lock(m_mutex);
+      m_results.push_back({gamePath, success});
+      m_completedEvent.Set();
+    };
+  }
+
+  /*!
+   * \brief Wait until the given number of savestates has completed
+   *
+   * \return The results of the completed savestates, in order of completion
+   */
+  std::vector<std::pair<std::string, bool>> Wait(size_t count)
+  {
+    XbmcThreads::EndTime endTime(static_cast<unsigned int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(TIMEOUT).count()));
+
+    CSingleLock lock(m_mutex);
+    while (m_results.size() < count && !endTime.IsTimePast())
+    {
+      lock.Leave();
+      m_completedEvent.Wait(std::chrono::milliseconds(endTime.MillisLeft()));
+      lock.Enter();
+    }
+    return m_results;
+  }
+
+  size_t Count()
+  {
+    CSingleLock lock(m_mutex);
+    return m_results.size();
+  }
+
+private:
+  CCriticalSection m_mutex;
+  CEvent m_completedEvent;
+  std::vector<std::pair<std::string, bool>> m_results;
+};
+
+void Write(CSavestateWriter& writer,
+           const std::string& gamePath,
+           const std::string& label,
+           CSavestateWriter::CompletionFunction onWritten = nullptr)
+{
+  std::unique_ptr<ISavestate> savestate(new CSavestateFlatBuffer);
+  savestate->SetLabel(label);
+
+  std::vector<uint8_t> memory = writer.AcquireBuffer(1024);
+  for (size_t i = 0; i < memory.size(); i++)
+    memory[i] = static_cast<uint8_t>(i);
+
+  writer.Write(gamePath, std::move(savestate), std::move(memory), std::move(onWritten));
+}
+} // namespace
+
+TEST(TestSavestateWriter, WritesSavestate)
+{
+  CTestTarget target;
+  CTestCompletion completion;
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  Write(writer, GAME_1, "1", completion.GetCompletionFunction());
+
+  const auto results = completion.Wait(1);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(GAME_1, results[0].first);
+  EXPECT_TRUE(results[0].second);
+
+  const auto written = target.Written();
+  ASSERT_EQ(1u, written.size());
+  EXPECT_EQ(GAME_1, written[0].gamePath);
+  EXPECT_EQ("1", written[0].label);
+  ASSERT_EQ(1024u, written[0].memory.size());
+  EXPECT_EQ(255, written[0].memory[255]);
+}
+
+TEST(TestSavestateWriter, ReportsFailure)
+{
+  CTestTarget target;
+  CTestCompletion completion;
+  target.SetSuccess(false);
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  Write(writer, GAME_1, "1", completion.GetCompletionFunction());
+  ASSERT_EQ(1u, completion.Wait(1).size());
+
+  target.SetSuccess(true);
+  Write(writer, GAME_1, "2", completion.GetCompletionFunction());
+
+  const auto results = completion.Wait(2);
+  ASSERT_EQ(2u, results.size());
+  EXPECT_FALSE(results[0].second);
+  EXPECT_TRUE(results[1].second);
+}
+
+TEST(TestSavestateWriter, ReturnsWithoutWaiting)
+{
+  CTestTarget target;
+  CTestCompletion completion;
+  target.Block();
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  // Write() returns while the savestate is still being written
+  Write(writer, GAME_1, "1", completion.GetCompletionFunction());
+  ASSERT_TRUE(target.WaitStarted());
+  EXPECT_EQ(0u, completion.Count());
+
+  target.Release();
+  EXPECT_EQ(1u, completion.Wait(1).size());
+}
+
+TEST(TestSavestateWriter, ReplacesWaitingSavestate)
+{
+  CTestTarget target;
+  CTestCompletion completion;
+  target.Block();
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  Write(writer, GAME_1, "1", completion.GetCompletionFunction());
+  ASSERT_TRUE(target.WaitStarted());
+
+  // The first savestate is being written, the second one is replaced
+  Write(writer, GAME_1, "2", completion.GetCompletionFunction());
+  Write(writer, GAME_1, "3", completion.GetCompletionFunction());
+
+  target.Release();
+  ASSERT_TRUE(writer.Flush(TIMEOUT));
+
+  // The replaced savestate doesn't complete
+  EXPECT_EQ(2u, completion.Count());
+
+  const auto written = target.Written();
+  ASSERT_EQ(2u, written.size());
+  EXPECT_EQ("1", written[0].label);
+  EXPECT_EQ("3", written[1].label);
+}
+
+TEST(TestSavestateWriter, TimesOut)
+{
+  CTestTarget target;
+  target.Block();
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  Write(writer, GAME_1, "1");
+  ASSERT_TRUE(target.WaitStarted());
+
+  EXPECT_FALSE(writer.Flush(std::chrono::milliseconds(10)));
+
+  target.Release();
+  EXPECT_TRUE(writer.Flush(TIMEOUT));
+}
+
+TEST(TestSavestateWriter, FlushesAllGames)
+{
+  CTestTarget target;
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  Write(writer, GAME_1, "1");
+  Write(writer, GAME_2, "2");
+  ASSERT_TRUE(writer.Flush(TIMEOUT));
+
+  EXPECT_EQ(2u, target.Written().size());
+}
+
+TEST(TestSavestateWriter, FlushesWithoutSavestates)
+{
+  CTestTarget target;
+  CSavestateWriter writer(target.GetWriteFunction());
+
+  // Nothing was written
+  EXPECT_TRUE(writer.Flush(std::chrono::milliseconds(10)));
+}
@@ -14,6 +14,7 @@
 #include "cores/AudioEngine/Utils/AEChannelInfo.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/RetroPlayer/audio/AudioTranslator.h"
+#include "cores/RetroPlayer/playback/FrameTelemetry.h"
 #include "cores/RetroPlayer/process/RPProcessInfo.h"
 #include "utils/log.h"
 
@@ -115,6 +116,8 @@ void CRetroPlayerAudio::AddStreamData(const StreamPacket& packet)
     {
       const double delaySecs = m_pAudioStream->GetDelay();
 
+      m_processInfo.GetFrameTelemetry().SetAudioDelay(delaySecs * 1000.0);
+
       const size_t frameSize = m_pAudioStream->GetChannelCount() *
                                (CAEUtil::DataFormatToBits(m_pAudioStream->GetDataFormat()) >> 3);
 
@@ -29,6 +29,9 @@ public:
   size_t FrameSize() const override { return m_frameSize; }
   uint64_t MaxFrameCount() const override { return 1; }
   void SetMaxFrameCount(uint64_t maxFrameCount) override {}
+  size_t MaxMemorySize() const override { return 0; }
+  void SetMaxMemorySize(size_t maxMemorySize) override {}
+  size_t MemorySize() const override { return 0; }
   uint8_t* BeginFrame() override;
   void SubmitFrame() override;
   const uint8_t* CurrentFrame() const override;
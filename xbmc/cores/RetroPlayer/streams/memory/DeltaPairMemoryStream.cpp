@@ -10,37 +10,160 @@
 
 #include "utils/log.h"
 
+#include <cstring>
+
+#include <lzo/lzo1x.h>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace KODI;
 using namespace RETRO;
 
+namespace
+{
+// Runs separated by up to this many unchanged words are merged, which is the
+// size of a run header in words
+constexpr size_t RUN_MERGE_DISTANCE = 2;
+
+// Deltas smaller than this are not worth the compression overhead
+constexpr size_t MIN_COMPRESS_SIZE = 1024;
+
+/*!
+ * \brief Get the index of the first word in [pos, end) which differs between
+ *        the two buffers, or end if the buffers are equal
+ */
+size_t FindDifference(const uint32_t* a, const uint32_t* b, size_t pos, size_t end)
+{
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  // Compare 16 words at a time, savestates are mostly unchanged
+  for (; pos + 16 <= end; pos += 16)
+  {
+    const __m128i* va = reinterpret_cast<const __m128i*>(a + pos);
+    const __m128i* vb = reinterpret_cast<const __m128i*>(b + pos);
+
+    const __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128(va), _mm_loadu_si128(vb));
+    const __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128(va + 1), _mm_loadu_si128(vb + 1));
+    const __m128i eq2 = _mm_cmpeq_epi32(_mm_loadu_si128(va + 2), _mm_loadu_si128(vb + 2));
+    const __m128i eq3 = _mm_cmpeq_epi32(_mm_loadu_si128(va + 3), _mm_loadu_si128(vb + 3));
+
+    const __m128i eq = _mm_and_si128(_mm_and_si128(eq0, eq1), _mm_and_si128(eq2, eq3));
+    if (_mm_movemask_epi8(eq) != 0xFFFF)
+      break;
+  }
+#else
+  // Compare 2 words at a time
+  for (; pos + 2 <= end; pos += 2)
+  {
+    uint64_t va;
+    uint64_t vb;
+    std::memcpy(&va, a + pos, sizeof(va));
+    std::memcpy(&vb, b + pos, sizeof(vb));
+    if (va != vb)
+      break;
+  }
+#endif
+
+  while (pos < end && a[pos] == b[pos])
+    pos++;
+
+  return pos;
+}
+
+/*!
+ * \brief Get the index of the first word in [pos, end) which is equal in both
+ *        buffers, or end if all words differ
+ */
+size_t FindEqual(const uint32_t* a, const uint32_t* b, size_t pos, size_t end)
+{
+  while (pos < end && a[pos] != b[pos])
+    pos++;
+
+  return pos;
+}
+} // namespace
+
+CDeltaPairMemoryStream::CDeltaPairMemoryStream(bool bCompress /* = true */)
+  : m_bCompress(bCompress)
+{
+  if (m_bCompress && lzo_init() != LZO_E_OK)
+  {
+    CLog::Log(LOGERROR, "CDeltaPairMemoryStream: Failed to initialize compression");
+    m_bCompress = false;
+  }
+}
+
 void CDeltaPairMemoryStream::Reset()
 {
   CLinearMemoryStream::Reset();
 
   m_rewindBuffer.clear();
+  m_memorySize = 0;
+
+  m_runs.clear();
+  m_runs.shrink_to_fit();
+  m_deltas.clear();
+  m_deltas.shrink_to_fit();
+  m_compressed.clear();
+  m_compressed.shrink_to_fit();
+  m_compressionWorkMemory.clear();
+  m_compressionWorkMemory.shrink_to_fit();
+}
+
+void CDeltaPairMemoryStream::SetMaxMemorySize(size_t maxMemorySize)
+{
+  m_maxMemorySize = maxMemorySize;
+
+  CullToMemorySize();
 }
 
 void CDeltaPairMemoryStream::SubmitFrameInternal()
 {
-  m_rewindBuffer.emplace_back();
-  MemoryFrame& frame = m_rewindBuffer.back();
+  const uint32_t* currentFrame = m_currentFrame.get();
+  const uint32_t* nextFrame = m_nextFrame.get();
 
-  // Record frame history
-  frame.frameHistoryCount = m_currentFrameHistory++;
+  const size_t wordCount = m_paddedFrameSize / sizeof(uint32_t);
 
-  uint32_t* currentFrame = m_currentFrame.get();
-  uint32_t* nextFrame = m_nextFrame.get();
+  m_runs.clear();
+  m_deltas.clear();
 
-  for (size_t i = 0; i < m_paddedFrameSize; i++)
+  size_t pos = FindDifference(currentFrame, nextFrame, 0, wordCount);
+  while (pos < wordCount)
   {
-    uint32_t xor_val = currentFrame[i] ^ nextFrame[i];
-    if (xor_val)
+    // Extend the run over short stretches of unchanged words
+    size_t end = FindEqual(currentFrame, nextFrame, pos, wordCount);
+    size_t nextPos = FindDifference(currentFrame, nextFrame, end, wordCount);
+    while (nextPos < wordCount && nextPos - end <= RUN_MERGE_DISTANCE)
     {
-      DeltaPair pair = {i, xor_val};
-      frame.buffer.push_back(pair);
+      end = FindEqual(currentFrame, nextFrame, nextPos, wordCount);
+      nextPos = FindDifference(currentFrame, nextFrame, end, wordCount);
     }
+
+    m_runs.push_back({static_cast<uint32_t>(pos), static_cast<uint32_t>(end - pos)});
+
+    // Contiguous XOR, vectorized by the compiler
+    const size_t offset = m_deltas.size();
+    m_deltas.resize(offset + (end - pos));
+    uint32_t* deltas = m_deltas.data() + offset;
+    for (size_t i = 0; i < end - pos; i++)
+      deltas[i] = currentFrame[pos + i] ^ nextFrame[pos + i];
+
+    pos = nextPos;
   }
 
+  m_rewindBuffer.emplace_back();
+  MemoryFrame& frame = m_rewindBuffer.back();
+
+  // Record frame history
+  frame.frameHistoryCount = m_currentFrameHistory++;
+
+  // Copy the deltas to exactly sized buffers
+  frame.runs.assign(m_runs.begin(), m_runs.end());
+  CompressDeltas(frame);
+
+  m_memorySize += GetMemorySize(frame);
+
   // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
   std::swap(m_currentFrame, m_nextFrame);
 
@@ -48,6 +171,59 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
 
   if (PastFramesAvailable() + 1 > MaxFrameCount())
     CullPastFrames(1);
+
+  CullToMemorySize();
+}
+
+void CDeltaPairMemoryStream::CompressDeltas(MemoryFrame& frame)
+{
+  const uint8_t* deltas = reinterpret_cast<const uint8_t*>(m_deltas.data());
+  const size_t deltaSize = m_deltas.size() * sizeof(uint32_t);
+
+  frame.bCompressed = false;
+
+  if (m_bCompress && deltaSize >= MIN_COMPRESS_SIZE)
+  {
+    if (m_compressionWorkMemory.empty())
+      m_compressionWorkMemory.resize(LZO1X_1_MEM_COMPRESS);
+
+    // Worst case expansion of incompressible data, see lzo1x.h
+    m_compressed.resize(deltaSize + deltaSize / 16 + 64 + 3);
+
+    lzo_uint compressedSize = static_cast<lzo_uint>(m_compressed.size());
+    if (lzo1x_1_compress(deltas, static_cast<lzo_uint>(deltaSize), m_compressed.data(),
+                         &compressedSize, m_compressionWorkMemory.data()) == LZO_E_OK &&
+        compressedSize < deltaSize)
+    {
+      frame.deltas.assign(m_compressed.begin(), m_compressed.begin() + compressedSize);
+      frame.bCompressed = true;
+    }
+  }
+
+  if (!frame.bCompressed)
+    frame.deltas.assign(deltas, deltas + deltaSize);
+}
+
+const uint32_t* CDeltaPairMemoryStream::DecompressDeltas(const MemoryFrame& frame,
+                                                         size_t deltaCount)
+{
+  if (!frame.bCompressed)
+    return reinterpret_cast<const uint32_t*>(frame.deltas.data());
+
+  m_deltas.resize(deltaCount);
+
+  lzo_uint deltaSize = static_cast<lzo_uint>(deltaCount * sizeof(uint32_t));
+  if (lzo1x_decompress_safe(frame.deltas.data(), static_cast<lzo_uint>(frame.deltas.size()),
+                            reinterpret_cast<uint8_t*>(m_deltas.data()), &deltaSize,
+                            nullptr) != LZO_E_OK ||
+      deltaSize != deltaCount * sizeof(uint32_t))
+  {
+    CLog::Log(LOGERROR, "CDeltaPairMemoryStream: Failed to decompress frame {}",
+              frame.frameHistoryCount);
+    return nullptr;
+  }
+
+  return m_deltas.data();
 }
 
 uint64_t CDeltaPairMemoryStream::PastFramesAvailable() const
@@ -65,18 +241,33 @@ uint64_t CDeltaPairMemoryStream::RewindFrames(uint64_t frameCount)
       break;
 
     const MemoryFrame& frame = m_rewindBuffer.back();
-    const DeltaPair* buffer = frame.buffer.data();
 
-    size_t bufferSize = frame.buffer.size();
+    if (!frame.runs.empty())
+    {
+      size_t deltaCount = 0;
+      for (const DeltaRun& run : frame.runs)
+        deltaCount += run.length;
 
-    // buffer pointer redirection violates data-dependency requirements...
-    // no vectorization for us :(
-    for (size_t i = 0; i < bufferSize; i++)
-      m_currentFrame[buffer[i].pos] ^= buffer[i].delta;
+      const uint32_t* deltas = DecompressDeltas(frame, deltaCount);
+      if (deltas == nullptr)
+        break;
+
+      uint32_t* currentFrame = m_currentFrame.get();
+      for (const DeltaRun& run : frame.runs)
+      {
+        // Contiguous XOR, vectorized by the compiler
+        uint32_t* words = currentFrame + run.pos;
+        for (size_t i = 0; i < run.length; i++)
+          words[i] ^= deltas[i];
+
+        deltas += run.length;
+      }
+    }
 
     // Restore frame history
     m_currentFrameHistory = frame.frameHistoryCount;
 
+    m_memorySize -= GetMemorySize(frame);
     m_rewindBuffer.pop_back();
   }
 
@@ -94,6 +285,32 @@ void CDeltaPairMemoryStream::CullPastFrames(uint64_t frameCount)
                 frameCount - removedCount);
       break;
     }
+    m_memorySize -= GetMemorySize(m_rewindBuffer.front());
     m_rewindBuffer.pop_front();
   }
 }
+
+void CDeltaPairMemoryStream::CullToMemorySize()
+{
+  if (m_maxMemorySize == 0)
+    return;
+
+  uint64_t frameCount = 0;
+  size_t memorySize = m_memorySize;
+  for (const MemoryFrame& frame : m_rewindBuffer)
+  {
+    if (memorySize <= m_maxMemorySize)
+      break;
+
+    memorySize -= GetMemorySize(frame);
+    frameCount++;
+  }
+
+  if (frameCount > 0)
+    CullPastFrames(frameCount);
+}
+
+size_t CDeltaPairMemoryStream::GetMemorySize(const MemoryFrame& frame)
+{
+  return sizeof(MemoryFrame) + frame.runs.capacity() * sizeof(DeltaRun) + frame.deltas.capacity();
+}
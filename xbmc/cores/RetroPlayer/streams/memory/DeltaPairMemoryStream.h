@@ -23,12 +23,20 @@ namespace RETRO
 class CDeltaPairMemoryStream : public CLinearMemoryStream
 {
 public:
-  CDeltaPairMemoryStream() = default;
+  /*!
+   * \brief Create a memory stream
+   *
+   * \param bCompress True to compress large deltas, false to store them as-is
+   */
+  explicit CDeltaPairMemoryStream(bool bCompress = true);
 
   ~CDeltaPairMemoryStream() override = default;
 
   // implementation of IMemoryStream via CLinearMemoryStream
   void Reset() override;
+  size_t MaxMemorySize() const override { return m_maxMemorySize; }
+  void SetMaxMemorySize(size_t maxMemorySize) override;
+  size_t MemorySize() const override { return m_memorySize; }
   uint64_t PastFramesAvailable() const override;
   uint64_t RewindFrames(uint64_t frameCount) override;
 
@@ -44,24 +52,50 @@ protected:
    * of original save state size depending on the system. The algorithm runs
    * on 32 bits at a time for speed.
    *
+   * Changed words are grouped into runs of consecutive words, so that both
+   * encoding and decoding operate on contiguous memory and can be vectorized.
+   * Runs separated by only a few unchanged words are merged, as storing the
+   * zero deltas is cheaper than storing another run.
+   *
    * Use std::deque here to achieve amortized O(1) on pop/push to front and
    * back.
    */
-  struct DeltaPair
+  struct DeltaRun
   {
-    size_t pos;
-    uint32_t delta;
+    uint32_t pos; // Offset of the first changed word
+    uint32_t length; // Number of words covered by the run
   };
 
-  using DeltaPairVector = std::vector<DeltaPair>;
+  using DeltaRunVector = std::vector<DeltaRun>;
 
   struct MemoryFrame
   {
-    DeltaPairVector buffer;
+    DeltaRunVector runs;
+    std::vector<uint8_t> deltas; // XOR values of all runs, compressed if bCompressed is set
+    bool bCompressed;
     uint64_t frameHistoryCount;
   };
 
+  static size_t GetMemorySize(const MemoryFrame& frame);
+
+  void CompressDeltas(MemoryFrame& frame);
+  const uint32_t* DecompressDeltas(const MemoryFrame& frame, size_t deltaCount);
+  void CullToMemorySize();
+
   std::deque<MemoryFrame> m_rewindBuffer;
+
+  // Memory budget
+  size_t m_maxMemorySize = 0;
+  size_t m_memorySize = 0;
+
+  // Compression parameters
+  bool m_bCompress;
+
+  // Scratch buffers, reused across frames to avoid allocations while playing
+  DeltaRunVector m_runs;
+  std::vector<uint32_t> m_deltas;
+  std::vector<uint8_t> m_compressed;
+  std::vector<uint8_t> m_compressionWorkMemory;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -75,6 +75,25 @@ public:
    */
   virtual void SetMaxFrameCount(uint64_t maxFrameCount) = 0;
 
+  /*!
+   * \brief Return the current memory budget for past frames, or 0 if unlimited
+   */
+  virtual size_t MaxMemorySize() const = 0;
+
+  /*!
+   * \brief Update the memory budget for past frames
+   *
+   * Old frames may be deleted if the memory budget is reduced.
+   *
+   * \param maxMemorySize The memory budget in bytes, or 0 for no limit
+   */
+  virtual void SetMaxMemorySize(size_t maxMemorySize) = 0;
+
+  /*!
+   * \brief Return the number of bytes used to store past frames
+   */
+  virtual size_t MemorySize() const = 0;
+
   /*!
    * \ brief Get a pointer to which FrameSize() bytes can be written
    *
@@ -0,0 +1,285 @@
+/*
+ *  Copyright (C) 2016-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+using Savestate = std::vector<uint8_t>;
+
+constexpr size_t FRAME_SIZE = 256 * 1024 + 3; // Not a multiple of the word size
+
+/*!
+ * \brief Generate a sequence of savestates resembling those of a game console
+ *
+ * Each frame changes a few blocks of work RAM and some scattered counters.
+ */
+std::vector<Savestate> GenerateSavestates(size_t frameSize, unsigned int frameCount)
+{
+  std::mt19937 random(1234);
+  std::uniform_int_distribution<size_t> position(0, frameSize - 1);
+  std::uniform_int_distribution<size_t> length(16, 512);
+  std::uniform_int_distribution<unsigned int> value(0, 255);
+
+  std::vector<Savestate> savestates;
+  Savestate savestate(frameSize);
+  for (uint8_t& byte : savestate)
+    byte = static_cast<uint8_t>(value(random));
+
+  for (unsigned int frame = 0; frame < frameCount; frame++)
+  {
+    for (unsigned int block = 0; block < 8; block++)
+    {
+      const size_t start = position(random);
+      const size_t end = std::min(start + length(random), frameSize);
+      for (size_t i = start; i < end; i++)
+        savestate[i] = static_cast<uint8_t>(savestate[i] + 1);
+    }
+
+    for (unsigned int counter = 0; counter < 32; counter++)
+      savestate[position(random)] = static_cast<uint8_t>(value(random));
+
+    savestates.push_back(savestate);
+  }
+
+  return savestates;
+}
+
+/*!
+ * \brief Load a recorded sequence of savestates, one file per frame in file
+ *        name order, all of the same size
+ */
+std::vector<Savestate> LoadSavestates(const std::string& path)
+{
+  std::vector<Savestate> savestates;
+
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(path, items, "", XFILE::DIR_FLAG_DEFAULTS))
+    return savestates;
+
+  items.Sort(SortByFile, SortOrderAscending);
+
+  for (const auto& item : items)
+  {
+    if (item->m_bIsFolder)
+      continue;
+
+    XFILE::CFile file;
+    XFILE::auto_buffer buffer;
+    if (file.LoadFile(item->GetPath(), buffer) <= 0)
+      continue;
+
+    if (!savestates.empty() && buffer.size() != savestates.front().size())
+      continue;
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.get());
+    savestates.emplace_back(data, data + buffer.size());
+  }
+
+  return savestates;
+}
+
+void SubmitFrame(IMemoryStream& stream, const Savestate& savestate)
+{
+  uint8_t* frame = stream.BeginFrame();
+  ASSERT_NE(frame, nullptr);
+  std::memcpy(frame, savestate.data(), savestate.size());
+  stream.SubmitFrame();
+}
+
+class TestDeltaPairMemoryStream : public ::testing::TestWithParam<bool>
+{
+};
+} // namespace
+
+TEST_P(TestDeltaPairMemoryStream, RewindRestoresFrames)
+{
+  const std::vector<Savestate> savestates = GenerateSavestates(FRAME_SIZE, 20);
+
+  CDeltaPairMemoryStream stream(GetParam());
+  stream.Init(FRAME_SIZE, 100);
+
+  for (const Savestate& savestate : savestates)
+    SubmitFrame(stream, savestate);
+
+  EXPECT_EQ(stream.PastFramesAvailable(), savestates.size() - 1);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestates.back().data(), FRAME_SIZE), 0);
+
+  EXPECT_EQ(stream.RewindFrames(1), 1u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestates[18].data(), FRAME_SIZE), 0);
+
+  EXPECT_EQ(stream.RewindFrames(10), 10u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestates[8].data(), FRAME_SIZE), 0);
+  EXPECT_EQ(stream.GetFrameCounter(), 8u);
+
+  // Play on from the rewound state
+  SubmitFrame(stream, savestates[19]);
+  EXPECT_EQ(stream.RewindFrames(1), 1u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestates[8].data(), FRAME_SIZE), 0);
+
+  EXPECT_EQ(stream.RewindFrames(100), 8u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestates[0].data(), FRAME_SIZE), 0);
+  EXPECT_EQ(stream.MemorySize(), 0u);
+}
+
+TEST_P(TestDeltaPairMemoryStream, UnchangedFrame)
+{
+  const Savestate savestate(FRAME_SIZE, 0x5A);
+
+  CDeltaPairMemoryStream stream(GetParam());
+  stream.Init(FRAME_SIZE, 100);
+
+  SubmitFrame(stream, savestate);
+  SubmitFrame(stream, savestate);
+
+  EXPECT_EQ(stream.PastFramesAvailable(), 1u);
+  EXPECT_LT(stream.MemorySize(), 100u);
+
+  EXPECT_EQ(stream.RewindFrames(1), 1u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestate.data(), FRAME_SIZE), 0);
+}
+
+TEST_P(TestDeltaPairMemoryStream, MaxFrameCount)
+{
+  const std::vector<Savestate> savestates = GenerateSavestates(FRAME_SIZE, 20);
+
+  CDeltaPairMemoryStream stream(GetParam());
+  stream.Init(FRAME_SIZE, 10);
+
+  for (const Savestate& savestate : savestates)
+    SubmitFrame(stream, savestate);
+
+  EXPECT_EQ(stream.PastFramesAvailable(), 9u);
+
+  EXPECT_EQ(stream.RewindFrames(100), 9u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), savestates[10].data(), FRAME_SIZE), 0);
+}
+
+TEST_P(TestDeltaPairMemoryStream, MaxMemorySize)
+{
+  const std::vector<Savestate> savestates = GenerateSavestates(FRAME_SIZE, 20);
+
+  CDeltaPairMemoryStream stream(GetParam());
+  stream.Init(FRAME_SIZE, 100);
+
+  for (const Savestate& savestate : savestates)
+    SubmitFrame(stream, savestate);
+
+  const size_t memorySize = stream.MemorySize();
+  ASSERT_GT(memorySize, 0u);
+
+  // Reducing the budget culls the oldest frames
+  stream.SetMaxMemorySize(memorySize / 2);
+  EXPECT_LE(stream.MemorySize(), memorySize / 2);
+  EXPECT_LT(stream.PastFramesAvailable(), 19u);
+  EXPECT_GT(stream.PastFramesAvailable(), 0u);
+
+  // The budget is respected while playing
+  for (const Savestate& savestate : savestates)
+    SubmitFrame(stream, savestate);
+  EXPECT_LE(stream.MemorySize(), memorySize / 2);
+
+  const uint64_t pastFrames = stream.PastFramesAvailable();
+  EXPECT_EQ(stream.RewindFrames(pastFrames), pastFrames);
+  EXPECT_EQ(
+      std::memcmp(stream.CurrentFrame(), savestates[19 - pastFrames].data(), FRAME_SIZE), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, TestDeltaPairMemoryStream, ::testing::Bool());
+
+TEST(TestDeltaPairMemoryStreamCompression, CompressionReducesMemory)
+{
+  const std::vector<Savestate> savestates = GenerateSavestates(FRAME_SIZE, 20);
+
+  CDeltaPairMemoryStream uncompressed(false);
+  CDeltaPairMemoryStream compressed(true);
+  uncompressed.Init(FRAME_SIZE, 100);
+  compressed.Init(FRAME_SIZE, 100);
+
+  for (const Savestate& savestate : savestates)
+  {
+    SubmitFrame(uncompressed, savestate);
+    SubmitFrame(compressed, savestate);
+  }
+
+  EXPECT_LT(compressed.MemorySize(), uncompressed.MemorySize());
+}
+
+/*!
+ * Benchmark of encoding, memory usage and rewinding. Runs on a recorded
+ * sequence of savestates if the environment variable
+ * KODI_SAVESTATE_SEQUENCE_PATH points to a directory containing one file per
+ * frame, otherwise on a generated sequence.
+ *
+ * Run with --gtest_also_run_disabled_tests. The results are recorded as test
+ * properties, see --gtest_output=xml.
+ */
+TEST(TestDeltaPairMemoryStreamBenchmark, DISABLED_Benchmark)
+{
+  std::vector<Savestate> savestates;
+
+  const char* path = std::getenv("KODI_SAVESTATE_SEQUENCE_PATH");
+  if (path != nullptr)
+    savestates = LoadSavestates(path);
+  else
+    savestates = GenerateSavestates(4 * 1024 * 1024, 300);
+
+  ASSERT_GT(savestates.size(), 1u);
+
+  const size_t frameSize = savestates.front().size();
+
+  RecordProperty("Frames", static_cast<int>(savestates.size()));
+  RecordProperty("FrameSize", static_cast<int>(frameSize));
+
+  for (bool bCompress : {false, true})
+  {
+    CDeltaPairMemoryStream stream(bCompress);
+    stream.Init(frameSize, savestates.size());
+
+    const auto submitStart = std::chrono::steady_clock::now();
+    for (const Savestate& savestate : savestates)
+      SubmitFrame(stream, savestate);
+    const auto submitEnd = std::chrono::steady_clock::now();
+
+    const size_t memorySize = stream.MemorySize();
+
+    const auto rewindStart = std::chrono::steady_clock::now();
+    const uint64_t rewound = stream.RewindFrames(savestates.size());
+    const auto rewindEnd = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(rewound, savestates.size() - 1);
+    ASSERT_EQ(std::memcmp(stream.CurrentFrame(), savestates.front().data(), frameSize), 0);
+
+    const double submitUs =
+        std::chrono::duration<double, std::micro>(submitEnd - submitStart).count() /
+        savestates.size();
+    const double rewindUs =
+        std::chrono::duration<double, std::micro>(rewindEnd - rewindStart).count() / rewound;
+
+    const std::string prefix = bCompress ? "Compressed" : "Uncompressed";
+    RecordProperty(prefix + "SubmitUsPerFrame", static_cast<int>(submitUs));
+    RecordProperty(prefix + "RewindUsPerFrame", static_cast<int>(rewindUs));
+    RecordProperty(prefix + "BytesPerFrame", static_cast<int>(memorySize / rewound));
+  }
+}
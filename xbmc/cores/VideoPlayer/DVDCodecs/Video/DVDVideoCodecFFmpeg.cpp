@@ -20,6 +20,7 @@
 #include "settings/SettingsComponent.h"
 #include "utils/CPUInfo.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
@@ -31,8 +32,6 @@ extern "C" {
 #include <libavutil/opt.h>
 #include <libavutil/mastering_display_metadata.h>
 #include <libavfilter/avfilter.h>
-#include <libavfilter/buffersink.h>
-#include <libavfilter/buffersrc.h>
 #include <libavutil/pixdesc.h>
 }
 
@@ -61,6 +60,24 @@ enum EFilterFlags {
   FILTER_ROTATE              = 0x40,  //< rotate image according to the codec hints
 };
 
+namespace
+{
+// Adds the time spent in a scope to a counter
+class CDecodeTimer
+{
+public:
+  explicit CDecodeTimer(int64_t& time) : m_time(time), m_start(CurrentHostCounter()) {}
+  ~CDecodeTimer() { m_time += CurrentHostCounter() - m_start; }
+
+private:
+  CDecodeTimer(const CDecodeTimer&) = delete;
+  CDecodeTimer& operator=(const CDecodeTimer&) = delete;
+
+  int64_t& m_time;
+  const int64_t m_start;
+};
+} // namespace
+
 //------------------------------------------------------------------------------
 // Video Buffers
 //------------------------------------------------------------------------------
@@ -365,19 +382,60 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     if (m_decoderState == STATE_NONE)
     {
       m_decoderState = STATE_HW_SINGLE;
+      m_processInfo.SetVideoDecoderThreading("");
     }
     else
     {
-      int num_threads = CServiceBroker::GetCPUInfo()->GetCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
+      const int cpuCount = CServiceBroker::GetCPUInfo()->GetCPUCount();
+      CVideoCodecThreading::Config threading;
+
+      m_adaptiveThreading =
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoAdaptiveThreading;
+      if (m_adaptiveThreading && m_threadingReopen)
+      {
+        threading = m_threading.GetConfig();
+      }
+      else if (m_adaptiveThreading)
+      {
+        CVideoCodecThreading::Stream stream;
+        stream.width = hints.width;
+        stream.height = hints.height;
+        stream.frameThreads = (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) != 0;
+        stream.sliceThreads = (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) != 0;
+        // broadcast streams of these codecs have many slices per frame, hevc
+        // streams rarely do
+        stream.sliceEfficient = hints.codec == AV_CODEC_ID_MPEG2VIDEO ||
+                                hints.codec == AV_CODEC_ID_MPEG1VIDEO ||
+                                hints.codec == AV_CODEC_ID_H264;
+        stream.realtime = m_processInfo.IsRealtimeStream();
+
+        threading = CVideoCodecThreading::Select(stream, cpuCount);
+        m_threading.Start(stream, threading, cpuCount);
+      }
+      else
+      {
+        threading.threads = std::max(1, std::min(cpuCount * 3 / 2, 16));
+      }
+      m_threadingReopen = false;
+
+      m_pCodecContext->thread_count = threading.threads;
+      if (m_adaptiveThreading)
+      {
+        m_pCodecContext->thread_type = threading.type == CVideoCodecThreading::Type::SLICE
+                                           ? FF_THREAD_SLICE
+                                           : FF_THREAD_FRAME;
+      }
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with {} threads",
-                num_threads);
+      m_processInfo.SetVideoDecoderThreading(CVideoCodecThreading::ToString(threading));
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open threaded: {}",
+                CVideoCodecThreading::ToString(threading));
     }
   }
   else
+  {
     m_decoderState = STATE_SW_SINGLE;
+    m_processInfo.SetVideoDecoderThreading("");
+  }
 
   // if we don't do this, then some codecs seem to fail.
   m_pCodecContext->coded_height = hints.height;
@@ -443,6 +501,7 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
 
   m_dropCtrl.Reset(true);
   m_eof = false;
+  m_decodeTime = 0;
   return true;
 }
 
@@ -524,10 +583,38 @@ void CDVDVideoCodecFFmpeg::UpdateName()
     m_name += "-" + m_pHardware->Name();
 
   m_processInfo.SetVideoDecoderName(m_name, m_pHardware ? true : false);
+  if (m_pHardware)
+    m_processInfo.SetVideoDecoderThreading("");
 
   CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - Updated codec: {}", m_name);
 }
 
+void CDVDVideoCodecFFmpeg::UpdateThreading()
+{
+  const int64_t decodeTime = m_decodeTime;
+  m_decodeTime = 0;
+
+  if (!m_adaptiveThreading || m_threadingReopen || m_pHardware ||
+      m_decoderState != STATE_SW_MULTI)
+    return;
+
+  // timestamps of decoded frames are in AV_TIME_BASE units
+  double frameInterval = 0.0;
+  if (m_dropCtrl.m_state == CDropControl::VALID)
+    frameInterval = static_cast<double>(m_dropCtrl.m_diffPTS) * DVD_TIME_BASE / AV_TIME_BASE;
+  else if (m_hints.fpsrate > 0 && m_hints.fpsscale > 0)
+    frameInterval = static_cast<double>(DVD_TIME_BASE) * m_hints.fpsscale / m_hints.fpsrate;
+
+  const double time = static_cast<double>(decodeTime) * DVD_TIME_BASE / CurrentHostFrequency();
+  if (m_threading.Update(time, frameInterval))
+  {
+    m_threadingReopen = true;
+    CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::{} - changing threading to {}{}", __FUNCTION__,
+              CVideoCodecThreading::ToString(m_threading.GetConfig()),
+              m_threading.IsUrgent() ? "" : " on next flush");
+  }
+}
+
 union pts_union
 {
   double  pts_d;
@@ -549,6 +636,8 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
   if (!packet.pData)
     return true;
 
+  CDecodeTimer timer(m_decodeTime);
+
   if (m_eof)
   {
     Reset();
@@ -627,6 +716,16 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     return VC_EOF;
   }
 
+  // the decoder falls behind, reopen with more threads. decoding resumes
+  // from the packets since the last keyframe
+  if (m_threadingReopen && m_threading.IsUrgent())
+  {
+    m_started = false;
+    return VC_REOPEN;
+  }
+
+  CDecodeTimer timer(m_decodeTime);
+
   // handle hw accelerators first, they may have frames ready
   if (m_pHardware)
   {
@@ -646,7 +745,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     else
       return ret;
   }
-  else if (m_pFilterGraph && !m_filterEof)
+  else if (m_filter.IsOpen() && !m_filterEof)
   {
     CDVDVideoCodec::VCReturn ret = FilterProcess(nullptr);
     if (ret == VC_PICTURE)
@@ -711,7 +810,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
         return VC_EOF;
       }
     }
-    else if (m_pFilterGraph && !m_filterEof)
+    else if (m_filter.IsOpen() && !m_filterEof)
     {
       int ret = FilterProcess(nullptr);
       if (ret == VC_PICTURE)
@@ -833,16 +932,16 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     if (!m_filters_next.empty() && m_filterEof)
       need_reopen = true;
 
-    if (m_pFilterIn)
+    if (m_filter.IsOpen())
     {
-      if (m_pFilterIn->outputs[0]->format != m_pCodecContext->pix_fmt ||
-          m_pFilterIn->outputs[0]->w != m_pCodecContext->width ||
-          m_pFilterIn->outputs[0]->h != m_pCodecContext->height)
+      const CVideoFilterPipeline::Format& input = m_filter.GetInputFormat();
+      if (input.pixFmt != m_pCodecContext->pix_fmt || input.width != m_pCodecContext->width ||
+          input.height != m_pCodecContext->height)
         need_reopen = true;
     }
 
     // try to setup new filters
-    if (need_reopen || (need_scale && m_pFilterGraph == nullptr))
+    if (need_reopen || (need_scale && !m_filter.IsOpen()))
     {
       m_filters = m_filters_next;
 
@@ -850,7 +949,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
         FilterClose();
     }
 
-    if (m_pFilterGraph && !m_filterEof)
+    if (m_filter.IsOpen() && !m_filterEof)
     {
       CDVDVideoCodec::VCReturn ret = FilterProcess(m_pDecodedFrame);
       if (ret != VC_PICTURE)
@@ -876,6 +975,8 @@ bool CDVDVideoCodecFFmpeg::SetPictureParams(VideoPicture* pVideoPicture)
   if (!GetPictureCommon(pVideoPicture))
     return false;
 
+  UpdateThreading();
+
   pVideoPicture->iFlags |= m_pFrame->data[0] ? 0 : DVP_FLAG_DROPPED;
 
   if (pVideoPicture->videoBuffer)
@@ -897,6 +998,14 @@ bool CDVDVideoCodecFFmpeg::SetPictureParams(VideoPicture* pVideoPicture)
 
 void CDVDVideoCodecFFmpeg::Reset()
 {
+  // the decoder is flushed anyway, apply a new threading now
+  if (m_threadingReopen)
+  {
+    Reopen();
+    if (!m_pCodecContext)
+      return;
+  }
+
   m_started = false;
   m_startedInput = false;
   m_interlaced = false;
@@ -1120,9 +1229,7 @@ bool CDVDVideoCodecFFmpeg::GetPictureCommon(VideoPicture* pVideoPicture)
 
 int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
 {
-  int result;
-
-  if (m_pFilterGraph)
+  if (m_filter.IsOpen())
     FilterClose();
 
   if (filters.empty() && !scale)
@@ -1134,147 +1241,63 @@ int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
     return 0;
   }
 
-  if (!(m_pFilterGraph = avfilter_graph_alloc()))
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - unable to alloc filter graph");
-    return -1;
-  }
-
-  const AVFilter* srcFilter = avfilter_get_by_name("buffer");
-  const AVFilter* outFilter = avfilter_get_by_name("buffersink"); // should be last filter in the graph for now
+  CVideoFilterPipeline::Format input;
+  input.width = m_pCodecContext->width;
+  input.height = m_pCodecContext->height;
+  input.pixFmt = m_pCodecContext->pix_fmt;
+  if (m_pCodecContext->time_base.num)
+    input.timeBase = m_pCodecContext->time_base;
+  if (m_pCodecContext->sample_aspect_ratio.num != 0)
+    input.sampleAspectRatio = m_pCodecContext->sample_aspect_ratio;
 
-  std::string args = StringUtils::Format(
-      "{}:{}:{}:{}:{}:{}:{}", m_pCodecContext->width, m_pCodecContext->height,
-      m_pCodecContext->pix_fmt, m_pCodecContext->time_base.num ? m_pCodecContext->time_base.num : 1,
-      m_pCodecContext->time_base.num ? m_pCodecContext->time_base.den : 1,
-      m_pCodecContext->sample_aspect_ratio.num != 0 ? m_pCodecContext->sample_aspect_ratio.num : 1,
-      m_pCodecContext->sample_aspect_ratio.num != 0 ? m_pCodecContext->sample_aspect_ratio.den : 1);
-
-  if ((result = avfilter_graph_create_filter(&m_pFilterIn, srcFilter, "src", args.c_str(), NULL, m_pFilterGraph)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_create_filter: src");
-    return result;
-  }
-
-  if ((result = avfilter_graph_create_filter(&m_pFilterOut, outFilter, "out", NULL, NULL, m_pFilterGraph)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_create_filter: out");
-    return result;
-  }
-  if ((result = av_opt_set_int_list(m_pFilterOut, "pix_fmts", &m_formats[0],  AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - failed settings pix formats");
-    return result;
-  }
+  if (!m_filter.Open(filters, input, m_formats))
+    return -1;
 
-  if (!filters.empty())
+  if (filters.compare(0,5,"yadif") == 0)
   {
-    AVFilterInOut* outputs = avfilter_inout_alloc();
-    AVFilterInOut* inputs  = avfilter_inout_alloc();
-
-    outputs->name = av_strdup("in");
-    outputs->filter_ctx = m_pFilterIn;
-    outputs->pad_idx = 0;
-    outputs->next = nullptr;
-
-    inputs->name = av_strdup("out");
-    inputs->filter_ctx = m_pFilterOut;
-    inputs->pad_idx = 0;
-    inputs->next = nullptr;
-
-    result = avfilter_graph_parse_ptr(m_pFilterGraph, m_filters.c_str(), &inputs, &outputs, NULL);
-    avfilter_inout_free(&outputs);
-    avfilter_inout_free(&inputs);
-
-    if (result < 0)
-    {
-      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_parse");
-      return result;
-    }
-
-    if (filters.compare(0,5,"yadif") == 0)
-    {
-      m_processInfo.SetVideoDeintMethod(filters);
-    }
-    else
-    {
-      m_processInfo.SetVideoDeintMethod("none");
-    }
+    m_processInfo.SetVideoDeintMethod(filters);
   }
   else
   {
-    if ((result = avfilter_link(m_pFilterIn, 0, m_pFilterOut, 0)) < 0)
-    {
-      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_link");
-      return result;
-    }
-
     m_processInfo.SetVideoDeintMethod("none");
   }
 
-  if ((result = avfilter_graph_config(m_pFilterGraph,  nullptr)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_config");
-    return result;
-  }
-
-  if (CServiceBroker::GetLogging().CanLogComponent(LOGVIDEO))
-  {
-    char* graphDump = avfilter_graph_dump(m_pFilterGraph, nullptr);
-    if (graphDump)
-    {
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::FilterOpen - Final filter graph:\n{}", graphDump);
-      av_freep(&graphDump);
-    }
-  }
-
   m_filterEof = false;
-  return result;
+  return 0;
 }
 
 void CDVDVideoCodecFFmpeg::FilterClose()
 {
-  if (m_pFilterGraph)
-  {
-    CLog::Log(LOGDEBUG, LOGVIDEO, "CDVDVideoCodecFFmpeg::FilterClose - Freeing filter graph");
-    avfilter_graph_free(&m_pFilterGraph);
-
-    // Disposed by above code
-    m_pFilterIn = nullptr;
-    m_pFilterOut = nullptr;
-  }
+  m_filter.Close();
 }
 
 CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::FilterProcess(AVFrame* frame)
 {
-  int result;
-
   if (frame || (m_codecControlFlags & DVD_CODEC_CTRL_DRAIN))
   {
-    result = av_buffersrc_add_frame(m_pFilterIn, frame);
-    if (result < 0)
+    if (!m_filter.Push(frame))
     {
-      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - av_buffersrc_add_frame");
+      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - unable to queue frame");
       return VC_ERROR;
     }
   }
 
-  result = av_buffersink_get_frame(m_pFilterOut, m_pFilterFrame);
+  // filtering runs on its own thread, a pushed frame is usually returned by
+  // a later call
+  CDVDVideoCodec::VCReturn result = m_filter.Pull(m_pFilterFrame);
 
-  if (result  == AVERROR(EAGAIN))
-    return VC_BUFFER;
-  else if (result == AVERROR_EOF)
+  if (result == VC_EOF)
   {
-    result = av_buffersink_get_frame(m_pFilterOut, m_pFilterFrame);
     m_filterEof = true;
-    if (result < 0)
-      return VC_BUFFER;
+    return VC_BUFFER;
   }
-  else if (result < 0)
+  else if (result == VC_ERROR)
   {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - av_buffersink_get_frame");
+    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - filtering failed");
     return VC_ERROR;
   }
+  else if (result != VC_PICTURE)
+    return result;
 
   av_frame_unref(m_pFrame);
   av_frame_move_ref(m_pFrame, m_pFilterFrame);
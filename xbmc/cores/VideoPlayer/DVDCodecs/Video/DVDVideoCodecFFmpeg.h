@@ -12,6 +12,8 @@
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
 #include "DVDVideoPPFFmpeg.h"
+#include "VideoCodecThreading.h"
+#include "VideoFilterPipeline.h"
 #include <string>
 #include <vector>
 
@@ -54,6 +56,7 @@ protected:
   CDVDVideoCodec::VCReturn FilterProcess(AVFrame* frame);
   void SetFilters();
   void UpdateName();
+  void UpdateThreading();
   bool SetPictureParams(VideoPicture* pVideoPicture);
 
   bool HasHardware() { return m_pHardware != nullptr; };
@@ -66,9 +69,7 @@ protected:
 
   std::string m_filters;
   std::string m_filters_next;
-  AVFilterGraph* m_pFilterGraph = nullptr;
-  AVFilterContext* m_pFilterIn = nullptr;
-  AVFilterContext* m_pFilterOut = nullptr;;
+  CVideoFilterPipeline m_filter;
   AVFrame* m_pFilterFrame = nullptr;;
   bool m_filterEof = false;
   bool m_eof = false;
@@ -99,6 +100,11 @@ protected:
   CDVDStreamInfo m_hints;
   CDVDCodecOptions m_options;
 
+  CVideoCodecThreading m_threading;
+  bool m_adaptiveThreading = false;
+  bool m_threadingReopen = false; ///< reopen with the threading of m_threading
+  int64_t m_decodeTime = 0; ///< host counter ticks spent in the decoder since the last picture
+
   struct CDropControl
   {
     CDropControl();
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoCodecThreading.h"
+
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+
+namespace
+{
+// More threads add memory and latency without making decoding faster
+constexpr int MAX_THREADS = 16;
+
+constexpr int SD_PIXELS = 720 * 576;
+constexpr int HD_PIXELS = 1920 * 1088;
+
+// Frame threads used for live streams when they start, each one delays
+// the first picture after a channel switch by one frame
+constexpr int REALTIME_SD_THREADS = 2;
+constexpr int REALTIME_HD_THREADS = 3;
+
+// The load is measured over at least this many frames and this much time
+constexpr int WINDOW_FRAMES = 30;
+constexpr double WINDOW_TIME = DVD_TIME_BASE * 2;
+
+// Share of the frame interval the decoder may be busy before it gets more
+// threads, and below which live streams get less
+constexpr double LOAD_HIGH = 0.85;
+constexpr double LOAD_LOW = 0.35;
+
+// Each change reopens the decoder, a stream doesn't get more than this
+constexpr int MAX_CHANGES = 4;
+} // namespace
+
+CVideoCodecThreading::Config CVideoCodecThreading::Select(const Stream& stream, int cpuCount)
+{
+  Config config;
+
+  if (cpuCount <= 1 || (!stream.frameThreads && !stream.sliceThreads))
+    return config;
+
+  const int maxThreads = GetMaxThreads(cpuCount);
+
+  if (!stream.frameThreads || (stream.realtime && stream.sliceThreads && stream.sliceEfficient))
+  {
+    config.type = Type::SLICE;
+    config.threads = std::min(cpuCount, MAX_THREADS);
+    return config;
+  }
+
+  const int pixels = stream.width * stream.height;
+
+  config.type = Type::FRAME;
+  if (pixels > 0 && pixels <= SD_PIXELS)
+    config.threads = stream.realtime ? REALTIME_SD_THREADS : 4;
+  else if (pixels > 0 && pixels <= HD_PIXELS)
+    config.threads = stream.realtime ? REALTIME_HD_THREADS : std::max(4, cpuCount);
+  else
+    config.threads = stream.realtime ? cpuCount : maxThreads;
+
+  config.threads = std::min(config.threads, maxThreads);
+  return config;
+}
+
+std::string CVideoCodecThreading::ToString(const Config& config)
+{
+  if (config.threads <= 1)
+    return "single";
+
+  return StringUtils::Format("{} x{}", config.type == Type::SLICE ? "slice" : "frame",
+                             config.threads);
+}
+
+void CVideoCodecThreading::Start(const Stream& stream, const Config& config, int cpuCount)
+{
+  m_stream = stream;
+  m_config = config;
+  m_cpuCount = cpuCount;
+  m_changes = 0;
+  m_warmup = 1;
+  m_increased = false;
+  m_urgent = false;
+  m_frames = 0;
+  m_decodeTime = 0.0;
+  m_frameTime = 0.0;
+}
+
+bool CVideoCodecThreading::Update(double decodeTime, double frameInterval)
+{
+  if (frameInterval <= 0.0 || m_changes >= MAX_CHANGES || m_cpuCount <= 1)
+    return false;
+
+  m_frames++;
+  m_decodeTime += decodeTime;
+  m_frameTime += frameInterval;
+
+  if (m_frames < WINDOW_FRAMES || m_frameTime < WINDOW_TIME)
+    return false;
+
+  const double load = m_decodeTime / m_frameTime;
+  m_frames = 0;
+  m_decodeTime = 0.0;
+  m_frameTime = 0.0;
+
+  // the first window after opening includes starting the threads
+  if (m_warmup > 0)
+  {
+    m_warmup--;
+    return false;
+  }
+
+  const int maxThreads = GetMaxThreads(m_cpuCount);
+  Config config = m_config;
+  bool urgent = false;
+
+  if (load > LOAD_HIGH)
+  {
+    if (config.type == Type::SLICE)
+    {
+      // the stream doesn't have enough slices, accept the latency of frame threading
+      if (m_stream.frameThreads)
+      {
+        config.type = Type::FRAME;
+        config.threads = std::min(maxThreads, std::max(2, m_cpuCount / 2));
+      }
+    }
+    else
+      config.threads = std::min(maxThreads, config.threads + std::max(1, config.threads / 2));
+
+    urgent = true;
+  }
+  else if (load < LOAD_LOW && m_stream.realtime && config.type == Type::FRAME &&
+           config.threads > 1 && !m_increased)
+  {
+    config.threads--;
+  }
+
+  if (config == m_config)
+    return false;
+
+  m_config = config;
+  m_urgent = urgent;
+  m_increased = m_increased || urgent;
+  m_changes++;
+  m_warmup = 1;
+  return true;
+}
+
+int CVideoCodecThreading::GetMaxThreads(int cpuCount)
+{
+  return std::max(1, std::min(cpuCount * 3 / 2, MAX_THREADS));
+}
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+
+/*!
+ * \brief Chooses the threading of a software video decoder
+ *
+ * Frame threading scales with the number of threads but delays every frame
+ * by one frame per thread, slice threading adds no delay but only scales
+ * with codecs that split frames into many slices. The initial choice is made
+ * from the stream and is adjusted while decoding from the time the decoder
+ * needs per frame compared to the frame interval.
+ */
+class CVideoCodecThreading
+{
+public:
+  enum class Type
+  {
+    FRAME,
+    SLICE
+  };
+
+  struct Config
+  {
+    Type type = Type::FRAME;
+    int threads = 1;
+
+    bool operator==(const Config& other) const
+    {
+      return type == other.type && threads == other.threads;
+    }
+    bool operator!=(const Config& other) const { return !(*this == other); }
+  };
+
+  struct Stream
+  {
+    int width = 0;
+    int height = 0;
+    bool frameThreads = false; ///< the codec supports frame threading
+    bool sliceThreads = false; ///< the codec supports slice threading
+    bool sliceEfficient = false; ///< slice threading scales well with the codec
+    bool realtime = false; ///< the stream is live and latency matters
+  };
+
+  /*!
+   * \brief Get the threading to open a decoder with
+   */
+  static Config Select(const Stream& stream, int cpuCount);
+
+  static std::string ToString(const Config& config);
+
+  /*!
+   * \brief Start measuring a decoder that was opened with a threading
+   */
+  void Start(const Stream& stream, const Config& config, int cpuCount);
+
+  /*!
+   * \brief Record the time the decoder was busy for one frame
+   *
+   * \param decodeTime Time spent in the decoder, in DVD_TIME_BASE units
+   * \param frameInterval Time between frames, in DVD_TIME_BASE units
+   * \return true if the decoder should be reopened with GetConfig()
+   */
+  bool Update(double decodeTime, double frameInterval);
+
+  const Config& GetConfig() const { return m_config; }
+
+  /*!
+   * \brief Whether the decoder falls behind and should change right away,
+   * otherwise the change can wait until the decoder is flushed
+   */
+  bool IsUrgent() const { return m_urgent; }
+
+private:
+  static int GetMaxThreads(int cpuCount);
+
+  Stream m_stream;
+  Config m_config;
+  int m_cpuCount = 1;
+  int m_changes = 0;
+  int m_warmup = 0;
+  bool m_increased = false;
+  bool m_urgent = false;
+
+  int m_frames = 0;
+  double m_decodeTime = 0.0;
+  double m_frameTime = 0.0;
+};
@@ -0,0 +1,331 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoFilterPipeline.h"
+
+#include "ServiceBroker.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+extern "C" {
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+#include <libavutil/opt.h>
+}
+
+bool CVideoFilterPipeline::Format::operator==(const Format& other) const
+{
+  return width == other.width && height == other.height && pixFmt == other.pixFmt &&
+         av_cmp_q(timeBase, other.timeBase) == 0 &&
+         av_cmp_q(sampleAspectRatio, other.sampleAspectRatio) == 0;
+}
+
+CVideoFilterPipeline::CVideoFilterPipeline() : CThread("VideoFilter")
+{
+}
+
+CVideoFilterPipeline::~CVideoFilterPipeline()
+{
+  {
+    CSingleLock lock(m_section);
+    m_bStop = true;
+    m_condition.notifyAll();
+  }
+  StopThread();
+
+  Close();
+
+  for (AVFrame* frame : m_freeFrames)
+    av_frame_free(&frame);
+}
+
+bool CVideoFilterPipeline::Open(const std::string& filters,
+                                const Format& input,
+                                const std::vector<AVPixelFormat>& outputFormats,
+                                int threads)
+{
+  Close();
+
+  CSingleLock lock(m_section);
+
+  if (!(m_graph = avfilter_graph_alloc()))
+  {
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - unable to alloc filter graph", __FUNCTION__);
+    return false;
+  }
+  m_graph->nb_threads = threads;
+
+  const AVFilter* srcFilter = avfilter_get_by_name("buffer");
+  const AVFilter* outFilter = avfilter_get_by_name("buffersink");
+
+  const std::string args = StringUtils::Format(
+      "{}:{}:{}:{}:{}:{}:{}", input.width, input.height, input.pixFmt, input.timeBase.num,
+      input.timeBase.den, input.sampleAspectRatio.num, input.sampleAspectRatio.den);
+
+  int result;
+  if ((result = avfilter_graph_create_filter(&m_source, srcFilter, "src", args.c_str(), nullptr,
+                                             m_graph)) < 0)
+  {
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - avfilter_graph_create_filter: src",
+              __FUNCTION__);
+  }
+  else if ((result = avfilter_graph_create_filter(&m_sink, outFilter, "out", nullptr, nullptr,
+                                                  m_graph)) < 0)
+  {
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - avfilter_graph_create_filter: out",
+              __FUNCTION__);
+  }
+  else if ((result = av_opt_set_int_list(m_sink, "pix_fmts", outputFormats.data(),
+                                         AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN)) < 0)
+  {
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - failed settings pix formats", __FUNCTION__);
+  }
+  else if (!filters.empty())
+  {
+    AVFilterInOut* outputs = avfilter_inout_alloc();
+    AVFilterInOut* inputs = avfilter_inout_alloc();
+
+    outputs->name = av_strdup("in");
+    outputs->filter_ctx = m_source;
+    outputs->pad_idx = 0;
+    outputs->next = nullptr;
+
+    inputs->name = av_strdup("out");
+    inputs->filter_ctx = m_sink;
+    inputs->pad_idx = 0;
+    inputs->next = nullptr;
+
+    result = avfilter_graph_parse_ptr(m_graph, filters.c_str(), &inputs, &outputs, nullptr);
+    avfilter_inout_free(&outputs);
+    avfilter_inout_free(&inputs);
+
+    if (result < 0)
+      CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - avfilter_graph_parse", __FUNCTION__);
+  }
+  else if ((result = avfilter_link(m_source, 0, m_sink, 0)) < 0)
+  {
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - avfilter_link", __FUNCTION__);
+  }
+
+  if (result >= 0 && (result = avfilter_graph_config(m_graph, nullptr)) < 0)
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - avfilter_graph_config", __FUNCTION__);
+
+  if (result < 0)
+  {
+    avfilter_graph_free(&m_graph);
+    m_source = nullptr;
+    m_sink = nullptr;
+    return false;
+  }
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGVIDEO))
+  {
+    char* graphDump = avfilter_graph_dump(m_graph, nullptr);
+    if (graphDump)
+    {
+      CLog::Log(LOGDEBUG, "CVideoFilterPipeline::{} - Final filter graph:\n{}", __FUNCTION__,
+                graphDump);
+      av_freep(&graphDump);
+    }
+  }
+
+  m_input = input;
+
+  if (!IsRunning())
+    Create();
+
+  return true;
+}
+
+void CVideoFilterPipeline::Close()
+{
+  CSingleLock lock(m_section);
+
+  // the graph can't be freed while the worker uses it
+  while (m_busy)
+    m_condition.wait(lock);
+
+  if (m_graph)
+  {
+    CLog::Log(LOGDEBUG, LOGVIDEO, "CVideoFilterPipeline::{} - Freeing filter graph", __FUNCTION__);
+    avfilter_graph_free(&m_graph);
+    m_source = nullptr;
+    m_sink = nullptr;
+  }
+
+  for (auto* queue : {&m_inputQueue, &m_outputQueue})
+  {
+    for (AVFrame* frame : *queue)
+    {
+      av_frame_unref(frame);
+      m_freeFrames.push_back(frame);
+    }
+    queue->clear();
+  }
+
+  m_inputEnded = false;
+  m_outputEnded = false;
+  m_error = false;
+}
+
+bool CVideoFilterPipeline::Push(AVFrame* frame)
+{
+  CSingleLock lock(m_section);
+
+  if (!m_graph || m_error)
+    return false;
+
+  if (m_inputEnded)
+  {
+    if (frame)
+      av_frame_unref(frame);
+    return true;
+  }
+
+  if (!frame)
+  {
+    m_inputEnded = true;
+    m_condition.notifyAll();
+    return true;
+  }
+
+  while (m_inputQueue.size() >= MAX_QUEUED && !m_error)
+    m_condition.wait(lock);
+
+  AVFrame* queued = m_error ? nullptr : GetFreeFrame();
+  if (!queued)
+    return false;
+
+  av_frame_move_ref(queued, frame);
+  m_inputQueue.push_back(queued);
+  m_condition.notifyAll();
+  return true;
+}
+
+CDVDVideoCodec::VCReturn CVideoFilterPipeline::Pull(AVFrame* frame)
+{
+  CSingleLock lock(m_section);
+
+  while (m_graph && m_inputEnded && m_outputQueue.empty() && !m_outputEnded && !m_error)
+    m_condition.wait(lock);
+
+  if (!m_outputQueue.empty())
+  {
+    AVFrame* filtered = m_outputQueue.front();
+    m_outputQueue.pop_front();
+    av_frame_unref(frame);
+    av_frame_move_ref(frame, filtered);
+    m_freeFrames.push_back(filtered);
+    return CDVDVideoCodec::VC_PICTURE;
+  }
+
+  if (m_error)
+    return CDVDVideoCodec::VC_ERROR;
+  else if (m_outputEnded)
+    return CDVDVideoCodec::VC_EOF;
+
+  return CDVDVideoCodec::VC_BUFFER;
+}
+
+void CVideoFilterPipeline::Process()
+{
+  CSingleLock lock(m_section);
+
+  while (!m_bStop)
+  {
+    AVFrame* frame = nullptr;
+
+    if (m_graph && !m_error && !m_inputQueue.empty())
+    {
+      frame = m_inputQueue.front();
+      m_inputQueue.pop_front();
+    }
+    else if (!(m_graph && !m_error && m_inputEnded && !m_outputEnded))
+    {
+      m_condition.wait(lock);
+      continue;
+    }
+
+    // a queue slot is free again
+    m_condition.notifyAll();
+
+    m_busy = true;
+    bool success;
+    {
+      CSingleExit exit(m_section);
+      success = FilterFrame(frame);
+    }
+    m_busy = false;
+
+    if (frame)
+    {
+      av_frame_unref(frame);
+      m_freeFrames.push_back(frame);
+    }
+
+    if (!success)
+      m_error = true;
+
+    m_condition.notifyAll();
+  }
+}
+
+bool CVideoFilterPipeline::FilterFrame(AVFrame* frame)
+{
+  // nullptr flushes the frames that the filters hold back
+  if (av_buffersrc_add_frame(m_source, frame) < 0)
+  {
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - av_buffersrc_add_frame", __FUNCTION__);
+    return false;
+  }
+
+  while (true)
+  {
+    AVFrame* filtered;
+    {
+      CSingleLock lock(m_section);
+      filtered = GetFreeFrame();
+    }
+    if (!filtered)
+      return false;
+
+    const int result = av_buffersink_get_frame(m_sink, filtered);
+
+    CSingleLock lock(m_section);
+    if (result >= 0)
+    {
+      m_outputQueue.push_back(filtered);
+      m_condition.notifyAll();
+      continue;
+    }
+
+    m_freeFrames.push_back(filtered);
+
+    if (result == AVERROR(EAGAIN))
+      return true;
+    else if (result == AVERROR_EOF)
+    {
+      m_outputEnded = true;
+      return true;
+    }
+
+    CLog::Log(LOGERROR, "CVideoFilterPipeline::{} - av_buffersink_get_frame", __FUNCTION__);
+    return false;
+  }
+}
+
+AVFrame* CVideoFilterPipeline::GetFreeFrame()
+{
+  if (m_freeFrames.empty())
+    return av_frame_alloc();
+
+  AVFrame* frame = m_freeFrames.back();
+  m_freeFrames.pop_back();
+  return frame;
+}
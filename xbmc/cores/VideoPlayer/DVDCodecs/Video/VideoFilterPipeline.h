@@ -0,0 +1,131 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDVideoCodec.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavfilter/avfilter.h>
+#include <libavutil/frame.h>
+}
+
+/*!
+ * \brief Runs the software filters of decoded frames on a worker thread
+ *
+ * Deinterlacing, rotation and format conversion of software decoded frames
+ * run on their own thread, so that they overlap with decoding the next
+ * frame instead of adding to its time. Filters that support slice threading,
+ * e.g. yadif, additionally spread each frame over the threads of the graph.
+ *
+ * The decode thread pushes decoded frames and pulls filtered ones. At most
+ * MAX_QUEUED frames wait for the worker, the AVFrames of both queues are
+ * kept and reused.
+ */
+class CVideoFilterPipeline : private CThread
+{
+public:
+  /*!
+   * \brief Format of the frames that are filtered
+   */
+  struct Format
+  {
+    int width = 0;
+    int height = 0;
+    AVPixelFormat pixFmt = AV_PIX_FMT_NONE;
+    AVRational timeBase = {1, 1};
+    AVRational sampleAspectRatio = {1, 1};
+
+    bool operator==(const Format& other) const;
+    bool operator!=(const Format& other) const { return !(*this == other); }
+  };
+
+  CVideoFilterPipeline();
+  ~CVideoFilterPipeline() override;
+
+  /*!
+   * \brief Create the filter graph and start the worker
+   *
+   * \param filters The filters in the avfilter syntax, empty to only
+   * convert the format
+   * \param input The format of the frames that are pushed
+   * \param outputFormats Formats the output is converted to, terminated
+   * with AV_PIX_FMT_NONE
+   * \param threads Number of threads of filters that support slice
+   * threading, 0 for one per core
+   * \return true on success, false if the graph can't be created
+   */
+  bool Open(const std::string& filters,
+            const Format& input,
+            const std::vector<AVPixelFormat>& outputFormats,
+            int threads = 0);
+
+  /*!
+   * \brief Free the filter graph and discard all queued frames
+   */
+  void Close();
+
+  bool IsOpen() const { return m_graph != nullptr; }
+  const Format& GetInputFormat() const { return m_input; }
+
+  /*!
+   * \brief Queue a frame for filtering, waits while the queue is full
+   *
+   * \param frame The frame, its reference is taken. nullptr marks the end
+   * of the input, later calls are ignored until the pipeline is reopened.
+   * \return false if the pipeline isn't open or filtering failed
+   */
+  bool Push(AVFrame* frame);
+
+  /*!
+   * \brief Get the next filtered frame
+   *
+   * Doesn't wait, unless the end of the input was pushed. Then it waits
+   * until a frame is filtered or all frames were returned.
+   *
+   * \param frame Receives the reference of the filtered frame
+   * \return VC_PICTURE if a frame was returned, VC_BUFFER if none is ready
+   * yet, VC_EOF after the last frame, VC_ERROR if filtering failed
+   */
+  CDVDVideoCodec::VCReturn Pull(AVFrame* frame);
+
+  /*!
+   * \brief Frames that may wait for the worker before Push() blocks
+   */
+  static constexpr size_t MAX_QUEUED = 2;
+
+protected:
+  void Process() override;
+
+private:
+  bool FilterFrame(AVFrame* frame);
+  AVFrame* GetFreeFrame();
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_condition;
+
+  AVFilterGraph* m_graph = nullptr;
+  AVFilterContext* m_source = nullptr;
+  AVFilterContext* m_sink = nullptr;
+  Format m_input;
+
+  std::deque<AVFrame*> m_inputQueue;
+  std::deque<AVFrame*> m_outputQueue;
+  std::vector<AVFrame*> m_freeFrames;
+  bool m_inputEnded = false; ///< the end of the input was pushed
+  bool m_outputEnded = false; ///< the graph returned its last frame
+  bool m_busy = false; ///< the worker filters a frame outside of the lock
+  bool m_error = false;
+};
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/VideoCodecThreading.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr int CPU_COUNT = 8;
+constexpr double FRAME_INTERVAL = DVD_TIME_BASE / 25.0;
+
+CVideoCodecThreading::Stream CreateStream(int width, int height, bool realtime)
+{
+  CVideoCodecThreading::Stream stream;
+  stream.width = width;
+  stream.height = height;
+  stream.frameThreads = true;
+  stream.sliceThreads = true;
+  stream.sliceEfficient = true;
+  stream.realtime = realtime;
+  return stream;
+}
+
+// Decode frames with a load, returns true if the threading changed
+bool Decode(CVideoCodecThreading& threading, double load, int frames)
+{
+  bool changed = false;
+  for (int i = 0; i < frames; i++)
+    changed |= threading.Update(FRAME_INTERVAL * load, FRAME_INTERVAL);
+  return changed;
+}
+} // namespace
+
+TEST(TestVideoCodecThreading, SelectFile)
+{
+  const auto sd = CVideoCodecThreading::Select(CreateStream(720, 576, false), CPU_COUNT);
+  EXPECT_EQ(sd.type, CVideoCodecThreading::Type::FRAME);
+  EXPECT_EQ(sd.threads, 4);
+
+  const auto uhd = CVideoCodecThreading::Select(CreateStream(3840, 2160, false), CPU_COUNT);
+  EXPECT_EQ(uhd.type, CVideoCodecThreading::Type::FRAME);
+  EXPECT_EQ(uhd.threads, 12);
+
+  const auto single = CVideoCodecThreading::Select(CreateStream(1920, 1080, false), 1);
+  EXPECT_EQ(single.threads, 1);
+}
+
+TEST(TestVideoCodecThreading, SelectRealtime)
+{
+  const auto slice = CVideoCodecThreading::Select(CreateStream(1920, 1080, true), CPU_COUNT);
+  EXPECT_EQ(slice.type, CVideoCodecThreading::Type::SLICE);
+  EXPECT_EQ(slice.threads, CPU_COUNT);
+
+  auto stream = CreateStream(1920, 1080, true);
+  stream.sliceEfficient = false;
+  const auto frame = CVideoCodecThreading::Select(stream, CPU_COUNT);
+  const auto file = CVideoCodecThreading::Select(CreateStream(1920, 1080, false), CPU_COUNT);
+  EXPECT_EQ(frame.type, CVideoCodecThreading::Type::FRAME);
+  EXPECT_LT(frame.threads, file.threads);
+}
+
+TEST(TestVideoCodecThreading, IncreaseWhenBehind)
+{
+  const auto stream = CreateStream(1920, 1080, false);
+  const auto config = CVideoCodecThreading::Select(stream, CPU_COUNT);
+
+  CVideoCodecThreading threading;
+  threading.Start(stream, config, CPU_COUNT);
+
+  // the first window isn't used
+  EXPECT_FALSE(Decode(threading, 1.2, 50));
+  EXPECT_TRUE(Decode(threading, 1.2, 50));
+  EXPECT_TRUE(threading.IsUrgent());
+  EXPECT_EQ(threading.GetConfig().type, CVideoCodecThreading::Type::FRAME);
+  EXPECT_GT(threading.GetConfig().threads, config.threads);
+}
+
+TEST(TestVideoCodecThreading, SliceToFrame)
+{
+  const auto stream = CreateStream(1920, 1080, true);
+
+  CVideoCodecThreading threading;
+  threading.Start(stream, CVideoCodecThreading::Select(stream, CPU_COUNT), CPU_COUNT);
+
+  EXPECT_TRUE(Decode(threading, 1.0, 100));
+  EXPECT_EQ(threading.GetConfig().type, CVideoCodecThreading::Type::FRAME);
+}
+
+TEST(TestVideoCodecThreading, DecreaseRealtime)
+{
+  auto stream = CreateStream(1920, 1080, true);
+  stream.sliceEfficient = false;
+  const auto config = CVideoCodecThreading::Select(stream, CPU_COUNT);
+
+  CVideoCodecThreading threading;
+  threading.Start(stream, config, CPU_COUNT);
+
+  EXPECT_TRUE(Decode(threading, 0.1, 100));
+  EXPECT_FALSE(threading.IsUrgent());
+  EXPECT_EQ(threading.GetConfig().threads, config.threads - 1);
+
+  // files don't get fewer threads
+  stream.realtime = false;
+  threading.Start(stream, config, CPU_COUNT);
+  EXPECT_FALSE(Decode(threading, 0.1, 500));
+}
+
+TEST(TestVideoCodecThreading, Stable)
+{
+  const auto stream = CreateStream(1920, 1080, false);
+
+  CVideoCodecThreading threading;
+  threading.Start(stream, CVideoCodecThreading::Select(stream, CPU_COUNT), CPU_COUNT);
+
+  EXPECT_FALSE(Decode(threading, 0.5, 1000));
+}
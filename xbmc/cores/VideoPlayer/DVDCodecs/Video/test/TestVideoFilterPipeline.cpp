@@ -0,0 +1,239 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/VideoFilterPipeline.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const std::vector<AVPixelFormat> OUTPUT_FORMATS = {AV_PIX_FMT_YUV420P, AV_PIX_FMT_NONE};
+
+unsigned int GetEnvironment(const char* name, unsigned int defaultValue)
+{
+  const char* value = std::getenv(name);
+  if (value != nullptr && std::atoi(value) > 0)
+    return static_cast<unsigned int>(std::atoi(value));
+
+  return defaultValue;
+}
+
+CVideoFilterPipeline::Format CreateFormat(int width, int height, AVPixelFormat pixFmt)
+{
+  CVideoFilterPipeline::Format format;
+  format.width = width;
+  format.height = height;
+  format.pixFmt = pixFmt;
+  format.timeBase = {1, 25};
+  return format;
+}
+
+// An interlaced frame, the fields differ so that the filter has to work
+AVFrame* CreateFrame(const CVideoFilterPipeline::Format& format, int64_t pts)
+{
+  AVFrame* frame = av_frame_alloc();
+  frame->format = format.pixFmt;
+  frame->width = format.width;
+  frame->height = format.height;
+  frame->pts = pts;
+  frame->interlaced_frame = 1;
+  frame->top_field_first = 1;
+  if (av_frame_get_buffer(frame, 0) < 0)
+  {
+    av_frame_free(&frame);
+    return nullptr;
+  }
+
+  for (int plane = 0; plane < 3; plane++)
+  {
+    const int height = plane == 0 || format.pixFmt != AV_PIX_FMT_YUV420P ? format.height
+                                                                          : format.height / 2;
+    for (int y = 0; y < height; y++)
+      memset(frame->data[plane] + y * frame->linesize[plane],
+             (y % 2 ? 16 : 235) + static_cast<int>(pts % 8), frame->linesize[plane]);
+  }
+
+  return frame;
+}
+
+// Simulates the time that decoding a frame takes
+void Decode(std::chrono::microseconds duration)
+{
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end)
+    ;
+}
+
+struct FilterResult
+{
+  unsigned int frames = 0;
+  std::vector<int64_t> pts;
+  double milliseconds = 0.0;
+};
+
+void AddPicture(FilterResult& result, const AVFrame* filtered)
+{
+  EXPECT_EQ(filtered->format, AV_PIX_FMT_YUV420P);
+  result.frames++;
+  result.pts.push_back(filtered->pts);
+}
+
+// Frames must leave the pipeline in the order they were pushed
+void ExpectOrdered(const FilterResult& result)
+{
+  for (size_t i = 1; i < result.pts.size(); i++)
+    EXPECT_GT(result.pts[i], result.pts[i - 1]) << "frame " << i;
+}
+
+FilterResult Filter(CVideoFilterPipeline& pipeline,
+                    const CVideoFilterPipeline::Format& format,
+                    unsigned int frames,
+                    std::chrono::microseconds decodeTime)
+{
+  FilterResult result;
+  AVFrame* filtered = av_frame_alloc();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned int i = 0; i < frames; i++)
+  {
+    Decode(decodeTime);
+
+    AVFrame* frame = CreateFrame(format, i);
+    EXPECT_NE(frame, nullptr);
+    EXPECT_TRUE(pipeline.Push(frame));
+    av_frame_free(&frame);
+
+    while (pipeline.Pull(filtered) == CDVDVideoCodec::VC_PICTURE)
+      AddPicture(result, filtered);
+  }
+
+  EXPECT_TRUE(pipeline.Push(nullptr));
+
+  CDVDVideoCodec::VCReturn ret;
+  while ((ret = pipeline.Pull(filtered)) == CDVDVideoCodec::VC_PICTURE)
+    AddPicture(result, filtered);
+  EXPECT_EQ(ret, CDVDVideoCodec::VC_EOF);
+
+  result.milliseconds = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+  av_frame_free(&filtered);
+  return result;
+}
+} // namespace
+
+TEST(TestVideoFilterPipeline, Convert)
+{
+  const auto format = CreateFormat(320, 240, AV_PIX_FMT_YUV422P);
+
+  CVideoFilterPipeline pipeline;
+  ASSERT_TRUE(pipeline.Open("", format, OUTPUT_FORMATS));
+  EXPECT_TRUE(pipeline.GetInputFormat() == format);
+
+  const FilterResult result = Filter(pipeline, format, 10, std::chrono::microseconds(0));
+  EXPECT_EQ(result.frames, 10u);
+  ASSERT_EQ(result.pts.size(), 10u);
+  for (int64_t i = 0; i < 10; i++)
+    EXPECT_EQ(result.pts[i], i);
+}
+
+TEST(TestVideoFilterPipeline, Deinterlace)
+{
+  const auto format = CreateFormat(320, 240, AV_PIX_FMT_YUV420P);
+
+  CVideoFilterPipeline pipeline;
+  ASSERT_TRUE(pipeline.Open("yadif=1:-1", format, OUTPUT_FORMATS));
+
+  // yadif=1 outputs one frame per field
+  const FilterResult result = Filter(pipeline, format, 20, std::chrono::microseconds(0));
+  EXPECT_EQ(result.frames, 40u);
+  ExpectOrdered(result);
+}
+
+TEST(TestVideoFilterPipeline, Reopen)
+{
+  const auto format = CreateFormat(320, 240, AV_PIX_FMT_YUV420P);
+
+  CVideoFilterPipeline pipeline;
+  ASSERT_TRUE(pipeline.Open("yadif=0:-1", format, OUTPUT_FORMATS));
+
+  // queued frames are dropped
+  for (int i = 0; i < 2; i++)
+  {
+    AVFrame* frame = CreateFrame(format, i);
+    EXPECT_TRUE(pipeline.Push(frame));
+    av_frame_free(&frame);
+  }
+  pipeline.Close();
+  EXPECT_FALSE(pipeline.IsOpen());
+
+  AVFrame* frame = CreateFrame(format, 0);
+  EXPECT_FALSE(pipeline.Push(frame));
+  av_frame_free(&frame);
+
+  ASSERT_TRUE(pipeline.Open("yadif=0:-1", format, OUTPUT_FORMATS));
+  const FilterResult result = Filter(pipeline, format, 10, std::chrono::microseconds(0));
+  EXPECT_EQ(result.frames, 10u);
+  ExpectOrdered(result);
+}
+
+TEST(TestVideoFilterPipeline, InvalidFilter)
+{
+  CVideoFilterPipeline pipeline;
+  EXPECT_FALSE(pipeline.Open("nosuchfilter", CreateFormat(320, 240, AV_PIX_FMT_YUV420P),
+                             OUTPUT_FORMATS));
+  EXPECT_FALSE(pipeline.IsOpen());
+}
+
+/*!
+ * \brief Benchmark deinterlacing synthetic 1080i frames while a decoder is
+ *        simulated on the calling thread
+ *
+ * Disabled by default, run it with --gtest_also_run_disabled_tests. The
+ * times per frame are recorded as test properties, e.g. with
+ * --gtest_output=xml. Set KODI_FILTER_FRAMES, KODI_FILTER_WIDTH,
+ * KODI_FILTER_HEIGHT and KODI_FILTER_DECODE_US to benchmark other content,
+ * e.g. 1000 frames with 15000 us for a slow H.264 decoder.
+ */
+TEST(TestVideoFilterPipeline, DISABLED_HeadlessDeinterlace)
+{
+  const unsigned int frames = GetEnvironment("KODI_FILTER_FRAMES", 50);
+  const unsigned int width = GetEnvironment("KODI_FILTER_WIDTH", 1920);
+  const unsigned int height = GetEnvironment("KODI_FILTER_HEIGHT", 1080);
+  const std::chrono::microseconds decodeTime(GetEnvironment("KODI_FILTER_DECODE_US", 5000));
+
+  const auto format = CreateFormat(width, height, AV_PIX_FMT_YUV420P);
+
+  CVideoFilterPipeline pipeline;
+  ASSERT_TRUE(pipeline.Open("yadif=1:-1", format, OUTPUT_FORMATS));
+  const FilterResult filterOnly = Filter(pipeline, format, frames, std::chrono::microseconds(0));
+
+  ASSERT_TRUE(pipeline.Open("yadif=1:-1", format, OUTPUT_FORMATS));
+  const FilterResult pipelined = Filter(pipeline, format, frames, decodeTime);
+
+  const double decodeMs = frames * decodeTime.count() / 1000.0;
+
+  RecordProperty("FilterOnlyUsPerFrame",
+                 static_cast<int>(filterOnly.milliseconds * 1000 / frames));
+  RecordProperty("SequentialUsPerFrame",
+                 static_cast<int>((filterOnly.milliseconds + decodeMs) * 1000 / frames));
+  RecordProperty("PipelinedUsPerFrame", static_cast<int>(pipelined.milliseconds * 1000 / frames));
+
+  // yadif=1 outputs one frame per field
+  EXPECT_EQ(filterOnly.frames, frames * 2);
+  EXPECT_EQ(pipelined.frames, frames * 2);
+  ExpectOrdered(filterOnly);
+  ExpectOrdered(pipelined);
+}
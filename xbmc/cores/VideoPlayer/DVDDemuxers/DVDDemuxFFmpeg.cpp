@@ -11,10 +11,15 @@
 #include "DVDDemuxUtils.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
+#include "DVDInputStreams/InputStreamPVRRecording.h"
+#include "DemuxCacheFolder.h"
+#include "DemuxProbeCache.h"
+#include "DemuxSeekIndex.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "Util.h"
 #include "commons/Exception.h"
+#include "cores/DataCacheCore.h"
 #include "cores/FFmpeg.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h" // for DVD_TIME_BASE
 #include "filesystem/CurlFile.h"
@@ -30,6 +35,7 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
 #include <sstream>
 #include <utility>
 
@@ -226,9 +232,33 @@ bool CDVDDemuxFFmpeg::Aborted()
 }
 
 bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool fileinfo)
+{
+  const auto start = std::chrono::steady_clock::now();
+  m_probeCacheFailed = false;
+  m_probeCached = false;
+
+  if (!OpenInput(pInput, fileinfo))
+    return false;
+
+  if (!fileinfo)
+  {
+    const std::chrono::duration<float, std::milli> openTime =
+        std::chrono::steady_clock::now() - start;
+    CLog::Log(LOGDEBUG, "{} - demuxer opened in {:.0f} ms{}", __FUNCTION__, openTime.count(),
+              m_probeCached ? " with cached probe results" : "");
+    CServiceBroker::GetDataCacheCore().SetDemuxerOpenTime(openTime.count(), m_probeCached);
+  }
+
+  return true;
+}
+
+bool CDVDDemuxFFmpeg::OpenInput(const std::shared_ptr<CDVDInputStream>& pInput, bool fileinfo)
 {
   AVInputFormat* iformat = NULL;
   std::string strFile;
+  CDemuxProbeCache::Entry probeCacheEntry;
+  bool probeCacheAllowed = false;
+  bool probeCached = false;
   m_streaminfo = !pInput->IsRealtime() && !m_reopen;
   m_reopen = false;
   m_currentPts = DVD_NOPTS_VALUE;
@@ -367,6 +397,23 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     if (StringUtils::StartsWith(content, "audio/l16"))
       iformat = av_find_input_format("s16be");
 
+    // local files and files on network shares, where probing takes longest. Internet streams
+    // are left out, the entry would cost an extra request and their content may change
+    probeCacheAllowed = iformat == nullptr && seekable && !m_pInput->IsRealtime() &&
+                        m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) &&
+                        !URIUtils::IsInternetStream(strFile) &&
+                        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoProbeCache;
+
+    // skip probing the format of files that were probed before
+    if (probeCacheAllowed && !m_probeCacheFailed &&
+        CDemuxProbeCache::Lookup(strFile, probeCacheEntry))
+    {
+      iformat = av_find_input_format(probeCacheEntry.format.c_str());
+      probeCached = iformat != nullptr;
+      if (probeCached)
+        CLog::Log(LOGDEBUG, "{} - using cached format [{}]", __FUNCTION__, iformat->name);
+    }
+
     if (iformat == nullptr)
     {
       // let ffmpeg decide which demuxer we have to open
@@ -492,13 +539,19 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
 
     if (avformat_open_input(&m_pFormatContext, strFile.c_str(), iformat, &options) < 0)
     {
+      av_dict_free(&options);
+      if (probeCached)
+        return ReopenWithoutProbeCache(strFile, fileinfo);
+
       CLog::Log(LOGERROR, "{} - Error, could not open file {}", __FUNCTION__,
                 CURL::GetRedacted(strFile));
       Dispose();
-      av_dict_free(&options);
       return false;
     }
     av_dict_free(&options);
+
+    if (probeCached && !CDemuxProbeCache::Apply(probeCacheEntry, m_pFormatContext))
+      return ReopenWithoutProbeCache(strFile, fileinfo);
   }
 
   // Avoid detecting framerate if advancedsettings.xml says so
@@ -539,26 +592,38 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
-    CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
-    int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
-    if (iErr < 0)
+    if (probeCached)
     {
-      CLog::Log(LOGWARNING, "could not find codec parameters for {}", CURL::GetRedacted(strFile));
-      if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) ||
-          m_pInput->IsStreamType(DVDSTREAM_TYPE_BLURAY) ||
-          (m_pFormatContext->nb_streams == 1 &&
-           m_pFormatContext->streams[0]->codecpar->codec_id == AV_CODEC_ID_AC3) ||
-          m_checkTransportStream)
+      // the codec parameters were restored from the probe cache
+      CLog::Log(LOGDEBUG, "{} - using cached stream info", __FUNCTION__);
+    }
+    else
+    {
+      CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
+      int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+      if (iErr < 0)
       {
-        // special case, our codecs can still handle it.
+        CLog::Log(LOGWARNING, "could not find codec parameters for {}", CURL::GetRedacted(strFile));
+        if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) ||
+            m_pInput->IsStreamType(DVDSTREAM_TYPE_BLURAY) ||
+            (m_pFormatContext->nb_streams == 1 &&
+             m_pFormatContext->streams[0]->codecpar->codec_id == AV_CODEC_ID_AC3) ||
+            m_checkTransportStream)
+        {
+          // special case, our codecs can still handle it.
+        }
+        else
+        {
+          Dispose();
+          return false;
+        }
       }
-      else
+      else if (probeCacheAllowed)
       {
-        Dispose();
-        return false;
+        CDemuxProbeCache::Store(strFile, m_pFormatContext);
       }
+      CLog::Log(LOGDEBUG, "{} - av_find_stream_info finished", __FUNCTION__);
     }
-    CLog::Log(LOGDEBUG, "{} - av_find_stream_info finished", __FUNCTION__);
 
     // print some extra information
     av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(strFile).c_str(), 0);
@@ -648,6 +713,21 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
   m_startTime = 0;
   m_seekStream = -1;
+  m_probeCached = probeCached;
+
+  // formats that bisect the file to seek use an index of the keyframes played before
+  m_seekIndexKey.clear();
+  m_seekIndexStream = -1;
+  if (m_ioContext && m_ioContext->seekable && !m_pInput->IsRealtime() &&
+      m_pFormatContext->iformat && !m_pFormatContext->iformat->read_seek &&
+      !m_pFormatContext->iformat->read_seek2 &&
+      !(m_pFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK) &&
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoSeekIndex)
+  {
+    m_seekIndexKey = GetSeekIndexKey();
+    if (!m_seekIndexKey.empty())
+      OpenSeekIndex();
+  }
 
   if (m_checkTransportStream && m_streaminfo)
   {
@@ -655,7 +735,7 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
     Dispose();
     m_reopen = true;
-    if (!Open(pInputStream, false))
+    if (!OpenInput(pInputStream, false))
       return false;
     m_pFormatContext->duration = duration;
   }
@@ -668,6 +748,13 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  if (!m_seekIndexKey.empty())
+  {
+    m_seekIndex.Save(m_seekIndexKey, m_seekIndexSize, m_seekIndexTime);
+    m_seekIndexKey.clear();
+    m_seekIndexStream = -1;
+  }
+
   if (m_pFormatContext)
   {
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
@@ -693,11 +780,27 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pInput = NULL;
 }
 
+bool CDVDDemuxFFmpeg::ReopenWithoutProbeCache(const std::string& strFile, bool fileinfo)
+{
+  CLog::Log(LOGDEBUG, "{} - cached probe results don't match {}, probing again", __FUNCTION__,
+            CURL::GetRedacted(strFile));
+  CDemuxProbeCache::Remove(strFile);
+
+  std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
+  Dispose();
+  m_probeCacheFailed = true;
+
+  if (pInputStream->Seek(0, SEEK_SET) != 0)
+    return false;
+
+  return OpenInput(pInputStream, fileinfo);
+}
+
 bool CDVDDemuxFFmpeg::Reset()
 {
   std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
   Dispose();
-  return Open(pInputStream, false);
+  return OpenInput(pInputStream, false);
 }
 
 void CDVDDemuxFFmpeg::Flush()
@@ -717,6 +820,7 @@ void CDVDDemuxFFmpeg::Flush()
   m_displayTime = 0;
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
   m_seekToKeyFrame = false;
+  m_seekIndex.Discontinuity();
 }
 
 void CDVDDemuxFFmpeg::Abort()
@@ -1074,6 +1178,17 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
 
       AVStream* stream = m_pFormatContext->streams[m_pkt.pkt.stream_index];
 
+      if (!m_seekIndexKey.empty() && stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+      {
+        // streams of transport streams may only be known now
+        if (m_seekIndexStream < 0)
+          OpenSeekIndex();
+
+        if (m_pkt.pkt.stream_index == m_seekIndexStream && (m_pkt.pkt.flags & AV_PKT_FLAG_KEY))
+          m_seekIndex.Add(m_pkt.pkt.pts != AV_NOPTS_VALUE ? m_pkt.pkt.pts : m_pkt.pkt.dts,
+                          m_pkt.pkt.pos);
+      }
+
       if (IsTransportStreamReady())
       {
         if (m_program != UINT_MAX)
@@ -1276,7 +1391,12 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   int ret;
   {
     CSingleLock lock(m_critSection);
-    ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
+    const bool indexed = SeekIndex(seek_pts, backwards);
+    if (indexed)
+      ret = 0;
+    else
+      ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts,
+                          backwards ? AVSEEK_FLAG_BACKWARD : 0);
 
     if (ret < 0)
     {
@@ -1303,7 +1423,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
         ret = 0;
     }
 
-    if (ret >= 0)
+    if (ret >= 0 && !indexed)
     {
       if (m_pFormatContext->iformat->read_seek)
         m_seekToKeyFrame = true;
@@ -1337,6 +1457,7 @@ bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
   CSingleLock lock(m_critSection);
   int ret = av_seek_frame(m_pFormatContext, -1, pos, AVSEEK_FLAG_BYTE);
+  m_seekIndex.Discontinuity();
 
   if (ret >= 0)
     UpdateCurrentPTS();
@@ -1347,6 +1468,88 @@ bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
   return (ret >= 0);
 }
 
+std::string CDVDDemuxFFmpeg::GetSeekIndexKey()
+{
+  m_seekIndexSize = 0;
+  m_seekIndexTime = 0;
+
+  if (m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE))
+  {
+    const std::string path = m_pInput->GetFileName();
+    if (CDemuxCacheFolder::GetFileInfo(path, m_seekIndexSize, m_seekIndexTime))
+      return path;
+  }
+  else if (m_pInput->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER))
+  {
+    // the backend doesn't tell when a recording changed, a finished recording is assumed to
+    // be unchanged as long as it has the same size
+    std::shared_ptr<CInputStreamPVRRecording> recording =
+        std::dynamic_pointer_cast<CInputStreamPVRRecording>(m_pInput);
+    if (recording && !recording->GetRecordingKey().empty())
+    {
+      m_seekIndexSize = m_pInput->GetLength();
+      if (m_seekIndexSize > 0)
+        return recording->GetRecordingKey();
+    }
+  }
+
+  return "";
+}
+
+void CDVDDemuxFFmpeg::OpenSeekIndex()
+{
+  m_seekIndexStream = -1;
+
+  for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
+  {
+    const AVStream* st = m_pFormatContext->streams[i];
+    if (st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO && st->discard < AVDISCARD_ALL &&
+        !(st->disposition & AV_DISPOSITION_ATTACHED_PIC))
+    {
+      m_seekIndexStream = i;
+      break;
+    }
+  }
+
+  if (m_seekIndexStream < 0)
+    return;
+
+  const AVRational& timeBase = m_pFormatContext->streams[m_seekIndexStream]->time_base;
+  if (m_seekIndex.Load(m_seekIndexKey, m_seekIndexSize, m_seekIndexTime, timeBase.num,
+                       timeBase.den))
+    CLog::Log(LOGDEBUG, "{} - loaded seek index with {} keyframes", __FUNCTION__,
+              m_seekIndex.GetSize());
+}
+
+bool CDVDDemuxFFmpeg::SeekIndex(int64_t seekPts, bool backwards)
+{
+  // the next keyframe read doesn't follow the last one
+  m_seekIndex.Discontinuity();
+
+  if (m_seekIndexStream < 0 || m_seekIndex.IsEmpty())
+    return false;
+
+  // the seek time is in the time base of the seek stream for transport streams
+  const AVRational timeBase = m_pFormatContext->streams[m_seekIndexStream]->time_base;
+  AVRational seekTimeBase = {1, AV_TIME_BASE};
+  if (m_seekStream >= 0)
+    seekTimeBase = m_pFormatContext->streams[m_seekStream]->time_base;
+
+  CDemuxSeekIndex::Entry entry;
+  if (!m_seekIndex.Find(av_rescale_q(seekPts, seekTimeBase, timeBase), backwards, entry))
+    return false;
+
+  if (av_seek_frame(m_pFormatContext, -1, entry.pos, AVSEEK_FLAG_BYTE) < 0)
+    return false;
+
+  m_seekToKeyFrame = true;
+  m_currentPts = ConvertTimestamp(entry.pts, timeBase.den, timeBase.num);
+
+  CLog::Log(LOGDEBUG, "{} - seeking to keyframe at byte {} from the seek index", __FUNCTION__,
+            entry.pos);
+  return true;
+}
+
 void CDVDDemuxFFmpeg::UpdateCurrentPTS()
 {
   m_currentPts = DVD_NOPTS_VALUE;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "DemuxSeekIndex.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
@@ -119,6 +120,8 @@ protected:
   friend class CDemuxStreamVideoFFmpeg;
   friend class CDemuxStreamSubtitleFFmpeg;
 
+  bool OpenInput(const std::shared_ptr<CDVDInputStream>& pInput, bool fileinfo);
+  bool ReopenWithoutProbeCache(const std::string& strFile, bool fileinfo);
   CDemuxStream* AddStream(int streamIdx);
   void AddStream(int streamIdx, CDemuxStream* stream);
   void CreateStreams(unsigned int program = UINT_MAX);
@@ -131,6 +134,9 @@ protected:
   AVDictionary* GetFFMpegOptionsFromInput();
   double ConvertTimestamp(int64_t pts, int den, int num);
   void UpdateCurrentPTS();
+  std::string GetSeekIndexKey();
+  void OpenSeekIndex();
+  bool SeekIndex(int64_t seekPts, bool backwards);
   bool IsProgramChange();
   unsigned int HLSSelectProgram();
 
@@ -170,10 +176,18 @@ protected:
 
   bool m_streaminfo;
   bool m_reopen = false;
+  bool m_probeCached = false; ///< opened with cached probe results
+  bool m_probeCacheFailed = false; ///< cached probe results didn't match, don't use them again
   bool m_checkTransportStream;
   int m_displayTime = 0;
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  CDemuxSeekIndex m_seekIndex;
+  std::string m_seekIndexKey; ///< key of the index, empty if the input isn't indexed
+  int64_t m_seekIndexSize = 0; ///< size of the input when it was opened
+  int64_t m_seekIndexTime = 0; ///< modification time of the input, 0 if unknown
+  int m_seekIndexStream = -1; ///< video stream whose keyframes are indexed
 };
 
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxCacheFolder.h"
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "XBDateTime.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/Digest.h"
+#include "utils/JobManager.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <vector>
+
+using KODI::UTILITY::CDigest;
+
+CDemuxCacheFolder::CDemuxCacheFolder(const std::string& name,
+                                     const std::string& extension,
+                                     size_t maxEntries,
+                                     int maxAgeDays)
+  : m_name(name), m_extension(extension), m_maxEntries(maxEntries), m_maxAgeDays(maxAgeDays)
+{
+}
+
+std::string CDemuxCacheFolder::GetCacheFile(const std::string& path) const
+{
+  return URIUtils::AddFileToFolder(GetFolder(),
+                                   CDigest::Calculate(CDigest::Type::MD5, path) + m_extension);
+}
+
+bool CDemuxCacheFolder::Write(const std::string& cacheFile, const std::string& data)
+{
+  XFILE::CFile file;
+  if (!file.OpenForWrite(cacheFile, true))
+  {
+    if (!XFILE::CDirectory::Create(URIUtils::GetDirectory(cacheFile)) ||
+        !file.OpenForWrite(cacheFile, true))
+    {
+      CLog::Log(LOGERROR, "CDemuxCacheFolder::{} - Unable to write {}", __FUNCTION__, cacheFile);
+      return false;
+    }
+  }
+
+  if (file.Write(data.c_str(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    file.Close();
+    XFILE::CFile::Delete(cacheFile);
+    return false;
+  }
+
+  if (!m_pruneScheduled.exchange(true))
+  {
+    CJobManager::GetInstance().Submit([this]() { Prune(CDateTime::GetCurrentDateTime()); },
+                                      CJob::PRIORITY_LOW_PAUSABLE);
+  }
+
+  return true;
+}
+
+size_t CDemuxCacheFolder::Prune(const CDateTime& now) const
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(GetFolder(), items, m_extension,
+                                       XFILE::DIR_FLAG_NO_FILE_DIRS | XFILE::DIR_FLAG_BYPASS_CACHE))
+    return 0;
+
+  std::vector<CFileItemPtr> entries;
+  for (const auto& item : items)
+  {
+    if (!item->m_bIsFolder)
+      entries.emplace_back(item);
+  }
+
+  // newest first
+  std::sort(entries.begin(), entries.end(), [](const CFileItemPtr& a, const CFileItemPtr& b) {
+    return a->m_dateTime > b->m_dateTime;
+  });
+
+  size_t removed = 0;
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    const CDateTime& written = entries[i]->m_dateTime;
+    if (i < m_maxEntries && (!written.IsValid() || (now - written).GetDays() < m_maxAgeDays))
+      continue;
+
+    if (XFILE::CFile::Delete(entries[i]->GetPath()))
+      removed++;
+  }
+
+  if (removed > 0)
+    CLog::Log(LOGDEBUG, "CDemuxCacheFolder::{} - removed {} of {} entries from {}", __FUNCTION__,
+              removed, entries.size(), m_name);
+
+  return removed;
+}
+
+bool CDemuxCacheFolder::GetFileInfo(const std::string& path,
+                                    int64_t& size,
+                                    int64_t& modificationTime)
+{
+  struct __stat64 st;
+  if (XFILE::CFile::Stat(path, &st) != 0)
+    return false;
+
+  size = st.st_size;
+  modificationTime = st.st_mtime;
+  return size > 0;
+}
+
+std::string CDemuxCacheFolder::GetFolder() const
+{
+  return URIUtils::AddFileToFolder(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cachePath, m_name);
+}
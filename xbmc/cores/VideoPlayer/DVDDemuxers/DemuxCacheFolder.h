@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class CDateTime;
+
+/*!
+ * \brief Folder below the cache path with one file per played file
+ *
+ * Used by the probe cache and the seek index. Files are named after the
+ * digest of the path they belong to and are checked against the size and
+ * modification time of that file when they are read.
+ *
+ * Nothing removes the entries of files that are deleted or never played
+ * again, so the folder is pruned once per session after it is first
+ * written: entries that weren't written for a while are removed, and the
+ * oldest ones when there are too many.
+ */
+class CDemuxCacheFolder
+{
+public:
+  /*!
+   * \param name Name of the folder in the cache path
+   * \param extension Extension of the entries, including the dot
+   * \param maxEntries Number of entries that are kept at most
+   * \param maxAgeDays Entries that weren't written for longer are removed
+   */
+  CDemuxCacheFolder(const std::string& name,
+                    const std::string& extension,
+                    size_t maxEntries,
+                    int maxAgeDays);
+
+  /*!
+   * \brief Get the entry of a file
+   */
+  std::string GetCacheFile(const std::string& path) const;
+
+  /*!
+   * \brief Write an entry, and prune the folder in the background once per session
+   */
+  bool Write(const std::string& cacheFile, const std::string& data);
+
+  /*!
+   * \brief Remove old entries, and the oldest ones beyond the limit
+   *
+   * \return The number of entries that were removed
+   */
+  size_t Prune(const CDateTime& now) const;
+
+  /*!
+   * \brief Get the size and modification time of a played file
+   */
+  static bool GetFileInfo(const std::string& path, int64_t& size, int64_t& modificationTime);
+
+private:
+  std::string GetFolder() const;
+
+  const std::string m_name;
+  const std::string m_extension;
+  const size_t m_maxEntries;
+  const int m_maxAgeDays;
+  std::atomic<bool> m_pruneScheduled{false};
+};
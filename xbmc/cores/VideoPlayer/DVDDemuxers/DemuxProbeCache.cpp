@@ -0,0 +1,348 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxProbeCache.h"
+
+#include "DemuxCacheFolder.h"
+#include "URL.h"
+#include "filesystem/File.h"
+#include "utils/Base64.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <string.h>
+
+namespace
+{
+// Bump when the stored fields change, older entries are ignored
+constexpr int CACHE_VERSION = 1;
+
+// An entry is a few KB, files that weren't probed again for months are likely gone
+CDemuxCacheFolder cacheFolder("probecache", ".json", 2000, 90);
+
+void SerializeRational(const AVRational& rational, CVariant& value)
+{
+  value = CVariant(CVariant::VariantTypeArray);
+  value.push_back(rational.num);
+  value.push_back(rational.den);
+}
+
+AVRational DeserializeRational(const CVariant& value)
+{
+  if (!value.isArray() || value.size() != 2)
+    return {0, 1};
+
+  return {static_cast<int>(value[0].asInteger()), static_cast<int>(value[1].asInteger(1))};
+}
+} // namespace
+
+bool CDemuxProbeCache::Lookup(const std::string& path, Entry& entry)
+{
+  int64_t size, modificationTime;
+  if (!CDemuxCacheFolder::GetFileInfo(path, size, modificationTime))
+    return false;
+
+  XFILE::CFile file;
+  XFILE::auto_buffer buffer;
+  if (file.LoadFile(cacheFolder.GetCacheFile(path), buffer) <= 0)
+    return false;
+
+  CVariant value;
+  if (!CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), value))
+    return false;
+
+  if (value["path"].asString() != path || !Deserialize(value, entry))
+    return false;
+
+  if (entry.fileSize != size || entry.modificationTime != modificationTime)
+  {
+    CLog::Log(LOGDEBUG, "CDemuxProbeCache::{} - {} changed since it was probed", __FUNCTION__,
+              CURL::GetRedacted(path));
+    Remove(path);
+    return false;
+  }
+
+  return true;
+}
+
+void CDemuxProbeCache::Store(const std::string& path, const AVFormatContext* context)
+{
+  if (!CanCache(context))
+    return;
+
+  Entry entry = FromFormatContext(context);
+  if (!CDemuxCacheFolder::GetFileInfo(path, entry.fileSize, entry.modificationTime))
+    return;
+
+  CVariant value;
+  Serialize(entry, value);
+  value["path"] = path;
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(value, json, true))
+    return;
+
+  cacheFolder.Write(cacheFolder.GetCacheFile(path), json);
+}
+
+void CDemuxProbeCache::Remove(const std::string& path)
+{
+  XFILE::CFile::Delete(cacheFolder.GetCacheFile(path));
+}
+
+bool CDemuxProbeCache::CanCache(const AVFormatContext* context)
+{
+  if (!context || !context->iformat || !context->iformat->name || context->nb_streams == 0)
+    return false;
+
+  // streams are only known after reading packets
+  if (context->ctx_flags & AVFMTCTX_NOHEADER)
+    return false;
+
+  return strcmp(context->iformat->name, "mpegts") != 0 &&
+         strcmp(context->iformat->name, "wav") != 0;
+}
+
+CDemuxProbeCache::Entry CDemuxProbeCache::FromFormatContext(const AVFormatContext* context)
+{
+  Entry entry;
+  entry.format = context->iformat->name;
+  entry.startTime = context->start_time;
+  entry.duration = context->duration;
+  entry.bitRate = context->bit_rate;
+
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    const AVStream* stream = context->streams[i];
+    const AVCodecParameters* codecpar = stream->codecpar;
+
+    StreamInfo info;
+    info.codecType = codecpar->codec_type;
+    info.codecId = codecpar->codec_id;
+    info.codecTag = codecpar->codec_tag;
+    if (codecpar->extradata && codecpar->extradata_size > 0)
+      info.extraData.assign(reinterpret_cast<const char*>(codecpar->extradata),
+                            codecpar->extradata_size);
+    info.format = codecpar->format;
+    info.bitRate = codecpar->bit_rate;
+    info.bitsPerCodedSample = codecpar->bits_per_coded_sample;
+    info.bitsPerRawSample = codecpar->bits_per_raw_sample;
+    info.profile = codecpar->profile;
+    info.level = codecpar->level;
+    info.width = codecpar->width;
+    info.height = codecpar->height;
+    info.sampleAspectRatio = codecpar->sample_aspect_ratio;
+    info.fieldOrder = codecpar->field_order;
+    info.colorRange = codecpar->color_range;
+    info.colorPrimaries = codecpar->color_primaries;
+    info.colorTrc = codecpar->color_trc;
+    info.colorSpace = codecpar->color_space;
+    info.chromaLocation = codecpar->chroma_location;
+    info.videoDelay = codecpar->video_delay;
+    info.channelLayout = codecpar->channel_layout;
+    info.channels = codecpar->channels;
+    info.sampleRate = codecpar->sample_rate;
+    info.blockAlign = codecpar->block_align;
+    info.frameSize = codecpar->frame_size;
+    info.initialPadding = codecpar->initial_padding;
+    info.rFrameRate = stream->r_frame_rate;
+    info.avgFrameRate = stream->avg_frame_rate;
+    info.startTime = stream->start_time;
+    info.duration = stream->duration;
+    info.codecInfoFrames = stream->codec_info_nb_frames;
+
+    entry.streams.push_back(std::move(info));
+  }
+
+  return entry;
+}
+
+bool CDemuxProbeCache::Apply(const Entry& entry, AVFormatContext* context)
+{
+  if (!context || context->nb_streams != entry.streams.size())
+    return false;
+
+  // the header must describe the same streams before anything is changed
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    const AVCodecParameters* codecpar = context->streams[i]->codecpar;
+    const StreamInfo& info = entry.streams[i];
+
+    if (codecpar->codec_type != info.codecType || codecpar->codec_id != info.codecId)
+      return false;
+
+    if (info.codecType == AVMEDIA_TYPE_VIDEO && (info.width <= 0 || info.height <= 0))
+      return false;
+    if (info.codecType == AVMEDIA_TYPE_AUDIO && (info.sampleRate <= 0 || info.channels <= 0))
+      return false;
+  }
+
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    AVStream* stream = context->streams[i];
+    AVCodecParameters* codecpar = stream->codecpar;
+    const StreamInfo& info = entry.streams[i];
+
+    if (codecpar->extradata_size == 0 && !info.extraData.empty())
+    {
+      codecpar->extradata = static_cast<uint8_t*>(
+          av_mallocz(info.extraData.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+      if (codecpar->extradata)
+      {
+        memcpy(codecpar->extradata, info.extraData.data(), info.extraData.size());
+        codecpar->extradata_size = static_cast<int>(info.extraData.size());
+      }
+    }
+
+    codecpar->codec_tag = info.codecTag;
+    codecpar->format = info.format;
+    codecpar->bit_rate = info.bitRate;
+    codecpar->bits_per_coded_sample = info.bitsPerCodedSample;
+    codecpar->bits_per_raw_sample = info.bitsPerRawSample;
+    codecpar->profile = info.profile;
+    codecpar->level = info.level;
+    codecpar->width = info.width;
+    codecpar->height = info.height;
+    codecpar->sample_aspect_ratio = info.sampleAspectRatio;
+    codecpar->field_order = static_cast<AVFieldOrder>(info.fieldOrder);
+    codecpar->color_range = static_cast<AVColorRange>(info.colorRange);
+    codecpar->color_primaries = static_cast<AVColorPrimaries>(info.colorPrimaries);
+    codecpar->color_trc = static_cast<AVColorTransferCharacteristic>(info.colorTrc);
+    codecpar->color_space = static_cast<AVColorSpace>(info.colorSpace);
+    codecpar->chroma_location = static_cast<AVChromaLocation>(info.chromaLocation);
+    codecpar->video_delay = info.videoDelay;
+    codecpar->channel_layout = info.channelLayout;
+    codecpar->channels = info.channels;
+    codecpar->sample_rate = info.sampleRate;
+    codecpar->block_align = info.blockAlign;
+    codecpar->frame_size = info.frameSize;
+    codecpar->initial_padding = info.initialPadding;
+
+    stream->r_frame_rate = info.rFrameRate;
+    stream->avg_frame_rate = info.avgFrameRate;
+    stream->start_time = info.startTime;
+    stream->duration = info.duration;
+    stream->codec_info_nb_frames = info.codecInfoFrames;
+  }
+
+  context->start_time = entry.startTime;
+  context->duration = entry.duration;
+  context->bit_rate = entry.bitRate;
+
+  return true;
+}
+
+void CDemuxProbeCache::Serialize(const Entry& entry, CVariant& value)
+{
+  value = CVariant(CVariant::VariantTypeObject);
+  value["version"] = CACHE_VERSION;
+  value["format"] = entry.format;
+  value["filesize"] = entry.fileSize;
+  value["mtime"] = entry.modificationTime;
+  value["starttime"] = entry.startTime;
+  value["duration"] = entry.duration;
+  value["bitrate"] = entry.bitRate;
+  value["streams"] = CVariant(CVariant::VariantTypeArray);
+
+  for (const StreamInfo& info : entry.streams)
+  {
+    CVariant stream(CVariant::VariantTypeObject);
+    stream["codectype"] = info.codecType;
+    stream["codecid"] = info.codecId;
+    stream["codectag"] = info.codecTag;
+    stream["extradata"] = Base64::Encode(info.extraData);
+    stream["format"] = info.format;
+    stream["bitrate"] = info.bitRate;
+    stream["bitspercodedsample"] = info.bitsPerCodedSample;
+    stream["bitsperrawsample"] = info.bitsPerRawSample;
+    stream["profile"] = info.profile;
+    stream["level"] = info.level;
+    stream["width"] = info.width;
+    stream["height"] = info.height;
+    SerializeRational(info.sampleAspectRatio, stream["sampleaspectratio"]);
+    stream["fieldorder"] = info.fieldOrder;
+    stream["colorrange"] = info.colorRange;
+    stream["colorprimaries"] = info.colorPrimaries;
+    stream["colortrc"] = info.colorTrc;
+    stream["colorspace"] = info.colorSpace;
+    stream["chromalocation"] = info.chromaLocation;
+    stream["videodelay"] = info.videoDelay;
+    stream["channellayout"] = info.channelLayout;
+    stream["channels"] = info.channels;
+    stream["samplerate"] = info.sampleRate;
+    stream["blockalign"] = info.blockAlign;
+    stream["framesize"] = info.frameSize;
+    stream["initialpadding"] = info.initialPadding;
+    SerializeRational(info.rFrameRate, stream["rframerate"]);
+    SerializeRational(info.avgFrameRate, stream["avgframerate"]);
+    stream["starttime"] = info.startTime;
+    stream["duration"] = info.duration;
+    stream["codecinfoframes"] = info.codecInfoFrames;
+
+    value["streams"].push_back(stream);
+  }
+}
+
+bool CDemuxProbeCache::Deserialize(const CVariant& value, Entry& entry)
+{
+  if (!value.isObject() || value["version"].asInteger() != CACHE_VERSION ||
+      !value["streams"].isArray())
+    return false;
+
+  entry.format = value["format"].asString();
+  entry.fileSize = value["filesize"].asInteger();
+  entry.modificationTime = value["mtime"].asInteger();
+  entry.startTime = value["starttime"].asInteger(AV_NOPTS_VALUE);
+  entry.duration = value["duration"].asInteger(AV_NOPTS_VALUE);
+  entry.bitRate = value["bitrate"].asInteger();
+  entry.streams.clear();
+
+  for (auto it = value["streams"].begin_array(); it != value["streams"].end_array(); ++it)
+  {
+    const CVariant& stream = *it;
+
+    StreamInfo info;
+    info.codecType = static_cast<int>(stream["codectype"].asInteger(AVMEDIA_TYPE_UNKNOWN));
+    info.codecId = static_cast<int>(stream["codecid"].asInteger(AV_CODEC_ID_NONE));
+    info.codecTag = static_cast<uint32_t>(stream["codectag"].asUnsignedInteger());
+    info.extraData = Base64::Decode(stream["extradata"].asString());
+    info.format = static_cast<int>(stream["format"].asInteger(-1));
+    info.bitRate = stream["bitrate"].asInteger();
+    info.bitsPerCodedSample = static_cast<int>(stream["bitspercodedsample"].asInteger());
+    info.bitsPerRawSample = static_cast<int>(stream["bitsperrawsample"].asInteger());
+    info.profile = static_cast<int>(stream["profile"].asInteger(FF_PROFILE_UNKNOWN));
+    info.level = static_cast<int>(stream["level"].asInteger(FF_LEVEL_UNKNOWN));
+    info.width = static_cast<int>(stream["width"].asInteger());
+    info.height = static_cast<int>(stream["height"].asInteger());
+    info.sampleAspectRatio = DeserializeRational(stream["sampleaspectratio"]);
+    info.fieldOrder = static_cast<int>(stream["fieldorder"].asInteger(AV_FIELD_UNKNOWN));
+    info.colorRange = static_cast<int>(stream["colorrange"].asInteger());
+    info.colorPrimaries = static_cast<int>(stream["colorprimaries"].asInteger(AVCOL_PRI_UNSPECIFIED));
+    info.colorTrc = static_cast<int>(stream["colortrc"].asInteger(AVCOL_TRC_UNSPECIFIED));
+    info.colorSpace = static_cast<int>(stream["colorspace"].asInteger(AVCOL_SPC_UNSPECIFIED));
+    info.chromaLocation = static_cast<int>(stream["chromalocation"].asInteger());
+    info.videoDelay = static_cast<int>(stream["videodelay"].asInteger());
+    info.channelLayout = stream["channellayout"].asUnsignedInteger();
+    info.channels = static_cast<int>(stream["channels"].asInteger());
+    info.sampleRate = static_cast<int>(stream["samplerate"].asInteger());
+    info.blockAlign = static_cast<int>(stream["blockalign"].asInteger());
+    info.frameSize = static_cast<int>(stream["framesize"].asInteger());
+    info.initialPadding = static_cast<int>(stream["initialpadding"].asInteger());
+    info.rFrameRate = DeserializeRational(stream["rframerate"]);
+    info.avgFrameRate = DeserializeRational(stream["avgframerate"]);
+    info.startTime = stream["starttime"].asInteger(AV_NOPTS_VALUE);
+    info.duration = stream["duration"].asInteger(AV_NOPTS_VALUE);
+    info.codecInfoFrames = static_cast<int>(stream["codecinfoframes"].asInteger());
+
+    entry.streams.push_back(std::move(info));
+  }
+
+  return !entry.format.empty() && !entry.streams.empty();
+}
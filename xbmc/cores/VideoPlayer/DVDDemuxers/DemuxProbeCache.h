@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+class CVariant;
+
+/*!
+ * \brief Cache of the results of probing a file with FFmpeg
+ *
+ * Probing the container format and the codec parameters of all streams
+ * reads and decodes the start of a file, which takes long over network
+ * shares. After a local file or a file on a network share has been probed
+ * once, the container format, stream layout and codec parameters are
+ * stored, keyed by the path, size and modification time of the file.
+ * Internet streams aren't cached.
+ *
+ * When the file is opened again, the demuxer opens the stored format
+ * directly and the header of the file must match the stored stream layout
+ * before the stored parameters are used. Otherwise the entry is dropped and
+ * the file is probed as usual.
+ */
+class CDemuxProbeCache
+{
+public:
+  struct StreamInfo
+  {
+    int codecType = AVMEDIA_TYPE_UNKNOWN;
+    int codecId = AV_CODEC_ID_NONE;
+    uint32_t codecTag = 0;
+    std::string extraData;
+    int format = -1;
+    int64_t bitRate = 0;
+    int bitsPerCodedSample = 0;
+    int bitsPerRawSample = 0;
+    int profile = FF_PROFILE_UNKNOWN;
+    int level = FF_LEVEL_UNKNOWN;
+    int width = 0;
+    int height = 0;
+    AVRational sampleAspectRatio = {0, 1};
+    int fieldOrder = AV_FIELD_UNKNOWN;
+    int colorRange = AVCOL_RANGE_UNSPECIFIED;
+    int colorPrimaries = AVCOL_PRI_UNSPECIFIED;
+    int colorTrc = AVCOL_TRC_UNSPECIFIED;
+    int colorSpace = AVCOL_SPC_UNSPECIFIED;
+    int chromaLocation = AVCHROMA_LOC_UNSPECIFIED;
+    int videoDelay = 0;
+    uint64_t channelLayout = 0;
+    int channels = 0;
+    int sampleRate = 0;
+    int blockAlign = 0;
+    int frameSize = 0;
+    int initialPadding = 0;
+    AVRational rFrameRate = {0, 1};
+    AVRational avgFrameRate = {0, 1};
+    int64_t startTime = AV_NOPTS_VALUE;
+    int64_t duration = AV_NOPTS_VALUE;
+    int codecInfoFrames = 0;
+  };
+
+  struct Entry
+  {
+    std::string format;
+    int64_t fileSize = 0;
+    int64_t modificationTime = 0;
+    int64_t startTime = AV_NOPTS_VALUE;
+    int64_t duration = AV_NOPTS_VALUE;
+    int64_t bitRate = 0;
+    std::vector<StreamInfo> streams;
+  };
+
+  /*!
+   * \brief Get the entry of a file, if the file didn't change since it was stored
+   */
+  static bool Lookup(const std::string& path, Entry& entry);
+
+  /*!
+   * \brief Store the probe results of a file
+   */
+  static void Store(const std::string& path, const AVFormatContext* context);
+
+  /*!
+   * \brief Remove the entry of a file
+   */
+  static void Remove(const std::string& path);
+
+  /*!
+   * \brief Check if the probe results of a format context can be reused
+   *
+   * Formats without a header that describes all streams, and formats that the
+   * demuxer probes further itself (mpegts, wav), are never cached.
+   */
+  static bool CanCache(const AVFormatContext* context);
+
+  /*!
+   * \brief Get the probe results of a probed format context
+   */
+  static Entry FromFormatContext(const AVFormatContext* context);
+
+  /*!
+   * \brief Apply stored probe results to a freshly opened format context
+   *
+   * \return false if the streams of the context don't match the entry, in which
+   * case the context must be probed as usual
+   */
+  static bool Apply(const Entry& entry, AVFormatContext* context);
+
+  static void Serialize(const Entry& entry, CVariant& value);
+  static bool Deserialize(const CVariant& value, Entry& entry);
+};
@@ -0,0 +1,321 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxSeekIndex.h"
+
+#include "DemuxCacheFolder.h"
+#include "URL.h"
+#include "filesystem/File.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr char CACHE_MAGIC[] = {'K', 'S', 'I', 'X'};
+
+// Bump when the format changes, older indexes are ignored
+constexpr uint64_t CACHE_VERSION = 1;
+
+// An index takes tens of KB for a long recording
+CDemuxCacheFolder cacheFolder("seekindex", ".idx", 500, 90);
+
+uint64_t ZigZag(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void WriteVarInt(std::string& data, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    data.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<char>(value));
+}
+
+bool ReadVarInt(const std::string& data, size_t& offset, uint64_t& value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64 && offset < data.size(); shift += 7)
+  {
+    const uint8_t byte = static_cast<uint8_t>(data[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+} // namespace
+
+void CDemuxSeekIndex::Reset(int timeBaseNum, int timeBaseDen)
+{
+  m_entries.clear();
+  m_timeBaseNum = timeBaseNum;
+  m_timeBaseDen = timeBaseDen;
+  m_fileSize = 0;
+  m_modificationTime = 0;
+  m_last = -1;
+  m_changed = false;
+}
+
+bool CDemuxSeekIndex::Load(const std::string& key,
+                           int64_t size,
+                           int64_t modificationTime,
+                           int timeBaseNum,
+                           int timeBaseDen)
+{
+  Reset(timeBaseNum, timeBaseDen);
+
+  if (size <= 0)
+    return false;
+
+  XFILE::CFile file;
+  XFILE::auto_buffer buffer;
+  if (file.LoadFile(cacheFolder.GetCacheFile(key), buffer) <= 0)
+    return false;
+
+  if (!Deserialize(std::string(buffer.get(), buffer.size())))
+  {
+    Reset(timeBaseNum, timeBaseDen);
+    return false;
+  }
+
+  if (m_fileSize != size || m_modificationTime != modificationTime)
+  {
+    CLog::Log(LOGDEBUG, "CDemuxSeekIndex::{} - {} changed since it was indexed", __FUNCTION__,
+              CURL::GetRedacted(key));
+    Remove(key);
+    Reset(timeBaseNum, timeBaseDen);
+    return false;
+  }
+
+  if (m_timeBaseNum != timeBaseNum || m_timeBaseDen != timeBaseDen)
+  {
+    Reset(timeBaseNum, timeBaseDen);
+    return false;
+  }
+
+  return true;
+}
+
+void CDemuxSeekIndex::Save(const std::string& key, int64_t size, int64_t modificationTime)
+{
+  if (!m_changed || m_entries.empty())
+    return;
+
+  m_changed = false;
+
+  if (size <= 0)
+    return;
+
+  // another player, e.g. the thumbnail extractor, may have stored keyframes of the same file
+  // since the index was loaded
+  const std::string cacheFile = cacheFolder.GetCacheFile(key);
+  XFILE::CFile file;
+  XFILE::auto_buffer buffer;
+  CDemuxSeekIndex stored;
+  if (file.LoadFile(cacheFile, buffer) > 0 &&
+      stored.Deserialize(std::string(buffer.get(), buffer.size())) &&
+      stored.m_fileSize == size && stored.m_modificationTime == modificationTime &&
+      stored.m_timeBaseNum == m_timeBaseNum && stored.m_timeBaseDen == m_timeBaseDen)
+    Merge(stored);
+
+  m_fileSize = size;
+  m_modificationTime = modificationTime;
+  cacheFolder.Write(cacheFile, Serialize());
+}
+
+void CDemuxSeekIndex::Merge(const CDemuxSeekIndex& other)
+{
+  std::vector<Entry> entries;
+  entries.reserve(m_entries.size() + other.m_entries.size());
+
+  auto it = m_entries.cbegin();
+  auto otherIt = other.m_entries.cbegin();
+  const Entry* previous = nullptr;
+  const Entry* otherPrevious = nullptr;
+
+  while (it != m_entries.cend() || otherIt != other.m_entries.cend())
+  {
+    const bool own =
+        it != m_entries.cend() && (otherIt == other.m_entries.cend() || it->pts <= otherIt->pts);
+    const bool others = otherIt != other.m_entries.cend() &&
+                        (it == m_entries.cend() || otherIt->pts <= it->pts);
+
+    // an entry only follows the one before it if nothing of the other index came in between
+    const int64_t* last = entries.empty() ? nullptr : &entries.back().pts;
+    Entry entry = own ? *it : *otherIt;
+    entry.continuous =
+        last && ((own && it->continuous && previous && previous->pts == *last) ||
+                 (others && otherIt->continuous && otherPrevious && otherPrevious->pts == *last));
+    entries.push_back(entry);
+
+    if (own)
+      previous = &*it++;
+    if (others)
+      otherPrevious = &*otherIt++;
+  }
+
+  m_entries = std::move(entries);
+  m_last = -1;
+}
+
+void CDemuxSeekIndex::Add(int64_t pts, int64_t pos)
+{
+  if (pos < 0)
+    return;
+
+  // timestamps went back, e.g. at a discontinuity of a recording
+  if (m_last >= 0 && pts <= m_entries[m_last].pts)
+    m_last = -1;
+
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), pts,
+                             [](const Entry& entry, int64_t value) { return entry.pts < value; });
+  const int index = static_cast<int>(it - m_entries.begin());
+  const bool continuous = m_last >= 0 && m_last == index - 1;
+
+  if (it != m_entries.end() && it->pts == pts)
+  {
+    if (continuous && !it->continuous)
+    {
+      it->continuous = true;
+      m_changed = true;
+    }
+  }
+  else
+  {
+    // a keyframe between two entries, the next one doesn't follow the previous one
+    if (it != m_entries.end())
+      it->continuous = false;
+
+    Entry entry;
+    entry.pts = pts;
+    entry.pos = pos;
+    entry.continuous = continuous;
+    m_entries.insert(it, entry);
+    m_changed = true;
+  }
+
+  m_last = index;
+}
+
+bool CDemuxSeekIndex::Find(int64_t pts, bool backwards, Entry& entry) const
+{
+  if (backwards)
+  {
+    auto next =
+        std::upper_bound(m_entries.begin(), m_entries.end(), pts,
+                         [](int64_t value, const Entry& entry) { return value < entry.pts; });
+    if (next == m_entries.begin())
+      return false;
+
+    // the first keyframe after the time must follow the last one before it
+    auto previous = next - 1;
+    if (previous->pts != pts && (next == m_entries.end() || !next->continuous))
+      return false;
+
+    entry = *previous;
+    return true;
+  }
+
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), pts,
+                             [](const Entry& entry, int64_t value) { return entry.pts < value; });
+  if (it == m_entries.end())
+    return false;
+
+  if (it->pts != pts && (it == m_entries.begin() || !it->continuous))
+    return false;
+
+  entry = *it;
+  return true;
+}
+
+std::string CDemuxSeekIndex::Serialize() const
+{
+  std::string data(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  data.reserve(sizeof(CACHE_MAGIC) + 32 + m_entries.size() * 6);
+
+  WriteVarInt(data, CACHE_VERSION);
+  WriteVarInt(data, ZigZag(m_fileSize));
+  WriteVarInt(data, ZigZag(m_modificationTime));
+  WriteVarInt(data, ZigZag(m_timeBaseNum));
+  WriteVarInt(data, ZigZag(m_timeBaseDen));
+  WriteVarInt(data, m_entries.size());
+
+  int64_t pts = 0;
+  int64_t pos = 0;
+  for (const Entry& entry : m_entries)
+  {
+    WriteVarInt(data, ZigZag(entry.pts - pts) << 1 | (entry.continuous ? 1 : 0));
+    WriteVarInt(data, ZigZag(entry.pos - pos));
+    pts = entry.pts;
+    pos = entry.pos;
+  }
+
+  return data;
+}
+
+bool CDemuxSeekIndex::Deserialize(const std::string& data)
+{
+  if (data.size() < sizeof(CACHE_MAGIC) ||
+      data.compare(0, sizeof(CACHE_MAGIC), CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+    return false;
+
+  size_t offset = sizeof(CACHE_MAGIC);
+  uint64_t version, fileSize, modificationTime, timeBaseNum, timeBaseDen, count;
+  if (!ReadVarInt(data, offset, version) || version != CACHE_VERSION ||
+      !ReadVarInt(data, offset, fileSize) || !ReadVarInt(data, offset, modificationTime) ||
+      !ReadVarInt(data, offset, timeBaseNum) || !ReadVarInt(data, offset, timeBaseDen) ||
+      !ReadVarInt(data, offset, count) || count > data.size())
+    return false;
+
+  std::vector<Entry> entries;
+  entries.reserve(count);
+
+  int64_t pts = 0;
+  int64_t pos = 0;
+  for (uint64_t i = 0; i < count; i++)
+  {
+    uint64_t ptsDelta, posDelta;
+    if (!ReadVarInt(data, offset, ptsDelta) || !ReadVarInt(data, offset, posDelta))
+      return false;
+
+    Entry entry;
+    entry.pts = pts + UnZigZag(ptsDelta >> 1);
+    entry.pos = pos + UnZigZag(posDelta);
+    entry.continuous = (ptsDelta & 1) && !entries.empty();
+
+    if (!entries.empty() && entry.pts <= pts)
+      return false;
+
+    entries.push_back(entry);
+    pts = entry.pts;
+    pos = entry.pos;
+  }
+
+  m_entries = std::move(entries);
+  m_fileSize = UnZigZag(fileSize);
+  m_modificationTime = UnZigZag(modificationTime);
+  m_timeBaseNum = static_cast<int>(UnZigZag(timeBaseNum));
+  m_timeBaseDen = static_cast<int>(UnZigZag(timeBaseDen));
+  m_last = -1;
+  m_changed = false;
+  return true;
+}
+
+void CDemuxSeekIndex::Remove(const std::string& path)
+{
+  XFILE::CFile::Delete(cacheFolder.GetCacheFile(path));
+}
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Persistent index of the keyframes of a file
+ *
+ * Formats without an index of their own, e.g. MPEG-TS and MPEG-PS, are
+ * seeked by bisecting the file, which reads several times from large
+ * recordings before the demuxer finds the keyframe. While a file is played,
+ * the timestamp and byte position of every keyframe of its video stream are
+ * added to the index. Later seeks to a time that was played before jump to
+ * the keyframe directly.
+ *
+ * Keyframes are only known to be adjacent when they were read one after the
+ * other, so an entry records if it was read continuously after the previous
+ * one. A time is only found between two such entries.
+ *
+ * The index is stored next to the probe cache in a compact binary file,
+ * keyed by the path, size and modification time of the file. Sources that
+ * aren't files, e.g. PVR recordings, pass a key of their own that stays the
+ * same across sessions instead of the path.
+ */
+class CDemuxSeekIndex
+{
+public:
+  struct Entry
+  {
+    int64_t pts = 0; ///< in the time base of the index
+    int64_t pos = 0; ///< byte position of the packet
+    bool continuous = false; ///< read right after the previous entry
+  };
+
+  /*!
+   * \brief Start an empty index
+   */
+  void Reset(int timeBaseNum, int timeBaseDen);
+
+  /*!
+   * \brief Load the index of a file, if the file didn't change since it was stored
+   *
+   * \param key The path of the file, or a stable key of another source
+   * \param size The current size of the file
+   * \param modificationTime The current modification time of the file, 0 if unknown
+   *
+   * \return false if there is no index or it uses another time base, the
+   * index is empty then
+   */
+  bool Load(const std::string& key,
+            int64_t size,
+            int64_t modificationTime,
+            int timeBaseNum,
+            int timeBaseDen);
+
+  /*!
+   * \brief Store the index of a file if keyframes were added since it was loaded
+   *
+   * The keyframes that were stored for the file in the meantime are merged
+   * into the index first, so that players of the same file don't drop the
+   * keyframes of each other.
+   *
+   * \param key The key the index was loaded with
+   * \param size The current size of the file
+   * \param modificationTime The current modification time of the file, 0 if unknown
+   */
+  void Save(const std::string& key, int64_t size, int64_t modificationTime);
+
+  /*!
+   * \brief Add the keyframes of another index of the same file
+   *
+   * Entries stay continuous only if no keyframe of the other index lies
+   * between them.
+   */
+  void Merge(const CDemuxSeekIndex& other);
+
+  /*!
+   * \brief Add a keyframe that was read from the file
+   */
+  void Add(int64_t pts, int64_t pos);
+
+  /*!
+   * \brief The next keyframe doesn't follow the last one, e.g. after a seek
+   */
+  void Discontinuity() { m_last = -1; }
+
+  /*!
+   * \brief Find the keyframe to seek to
+   *
+   * \param pts The time to seek to, in the time base of the index
+   * \param backwards Find the last keyframe before the time instead of the
+   * first one after it
+   * \return false if the keyframes around the time weren't read
+   */
+  bool Find(int64_t pts, bool backwards, Entry& entry) const;
+
+  bool IsEmpty() const { return m_entries.empty(); }
+  size_t GetSize() const { return m_entries.size(); }
+  bool IsChanged() const { return m_changed; }
+
+  /*!
+   * \brief Encode the entries, timestamps and positions are stored as
+   * variable length differences to the previous entry
+   */
+  std::string Serialize() const;
+  bool Deserialize(const std::string& data);
+
+  static void Remove(const std::string& path);
+
+private:
+  std::vector<Entry> m_entries;
+  int m_timeBaseNum = 0;
+  int m_timeBaseDen = 0;
+  int64_t m_fileSize = 0;
+  int64_t m_modificationTime = 0;
+  int m_last = -1; ///< entry of the last keyframe read
+  bool m_changed = false;
+};
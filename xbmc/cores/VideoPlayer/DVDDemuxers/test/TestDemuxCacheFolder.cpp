@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "cores/VideoPlayer/DVDDemuxers/DemuxCacheFolder.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/URIUtils.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr char FOLDER[] = "TestDemuxCacheFolder";
+
+void WriteEntry(const CDemuxCacheFolder& folder, const std::string& path)
+{
+  const std::string cacheFile = folder.GetCacheFile(path);
+  CDirectory::Create(URIUtils::GetDirectory(cacheFile));
+
+  CFile file;
+  ASSERT_TRUE(file.OpenForWrite(cacheFile, true));
+  EXPECT_EQ(file.Write("entry", 5), 5);
+}
+} // namespace
+
+class TestDemuxCacheFolder : public testing::Test
+{
+protected:
+  TestDemuxCacheFolder() : m_folder(FOLDER, ".test", 2, 30) {}
+
+  void TearDown() override
+  {
+    CDirectory::RemoveRecursive(URIUtils::GetDirectory(m_folder.GetCacheFile("")));
+  }
+
+  CDemuxCacheFolder m_folder;
+};
+
+TEST_F(TestDemuxCacheFolder, Prune)
+{
+  WriteEntry(m_folder, "/media/a.ts");
+  WriteEntry(m_folder, "/media/b.ts");
+  WriteEntry(m_folder, "/media/c.ts");
+
+  // beyond the limit
+  const CDateTime now = CDateTime::GetCurrentDateTime();
+  EXPECT_EQ(m_folder.Prune(now), 1u);
+  EXPECT_EQ(m_folder.Prune(now), 0u);
+
+  // not written for too long
+  EXPECT_EQ(m_folder.Prune(now + CDateTimeSpan(29, 0, 0, 0)), 0u);
+  EXPECT_EQ(m_folder.Prune(now + CDateTimeSpan(31, 0, 0, 0)), 2u);
+
+  EXPECT_FALSE(CFile::Exists(m_folder.GetCacheFile("/media/a.ts")));
+  EXPECT_FALSE(CFile::Exists(m_folder.GetCacheFile("/media/b.ts")));
+  EXPECT_FALSE(CFile::Exists(m_folder.GetCacheFile("/media/c.ts")));
+}
+
+TEST_F(TestDemuxCacheFolder, KeepsOtherFiles)
+{
+  WriteEntry(m_folder, "/media/a.ts");
+
+  const std::string other =
+      URIUtils::AddFileToFolder(URIUtils::GetDirectory(m_folder.GetCacheFile("")), "other.txt");
+  CFile file;
+  ASSERT_TRUE(file.OpenForWrite(other, true));
+  file.Close();
+
+  EXPECT_EQ(m_folder.Prune(CDateTime::GetCurrentDateTime() + CDateTimeSpan(31, 0, 0, 0)), 1u);
+  EXPECT_TRUE(CFile::Exists(other));
+}
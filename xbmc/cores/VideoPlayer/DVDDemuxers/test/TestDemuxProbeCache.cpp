@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxProbeCache.h"
+#include "utils/Variant.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const uint8_t EXTRADATA[] = {0x01, 0x64, 0x00, 0x28, 0xff, 0xe1};
+
+// A format context as it looks after reading the header of a file
+AVFormatContext* CreateContext(const char* format)
+{
+  AVFormatContext* context = avformat_alloc_context();
+  context->iformat = av_find_input_format(format);
+
+  AVStream* video = avformat_new_stream(context, nullptr);
+  video->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
+  video->codecpar->codec_id = AV_CODEC_ID_H264;
+
+  AVStream* audio = avformat_new_stream(context, nullptr);
+  audio->codecpar->codec_type = AVMEDIA_TYPE_AUDIO;
+  audio->codecpar->codec_id = AV_CODEC_ID_AAC;
+
+  return context;
+}
+
+// The same context after probing the streams
+AVFormatContext* CreateProbedContext(const char* format)
+{
+  AVFormatContext* context = CreateContext(format);
+  context->start_time = 0;
+  context->duration = 60 * AV_TIME_BASE;
+  context->bit_rate = 4000000;
+
+  AVStream* video = context->streams[0];
+  video->codecpar->width = 1920;
+  video->codecpar->height = 1080;
+  video->codecpar->profile = FF_PROFILE_H264_HIGH;
+  video->codecpar->level = 40;
+  video->codecpar->format = AV_PIX_FMT_YUV420P;
+  video->codecpar->extradata =
+      static_cast<uint8_t*>(av_mallocz(sizeof(EXTRADATA) + AV_INPUT_BUFFER_PADDING_SIZE));
+  memcpy(video->codecpar->extradata, EXTRADATA, sizeof(EXTRADATA));
+  video->codecpar->extradata_size = sizeof(EXTRADATA);
+  video->avg_frame_rate = {24000, 1001};
+  video->r_frame_rate = {24000, 1001};
+
+  AVStream* audio = context->streams[1];
+  audio->codecpar->sample_rate = 48000;
+  audio->codecpar->channels = 2;
+  audio->codecpar->channel_layout = AV_CH_LAYOUT_STEREO;
+  audio->codecpar->format = AV_SAMPLE_FMT_FLTP;
+  audio->codecpar->frame_size = 1024;
+
+  return context;
+}
+} // namespace
+
+TEST(TestDemuxProbeCache, SerializeRoundTrip)
+{
+  AVFormatContext* context = CreateProbedContext("matroska");
+  const CDemuxProbeCache::Entry entry = CDemuxProbeCache::FromFormatContext(context);
+  avformat_free_context(context);
+
+  CVariant value;
+  CDemuxProbeCache::Serialize(entry, value);
+
+  CDemuxProbeCache::Entry result;
+  ASSERT_TRUE(CDemuxProbeCache::Deserialize(value, result));
+  EXPECT_EQ(result.format, entry.format);
+  EXPECT_EQ(result.duration, entry.duration);
+  EXPECT_EQ(result.bitRate, entry.bitRate);
+  ASSERT_EQ(result.streams.size(), 2u);
+
+  const CDemuxProbeCache::StreamInfo& video = result.streams[0];
+  EXPECT_EQ(video.codecId, AV_CODEC_ID_H264);
+  EXPECT_EQ(video.width, 1920);
+  EXPECT_EQ(video.height, 1080);
+  EXPECT_EQ(video.extraData, std::string(reinterpret_cast<const char*>(EXTRADATA),
+                                         sizeof(EXTRADATA)));
+  EXPECT_EQ(video.avgFrameRate.num, 24000);
+  EXPECT_EQ(video.avgFrameRate.den, 1001);
+
+  const CDemuxProbeCache::StreamInfo& audio = result.streams[1];
+  EXPECT_EQ(audio.codecId, AV_CODEC_ID_AAC);
+  EXPECT_EQ(audio.sampleRate, 48000);
+  EXPECT_EQ(audio.channels, 2);
+  EXPECT_EQ(audio.channelLayout, static_cast<uint64_t>(AV_CH_LAYOUT_STEREO));
+}
+
+TEST(TestDemuxProbeCache, DeserializeInvalid)
+{
+  CDemuxProbeCache::Entry entry;
+  EXPECT_FALSE(CDemuxProbeCache::Deserialize(CVariant(CVariant::VariantTypeObject), entry));
+  EXPECT_FALSE(CDemuxProbeCache::Deserialize(CVariant("matroska"), entry));
+}
+
+TEST(TestDemuxProbeCache, Apply)
+{
+  AVFormatContext* probed = CreateProbedContext("matroska");
+  const CDemuxProbeCache::Entry entry = CDemuxProbeCache::FromFormatContext(probed);
+  avformat_free_context(probed);
+
+  AVFormatContext* context = CreateContext("matroska");
+  ASSERT_TRUE(CDemuxProbeCache::Apply(entry, context));
+
+  const AVCodecParameters* video = context->streams[0]->codecpar;
+  EXPECT_EQ(video->width, 1920);
+  EXPECT_EQ(video->height, 1080);
+  EXPECT_EQ(video->profile, FF_PROFILE_H264_HIGH);
+  ASSERT_EQ(video->extradata_size, static_cast<int>(sizeof(EXTRADATA)));
+  EXPECT_EQ(memcmp(video->extradata, EXTRADATA, sizeof(EXTRADATA)), 0);
+  EXPECT_EQ(context->streams[0]->avg_frame_rate.num, 24000);
+
+  const AVCodecParameters* audio = context->streams[1]->codecpar;
+  EXPECT_EQ(audio->sample_rate, 48000);
+  EXPECT_EQ(audio->channels, 2);
+
+  EXPECT_EQ(context->duration, 60 * AV_TIME_BASE);
+  avformat_free_context(context);
+}
+
+TEST(TestDemuxProbeCache, ApplyMismatch)
+{
+  AVFormatContext* probed = CreateProbedContext("matroska");
+  CDemuxProbeCache::Entry entry = CDemuxProbeCache::FromFormatContext(probed);
+  avformat_free_context(probed);
+
+  AVFormatContext* context = CreateContext("matroska");
+
+  // a different codec in the header
+  CDemuxProbeCache::Entry changed = entry;
+  changed.streams[0].codecId = AV_CODEC_ID_HEVC;
+  EXPECT_FALSE(CDemuxProbeCache::Apply(changed, context));
+
+  // a different number of streams
+  changed = entry;
+  changed.streams.pop_back();
+  EXPECT_FALSE(CDemuxProbeCache::Apply(changed, context));
+
+  // incomplete results
+  changed = entry;
+  changed.streams[1].sampleRate = 0;
+  EXPECT_FALSE(CDemuxProbeCache::Apply(changed, context));
+
+  // nothing is changed when the entry doesn't match
+  EXPECT_EQ(context->streams[0]->codecpar->width, 0);
+  EXPECT_EQ(context->streams[0]->codecpar->extradata_size, 0);
+  avformat_free_context(context);
+}
+
+TEST(TestDemuxProbeCache, CanCache)
+{
+  AVFormatContext* context = CreateProbedContext("matroska");
+  EXPECT_TRUE(CDemuxProbeCache::CanCache(context));
+
+  context->ctx_flags |= AVFMTCTX_NOHEADER;
+  EXPECT_FALSE(CDemuxProbeCache::CanCache(context));
+  avformat_free_context(context);
+
+  context = CreateProbedContext("mpegts");
+  EXPECT_FALSE(CDemuxProbeCache::CanCache(context));
+  avformat_free_context(context);
+}
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxSeekIndex.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Keyframes of a transport stream, one per second in the 90 kHz time base
+constexpr int64_t INTERVAL = 90000;
+constexpr int64_t START = 1234567;
+constexpr int64_t PACKET_SIZE = 188 * 2000;
+
+void Play(CDemuxSeekIndex& index, int first, int count)
+{
+  index.Discontinuity();
+  for (int i = first; i < first + count; i++)
+    index.Add(START + i * INTERVAL, i * PACKET_SIZE);
+}
+} // namespace
+
+TEST(TestDemuxSeekIndex, Find)
+{
+  CDemuxSeekIndex index;
+  index.Reset(1, 90000);
+  Play(index, 0, 10);
+
+  EXPECT_EQ(index.GetSize(), 10u);
+  EXPECT_TRUE(index.IsChanged());
+
+  CDemuxSeekIndex::Entry entry;
+  ASSERT_TRUE(index.Find(START + 4 * INTERVAL + 100, true, entry));
+  EXPECT_EQ(entry.pts, START + 4 * INTERVAL);
+  EXPECT_EQ(entry.pos, 4 * PACKET_SIZE);
+
+  ASSERT_TRUE(index.Find(START + 4 * INTERVAL + 100, false, entry));
+  EXPECT_EQ(entry.pts, START + 5 * INTERVAL);
+
+  // exact keyframes, including the last one
+  ASSERT_TRUE(index.Find(START + 9 * INTERVAL, true, entry));
+  EXPECT_EQ(entry.pos, 9 * PACKET_SIZE);
+  ASSERT_TRUE(index.Find(START, false, entry));
+  EXPECT_EQ(entry.pos, 0);
+
+  // not played yet
+  EXPECT_FALSE(index.Find(START + 9 * INTERVAL + 100, true, entry));
+  EXPECT_FALSE(index.Find(START - 100, false, entry));
+}
+
+TEST(TestDemuxSeekIndex, Gaps)
+{
+  CDemuxSeekIndex index;
+  index.Reset(1, 90000);
+  Play(index, 0, 5);
+  Play(index, 20, 5);
+
+  // the keyframes between the played parts are unknown
+  CDemuxSeekIndex::Entry entry;
+  EXPECT_FALSE(index.Find(START + 10 * INTERVAL, true, entry));
+  EXPECT_FALSE(index.Find(START + 10 * INTERVAL, false, entry));
+  EXPECT_TRUE(index.Find(START + 21 * INTERVAL + 100, true, entry));
+
+  // playing the gap closes it
+  Play(index, 4, 17);
+  EXPECT_EQ(index.GetSize(), 25u);
+  ASSERT_TRUE(index.Find(START + 10 * INTERVAL + 100, true, entry));
+  EXPECT_EQ(entry.pos, 10 * PACKET_SIZE);
+  ASSERT_TRUE(index.Find(START + 4 * INTERVAL + 100, false, entry));
+  EXPECT_EQ(entry.pos, 5 * PACKET_SIZE);
+}
+
+TEST(TestDemuxSeekIndex, Serialize)
+{
+  CDemuxSeekIndex index;
+  index.Reset(1, 90000);
+  Play(index, 0, 1000);
+  Play(index, 2000, 10);
+
+  const std::string data = index.Serialize();
+  // far less than the 16 bytes of a timestamp and a position
+  EXPECT_LT(data.size(), index.GetSize() * 8);
+
+  CDemuxSeekIndex loaded;
+  ASSERT_TRUE(loaded.Deserialize(data));
+  EXPECT_EQ(loaded.GetSize(), index.GetSize());
+  EXPECT_FALSE(loaded.IsChanged());
+
+  for (int64_t pts : {START, START + 500 * INTERVAL + 1, START + 1500 * INTERVAL,
+                      START + 2005 * INTERVAL})
+  {
+    CDemuxSeekIndex::Entry expected, entry;
+    const bool found = index.Find(pts, true, expected);
+    EXPECT_EQ(loaded.Find(pts, true, entry), found);
+    if (found)
+    {
+      EXPECT_EQ(entry.pts, expected.pts);
+      EXPECT_EQ(entry.pos, expected.pos);
+    }
+  }
+
+  EXPECT_FALSE(loaded.Deserialize(data.substr(0, data.size() - 1)));
+  EXPECT_FALSE(loaded.Deserialize("KSIX"));
+}
+
+TEST(TestDemuxSeekIndex, Merge)
+{
+  CDemuxSeekIndex index;
+  index.Reset(1, 90000);
+  Play(index, 0, 10);
+
+  CDemuxSeekIndex other;
+  other.Reset(1, 90000);
+  Play(other, 5, 10);
+  Play(other, 20, 5);
+
+  index.Merge(other);
+  EXPECT_EQ(index.GetSize(), 20u);
+
+  // the overlapping parts join up, the gap stays unknown
+  CDemuxSeekIndex::Entry entry;
+  ASSERT_TRUE(index.Find(START + 12 * INTERVAL + 100, true, entry));
+  EXPECT_EQ(entry.pos, 12 * PACKET_SIZE);
+  ASSERT_TRUE(index.Find(START + 3 * INTERVAL + 100, false, entry));
+  EXPECT_EQ(entry.pos, 4 * PACKET_SIZE);
+  EXPECT_FALSE(index.Find(START + 17 * INTERVAL, true, entry));
+  EXPECT_TRUE(index.Find(START + 22 * INTERVAL + 100, true, entry));
+}
+
+TEST(TestDemuxSeekIndex, MergeBetweenEntries)
+{
+  CDemuxSeekIndex index;
+  index.Reset(1, 90000);
+  Play(index, 0, 4);
+
+  // a keyframe the other index found between two adjacent entries
+  CDemuxSeekIndex other;
+  other.Reset(1, 90000);
+  other.Add(START + INTERVAL + INTERVAL / 2, PACKET_SIZE + PACKET_SIZE / 2);
+
+  index.Merge(other);
+  EXPECT_EQ(index.GetSize(), 5u);
+
+  CDemuxSeekIndex::Entry entry;
+  EXPECT_FALSE(index.Find(START + INTERVAL + 100, true, entry));
+  EXPECT_FALSE(index.Find(START + INTERVAL * 7 / 4, true, entry));
+  ASSERT_TRUE(index.Find(START + 2 * INTERVAL + 100, true, entry));
+  EXPECT_EQ(entry.pos, 2 * PACKET_SIZE);
+}
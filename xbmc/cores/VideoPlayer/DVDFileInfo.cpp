@@ -31,6 +31,7 @@
 #include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "Process/ProcessInfo.h"
+#include "ThumbExtractionService.h"
 
 #include <libavcodec/avcodec.h>
 #include <libswscale/swscale.h>
@@ -85,13 +86,114 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+namespace
+{
+// Feed the packets of a video stream to the decoder until it outputs a picture
+bool DecodePicture(CDVDDemux& demuxer,
+                   CDVDVideoCodec& codec,
+                   int streamId,
+                   VideoPicture& picture,
+                   int& packetsTried)
+{
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = demuxer.GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = demuxer.Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != streamId)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    codec.AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      iDecoderState = codec.GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if (!(picture.iFlags & DVP_FLAG_DROPPED))
+        break;
+    }
+
+  } while (abort_index--);
+
+  return iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED);
+}
+
+// Scale a decoded picture straight to the thumbnail size and store it
+bool StoreThumb(CThumbExtractionService::Decoder& decoder,
+                const CDVDStreamInfo& hint,
+                const VideoPicture& picture,
+                CTextureDetails& details)
+{
+  unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if(hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  decoder.scaler = sws_getCachedContext(decoder.scaler, picture.iWidth, picture.iHeight,
+                                        AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA,
+                                        SWS_FAST_BILINEAR, NULL, NULL, NULL);
+  if (!decoder.scaler)
+    return false;
+
+  // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
+  int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
+  uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
+  if (!pOutBuf)
+    return false;
+
+  uint8_t *planes[YuvImage::MAX_PLANES];
+  int stride[YuvImage::MAX_PLANES];
+  picture.videoBuffer->GetPlanes(planes);
+  picture.videoBuffer->GetStrides(stride);
+  uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
+  int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+  uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+  int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+  int orientation = DegreeToOrientation(hint.orientation);
+  sws_scale(decoder.scaler, src, srcStride, 0, picture.iHeight, dst, dstStride);
+
+  details.width = nWidth;
+  details.height = nHeight;
+  CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+  av_free(pOutBuf);
+  return true;
+}
+} // namespace
+
 bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
                                 int64_t pos)
 {
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
-  auto start = std::chrono::steady_clock::now();
+
+  CThumbExtractionService& service = CThumbExtractionService::GetInstance();
+
+  CThumbExtractionService::Timing timing;
+  const auto start = std::chrono::steady_clock::now();
+  auto stepStart = start;
+  auto stepTime = [&stepStart]() {
+    const auto now = std::chrono::steady_clock::now();
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - stepStart);
+    stepStart = now;
+    return duration;
+  };
 
   CFileItem item(fileItem);
   item.SetMimeTypeForInternetFile();
@@ -128,6 +230,8 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     return false;
   }
 
+  timing.open = stepTime();
+
   if (pStreamDetails)
   {
 
@@ -163,6 +267,8 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
+  timing.details = stepTime();
+
   int nVideoStream = -1;
   int64_t demuxerId = -1;
   for (CDemuxStream* pStream : pDemuxer->GetStreams())
@@ -181,110 +287,56 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
   }
 
   bool bOk = false;
-  int packetsTried = 0;
 
   if (nVideoStream != -1)
   {
-    std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
-    std::vector<AVPixelFormat> pixFmts;
-    pixFmts.push_back(AV_PIX_FMT_YUV420P);
-    pProcessInfo->SetPixFormats(pixFmts);
-
     CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
     hint.codecOptions = CODEC_FORCE_SOFTWARE;
 
-    std::unique_ptr<CDVDVideoCodec> pVideoCodec =
-        CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
+    const unsigned int thumbWidth = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes;
+    int nTotalLen = pDemuxer->GetStreamLength();
+    int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
 
-    if (pVideoCodec)
+    // Keyframes are enough for a thumbnail and much faster to find, but some
+    // streams only have recovery points that aren't flagged as keyframes
+    for (bool keyframesOnly : {true, false})
     {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
+      std::unique_ptr<CThumbExtractionService::Decoder> decoder =
+          service.AcquireDecoder(hint, thumbWidth, keyframesOnly);
+      if (!decoder)
+        break;
 
       CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__, nSeekTo,
                 nTotalLen, redactPath);
 
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+      if (!pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
       {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
-
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
-
-          if (!pPacket)
-            break;
-
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
-
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+        service.ReleaseDecoder(std::move(decoder));
+        break;
+      }
+      timing.seek += stepTime();
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
+      VideoPicture picture = {};
+      const bool decoded =
+          DecodePicture(*pDemuxer, *decoder->codec, nVideoStream, picture, timing.packets);
+      timing.decode += stepTime();
 
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
-          {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
-          }
+      if (decoded)
+      {
+        bOk = StoreThumb(*decoder, hint, picture, details);
+        timing.scale = stepTime();
+      }
+      else
+      {
+        CLog::Log(LOGDEBUG, "{} - decode {}failed in {} after {} packets.", __FUNCTION__,
+                  keyframesOnly ? "of keyframes " : "", redactPath, timing.packets);
+      }
 
-        } while (abort_index--);
+      picture.Reset();
+      service.ReleaseDecoder(std::move(decoder));
 
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
-            int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
-            uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
-        }
-        else
-        {
-          CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__,
-                    redactPath, packetsTried);
-        }
-      }
+      if (decoded)
+        break;
     }
   }
 
@@ -298,10 +350,9 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
       file.Close();
   }
 
-  auto end = std::chrono::steady_clock::now();
-  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-  CLog::Log(LOGDEBUG, "{} - measured {} ms to extract thumb from file <{}> in {} packets. ",
-            __FUNCTION__, duration.count(), redactPath, packetsTried);
+  timing.total = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  service.Report(fileItem.GetPath(), timing);
 
   return bOk;
 }
@@ -326,6 +377,11 @@ bool CDVDFileInfo::GetFileStreamDetails(CFileItem *pItem)
   if (URIUtils::IsStack(playablePath))
     playablePath = XFILE::CStackDirectory::GetFirstStackedFile(playablePath);
 
+  CThumbExtractionService& service = CThumbExtractionService::GetInstance();
+
+  CThumbExtractionService::Timing timing;
+  const auto start = std::chrono::steady_clock::now();
+
   CFileItem item(playablePath, false);
   item.SetMimeTypeForInternetFile();
   auto pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
@@ -345,8 +401,16 @@ bool CDVDFileInfo::GetFileStreamDetails(CFileItem *pItem)
   CDVDDemux *pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true);
   if (pDemuxer)
   {
+    const auto opened = std::chrono::steady_clock::now();
     bool retVal = DemuxerToStreamDetails(pInputStream, pDemuxer, pItem->GetVideoInfoTag()->m_streamDetails, strFileNameAndPath);
     delete pDemuxer;
+
+    const auto end = std::chrono::steady_clock::now();
+    timing.open = std::chrono::duration_cast<std::chrono::milliseconds>(opened - start);
+    timing.details = std::chrono::duration_cast<std::chrono::milliseconds>(end - opened);
+    timing.total = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    service.Report(playablePath, timing);
+
     return retVal;
   }
   else
@@ -11,7 +11,9 @@
 #include "ServiceBroker.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClient.h"
+#include "pvr/recordings/PVRRecording.h"
 #include "pvr/recordings/PVRRecordings.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
 using namespace PVR;
@@ -42,6 +44,11 @@ bool CInputStreamPVRRecording::OpenPVRStream()
   {
     CLog::Log(LOGDEBUG, "CInputStreamPVRRecording - {} - opened recording stream {}", __FUNCTION__,
               m_item.GetPath());
+
+    // in-progress recordings still grow, the data cached about them would be outdated right away
+    if (!recording->IsInProgress())
+      m_recordingKey = StringUtils::Format("pvr://recordings/{}/{}", recording->m_iClientId,
+                                           recording->m_strRecordingId);
     return true;
   }
   return false;
@@ -49,6 +56,8 @@ bool CInputStreamPVRRecording::OpenPVRStream()
 
 void CInputStreamPVRRecording::ClosePVRStream()
 {
+  m_recordingKey.clear();
+
   if (m_client && (m_client->CloseRecordedStream() == PVR_ERROR_NO_ERROR))
   {
     CLog::Log(LOGDEBUG, "CInputStreamPVRRecording - {} - closed recording stream {}", __FUNCTION__,
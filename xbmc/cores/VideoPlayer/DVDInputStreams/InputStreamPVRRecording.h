@@ -10,12 +10,22 @@
 
 #include "InputStreamPVRBase.h"
 
+#include <string>
+
 class CInputStreamPVRRecording : public CInputStreamPVRBase
 {
 public:
   CInputStreamPVRRecording(IVideoPlayer* pPlayer, const CFileItem& fileitem);
   ~CInputStreamPVRRecording() override;
 
+  /*!
+   * @brief Get a key that identifies the recording across sessions, e.g. to cache data about it.
+   * Unlike the path of the recording, the key doesn't change if the recording is renamed or moved.
+   * @return the key, or an empty string if the stream isn't open or the recording is still in
+   * progress
+   */
+  const std::string& GetRecordingKey() const { return m_recordingKey; }
+
 protected:
   bool OpenPVRStream() override;
   void ClosePVRStream() override;
@@ -25,4 +35,7 @@ protected:
   ENextStream NextPVRStream() override;
   bool CanPausePVRStream() override;
   bool CanSeekPVRStream() override;
+
+private:
+  std::string m_recordingKey;
 };
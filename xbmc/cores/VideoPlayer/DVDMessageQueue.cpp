@@ -11,11 +11,13 @@
 #include "cores/VideoPlayer/Interface/DemuxPacket.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "threads/SingleLock.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/log.h"
 
 #include <math.h>
 
-CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m_owner(owner)
+CDVDMessageQueue::CDVDMessageQueue(const std::string& owner)
+  : m_hEvent(true), m_owner(owner), m_traceName(CPlaybackTracer::Intern(owner))
 {
   m_iDataSize     = 0;
   m_bAbortRequest = false;
@@ -148,6 +150,8 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
         UpdateTimeFront();
       else
         UpdateTimeBack();
+
+      CPlaybackTracer::Counter("queue", m_traceName, m_iDataSize);
     }
   }
 
@@ -187,6 +191,7 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
         if (packet)
         {
           m_iDataSize -= packet->iSize;
+          CPlaybackTracer::Counter("queue", m_traceName, m_iDataSize);
         }
       }
 
@@ -207,8 +212,11 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
       lock.Leave();
 
       // wait for a new message
-      if (!m_hEvent.Wait(std::chrono::milliseconds(iTimeoutInMilliSeconds)))
-        return MSGQ_TIMEOUT;
+      {
+        PLAYBACK_TRACE_SCOPE("queue.wait", m_traceName);
+        if (!m_hEvent.Wait(std::chrono::milliseconds(iTimeoutInMilliSeconds)))
+          return MSGQ_TIMEOUT;
+      }
 
       lock.Enter();
     }
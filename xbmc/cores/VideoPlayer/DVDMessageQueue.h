@@ -114,6 +114,7 @@ private:
 
   int m_iMaxDataSize;
   std::string m_owner;
+  const char* m_traceName; ///< name of the queue in playback traces
 
   std::list<DVDMessageListItem> m_messages;
   std::list<DVDMessageListItem> m_prioMessages;
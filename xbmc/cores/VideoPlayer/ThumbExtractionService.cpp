@@ -0,0 +1,282 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ThumbExtractionService.h"
+
+#include "DVDCodecs/DVDCodecs.h"
+#include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
+#include "Process/ProcessInfo.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+namespace
+{
+// Workers are limited to this number on machines with many cores, as most
+// of the time is spent waiting for storage
+constexpr unsigned int MAX_WORKERS = 4;
+
+// Highest lowres factor that is used, 1/8 of the size
+constexpr int MAX_LOWRES = 3;
+} // namespace
+
+CThumbExtractionService::Decoder::Decoder() = default;
+
+CThumbExtractionService::Decoder::~Decoder()
+{
+  codec.reset();
+  sws_freeContext(scaler);
+}
+
+CThumbExtractionService::CThumbExtractionService(unsigned int workers)
+  : m_workers(std::max(1u, workers))
+{
+}
+
+CThumbExtractionService::~CThumbExtractionService()
+{
+  CSingleLock lock(m_jobSection);
+  for (const Job& job : m_queuedJobs)
+    delete job.job;
+  m_queuedJobs.clear();
+
+  for (const Job& job : m_runningJobs)
+    CJobManager::GetInstance().CancelJob(job.id);
+  m_runningJobs.clear();
+}
+
+CThumbExtractionService& CThumbExtractionService::GetInstance()
+{
+  static CThumbExtractionService service(GetDefaultWorkerCount());
+  return service;
+}
+
+unsigned int CThumbExtractionService::GetDefaultWorkerCount()
+{
+  // leave half of the cores to playback and the GUI
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  const int cpuCount = cpuInfo ? cpuInfo->GetCPUCount() : 1;
+  return std::max(1u, std::min(MAX_WORKERS, static_cast<unsigned int>(cpuCount) / 2));
+}
+
+void CThumbExtractionService::AddJob(CJob* job, IJobCallback* callback)
+{
+  CSingleLock lock(m_jobSection);
+
+  const auto equals = [job, callback](const Job& other) {
+    return other.callback == callback && *other.job == job;
+  };
+  if (std::any_of(m_queuedJobs.begin(), m_queuedJobs.end(), equals) ||
+      std::any_of(m_runningJobs.begin(), m_runningJobs.end(), equals))
+  {
+    delete job;
+    return;
+  }
+
+  m_queuedJobs.push_back({job, callback, 0});
+  StartJobs();
+}
+
+void CThumbExtractionService::CancelJobs(IJobCallback* callback)
+{
+  CSingleLock lock(m_jobSection);
+
+  for (auto it = m_queuedJobs.begin(); it != m_queuedJobs.end();)
+  {
+    if (it->callback == callback)
+    {
+      delete it->job;
+      it = m_queuedJobs.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  // running jobs keep their worker until they finish
+  for (Job& job : m_runningJobs)
+  {
+    if (job.callback == callback)
+      job.callback = nullptr;
+  }
+}
+
+void CThumbExtractionService::OnJobComplete(unsigned int jobID, bool success, CJob* job)
+{
+  IJobCallback* callback = OnJobDone(jobID);
+  if (callback)
+    callback->OnJobComplete(jobID, success, job);
+}
+
+void CThumbExtractionService::OnJobAbort(unsigned int jobID, CJob* job)
+{
+  IJobCallback* callback = OnJobDone(jobID);
+  if (callback)
+    callback->OnJobAbort(jobID, job);
+}
+
+IJobCallback* CThumbExtractionService::OnJobDone(unsigned int jobID)
+{
+  CSingleLock lock(m_jobSection);
+
+  IJobCallback* callback = nullptr;
+  auto it = std::find_if(m_runningJobs.begin(), m_runningJobs.end(),
+                         [jobID](const Job& job) { return job.id == jobID; });
+  if (it != m_runningJobs.end())
+  {
+    callback = it->callback;
+    m_runningJobs.erase(it);
+  }
+
+  StartJobs();
+  return callback;
+}
+
+void CThumbExtractionService::StartJobs()
+{
+  CSingleLock lock(m_jobSection);
+
+  while (!m_queuedJobs.empty() && m_runningJobs.size() < m_workers)
+  {
+    Job job = m_queuedJobs.back();
+    m_queuedJobs.pop_back();
+
+    // the job manager deletes the job if it isn't running
+    job.id = CJobManager::GetInstance().AddJob(job.job, this, CJob::PRIORITY_LOW_PAUSABLE);
+    if (job.id > 0)
+      m_runningJobs.push_back(job);
+  }
+}
+
+std::unique_ptr<CThumbExtractionService::Decoder> CThumbExtractionService::AcquireDecoder(
+    const CDVDStreamInfo& hint, unsigned int width, bool keyframesOnly)
+{
+  const int lowres = GetLowres(hint, width);
+
+  {
+    CSingleLock lock(m_decoderSection);
+
+    // most recently used first, files that are extracted one after another
+    // often come from the same source
+    for (auto it = m_decoders.rbegin(); it != m_decoders.rend(); ++it)
+    {
+      if (CanReuse(**it, hint, lowres, keyframesOnly))
+      {
+        std::unique_ptr<Decoder> decoder = std::move(*it);
+        m_decoders.erase(std::next(it).base());
+        return decoder;
+      }
+    }
+  }
+
+  auto decoder = std::make_unique<Decoder>();
+  decoder->hint = hint;
+  decoder->hint.codecOptions = CODEC_FORCE_SOFTWARE;
+  decoder->keyframesOnly = keyframesOnly;
+  decoder->lowres = lowres;
+
+  decoder->processInfo.reset(CProcessInfo::CreateInstance());
+  std::vector<AVPixelFormat> pixFmts = {AV_PIX_FMT_YUV420P};
+  decoder->processInfo->SetPixFormats(pixFmts);
+
+  CDVDCodecOptions options;
+  if (keyframesOnly)
+    options.m_keys.emplace_back("skip_frame", "nokey");
+  if (lowres > 0)
+    options.m_keys.emplace_back("lowres", StringUtils::Format("{}", lowres));
+
+  decoder->codec = std::make_unique<CDVDVideoCodecFFmpeg>(*decoder->processInfo);
+  if (!decoder->codec->Open(decoder->hint, options))
+  {
+    CLog::Log(LOGDEBUG, "CThumbExtractionService::{} - unable to open decoder for codec {}",
+              __FUNCTION__, hint.codec);
+    return nullptr;
+  }
+
+  return decoder;
+}
+
+void CThumbExtractionService::ReleaseDecoder(std::unique_ptr<Decoder> decoder)
+{
+  if (!decoder)
+    return;
+
+  decoder->codec->Reset();
+
+  CSingleLock lock(m_decoderSection);
+  m_decoders.emplace_back(std::move(decoder));
+
+  // one idle decoder per worker is enough to get the next file going
+  if (m_decoders.size() > m_workers)
+    m_decoders.erase(m_decoders.begin());
+}
+
+void CThumbExtractionService::Report(const std::string& path, const Timing& timing)
+{
+  unsigned int files;
+  std::chrono::milliseconds average;
+  {
+    CSingleLock lock(m_statsSection);
+    files = ++m_files;
+    m_totalTime += timing.total;
+    average = m_totalTime / files;
+  }
+
+  CLog::Log(LOGDEBUG,
+            "CThumbExtractionService::{} - extracted <{}> in {} ms (open: {} ms, details: {} ms, "
+            "seek: {} ms, decode: {} ms in {} packets, scale: {} ms), average {} ms over {} files",
+            __FUNCTION__, CURL::GetRedacted(path), timing.total.count(), timing.open.count(),
+            timing.details.count(), timing.seek.count(), timing.decode.count(), timing.packets,
+            timing.scale.count(), average.count(), files);
+}
+
+bool CThumbExtractionService::CanReuse(const Decoder& decoder,
+                                       const CDVDStreamInfo& hint,
+                                       int lowres,
+                                       bool keyframesOnly)
+{
+  const CDVDStreamInfo& other = decoder.hint;
+
+  if (decoder.keyframesOnly != keyframesOnly || decoder.lowres != lowres ||
+      other.codec != hint.codec || other.codec_tag != hint.codec_tag ||
+      other.width != hint.width || other.height != hint.height ||
+      other.profile != hint.profile || other.bitsperpixel != hint.bitsperpixel)
+    return false;
+
+  // the decoder is configured from the extradata when it's opened
+  if (other.extrasize != hint.extrasize)
+    return false;
+
+  return hint.extrasize == 0 || memcmp(other.extradata, hint.extradata, hint.extrasize) == 0;
+}
+
+int CThumbExtractionService::GetLowres(const CDVDStreamInfo& hint, unsigned int width)
+{
+  const AVCodec* codec = avcodec_find_decoder(hint.codec);
+  if (!codec || width == 0 || hint.width <= 0)
+    return 0;
+
+  // decode at the smallest size that is still as wide as the thumbnail
+  const int maxLowres = std::min(static_cast<int>(codec->max_lowres), MAX_LOWRES);
+  int lowres = 0;
+  while (lowres < maxLowres && static_cast<unsigned int>(hint.width >> (lowres + 1)) >= width)
+    lowres++;
+
+  return lowres;
+}
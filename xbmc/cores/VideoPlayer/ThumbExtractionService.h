@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDStreamInfo.h"
+#include "threads/CriticalSection.h"
+#include "utils/Job.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CDVDVideoCodec;
+class CProcessInfo;
+struct SwsContext;
+
+/*!
+ * \brief Runs thumbnail and stream details extraction of video files
+ *
+ * Extraction jobs from all thumb loaders are queued here and handed to the
+ * job manager only while fewer than the bounded number of workers are busy,
+ * so that more files are processed in parallel on machines with more cores
+ * without starving playback and the GUI. Queued jobs don't occupy a thread
+ * of the job manager.
+ *
+ * Thumbnails are decoded from keyframes only, at a reduced resolution when
+ * the codec supports it, and decoders are kept open and reused for the next
+ * file with the same codec parameters.
+ */
+class CThumbExtractionService : private IJobCallback
+{
+public:
+  /*!
+   * \brief Time spent in each step of an extraction
+   */
+  struct Timing
+  {
+    std::chrono::milliseconds open{0}; ///< opening the input stream and the demuxer
+    std::chrono::milliseconds details{0}; ///< reading the stream details
+    std::chrono::milliseconds seek{0}; ///< seeking to the thumbnail position
+    std::chrono::milliseconds decode{0}; ///< decoding the thumbnail frame
+    std::chrono::milliseconds scale{0}; ///< scaling and storing the thumbnail
+    std::chrono::milliseconds total{0};
+    int packets = 0;
+  };
+
+  /*!
+   * \brief A video decoder prepared for thumbnail extraction
+   */
+  struct Decoder
+  {
+    Decoder();
+    ~Decoder();
+
+    CDVDStreamInfo hint;
+    bool keyframesOnly = false;
+    int lowres = 0;
+    std::unique_ptr<CProcessInfo> processInfo;
+    std::unique_ptr<CDVDVideoCodec> codec;
+    SwsContext* scaler = nullptr;
+  };
+
+  explicit CThumbExtractionService(unsigned int workers);
+  ~CThumbExtractionService() override;
+
+  static CThumbExtractionService& GetInstance();
+
+  /*!
+   * \brief Number of workers used on this machine
+   */
+  static unsigned int GetDefaultWorkerCount();
+
+  unsigned int GetWorkerCount() const { return m_workers; }
+
+  /*!
+   * \brief Queue an extraction job, it is started when a worker is free
+   *
+   * Jobs are started last in first out, so that the items that were
+   * requested last, usually the visible ones, are processed first. A job
+   * that equals one that is queued or running for the same callback is
+   * dropped.
+   *
+   * \param job The job, deleted when it is done or dropped
+   * \param callback Notified when the job is done, must cancel its jobs
+   * before it is destroyed
+   */
+  void AddJob(CJob* job, IJobCallback* callback);
+
+  /*!
+   * \brief Drop the queued jobs of a callback and stop notifying it
+   *
+   * Running jobs finish, but the callback isn't notified anymore.
+   */
+  void CancelJobs(IJobCallback* callback);
+
+  /*!
+   * \brief Get an open decoder for a video stream
+   *
+   * An idle decoder that was opened with the same parameters is reused,
+   * otherwise a new software decoder is opened.
+   *
+   * \param hint The stream to decode
+   * \param width The width that the thumbnail is scaled to
+   * \param keyframesOnly Skip all frames that aren't keyframes
+   * \return The decoder, or nullptr if the stream can't be decoded
+   */
+  std::unique_ptr<Decoder> AcquireDecoder(const CDVDStreamInfo& hint,
+                                          unsigned int width,
+                                          bool keyframesOnly);
+
+  /*!
+   * \brief Return a decoder for use with the next file
+   */
+  void ReleaseDecoder(std::unique_ptr<Decoder> decoder);
+
+  /*!
+   * \brief Log the timing of an extraction
+   */
+  void Report(const std::string& path, const Timing& timing);
+
+protected:
+  static bool CanReuse(const Decoder& decoder,
+                       const CDVDStreamInfo& hint,
+                       int lowres,
+                       bool keyframesOnly);
+  static int GetLowres(const CDVDStreamInfo& hint, unsigned int width);
+
+private:
+  struct Job
+  {
+    CJob* job;
+    IJobCallback* callback; ///< nullptr when the job was cancelled
+    unsigned int id;
+  };
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+  void OnJobAbort(unsigned int jobID, CJob* job) override;
+  IJobCallback* OnJobDone(unsigned int jobID);
+  void StartJobs();
+
+  const unsigned int m_workers;
+
+  CCriticalSection m_jobSection;
+  std::vector<Job> m_queuedJobs; ///< oldest first
+  std::vector<Job> m_runningJobs;
+
+  CCriticalSection m_decoderSection;
+  std::vector<std::unique_ptr<Decoder>> m_decoders; ///< idle decoders, oldest first
+
+  CCriticalSection m_statsSection;
+  unsigned int m_files = 0;
+  std::chrono::milliseconds m_totalTime{0};
+};
@@ -52,6 +52,7 @@
 #include "storage/MediaManager.h"
 #include "utils/JobManager.h"
 #include "utils/LangCodeExpander.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/StreamDetails.h"
 #include "utils/StreamUtils.h"
 #include "utils/StringUtils.h"
@@ -850,7 +851,8 @@ bool CVideoPlayer::OpenDemuxStream()
   m_pDemuxer->GetPrograms(m_programs);
   UpdateContent();
   m_demuxerSpeed = DVD_PLAYSPEED_NORMAL;
-  m_processInfo->SetStateRealtime(false);
+  // known before the codecs are opened, so that they can prefer low latency
+  m_processInfo->SetStateRealtime(m_pInputStream->IsRealtime());
 
   int64_t len = m_pInputStream->GetLength();
   int64_t tim = m_pDemuxer->GetStreamLength();
@@ -996,6 +998,7 @@ void CVideoPlayer::OpenDefaultStreams(bool reset)
 
 bool CVideoPlayer::ReadPacket(DemuxPacket*& packet, CDemuxStream*& stream)
 {
+  PLAYBACK_TRACE_SCOPE("demux", "CVideoPlayer::ReadPacket");
 
   // check if we should read from subtitle demuxer
   if (m_pSubtitleDemuxer && m_VideoPlayerSubtitle->AcceptsData())
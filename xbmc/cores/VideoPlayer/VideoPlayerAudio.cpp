@@ -18,6 +18,7 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/MathUtils.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/log.h"
 
 #include "system.h"
@@ -393,7 +394,13 @@ void CVideoPlayerAudio::Process()
         continue;
       }
 
-      if (!m_pAudioCodec->AddData(*pPacket))
+      bool added;
+      {
+        PLAYBACK_TRACE_SCOPE("audio", "CVideoPlayerAudio::AddData");
+        added = m_pAudioCodec->AddData(*pPacket);
+      }
+
+      if (!added)
       {
         m_messageQueue.PutBack(pMsg);
         onlyPrioMsgs = true;
@@ -418,7 +425,10 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
   {
     audioframe.hasDownmix = false;
 
-    m_pAudioCodec->GetData(audioframe);
+    {
+      PLAYBACK_TRACE_SCOPE("audio", "CVideoPlayerAudio::GetData");
+      m_pAudioCodec->GetData(audioframe);
+    }
 
     if (audioframe.nb_frames == 0)
     {
@@ -504,7 +514,11 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
     }
   }
 
-  int framesOutput = m_audioSink.AddPackets(audioframe);
+  int framesOutput;
+  {
+    PLAYBACK_TRACE_SCOPE("audio", "CVideoPlayerAudio::OutputPacket");
+    framesOutput = m_audioSink.AddPackets(audioframe);
+  }
 
   // guess next pts
   m_audioClock += audioframe.duration * ((double)framesOutput / audioframe.nb_frames);
@@ -17,6 +17,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/MathUtils.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -565,7 +566,13 @@ void CVideoPlayerVideo::Process()
         codecControl |= DVD_CODEC_CTRL_ROTATE;
       m_pVideoCodec->SetCodecControl(codecControl);
 
-      if (m_pVideoCodec->AddData(*pPacket))
+      bool added;
+      {
+        PLAYBACK_TRACE_SCOPE("video", "CVideoPlayerVideo::AddData");
+        added = m_pVideoCodec->AddData(*pPacket);
+      }
+
+      if (added)
       {
         // buffer packets so we can recover should decoder flush for some reason
         if (m_pVideoCodec->GetConvergeCount() > 0)
@@ -594,7 +601,11 @@ void CVideoPlayerVideo::Process()
 
 bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
 {
-  CDVDVideoCodec::VCReturn decoderState = m_pVideoCodec->GetPicture(&m_picture);
+  CDVDVideoCodec::VCReturn decoderState;
+  {
+    PLAYBACK_TRACE_SCOPE("video", "CVideoPlayerVideo::GetPicture");
+    decoderState = m_pVideoCodec->GetPicture(&m_picture);
+  }
 
   if (decoderState == CDVDVideoCodec::VC_BUFFER)
   {
@@ -830,6 +841,8 @@ void CVideoPlayerVideo::ProcessOverlays(const VideoPicture* pSource, double pts)
 
 CVideoPlayerVideo::EOutputState CVideoPlayerVideo::OutputPicture(const VideoPicture* pPicture)
 {
+  PLAYBACK_TRACE_SCOPE("video", "CVideoPlayerVideo::OutputPicture");
+
   m_bAbortOutput = false;
 
   if (m_processInfo.GetVideoStereoMode() != pPicture->stereoMode)
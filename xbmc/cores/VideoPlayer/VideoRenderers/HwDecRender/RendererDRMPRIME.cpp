@@ -19,15 +19,148 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
+#include "utils/ImageKernels.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/gbm/WinSystemGbm.h"
 #include "windowing/gbm/drm/DRMAtomic.h"
 
+#include <cerrno>
+#include <cstring>
+
+#include <drm_fourcc.h>
+#include <sys/mman.h>
+
+#if defined(HAVE_LINUX_DMA_BUF)
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#endif
+
 using namespace KODI::WINDOWING::GBM;
 
 const std::string SETTING_VIDEOPLAYER_USEPRIMERENDERER = "videoplayer.useprimerenderer";
 
+namespace
+{
+void SyncObject(int fd, bool start)
+{
+#if defined(HAVE_LINUX_DMA_BUF)
+  struct dma_buf_sync sync;
+  sync.flags = (start ? DMA_BUF_SYNC_START : DMA_BUF_SYNC_END) | DMA_BUF_SYNC_READ;
+
+  int ret = ioctl(fd, DMA_BUF_IOCTL_SYNC, &sync);
+  if (ret < 0)
+    CLog::LogF(LOGERROR, "ioctl DMA_BUF_IOCTL_SYNC failed, ret={} errno={}", ret, strerror(errno));
+#endif
+}
+
+bool ConvertToBGRA(CVideoBufferDRMPRIME* buffer,
+                   uint8_t* target,
+                   unsigned int width,
+                   unsigned int height)
+{
+  const AVDRMFrameDescriptor* descriptor = buffer->GetDescriptor();
+  if (!descriptor || descriptor->nb_layers != 1)
+    return false;
+
+  const AVDRMLayerDescriptor& layer = descriptor->layers[0];
+
+  CImageKernels::YUVImage image;
+  switch (layer.format)
+  {
+    case DRM_FORMAT_NV12:
+      image.format = CImageKernels::YUVFormat::NV12;
+      break;
+    case DRM_FORMAT_YUV420:
+      image.format = CImageKernels::YUVFormat::YUV420P;
+      break;
+#if defined(DRM_FORMAT_P010)
+    case DRM_FORMAT_P010:
+      image.format = CImageKernels::YUVFormat::P010;
+      break;
+#endif
+    default:
+      return false;
+  }
+
+  const int planes = image.format == CImageKernels::YUVFormat::YUV420P ? 3 : 2;
+  if (layer.nb_planes != planes)
+    return false;
+
+  // tiled or compressed buffers can't be read linearly
+  for (int i = 0; i < descriptor->nb_objects; i++)
+  {
+    const uint64_t modifier = descriptor->objects[i].format_modifier;
+    if (modifier != DRM_FORMAT_MOD_LINEAR && modifier != DRM_FORMAT_MOD_INVALID)
+      return false;
+  }
+
+  const VideoPicture& picture = buffer->GetPicture();
+  switch (picture.color_space)
+  {
+    case AVCOL_SPC_BT2020_CL:
+    case AVCOL_SPC_BT2020_NCL:
+      image.matrix = CImageKernels::ColorMatrix::BT2020;
+      break;
+    case AVCOL_SPC_SMPTE170M:
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_FCC:
+      image.matrix = CImageKernels::ColorMatrix::BT601;
+      break;
+    case AVCOL_SPC_BT709:
+      image.matrix = CImageKernels::ColorMatrix::BT709;
+      break;
+    default:
+      image.matrix = picture.iWidth > 1024 || picture.iHeight >= 600
+                         ? CImageKernels::ColorMatrix::BT709
+                         : CImageKernels::ColorMatrix::BT601;
+      break;
+  }
+  image.limitedRange = !picture.color_range;
+  image.width = buffer->GetWidth();
+  image.height = buffer->GetHeight();
+
+  void* maps[AV_DRM_MAX_PLANES] = {};
+  bool ok = true;
+  for (int i = 0; i < descriptor->nb_objects && ok; i++)
+  {
+    maps[i] = mmap(nullptr, descriptor->objects[i].size, PROT_READ, MAP_SHARED,
+                   descriptor->objects[i].fd, 0);
+    if (maps[i] == MAP_FAILED)
+    {
+      CLog::LogF(LOGERROR, "mmap failed, errno={}", strerror(errno));
+      maps[i] = nullptr;
+      ok = false;
+    }
+    else
+      SyncObject(descriptor->objects[i].fd, true);
+  }
+
+  if (ok)
+  {
+    for (int i = 0; i < planes; i++)
+    {
+      const AVDRMPlaneDescriptor& plane = layer.planes[i];
+      image.planes[i] = static_cast<const uint8_t*>(maps[plane.object_index]) + plane.offset;
+      image.strides[i] = static_cast<int>(plane.pitch);
+    }
+
+    CImageKernels::ConvertToBGRA(image, target, width * 4, width, height);
+  }
+
+  for (int i = 0; i < descriptor->nb_objects; i++)
+  {
+    if (maps[i])
+    {
+      SyncObject(descriptor->objects[i].fd, false);
+      munmap(maps[i], descriptor->objects[i].size);
+    }
+  }
+
+  return ok;
+}
+} // namespace
+
 CRendererDRMPRIME::~CRendererDRMPRIME()
 {
   Flush(false);
@@ -224,9 +357,27 @@ void CRendererDRMPRIME::RenderUpdate(
 
 bool CRendererDRMPRIME::RenderCapture(CRenderCapture* capture)
 {
+  if (m_iLastRenderBuffer < 0)
+    return false;
+
+  CVideoBufferDRMPRIME* buffer =
+      dynamic_cast<CVideoBufferDRMPRIME*>(m_buffers[m_iLastRenderBuffer].videoBuffer);
+  if (!buffer || !buffer->IsValid())
+    return false;
+
   capture->BeginRender();
+
+  // the video plane is scanned out directly, so the frame is converted on the CPU
+  uint8_t* pixels = static_cast<uint8_t*>(capture->GetRenderBuffer());
+  bool ok = pixels && buffer->AcquireDescriptor();
+  if (ok)
+  {
+    ok = ConvertToBGRA(buffer, pixels, capture->GetWidth(), capture->GetHeight());
+    buffer->ReleaseDescriptor();
+  }
+
   capture->EndRender();
-  return true;
+  return ok;
 }
 
 bool CRendererDRMPRIME::ConfigChanged(const VideoPicture& picture)
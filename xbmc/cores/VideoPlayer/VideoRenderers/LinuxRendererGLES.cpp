@@ -25,6 +25,7 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/GLUtils.h"
+#include "utils/ImageKernels.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
@@ -305,11 +306,8 @@ void CLinuxRendererGLES::LoadPlane(CYuvPlane& plane, int type,
         m_planeBufferSize = planeSize;
       }
 
-      unsigned char *src(static_cast<unsigned char*>(data)),
-                    *dst(m_planeBuffer);
-
-      for (unsigned int y = 0; y < height; ++y, src += stride, dst += width * bps)
-        memcpy(dst, src, width * bps);
+      CImageKernels::CopyPlane(m_planeBuffer, width * bps, static_cast<const uint8_t*>(data),
+                               stride, width * bps, height);
 
       pixelData = m_planeBuffer;
     }
@@ -1277,12 +1275,10 @@ bool CLinuxRendererGLES::RenderCapture(CRenderCapture* capture)
                GL_RGBA, GL_UNSIGNED_BYTE, capture->GetRenderBuffer());
 
   // OpenGLES returns in RGBA order but CRenderCapture needs BGRA order
-  // XOR Swap RGBA -> BGRA
-  unsigned char* pixels = static_cast<unsigned char*>(capture->GetRenderBuffer());
-  for (unsigned int i = 0; i < capture->GetWidth() * capture->GetHeight(); i++, pixels += 4)
-  {
-    std::swap(pixels[0], pixels[2]);
-  }
+  uint8_t* pixels = static_cast<uint8_t*>(capture->GetRenderBuffer());
+  const int stride = capture->GetWidth() * 4;
+  CImageKernels::SwapRedBlue(pixels, stride, pixels, stride, capture->GetWidth(),
+                             capture->GetHeight());
 
   capture->EndRender();
 
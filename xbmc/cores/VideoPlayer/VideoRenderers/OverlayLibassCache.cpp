@@ -0,0 +1,222 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "OverlayLibassCache.h"
+
+#include "cores/VideoPlayer/DVDClock.h"
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitlesLibass.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+
+using namespace OVERLAY;
+
+namespace
+{
+// How far frames are rendered ahead of the clock at normal speed
+constexpr double MAX_PREFETCH = DVD_TIME_BASE;
+
+// Frames that are kept when the render thread doesn't consume them, e.g. while paused
+constexpr size_t MAX_ENTRIES = 32;
+} // namespace
+
+bool CLibassCache::SParams::operator==(const SParams& other) const
+{
+  return frameWidth == other.frameWidth && frameHeight == other.frameHeight &&
+         videoWidth == other.videoWidth && videoHeight == other.videoHeight &&
+         sourceWidth == other.sourceWidth && sourceHeight == other.sourceHeight &&
+         useMargin == other.useMargin && position == other.position;
+}
+
+CLibassCache::CLibassCache() : CThread("LibassCache")
+{
+}
+
+CLibassCache::~CLibassCache()
+{
+  m_bStop = true;
+  m_jobEvent.Set();
+  StopThread();
+}
+
+void CLibassCache::SetClock(CDVDClock* clock)
+{
+  CSingleLock lock(m_section);
+  m_clock = clock;
+}
+
+void CLibassCache::Prefetch(const std::shared_ptr<CDVDSubtitlesLibass>& libass, double pts)
+{
+  if (!libass)
+    return;
+
+  {
+    CSingleLock lock(m_section);
+    if (!m_clock)
+      return;
+
+    m_jobs.push_back({libass, pts});
+  }
+
+  StartWorker();
+  m_jobEvent.Set();
+}
+
+std::shared_ptr<CLibassCache::SFrame> CLibassCache::Get(
+    const std::shared_ptr<CDVDSubtitlesLibass>& libass, double pts, const SParams& params)
+{
+  std::shared_ptr<SFrame> frame;
+  {
+    CSingleLock lock(m_section);
+    m_params = params;
+    m_hasParams = true;
+
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [pts](const SEntry& entry) { return entry.pts < pts; }),
+                    m_entries.end());
+
+    frame = Find(libass, pts, params);
+  }
+
+  // the geometry is known now, the worker can start with the next frames
+  m_jobEvent.Set();
+
+  if (!frame)
+  {
+    CSingleLock renderLock(m_renderSection);
+
+    // the worker may have finished it in the meantime
+    {
+      CSingleLock lock(m_section);
+      frame = Find(libass, pts, params);
+    }
+
+    if (!frame)
+      frame = Render(libass, pts, params);
+  }
+
+  return frame;
+}
+
+void CLibassCache::Flush()
+{
+  {
+    CSingleLock lock(m_section);
+    m_jobs.clear();
+    m_entries.clear();
+    m_generation++;
+  }
+
+  CSingleLock lock(m_renderSection);
+  m_last.clear();
+}
+
+bool CLibassCache::GetJob(SJob& job, SParams& params, unsigned int& generation)
+{
+  CSingleLock lock(m_section);
+  if (!m_clock || !m_hasParams)
+    return false;
+
+  const double clock = m_clock->GetClock();
+  const double distance = MAX_PREFETCH * std::max(1.0, m_clock->GetClockSpeed());
+
+  while (!m_jobs.empty())
+  {
+    // too late to be of any use
+    if (m_jobs.front().pts < clock)
+    {
+      m_jobs.pop_front();
+      continue;
+    }
+
+    if (m_jobs.front().pts > clock + distance || m_entries.size() >= MAX_ENTRIES)
+      return false;
+
+    job = m_jobs.front();
+    m_jobs.pop_front();
+    params = m_params;
+    generation = m_generation;
+    return true;
+  }
+
+  return false;
+}
+
+void CLibassCache::Process()
+{
+  while (!m_bStop)
+  {
+    if (!ProcessJob())
+      m_jobEvent.Wait(std::chrono::milliseconds(100));
+  }
+}
+
+bool CLibassCache::ProcessJob()
+{
+  SJob job;
+  SParams params;
+  unsigned int generation;
+  if (!GetJob(job, params, generation))
+    return false;
+
+  CSingleLock renderLock(m_renderSection);
+  std::shared_ptr<SFrame> frame = Render(job.libass, job.pts, params);
+
+  CSingleLock lock(m_section);
+  if (generation == m_generation)
+    m_entries.push_back({job.libass, job.pts, params, frame});
+
+  return true;
+}
+
+void CLibassCache::StartWorker()
+{
+  if (!IsRunning())
+    Create();
+}
+
+ASS_Image* CLibassCache::RenderImage(CDVDSubtitlesLibass& libass,
+                                     double pts,
+                                     const SParams& params,
+                                     int& changes)
+{
+  return libass.RenderImage(params.frameWidth, params.frameHeight, params.videoWidth,
+                            params.videoHeight, params.sourceWidth, params.sourceHeight, pts,
+                            params.useMargin, params.position, &changes);
+}
+
+std::shared_ptr<CLibassCache::SFrame> CLibassCache::Find(
+    const std::shared_ptr<CDVDSubtitlesLibass>& libass, double pts, const SParams& params) const
+{
+  for (const SEntry& entry : m_entries)
+  {
+    if (entry.libass == libass && entry.pts == pts && entry.params == params)
+      return entry.frame;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CLibassCache::SFrame> CLibassCache::Render(
+    const std::shared_ptr<CDVDSubtitlesLibass>& libass, double pts, const SParams& params)
+{
+  int changes = 0;
+  ASS_Image* images = RenderImage(*libass, pts, params, changes);
+
+  SLast& last = m_last[libass.get()];
+  if (changes == 0 && last.frame && last.params == params)
+    return last.frame;
+
+  auto frame = std::make_shared<SFrame>();
+  convert_quad(images, frame->quads, params.frameWidth);
+
+  last.libass = libass;
+  last.params = params;
+  last.frame = frame;
+  return frame;
+}
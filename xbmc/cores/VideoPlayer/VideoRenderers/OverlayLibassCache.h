@@ -0,0 +1,168 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "OverlayRendererUtil.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+
+class CDVDClock;
+class CDVDSubtitlesLibass;
+
+namespace OVERLAY
+{
+
+/*!
+ * \brief Renders ASS subtitles ahead of time on a worker thread
+ *
+ * The overlays of a video frame are queued when the frame is queued for
+ * rendering. The worker renders them with libass and packs the glyphs into
+ * an atlas, so that the render thread only has to upload and draw it.
+ * Frames that libass reports as unchanged share the atlas of the previous
+ * frame, which keeps its texture.
+ *
+ * Frames that the clock already passed are skipped, and frames more than a
+ * second of playback ahead of the clock wait. A frame that isn't ready when
+ * it is shown is rendered on the render thread, like before.
+ */
+class CLibassCache : private CThread
+{
+public:
+  /*!
+   * \brief Geometry that the subtitles are rendered with
+   */
+  struct SParams
+  {
+    int frameWidth = 0;
+    int frameHeight = 0;
+    int videoWidth = 0;
+    int videoHeight = 0;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    int useMargin = 0;
+    double position = 0.0;
+
+    bool operator==(const SParams& other) const;
+    bool operator!=(const SParams& other) const { return !(*this == other); }
+  };
+
+  /*!
+   * \brief The glyph atlas of a frame
+   */
+  struct SFrame
+  {
+    SQuads quads;
+    //! Texture of the atlas, set and used by the render thread only
+    unsigned int textureid = 0;
+  };
+
+  CLibassCache();
+  ~CLibassCache() override;
+
+  /*!
+   * \brief Set the clock of the player, prefetching is disabled without it
+   */
+  void SetClock(CDVDClock* clock);
+
+  /*!
+   * \brief Queue the subtitles of a frame that was queued for rendering
+   */
+  void Prefetch(const std::shared_ptr<CDVDSubtitlesLibass>& libass, double pts);
+
+  /*!
+   * \brief Get the atlas of a frame that is shown, renders it if it isn't prefetched
+   *
+   * Prefetched frames before pts are dropped, and the geometry is used for
+   * the following frames.
+   */
+  std::shared_ptr<SFrame> Get(const std::shared_ptr<CDVDSubtitlesLibass>& libass,
+                              double pts,
+                              const SParams& params);
+
+  /*!
+   * \brief Discard queued and prefetched frames, e.g. after a seek
+   */
+  void Flush();
+
+protected:
+  void Process() override;
+
+  /*!
+   * \brief Render a frame with libass, overridden by tests
+   *
+   * \param[out] changes 0 if the images equal those of the previous call
+   */
+  virtual ASS_Image* RenderImage(CDVDSubtitlesLibass& libass,
+                                 double pts,
+                                 const SParams& params,
+                                 int& changes);
+
+  /*!
+   * \brief Start the worker if it isn't running, overridden by tests
+   */
+  virtual void StartWorker();
+
+  /*!
+   * \brief Render the next queued frame that is due
+   *
+   * \return false if no frame is due
+   */
+  bool ProcessJob();
+
+private:
+  struct SJob
+  {
+    std::shared_ptr<CDVDSubtitlesLibass> libass;
+    double pts;
+  };
+
+  struct SEntry
+  {
+    std::shared_ptr<CDVDSubtitlesLibass> libass;
+    double pts;
+    SParams params;
+    std::shared_ptr<SFrame> frame;
+  };
+
+  struct SLast
+  {
+    std::shared_ptr<CDVDSubtitlesLibass> libass;
+    SParams params;
+    std::shared_ptr<SFrame> frame;
+  };
+
+  bool GetJob(SJob& job, SParams& params, unsigned int& generation);
+  std::shared_ptr<SFrame> Find(const std::shared_ptr<CDVDSubtitlesLibass>& libass,
+                               double pts,
+                               const SParams& params) const;
+  std::shared_ptr<SFrame> Render(const std::shared_ptr<CDVDSubtitlesLibass>& libass,
+                                 double pts,
+                                 const SParams& params);
+
+  CCriticalSection m_section;
+  CEvent m_jobEvent;
+  CDVDClock* m_clock = nullptr;
+  std::deque<SJob> m_jobs;
+  std::deque<SEntry> m_entries;
+  SParams m_params;
+  bool m_hasParams = false;
+  unsigned int m_generation = 0;
+
+  //! Serializes libass, whose change detection is relative to its last frame.
+  //! Taken before m_section when both are needed.
+  CCriticalSection m_renderSection;
+  std::map<const CDVDSubtitlesLibass*, SLast> m_last;
+};
+
+} // namespace OVERLAY
@@ -75,6 +75,9 @@ void CRenderer::AddOverlay(CDVDOverlay* o, double pts, int index)
   e.pts = pts;
   e.overlay_dvd = o->Acquire();
   m_buffers[index].push_back(e);
+
+  if (o->IsOverlayType(DVDOVERLAY_TYPE_SSA))
+    m_libassCache.Prefetch(static_cast<CDVDOverlaySSA*>(o)->GetLibass(), pts);
 }
 
 void CRenderer::Release(std::vector<SElement>& list)
@@ -97,6 +100,7 @@ void CRenderer::Flush()
     Release(buffer);
 
   ReleaseCache();
+  m_libassCache.Flush();
 
   g_fontManager.Unload(m_font);
   g_fontManager.Unload(m_fontBorder);
@@ -339,6 +343,11 @@ void CRenderer::SetStereoMode(const std::string &stereomode)
   m_stereomode = stereomode;
 }
 
+void CRenderer::SetClock(CDVDClock* clock)
+{
+  m_libassCache.SetClock(clock);
+}
+
 COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
 {
   if (!o || !o->GetLibass())
@@ -390,26 +399,33 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
   }
   else
     position = 0.0;
-  int changes = 0;
-  ASS_Image* images =
-      o->GetLibass()->RenderImage(targetWidth, targetHeight, videoWidth, videoHeight, sourceWidth,
-                                  sourceHeight, pts, useMargin, position, &changes);
-
-  if(o->m_textureid)
+  CLibassCache::SParams params;
+  params.frameWidth = targetWidth;
+  params.frameHeight = targetHeight;
+  params.videoWidth = videoWidth;
+  params.videoHeight = videoHeight;
+  params.sourceWidth = sourceWidth;
+  params.sourceHeight = sourceHeight;
+  params.useMargin = useMargin;
+  params.position = position;
+
+  // usually prefetched, frames that didn't change share the atlas and its texture
+  std::shared_ptr<CLibassCache::SFrame> frame = m_libassCache.Get(o->GetLibass(), pts, params);
+  if (frame->textureid)
   {
-    if(changes == 0)
+    std::map<unsigned int, COverlay*>::iterator it = m_textureCache.find(frame->textureid);
+    if (it != m_textureCache.end())
     {
-      std::map<unsigned int, COverlay*>::iterator it = m_textureCache.find(o->m_textureid);
-      if (it != m_textureCache.end())
-        return it->second;
+      o->m_textureid = frame->textureid;
+      return it->second;
     }
   }
 
   COverlay *overlay = NULL;
 #if defined(HAS_GL) || defined(HAS_GLES)
-  overlay = new COverlayGlyphGL(images, targetWidth, targetHeight);
+  overlay = new COverlayGlyphGL(frame->quads, targetWidth, targetHeight);
 #elif defined(HAS_DX)
-  overlay = new COverlayQuadsDX(images, targetWidth, targetHeight);
+  overlay = new COverlayQuadsDX(frame->quads, targetWidth, targetHeight);
 #endif
   // scale to video dimensions
   if (overlay)
@@ -421,6 +437,7 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
   }
   m_textureCache[m_textureid] = overlay;
   o->m_textureid = m_textureid;
+  frame->textureid = m_textureid;
   m_textureid++;
   return overlay;
 }
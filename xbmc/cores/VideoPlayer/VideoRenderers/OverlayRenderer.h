@@ -10,11 +10,13 @@
 #pragma once
 
 #include "BaseRenderer.h"
+#include "OverlayLibassCache.h"
 #include "threads/CriticalSection.h"
 
 #include <map>
 #include <vector>
 
+class CDVDClock;
 class CDVDOverlay;
 class CDVDOverlayImage;
 class CDVDOverlaySpu;
@@ -76,6 +78,7 @@ namespace OVERLAY {
     bool HasOverlay(int idx);
     void SetVideoRect(CRect &source, CRect &dest, CRect &view);
     void SetStereoMode(const std::string &stereomode);
+    void SetClock(CDVDClock* clock);
 
   protected:
 
@@ -101,6 +104,7 @@ namespace OVERLAY {
     CCriticalSection m_section;
     std::vector<SElement> m_buffers[NUM_BUFFERS];
     std::map<unsigned int, COverlay*> m_textureCache;
+    CLibassCache m_libassCache;
     static unsigned int m_textureid;
     CRect m_rv, m_rs, m_rd;
     std::string m_font, m_fontBorder;
@@ -17,10 +17,11 @@ class CDVDOverlay;
 class CDVDOverlayImage;
 class CDVDOverlaySpu;
 class CDVDOverlaySSA;
-typedef struct ass_image ASS_Image;
 
 namespace OVERLAY {
 
+  struct SQuads;
+
   class COverlayTextureGL : public COverlay
   {
   public:
@@ -39,7 +40,7 @@ namespace OVERLAY {
   class COverlayGlyphGL : public COverlay
   {
   public:
-   COverlayGlyphGL(ASS_Image* images, int width, int height);
+   COverlayGlyphGL(const SQuads& quads, int width, int height);
 
    ~COverlayGlyphGL() override;
 
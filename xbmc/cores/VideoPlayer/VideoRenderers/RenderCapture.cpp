@@ -8,6 +8,7 @@
 
 #include "RenderCapture.h"
 #include "ServiceBroker.h"
+#include "utils/ImageKernels.h"
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 #include "settings/AdvancedSettings.h"
@@ -387,16 +388,8 @@ void CRenderCaptureDX::SurfaceToBuffer()
   D3D11_MAPPED_SUBRESOURCE lockedRect;
   if (m_copyTex.LockRect(0, &lockedRect, D3D11_MAP_READ))
   {
-    //if pitch is same, do a direct copy, otherwise copy one line at a time
-    if (lockedRect.RowPitch == m_width * 4)
-    {
-      memcpy(m_pixels, lockedRect.pData, m_width * m_height * 4);
-    }
-    else
-    {
-      for (unsigned int y = 0; y < m_height; y++)
-        memcpy(m_pixels + y * m_width * 4, (uint8_t*)lockedRect.pData + y * lockedRect.RowPitch, m_width * 4);
-    }
+    CImageKernels::CopyPlane(m_pixels, m_width * 4, static_cast<const uint8_t*>(lockedRect.pData),
+                             lockedRect.RowPitch, m_width * 4, m_height);
     m_copyTex.UnlockRect(0);
     SetState(CAPTURESTATE_DONE);
   }
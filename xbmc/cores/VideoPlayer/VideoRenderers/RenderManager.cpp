@@ -21,6 +21,7 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/MathUtils.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/StringUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
@@ -48,6 +49,7 @@ CRenderManager::CRenderManager(CDVDClock &clock, IRenderMsg *player) :
   m_dvdClock(clock),
   m_playerPort(player)
 {
+  m_overlays.SetClock(&m_dvdClock);
 }
 
 CRenderManager::~CRenderManager()
@@ -282,6 +284,8 @@ bool CRenderManager::IsPresenting()
 
 void CRenderManager::FrameMove()
 {
+  PLAYBACK_TRACE_SCOPE("render", "CRenderManager::FrameMove");
+
   bool firstFrame = false;
   UpdateResolution();
 
@@ -817,6 +821,8 @@ bool CRenderManager::IsVideoLayer()
 /* simple present method */
 void CRenderManager::PresentSingle(bool clear, DWORD flags, DWORD alpha)
 {
+  PLAYBACK_TRACE_SCOPE("render", "CRenderManager::PresentSingle");
+
   SPresent& m = m_Queue[m_presentsource];
 
   if (m.presentfield == FS_BOT)
@@ -831,6 +837,8 @@ void CRenderManager::PresentSingle(bool clear, DWORD flags, DWORD alpha)
  * we just render the two fields right after eachother */
 void CRenderManager::PresentFields(bool clear, DWORD flags, DWORD alpha)
 {
+  PLAYBACK_TRACE_SCOPE("render", "CRenderManager::PresentFields");
+
   SPresent& m = m_Queue[m_presentsource];
 
   if(m_presentstep == PRESENT_FRAME)
@@ -851,6 +859,8 @@ void CRenderManager::PresentFields(bool clear, DWORD flags, DWORD alpha)
 
 void CRenderManager::PresentBlend(bool clear, DWORD flags, DWORD alpha)
 {
+  PLAYBACK_TRACE_SCOPE("render", "CRenderManager::PresentBlend");
+
   SPresent& m = m_Queue[m_presentsource];
 
   if( m.presentfield == FS_BOT )
@@ -923,6 +933,8 @@ void CRenderManager::ToggleDebugVideo()
 
 bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::atomic_bool& bStop, EINTERLACEMETHOD deintMethod, bool wait)
 {
+  PLAYBACK_TRACE_SCOPE("render", "CRenderManager::AddVideoPicture");
+
   CSingleLock lock(m_presentlock);
 
   if (m_free.empty())
@@ -1182,6 +1194,7 @@ void CRenderManager::PrepareNextRender()
       {
         m_discard.push_back(m_presentsourcePast);
         m_QueueSkip++;
+        CPlaybackTracer::Instant("render", "CRenderManager::SkipLateFrame");
       }
       m_presentsourcePast = m_queued.front();
       m_queued.pop_front();
@@ -1194,6 +1207,9 @@ void CRenderManager::PrepareNextRender()
     else
       m_lateframes = 0;
 
+    CPlaybackTracer::Counter("render", "lateframes", m_lateframes);
+    CPlaybackTracer::Instant("render", "CRenderManager::Flip");
+
     m_presentstep = PRESENT_FLIP;
     m_discard.push_back(m_presentsource);
     m_presentsource = idx;
@@ -1206,6 +1222,8 @@ void CRenderManager::PrepareNextRender()
   else if (!combined && renderPts > (nextFramePts - frametime))
   {
     m_lateframes = 0;
+    CPlaybackTracer::Instant("render", "CRenderManager::Flip");
+
     m_presentstep = PRESENT_FLIP;
     m_presentsourcePast = m_presentsource;
     m_presentsource = m_queued.front();
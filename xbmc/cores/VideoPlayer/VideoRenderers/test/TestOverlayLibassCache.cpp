@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDClock.h"
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitlesLibass.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "cores/VideoPlayer/VideoRenderers/OverlayLibassCache.h"
+
+#include <functional>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using namespace OVERLAY;
+
+namespace
+{
+
+constexpr double CLOCK = 10.0 * DVD_TIME_BASE;
+
+// Renders a single opaque glyph instead of calling libass, and runs the jobs
+// on the test thread instead of the worker
+class CTestLibassCache : public CLibassCache
+{
+public:
+  using CLibassCache::ProcessJob;
+
+  int renders = 0;
+  int reportedChanges = 1;
+  std::function<void()> onRender;
+
+protected:
+  ASS_Image* RenderImage(CDVDSubtitlesLibass& libass,
+                         double pts,
+                         const SParams& params,
+                         int& changes) override
+  {
+    renders++;
+    changes = reportedChanges;
+
+    if (onRender)
+    {
+      auto callback = std::move(onRender);
+      onRender = nullptr;
+      callback();
+    }
+
+    m_image = {};
+    m_image.w = 2;
+    m_image.h = 2;
+    m_image.stride = 2;
+    m_image.bitmap = m_bitmap;
+    m_image.color = 0xffffff00;
+    return &m_image;
+  }
+
+  void StartWorker() override {}
+
+private:
+  ASS_Image m_image;
+  unsigned char m_bitmap[4] = {0xff, 0xff, 0xff, 0xff};
+};
+
+class TestOverlayLibassCache : public ::testing::Test
+{
+protected:
+  TestOverlayLibassCache()
+  {
+    // a paused clock doesn't move, and runs at normal speed when resumed
+    clock.SetSpeed(DVD_PLAYSPEED_PAUSE);
+    clock.Discontinuity(CLOCK);
+    cache.SetClock(&clock);
+
+    params.frameWidth = 1920;
+    params.frameHeight = 1080;
+    params.videoWidth = 1920;
+    params.videoHeight = 1080;
+    params.sourceWidth = 1920;
+    params.sourceHeight = 1080;
+  }
+
+  double Pts(double seconds) const { return CLOCK + seconds * DVD_TIME_BASE; }
+
+  CDVDClock clock;
+  CTestLibassCache cache;
+  std::shared_ptr<CDVDSubtitlesLibass> libass = std::make_shared<CDVDSubtitlesLibass>();
+  CLibassCache::SParams params;
+};
+
+} // namespace
+
+TEST_F(TestOverlayLibassCache, WaitsForGeometry)
+{
+  cache.Prefetch(libass, Pts(0.1));
+  EXPECT_FALSE(cache.ProcessJob());
+
+  cache.Get(libass, Pts(0.0), params);
+  EXPECT_TRUE(cache.ProcessJob());
+  EXPECT_EQ(2, cache.renders);
+}
+
+TEST_F(TestOverlayLibassCache, HandsOffPrefetchedFrame)
+{
+  cache.Get(libass, Pts(0.0), params);
+  cache.Prefetch(libass, Pts(0.1));
+  ASSERT_TRUE(cache.ProcessJob());
+  ASSERT_EQ(2, cache.renders);
+
+  auto frame = cache.Get(libass, Pts(0.1), params);
+  ASSERT_NE(nullptr, frame);
+  EXPECT_EQ(1, frame->quads.count);
+  EXPECT_EQ(2, cache.renders);
+}
+
+TEST_F(TestOverlayLibassCache, DropsLateFrames)
+{
+  cache.Get(libass, Pts(0.0), params);
+  cache.Prefetch(libass, Pts(-1.0));
+  cache.Prefetch(libass, Pts(0.5));
+
+  // the late frame is skipped, the next one is rendered
+  EXPECT_TRUE(cache.ProcessJob());
+  EXPECT_FALSE(cache.ProcessJob());
+  EXPECT_EQ(2, cache.renders);
+
+  cache.Get(libass, Pts(0.5), params);
+  EXPECT_EQ(2, cache.renders);
+}
+
+TEST_F(TestOverlayLibassCache, WaitsForFramesAhead)
+{
+  cache.Get(libass, Pts(0.0), params);
+  cache.Prefetch(libass, Pts(1.5));
+  EXPECT_FALSE(cache.ProcessJob());
+
+  // twice the speed renders twice as far ahead
+  clock.SetSpeed(DVD_PLAYSPEED_NORMAL * 2);
+  EXPECT_TRUE(cache.ProcessJob());
+}
+
+TEST_F(TestOverlayLibassCache, LimitsEntries)
+{
+  cache.Get(libass, Pts(0.0), params);
+  for (int i = 1; i <= 33; i++)
+    cache.Prefetch(libass, Pts(0.01 * i));
+
+  for (int i = 1; i <= 32; i++)
+    EXPECT_TRUE(cache.ProcessJob()) << "entry " << i;
+  EXPECT_FALSE(cache.ProcessJob());
+
+  // showing a frame releases the entries before it
+  cache.Get(libass, Pts(0.02), params);
+  EXPECT_TRUE(cache.ProcessJob());
+  EXPECT_EQ(34, cache.renders);
+}
+
+TEST_F(TestOverlayLibassCache, FlushDiscardsJobs)
+{
+  cache.Get(libass, Pts(0.0), params);
+  cache.Prefetch(libass, Pts(0.1));
+  cache.Flush();
+  EXPECT_FALSE(cache.ProcessJob());
+}
+
+TEST_F(TestOverlayLibassCache, FlushDiscardsFrameInProgress)
+{
+  cache.Get(libass, Pts(0.0), params);
+  cache.Prefetch(libass, Pts(0.1));
+  cache.onRender = [this]() { cache.Flush(); };
+  ASSERT_TRUE(cache.ProcessJob());
+  ASSERT_EQ(2, cache.renders);
+
+  // the frame of the previous generation isn't handed out
+  cache.Get(libass, Pts(0.1), params);
+  EXPECT_EQ(3, cache.renders);
+}
+
+TEST_F(TestOverlayLibassCache, SharesUnchangedFrames)
+{
+  auto first = cache.Get(libass, Pts(0.0), params);
+
+  cache.reportedChanges = 0;
+  auto second = cache.Get(libass, Pts(0.1), params);
+  EXPECT_EQ(first, second);
+
+  // the atlas depends on the geometry
+  params.frameWidth = 1280;
+  auto third = cache.Get(libass, Pts(0.2), params);
+  EXPECT_NE(first, third);
+}
@@ -0,0 +1,194 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/ThumbExtractionService.h"
+#include "test/MtTestUtils.h"
+#include "utils/Job.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace ConditionPoll;
+
+namespace
+{
+class CTestThumbExtractionService : public CThumbExtractionService
+{
+public:
+  using CThumbExtractionService::CanReuse;
+  using CThumbExtractionService::CThumbExtractionService;
+  using CThumbExtractionService::GetLowres;
+};
+
+CDVDStreamInfo Hint(AVCodecID codec, int width, int height)
+{
+  CDVDStreamInfo hint;
+  hint.codec = codec;
+  hint.width = width;
+  hint.height = height;
+  return hint;
+}
+
+void SetExtraData(CDVDStreamInfo& hint, const std::string& data)
+{
+  if (hint.extradata && hint.extrasize)
+    free(hint.extradata);
+
+  hint.extradata = malloc(data.size());
+  memcpy(hint.extradata, data.data(), data.size());
+  hint.extrasize = static_cast<unsigned int>(data.size());
+}
+
+struct JobState
+{
+  std::atomic<bool> release{false};
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+};
+
+// Runs until the test releases it
+class CTestJob : public CJob
+{
+public:
+  CTestJob(JobState& state, int id) : m_state(state), m_id(id) {}
+
+  bool DoWork() override
+  {
+    const int running = ++m_state.running;
+    int maxRunning = m_state.maxRunning;
+    while (running > maxRunning && !m_state.maxRunning.compare_exchange_weak(maxRunning, running))
+    {
+    }
+
+    while (!m_state.release)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    m_state.running--;
+    return true;
+  }
+
+  bool operator==(const CJob* job) const override
+  {
+    const CTestJob* other = dynamic_cast<const CTestJob*>(job);
+    return other && other->m_id == m_id;
+  }
+
+private:
+  JobState& m_state;
+  const int m_id;
+};
+
+class CTestCallback : public IJobCallback
+{
+public:
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override { completed++; }
+
+  std::atomic<int> completed{0};
+};
+} // namespace
+
+TEST(TestThumbExtractionService, GetLowres)
+{
+  // decode at the smallest size that is still as wide as the thumbnail
+  EXPECT_EQ(CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_MPEG2VIDEO, 1920, 1080), 320),
+            2);
+  EXPECT_EQ(CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_MPEG2VIDEO, 1920, 1080), 960),
+            1);
+  EXPECT_EQ(
+      CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_MPEG2VIDEO, 1920, 1080), 1920), 0);
+
+  // limited to 1/8 of the size
+  EXPECT_EQ(CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_MPEG2VIDEO, 7680, 4320), 320),
+            3);
+
+  // the codec doesn't support it, or the size is unknown
+  EXPECT_EQ(CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_H264, 1920, 1080), 320), 0);
+  EXPECT_EQ(CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_MPEG2VIDEO, 0, 0), 320), 0);
+  EXPECT_EQ(CTestThumbExtractionService::GetLowres(Hint(AV_CODEC_ID_MPEG2VIDEO, 1920, 1080), 0),
+            0);
+}
+
+TEST(TestThumbExtractionService, CanReuse)
+{
+  CThumbExtractionService::Decoder decoder;
+  decoder.hint = Hint(AV_CODEC_ID_MPEG2VIDEO, 1920, 1080);
+  decoder.keyframesOnly = true;
+  decoder.lowres = 2;
+
+  CDVDStreamInfo hint = Hint(AV_CODEC_ID_MPEG2VIDEO, 1920, 1080);
+  EXPECT_TRUE(CTestThumbExtractionService::CanReuse(decoder, hint, 2, true));
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(decoder, hint, 1, true));
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(decoder, hint, 2, false));
+
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(
+      decoder, Hint(AV_CODEC_ID_MPEG2VIDEO, 1280, 720), 2, true));
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(
+      decoder, Hint(AV_CODEC_ID_MPEG4, 1920, 1080), 2, true));
+
+  hint.profile = 4;
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(decoder, hint, 2, true));
+  hint.profile = decoder.hint.profile;
+
+  // the decoder is configured from the extradata
+  SetExtraData(decoder.hint, "header");
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(decoder, hint, 2, true));
+  SetExtraData(hint, "header");
+  EXPECT_TRUE(CTestThumbExtractionService::CanReuse(decoder, hint, 2, true));
+  SetExtraData(hint, "HEADER");
+  EXPECT_FALSE(CTestThumbExtractionService::CanReuse(decoder, hint, 2, true));
+}
+
+TEST(TestThumbExtractionService, BoundsJobs)
+{
+  CTestThumbExtractionService service(1);
+  CTestCallback callback;
+  JobState state;
+
+  for (int i = 0; i < 3; i++)
+    service.AddJob(new CTestJob(state, i), &callback);
+
+  // equals a queued job
+  service.AddJob(new CTestJob(state, 2), &callback);
+
+  EXPECT_TRUE(poll([&state]() { return state.running == 1; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(state.running, 1);
+
+  state.release = true;
+  EXPECT_TRUE(poll([&callback]() { return callback.completed == 3; }));
+  EXPECT_EQ(state.maxRunning, 1);
+}
+
+TEST(TestThumbExtractionService, CancelJobs)
+{
+  CTestThumbExtractionService service(1);
+  CTestCallback callback;
+  JobState state;
+
+  for (int i = 0; i < 3; i++)
+    service.AddJob(new CTestJob(state, i), &callback);
+  EXPECT_TRUE(poll([&state]() { return state.running == 1; }));
+
+  // the running job finishes, the queued ones are dropped
+  service.CancelJobs(&callback);
+  state.release = true;
+  EXPECT_TRUE(poll([&state]() { return state.running == 0; }));
+
+  // the worker of the cancelled job is free again
+  CTestCallback other;
+  service.AddJob(new CTestJob(state, 0), &other);
+  EXPECT_TRUE(poll([&other]() { return other.completed == 1; }));
+  EXPECT_EQ(callback.completed, 0);
+}
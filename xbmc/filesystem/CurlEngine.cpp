@@ -0,0 +1,372 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CurlEngine.h"
+
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <utility>
+
+using namespace XCURL;
+
+namespace
+{
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+// Time to wait for socket activity when no transfer needs a timeout sooner
+constexpr int IDLE_TIMEOUT_MS = 1000;
+#else
+// Without curl_multi_wakeup() the thread polls for new commands instead
+constexpr int POLL_TIMEOUT_MS = 50;
+#endif
+} // namespace
+
+CCurlEngine::CCurlEngine() : CThread("CurlEngine")
+{
+  m_multiHandle = curl_multi_init();
+  if (m_multiHandle == nullptr)
+  {
+    CLog::Log(LOGERROR, "CCurlEngine::{} - Failed to create multi handle", __FUNCTION__);
+  }
+  else
+  {
+    // Multiplex HTTP/2 streams to the same host over a single connection
+    curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  }
+
+  m_shareHandle = curl_share_init();
+  if (m_shareHandle != nullptr)
+  {
+    curl_share_setopt(m_shareHandle, CURLSHOPT_LOCKFUNC, LockShare);
+    curl_share_setopt(m_shareHandle, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+    curl_share_setopt(m_shareHandle, CURLSHOPT_USERDATA, this);
+    // Not the connection cache, which curl doesn't support sharing between handles that
+    // are performed on different threads. The transfers of the multi handle share its
+    // connection cache anyway.
+    curl_share_setopt(m_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
+}
+
+CCurlEngine::~CCurlEngine()
+{
+  Stop();
+
+  if (m_multiHandle != nullptr)
+    curl_multi_cleanup(m_multiHandle);
+
+  if (m_shareHandle != nullptr)
+    curl_share_cleanup(m_shareHandle);
+}
+
+void CCurlEngine::Share(CURL_HANDLE* easyHandle)
+{
+  if (m_shareHandle != nullptr)
+    curl_easy_setopt(easyHandle, CURLOPT_SHARE, m_shareHandle);
+}
+
+void CCurlEngine::AddTransfer(CURL_HANDLE* easyHandle, DoneCallback callback)
+{
+  if (m_multiHandle == nullptr)
+  {
+    if (callback)
+      callback(CURLE_FAILED_INIT);
+    return;
+  }
+
+  // Prefer waiting for a connection that can be multiplexed over opening a new one
+  curl_easy_setopt(easyHandle, CURLOPT_PIPEWAIT, 1L);
+
+  {
+    CSingleLock lock(m_commandSection);
+
+    m_commands.emplace_back(Command{CommandType::ADD, easyHandle, std::move(callback), nullptr});
+
+    if (!m_bStarted)
+      Start();
+  }
+
+  Wakeup();
+}
+
+void CCurlEngine::RemoveTransfer(CURL_HANDLE* easyHandle)
+{
+  CEvent doneEvent;
+
+  // From a callback, curl doesn't allow removing handles from the multi handle. Stop the
+  // transfer and remove it once curl_multi_perform() returns.
+  if (IsCurrentThread())
+  {
+    auto it = m_transfers.find(easyHandle);
+    if (it != m_transfers.end())
+    {
+      curl_easy_pause(easyHandle, CURLPAUSE_ALL);
+      m_transfers.erase(it);
+      m_removals.emplace_back(easyHandle);
+
+      CSingleLock lock(m_commandSection);
+      m_transferCount = m_transfers.size();
+    }
+    return;
+  }
+
+  {
+    CSingleLock lock(m_commandSection);
+
+    // Without a running event thread, remove it directly
+    if (!m_bStarted)
+    {
+      Command command{CommandType::REMOVE, easyHandle, nullptr, nullptr};
+      ProcessCommand(command);
+      return;
+    }
+
+    m_commands.emplace_back(Command{CommandType::REMOVE, easyHandle, nullptr, &doneEvent});
+  }
+
+  Wakeup();
+
+  doneEvent.Wait();
+}
+
+void CCurlEngine::Unpause(CURL_HANDLE* easyHandle)
+{
+  // From a callback, resume it directly
+  if (IsCurrentThread())
+  {
+    curl_easy_pause(easyHandle, CURLPAUSE_CONT);
+    return;
+  }
+
+  {
+    CSingleLock lock(m_commandSection);
+
+    m_commands.emplace_back(Command{CommandType::UNPAUSE, easyHandle, nullptr, nullptr});
+  }
+
+  Wakeup();
+}
+
+void CCurlEngine::Stop()
+{
+  {
+    CSingleLock lock(m_commandSection);
+    if (!m_bStarted)
+      return;
+  }
+
+  CThread::StopThread(false);
+  Wakeup();
+  CThread::StopThread(true);
+
+  CSingleLock lock(m_commandSection);
+  m_bStarted = false;
+
+  // Fail commands that were queued while the thread was exiting
+  ProcessCommands();
+}
+
+size_t CCurlEngine::GetTransferCount() const
+{
+  CSingleLock lock(m_commandSection);
+  return m_transferCount;
+}
+
+void CCurlEngine::Start()
+{
+  m_bStarted = true;
+  Create();
+}
+
+void CCurlEngine::Wakeup()
+{
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  if (m_multiHandle != nullptr)
+    curl_multi_wakeup(m_multiHandle);
+#endif
+}
+
+void CCurlEngine::Process()
+{
+  CLog::Log(LOGDEBUG, "CCurlEngine::{} - Started", __FUNCTION__);
+
+  while (!m_bStop)
+  {
+    ProcessCommands();
+
+    int runningHandles = 0;
+    const CURLMcode result = curl_multi_perform(m_multiHandle, &runningHandles);
+    if (result != CURLM_OK)
+      CLog::Log(LOGERROR, "CCurlEngine::{} - Multi perform failed with code {}", __FUNCTION__,
+                result);
+
+    ProcessRemovals();
+    ProcessMessages();
+
+    if (m_bStop)
+      break;
+
+    // Sleep until there is socket activity, a transfer times out or a command
+    // is queued
+    int numfds = 0;
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+    curl_multi_poll(m_multiHandle, nullptr, 0, IDLE_TIMEOUT_MS, &numfds);
+#else
+    curl_multi_wait(m_multiHandle, nullptr, 0, POLL_TIMEOUT_MS, &numfds);
+#endif
+  }
+
+  // Fail everything that is left so that no caller waits forever
+  ProcessCommands();
+  ProcessRemovals();
+  RemoveAll();
+
+  CLog::Log(LOGDEBUG, "CCurlEngine::{} - Stopped", __FUNCTION__);
+}
+
+void CCurlEngine::ProcessCommands()
+{
+  std::vector<Command> commands;
+
+  {
+    CSingleLock lock(m_commandSection);
+    commands.swap(m_commands);
+  }
+
+  for (Command& command : commands)
+    ProcessCommand(command);
+}
+
+void CCurlEngine::ProcessCommand(Command& command)
+{
+  switch (command.type)
+  {
+    case CommandType::ADD:
+    {
+      CURLMcode result = CURLM_BAD_HANDLE;
+      if (!m_bStop)
+        result = curl_multi_add_handle(m_multiHandle, command.easyHandle);
+
+      if (result == CURLM_OK)
+      {
+        m_transfers[command.easyHandle] = std::move(command.callback);
+      }
+      else
+      {
+        if (!m_bStop)
+          CLog::Log(LOGERROR, "CCurlEngine::{} - Failed to add transfer with code {}",
+                    __FUNCTION__, result);
+
+        if (command.callback)
+          command.callback(CURLE_ABORTED_BY_CALLBACK);
+      }
+      break;
+    }
+    case CommandType::REMOVE:
+    {
+      auto it = m_transfers.find(command.easyHandle);
+      if (it != m_transfers.end())
+      {
+        curl_multi_remove_handle(m_multiHandle, command.easyHandle);
+        m_transfers.erase(it);
+      }
+
+      if (command.doneEvent != nullptr)
+        command.doneEvent->Set();
+      break;
+    }
+    case CommandType::UNPAUSE:
+    {
+      if (m_transfers.find(command.easyHandle) != m_transfers.end())
+        curl_easy_pause(command.easyHandle, CURLPAUSE_CONT);
+      break;
+    }
+    default:
+      break;
+  }
+
+  CSingleLock lock(m_commandSection);
+  m_transferCount = m_transfers.size();
+}
+
+void CCurlEngine::ProcessRemovals()
+{
+  for (CURL_HANDLE* easyHandle : m_removals)
+    curl_multi_remove_handle(m_multiHandle, easyHandle);
+
+  m_removals.clear();
+}
+
+void CCurlEngine::ProcessMessages()
+{
+  int msgsInQueue = 0;
+  CURLMsg* msg;
+
+  while ((msg = curl_multi_info_read(m_multiHandle, &msgsInQueue)) != nullptr)
+  {
+    if (msg->msg != CURLMSG_DONE)
+      continue;
+
+    CURL_HANDLE* easyHandle = msg->easy_handle;
+    const CURLcode result = msg->data.result;
+
+    auto it = m_transfers.find(easyHandle);
+    if (it == m_transfers.end())
+      continue;
+
+    DoneCallback callback = std::move(it->second);
+    m_transfers.erase(it);
+
+    curl_multi_remove_handle(m_multiHandle, easyHandle);
+
+    {
+      CSingleLock lock(m_commandSection);
+      m_transferCount = m_transfers.size();
+    }
+
+    if (callback)
+      callback(result);
+  }
+}
+
+void CCurlEngine::RemoveAll()
+{
+  std::map<CURL_HANDLE*, DoneCallback> transfers;
+  transfers.swap(m_transfers);
+
+  {
+    CSingleLock lock(m_commandSection);
+    m_transferCount = 0;
+  }
+
+  for (auto& transfer : transfers)
+  {
+    curl_multi_remove_handle(m_multiHandle, transfer.first);
+
+    if (transfer.second)
+      transfer.second(CURLE_ABORTED_BY_CALLBACK);
+  }
+}
+
+void CCurlEngine::LockShare(CURL_HANDLE* handle,
+                            curl_lock_data data,
+                            curl_lock_access access,
+                            void* userptr)
+{
+  CCurlEngine* engine = static_cast<CCurlEngine*>(userptr);
+  if (data < CURL_LOCK_DATA_LAST)
+    engine->m_shareLocks[data].lock();
+}
+
+void CCurlEngine::UnlockShare(CURL_HANDLE* handle, curl_lock_data data, void* userptr)
+{
+  CCurlEngine* engine = static_cast<CCurlEngine*>(userptr);
+  if (data < CURL_LOCK_DATA_LAST)
+    engine->m_shareLocks[data].unlock();
+}
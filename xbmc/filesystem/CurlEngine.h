@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#define CURL CURL_HANDLE
+#include <curl/curl.h>
+#undef CURL
+
+class CEvent;
+
+namespace XCURL
+{
+/*!
+ * \brief Process-wide engine that drives curl transfers
+ *
+ * All transfers run on a single multi handle, which is driven by one event
+ * thread. Connections are cached across all transfers, and HTTP/2 streams to
+ * the same host are multiplexed over one connection. DNS lookups and TLS
+ * sessions are also shared with handles that are performed outside of the
+ * engine.
+ *
+ * Curl callbacks of a transfer (write, read, header, ...) are invoked on the
+ * event thread. A transfer that can't accept more data should pause itself
+ * from its callback and be resumed with Unpause().
+ *
+ * All functions are thread safe.
+ */
+class CCurlEngine : private CThread
+{
+public:
+  /*!
+   * \brief Called on the event thread when a transfer is done
+   *
+   * The transfer has been removed from the engine when this is called.
+   */
+  using DoneCallback = std::function<void(CURLcode result)>;
+
+  CCurlEngine();
+  ~CCurlEngine() override;
+
+  /*!
+   * \brief Set up an easy handle to use the DNS and TLS session caches of the engine
+   *
+   * Also useful for handles performed outside of the engine.
+   */
+  void Share(CURL_HANDLE* easyHandle);
+
+  /*!
+   * \brief Start a transfer
+   *
+   * \param easyHandle The fully configured easy handle
+   * \param callback Called when the transfer is done, unless it is removed first
+   */
+  void AddTransfer(CURL_HANDLE* easyHandle, DoneCallback callback);
+
+  /*!
+   * \brief Stop a transfer
+   *
+   * When this returns, no more callbacks will be invoked for the transfer
+   * and the easy handle can be reused. Does nothing if the transfer is done.
+   *
+   * From a callback, the transfer is paused and the easy handle can only be
+   * reused after the callback returns.
+   */
+  void RemoveTransfer(CURL_HANDLE* easyHandle);
+
+  /*!
+   * \brief Resume a transfer that was paused from one of its callbacks
+   */
+  void Unpause(CURL_HANDLE* easyHandle);
+
+  /*!
+   * \brief Stop the event thread and all transfers
+   */
+  void Stop();
+
+  /*!
+   * \brief Get the number of transfers in progress
+   */
+  size_t GetTransferCount() const;
+
+protected:
+  // implementation of CThread
+  void Process() override;
+
+private:
+  enum class CommandType
+  {
+    ADD,
+    REMOVE,
+    UNPAUSE,
+  };
+
+  struct Command
+  {
+    CommandType type;
+    CURL_HANDLE* easyHandle;
+    DoneCallback callback;
+    CEvent* doneEvent;
+  };
+
+  void Start();
+  void Wakeup();
+  void ProcessCommands();
+  void ProcessCommand(Command& command);
+  void ProcessRemovals();
+  void ProcessMessages();
+  void RemoveAll();
+
+  static void LockShare(CURL_HANDLE* handle,
+                        curl_lock_data data,
+                        curl_lock_access access,
+                        void* userptr);
+  static void UnlockShare(CURL_HANDLE* handle, curl_lock_data data, void* userptr);
+
+  // Curl handles
+  CURLM* m_multiHandle = nullptr;
+  CURLSH* m_shareHandle = nullptr;
+  CCriticalSection m_shareLocks[CURL_LOCK_DATA_LAST];
+
+  // Owned by the event thread
+  std::map<CURL_HANDLE*, DoneCallback> m_transfers;
+  std::vector<CURL_HANDLE*> m_removals; ///< Removed from a callback, still on the multi handle
+
+  // Commands for the event thread
+  std::vector<Command> m_commands;
+  mutable CCriticalSection m_commandSection;
+  bool m_bStarted = false;
+  size_t m_transferCount = 0;
+};
+} // namespace XCURL
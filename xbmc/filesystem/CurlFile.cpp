@@ -8,6 +8,7 @@
 
 #include "CurlFile.h"
 
+#include "CurlEngine.h"
 #include "File.h"
 #include "ServiceBroker.h"
 #include "URL.h"
@@ -17,6 +18,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/Base64.h"
 #include "utils/XTimeUtils.h"
@@ -166,12 +168,15 @@ size_t CCurlFile::CReadState::HeaderCallback(void *ptr, size_t size, size_t nmem
 
 size_t CCurlFile::CReadState::ReadCallback(char *buffer, size_t size, size_t nitems)
 {
+  CSingleLock lock(m_stateSection);
+
   if (m_fileSize == 0)
     return 0;
 
   if (m_filePos >= m_fileSize)
   {
     m_isPaused = true;
+    m_dataEvent.Set();
     return CURL_READFUNC_PAUSE;
   }
 
@@ -185,6 +190,9 @@ size_t CCurlFile::CReadState::ReadCallback(char *buffer, size_t size, size_t nit
 size_t CCurlFile::CReadState::WriteCallback(char *buffer, size_t size, size_t nitems)
 {
   unsigned int amount = size * nitems;
+
+  CSingleLock lock(m_stateSection);
+
   if (m_overflowSize)
   {
     // we have our overflow buffer - first get rid of as much as we can
@@ -209,6 +217,16 @@ size_t CCurlFile::CReadState::WriteCallback(char *buffer, size_t size, size_t ni
       m_overflowBuffer = (char*)realloc_simple(m_overflowBuffer, m_overflowSize);
     }
   }
+
+  // the reader is behind, pause until it makes room. curl delivers the same
+  // data again when the transfer is resumed.
+  if (m_overflowSize || m_buffer.getMaxWriteSize() == 0)
+  {
+    m_writePaused = true;
+    m_dataEvent.Set();
+    return CURL_WRITEFUNC_PAUSE;
+  }
+
   // ok, now copy the data into our ring buffer
   unsigned int maxWriteable = std::min(m_buffer.getMaxWriteSize(), amount);
   if (maxWriteable)
@@ -241,13 +259,13 @@ size_t CCurlFile::CReadState::WriteCallback(char *buffer, size_t size, size_t ni
     memcpy(m_overflowBuffer + m_overflowSize, buffer, amount);
     m_overflowSize += amount;
   }
+  m_dataEvent.Set();
   return size * nitems;
 }
 
 CCurlFile::CReadState::CReadState()
 {
   m_easyHandle = NULL;
-  m_multiHandle = NULL;
   m_overflowBuffer = NULL;
   m_overflowSize = 0;
   m_stillRunning = 0;
@@ -263,6 +281,10 @@ CCurlFile::CReadState::CReadState()
   m_bRetry = true;
   m_curlHeaderList = NULL;
   m_curlAliasList = NULL;
+  m_transferActive = false;
+  m_writePaused = false;
+  m_resultPending = false;
+  m_result = CURLE_OK;
 }
 
 CCurlFile::CReadState::~CReadState()
@@ -270,7 +292,7 @@ CCurlFile::CReadState::~CReadState()
   Disconnect();
 
   if(m_easyHandle)
-    g_curlInterface.easy_release(&m_easyHandle, &m_multiHandle);
+    g_curlInterface.easy_release(&m_easyHandle, NULL);
 }
 
 bool CCurlFile::CReadState::Seek(int64_t pos)
@@ -345,7 +367,6 @@ long CCurlFile::CReadState::Connect(unsigned int size)
               fmt::ptr(this), m_filePos);
 
   SetResume();
-  g_curlInterface.multi_add_handle(m_multiHandle, m_easyHandle);
 
   m_bufferSize = size;
   m_buffer.Destroy();
@@ -354,7 +375,7 @@ long CCurlFile::CReadState::Connect(unsigned int size)
 
   // read some data in to try and obtain the length
   // maybe there's a better way to get this info??
-  m_stillRunning = 1;
+  StartTransfer();
 
   // (Try to) fill buffer
   if (FillBuffer(1) != FILLBUFFER_OK)
@@ -384,8 +405,7 @@ long CCurlFile::CReadState::Connect(unsigned int size)
 
 void CCurlFile::CReadState::Disconnect()
 {
-  if(m_multiHandle && m_easyHandle)
-    g_curlInterface.multi_remove_handle(m_multiHandle, m_easyHandle);
+  StopTransfer();
 
   m_buffer.Clear();
   free(m_overflowBuffer);
@@ -406,6 +426,62 @@ void CCurlFile::CReadState::Disconnect()
   m_curlAliasList = NULL;
 }
 
+void CCurlFile::CReadState::StartTransfer()
+{
+  {
+    CSingleLock lock(m_stateSection);
+    m_stillRunning = 1;
+    m_writePaused = false;
+    m_resultPending = false;
+    m_result = CURLE_OK;
+  }
+
+  m_transferActive = true;
+  g_curlInterface.GetEngine().AddTransfer(m_easyHandle,
+                                          [this](CURLcode result) { OnTransferDone(result); });
+}
+
+void CCurlFile::CReadState::StopTransfer()
+{
+  if (m_transferActive)
+  {
+    // no more callbacks once this returns
+    g_curlInterface.GetEngine().RemoveTransfer(m_easyHandle);
+    m_transferActive = false;
+  }
+
+  CSingleLock lock(m_stateSection);
+  m_stillRunning = 0;
+  m_writePaused = false;
+  m_resultPending = false;
+}
+
+void CCurlFile::CReadState::OnTransferDone(int result)
+{
+  {
+    CSingleLock lock(m_stateSection);
+    m_result = result;
+    m_resultPending = true;
+    m_stillRunning = 0;
+  }
+
+  m_dataEvent.Set();
+}
+
+void CCurlFile::CReadState::ResumeTransfer()
+{
+  {
+    CSingleLock lock(m_stateSection);
+
+    if (!m_writePaused || m_buffer.getMaxWriteSize() == 0)
+      return;
+
+    m_writePaused = false;
+  }
+
+  g_curlInterface.GetEngine().Unpause(m_easyHandle);
+}
+
 
 CCurlFile::~CCurlFile()
 {
@@ -478,6 +554,9 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
 
   g_curlInterface.easy_reset(h);
 
+  // share DNS lookups and TLS sessions with all other transfers
+  g_curlInterface.GetEngine().Share(h);
+
   g_curlInterface.easy_setopt(h, CURLOPT_DEBUGFUNCTION, debug_callback);
 
   if( CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_logLevel >= LOG_LEVEL_DEBUG )
@@ -1086,12 +1165,10 @@ bool CCurlFile::Open(const CURL& url)
   std::string redactPath = CURL::GetRedacted(m_url);
   CLog::Log(LOGDEBUG, "CurlFile::{} - <{}>", __FUNCTION__, redactPath);
 
-  assert(!(!m_state->m_easyHandle ^ !m_state->m_multiHandle));
   if( m_state->m_easyHandle == NULL )
     g_curlInterface.easy_acquire(url2.GetProtocol().c_str(),
                                 url2.GetHostName().c_str(),
-                                &m_state->m_easyHandle,
-                                &m_state->m_multiHandle);
+                                &m_state->m_easyHandle, NULL);
 
   // setup common curl options
   SetCommonOptions(m_state,
@@ -1196,8 +1273,7 @@ bool CCurlFile::OpenForWrite(const CURL& url, bool bOverWrite)
   assert(m_state->m_easyHandle == NULL);
   g_curlInterface.easy_acquire(url2.GetProtocol().c_str(),
                               url2.GetHostName().c_str(),
-                              &m_state->m_easyHandle,
-                              &m_state->m_multiHandle);
+                              &m_state->m_easyHandle, NULL);
 
   // setup common curl options
   SetCommonOptions(m_state);
@@ -1212,12 +1288,10 @@ bool CCurlFile::OpenForWrite(const CURL& url, bool bOverWrite)
   m_inError = false;
   m_writeOffset = 0;
 
-  assert(m_state->m_multiHandle);
-
   g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_UPLOAD, 1);
 
-  g_curlInterface.multi_add_handle(m_state->m_multiHandle, m_state->m_easyHandle);
-
+  // the transfer is started by the first write, so that it doesn't see the
+  // empty read buffer as the end of the upload
   m_state->SetReadBuffer(NULL, 0);
 
   return true;
@@ -1228,31 +1302,38 @@ ssize_t CCurlFile::Write(const void* lpBuf, size_t uiBufSize)
   if (!(m_opened && m_forWrite) || m_inError)
     return -1;
 
-  assert(m_state->m_multiHandle);
-
   m_state->SetReadBuffer(lpBuf, uiBufSize);
-  m_state->m_isPaused = false;
-  g_curlInterface.easy_pause(m_state->m_easyHandle, CURLPAUSE_CONT);
 
-  CURLMcode result = CURLM_OK;
+  // the read callback pauses the transfer when it has consumed the buffer
+  if (!m_state->m_transferActive)
+    m_state->StartTransfer();
+  else
+    g_curlInterface.GetEngine().Unpause(m_state->m_easyHandle);
 
-  m_stillRunning = 1;
-  while (m_stillRunning && !m_state->m_isPaused)
+  while (true)
   {
-    while ((result = g_curlInterface.multi_perform(m_state->m_multiHandle, &m_stillRunning)) == CURLM_CALL_MULTI_PERFORM);
+    {
+      CSingleLock lock(m_state->m_stateSection);
 
-    if (!m_stillRunning)
-      break;
+      if (m_state->m_isPaused)
+        break;
 
-    if (result != CURLM_OK)
-    {
-      long code;
-      if(g_curlInterface.easy_getinfo(m_state->m_easyHandle, CURLINFO_RESPONSE_CODE, &code) == CURLE_OK )
-        CLog::Log(LOGERROR, "CCurlFile::{} - <{}> Unable to write curl resource with code {}",
-                  __FUNCTION__, CURL::GetRedacted(m_url), code);
-      m_inError = true;
-      return -1;
+      if (!m_state->m_stillRunning)
+      {
+        if (m_state->m_result != CURLE_OK)
+        {
+          long code;
+          if(g_curlInterface.easy_getinfo(m_state->m_easyHandle, CURLINFO_RESPONSE_CODE, &code) == CURLE_OK )
+            CLog::Log(LOGERROR, "CCurlFile::{} - <{}> Unable to write curl resource with code {}",
+                      __FUNCTION__, CURL::GetRedacted(m_url), code);
+          m_inError = true;
+          return -1;
+        }
+        break;
+      }
     }
+
+    m_state->m_dataEvent.Wait(std::chrono::milliseconds(200));
   }
 
   m_writeOffset += m_state->m_filePos;
@@ -1433,8 +1514,7 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
       m_state->m_fileSize = m_oldState->m_fileSize;
       g_curlInterface.easy_acquire(url.GetProtocol().c_str(),
                                   url.GetHostName().c_str(),
-                                  &m_state->m_easyHandle,
-                                  &m_state->m_multiHandle );
+                                  &m_state->m_easyHandle, NULL);
     }
     else
     {
@@ -1677,9 +1757,9 @@ ssize_t CCurlFile::CReadState::Read(void* lpBuf, size_t uiBufSize)
 int8_t CCurlFile::CReadState::FillBuffer(unsigned int want)
 {
   int retry = 0;
-  fd_set fdread;
-  fd_set fdwrite;
-  fd_set fdexcep;
+
+  // the transfer may have paused while the buffer was full
+  ResumeTransfer();
 
   // only attempt to fill buffer if transactions still running and buffer
   // doesn't exceed required size already
@@ -1688,123 +1768,130 @@ int8_t CCurlFile::CReadState::FillBuffer(unsigned int want)
     if (m_cancelled)
       return FILLBUFFER_NO_DATA;
 
-    /* if there is data in overflow buffer, try to use that first */
-    if (m_overflowSize)
+    bool bRunning;
+    bool bDone;
+    CURLcode result;
+
     {
-      unsigned amount = std::min(m_buffer.getMaxWriteSize(), m_overflowSize);
-      m_buffer.WriteData(m_overflowBuffer, amount);
+      CSingleLock lock(m_stateSection);
 
-      if (amount < m_overflowSize)
-        memmove(m_overflowBuffer, m_overflowBuffer + amount, m_overflowSize - amount);
+      /* if there is data in overflow buffer, try to use that first */
+      if (m_overflowSize)
+      {
+        unsigned amount = std::min(m_buffer.getMaxWriteSize(), m_overflowSize);
+        m_buffer.WriteData(m_overflowBuffer, amount);
 
-      m_overflowSize -= amount;
-      // Shrink memory:
-      m_overflowBuffer = (char*)realloc_simple(m_overflowBuffer, m_overflowSize);
-      continue;
+        if (amount < m_overflowSize)
+          memmove(m_overflowBuffer, m_overflowBuffer + amount, m_overflowSize - amount);
+
+        m_overflowSize -= amount;
+        // Shrink memory:
+        m_overflowBuffer = (char*)realloc_simple(m_overflowBuffer, m_overflowSize);
+        continue;
+      }
+
+      bRunning = m_stillRunning != 0;
+      bDone = m_resultPending;
+      result = static_cast<CURLcode>(m_result);
     }
 
-    CURLMcode result = g_curlInterface.multi_perform(m_multiHandle, &m_stillRunning);
-    if (!m_stillRunning)
+    ResumeTransfer();
+
+    if (!bRunning)
     {
-      if (result == CURLM_OK)
+      /* if we still have stuff in buffer, we are fine */
+      if (m_buffer.getMaxReadSize())
+        return FILLBUFFER_OK;
+
+      // check for errors
+      bool bRetryNow = true;
+      bool bError = false;
+      if (bDone)
       {
-        /* if we still have stuff in buffer, we are fine */
-        if (m_buffer.getMaxReadSize())
+        {
+          CSingleLock lock(m_stateSection);
+          m_resultPending = false;
+        }
+
+        if (result == CURLE_OK)
           return FILLBUFFER_OK;
 
-        // check for errors
-        int msgs;
-        CURLMsg* msg;
-        bool bRetryNow = true;
-        bool bError = false;
-        while ((msg = g_curlInterface.multi_info_read(m_multiHandle, &msgs)))
+        long httpCode = 0;
+        if (result == CURLE_HTTP_RETURNED_ERROR)
         {
-          if (msg->msg == CURLMSG_DONE)
-          {
-            if (msg->data.result == CURLE_OK)
-              return FILLBUFFER_OK;
-
-            long httpCode = 0;
-            if (msg->data.result == CURLE_HTTP_RETURNED_ERROR)
-            {
-              g_curlInterface.easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &httpCode);
-
-              // Don't log 404 not-found errors to prevent log-spam
-              if (httpCode != 404)
-                CLog::Log(LOGERROR,
-                          "CCurlFile::CReadState::{} - ({}) Failed: HTTP returned code {}",
-                          __FUNCTION__, fmt::ptr(this), httpCode);
-            }
-            else
-            {
-              CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed: {}({})", __FUNCTION__,
-                        fmt::ptr(this), g_curlInterface.easy_strerror(msg->data.result),
-                        msg->data.result);
-            }
-
-            if ( (msg->data.result == CURLE_OPERATION_TIMEDOUT ||
-                  msg->data.result == CURLE_PARTIAL_FILE       ||
-                  msg->data.result == CURLE_COULDNT_CONNECT    ||
-                  msg->data.result == CURLE_RECV_ERROR)        &&
-                  !m_bFirstLoop)
-            {
-              bRetryNow = false; // Leave it to caller whether the operation is retried
-              bError = true;
-            }
-            else if ( (msg->data.result == CURLE_HTTP_RANGE_ERROR              ||
-                       httpCode == 416 /* = Requested Range Not Satisfiable */ ||
-                       httpCode == 406 /* = Not Acceptable (fixes issues with non compliant HDHomerun servers */) &&
-                       m_bFirstLoop                                   &&
-                       m_filePos == 0                                 &&
-                       m_sendRange)
-            {
-              // If server returns a (possible) range error, disable range and retry (handled below)
-              bRetryNow = true;
-              bError = true;
-              m_sendRange = false;
-            }
-            else
-            {
-              // For all other errors, abort the operation
-              return FILLBUFFER_FAIL;
-            }
-          }
+          g_curlInterface.easy_getinfo(m_easyHandle, CURLINFO_RESPONSE_CODE, &httpCode);
+
+          // Don't log 404 not-found errors to prevent log-spam
+          if (httpCode != 404)
+            CLog::Log(LOGERROR,
+                      "CCurlFile::CReadState::{} - ({}) Failed: HTTP returned code {}",
+                      __FUNCTION__, fmt::ptr(this), httpCode);
+        }
+        else
+        {
+          CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed: {}({})", __FUNCTION__,
+                    fmt::ptr(this), g_curlInterface.easy_strerror(result), result);
         }
 
-        // Check for an actual error, if not, just return no-data
-        if (!bError && !m_bLastError)
-          return FILLBUFFER_NO_DATA;
+        if ( (result == CURLE_OPERATION_TIMEDOUT ||
+              result == CURLE_PARTIAL_FILE       ||
+              result == CURLE_COULDNT_CONNECT    ||
+              result == CURLE_RECV_ERROR)        &&
+              !m_bFirstLoop)
+        {
+          bRetryNow = false; // Leave it to caller whether the operation is retried
+          bError = true;
+        }
+        else if ( (result == CURLE_HTTP_RANGE_ERROR                   ||
+                   httpCode == 416 /* = Requested Range Not Satisfiable */ ||
+                   httpCode == 406 /* = Not Acceptable (fixes issues with non compliant HDHomerun servers */) &&
+                   m_bFirstLoop                                   &&
+                   m_filePos == 0                                 &&
+                   m_sendRange)
+        {
+          // If server returns a (possible) range error, disable range and retry (handled below)
+          bRetryNow = true;
+          bError = true;
+          m_sendRange = false;
+        }
+        else
+        {
+          // For all other errors, abort the operation
+          return FILLBUFFER_FAIL;
+        }
+      }
 
-        // Close handle
-        if (m_multiHandle && m_easyHandle)
-          g_curlInterface.multi_remove_handle(m_multiHandle, m_easyHandle);
+      // Check for an actual error, if not, just return no-data
+      if (!bError && !m_bLastError)
+        return FILLBUFFER_NO_DATA;
 
-        // Reset all the stuff like we would in Disconnect()
-        m_buffer.Clear();
-        free(m_overflowBuffer);
-        m_overflowBuffer = NULL;
-        m_overflowSize = 0;
-        m_bLastError = true; // Flag error for the next run
+      // Close handle
+      StopTransfer();
 
-        // Retry immediately or leave it up to the caller?
-        if ((m_bRetry && retry < CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlretries) || (bRetryNow && retry == 0))
-        {
-          retry++;
+      // Reset all the stuff like we would in Disconnect()
+      m_buffer.Clear();
+      free(m_overflowBuffer);
+      m_overflowBuffer = NULL;
+      m_overflowSize = 0;
+      m_bLastError = true; // Flag error for the next run
 
-          // Connect + seek to current position (again)
-          SetResume();
-          g_curlInterface.multi_add_handle(m_multiHandle, m_easyHandle);
+      // Retry immediately or leave it up to the caller?
+      if ((m_bRetry && retry < CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlretries) || (bRetryNow && retry == 0))
+      {
+        retry++;
 
-          CLog::Log(LOGWARNING, "CCurlFile::CReadState::{} - ({}) Reconnect, (re)try {}",
-                    __FUNCTION__, fmt::ptr(this), retry);
+        // Connect + seek to current position (again)
+        SetResume();
+        StartTransfer();
 
-          // Return to the beginning of the loop:
-          continue;
-        }
+        CLog::Log(LOGWARNING, "CCurlFile::CReadState::{} - ({}) Reconnect, (re)try {}",
+                  __FUNCTION__, fmt::ptr(this), retry);
 
-        return FILLBUFFER_NO_DATA; // We failed but flag no data to caller, so it can retry the operation
+        // Return to the beginning of the loop:
+        continue;
       }
-      return FILLBUFFER_FAIL;
+
+      return FILLBUFFER_NO_DATA; // We failed but flag no data to caller, so it can retry the operation
     }
 
     // We've finished out first loop
@@ -1814,103 +1901,21 @@ int8_t CCurlFile::CReadState::FillBuffer(unsigned int want)
     // No error this run
     m_bLastError = false;
 
-    switch (result)
-    {
-      case CURLM_OK:
-      {
-        int maxfd = -1;
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-
-        // get file descriptors from the transfers
-        g_curlInterface.multi_fdset(m_multiHandle, &fdread, &fdwrite, &fdexcep, &maxfd);
-
-        long timeout = 0;
-        if (CURLM_OK != g_curlInterface.multi_timeout(m_multiHandle, &timeout) || timeout == -1 || timeout < 200)
-          timeout = 200;
-
-        XbmcThreads::EndTime endTime(timeout);
-        int rc;
-
-        do
-        {
-          /* On success the value of maxfd is guaranteed to be >= -1. We call
-           * select(maxfd + 1, ...); specially in case of (maxfd == -1) there are
-           * no fds ready yet so we call select(0, ...) --or Sleep() on Windows--
-           * to sleep 100ms, which is the minimum suggested value in the
-           * curl_multi_fdset() doc.
-           */
-          if (maxfd == -1)
-          {
-#ifdef TARGET_WINDOWS
-            /* Windows does not support using select() for sleeping without a dummy
-             * socket. Instead use Windows' Sleep() and sleep for 100ms which is the
-             * minimum suggested value in the curl_multi_fdset() doc.
-             */
-            KODI::TIME::Sleep(100);
-            rc = 0;
-#else
-            /* Portable sleep for platforms other than Windows. */
-            struct timeval wait = { 0, 100 * 1000 }; /* 100ms */
-            rc = select(0, NULL, NULL, NULL, &wait);
-#endif
-          }
-          else
-          {
-            unsigned int time_left = endTime.MillisLeft();
-            struct timeval wait = { (int)time_left / 1000, ((int)time_left % 1000) * 1000 };
-            rc = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &wait);
-          }
-#ifdef TARGET_WINDOWS
-        } while(rc == SOCKET_ERROR && WSAGetLastError() == WSAEINTR);
-#else
-        } while(rc == SOCKET_ERROR && errno == EINTR);
-#endif
-
-        if(rc == SOCKET_ERROR)
-        {
-#ifdef TARGET_WINDOWS
-          char buf[256];
-          strerror_s(buf, 256, WSAGetLastError());
-          CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed with socket error:{}",
-                    __FUNCTION__, fmt::ptr(this), buf);
-#else
-          char const * str = strerror(errno);
-          CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed with socket error:{}",
-                    __FUNCTION__, fmt::ptr(this), str);
-#endif
-
-          return FILLBUFFER_FAIL;
-        }
-      }
-      break;
-      case CURLM_CALL_MULTI_PERFORM:
-      {
-        // we don't keep calling here as that can easily overwrite our buffer which we want to avoid
-        // docs says we should call it soon after, but aslong as we are reading data somewhere
-        // this aught to be soon enough. should stay in socket otherwise
-        continue;
-      }
-      break;
-      default:
-      {
-        CLog::Log(LOGERROR,
-                  "CCurlFile::CReadState::{} - ({}) Multi perform failed with code {}, aborting",
-                  __FUNCTION__, fmt::ptr(this), result);
-        return FILLBUFFER_FAIL;
-      }
-      break;
-    }
+    // the curl engine receives the data in the background, wait for more of
+    // it or for the transfer to finish
+    m_dataEvent.Wait(std::chrono::milliseconds(200));
   }
   return FILLBUFFER_OK;
 }
 
 void CCurlFile::CReadState::SetReadBuffer(const void* lpBuf, int64_t uiBufSize)
 {
+  CSingleLock lock(m_stateSection);
+
   m_readBuffer = const_cast<char*>((const char*)lpBuf);
   m_fileSize = uiBufSize;
   m_filePos = 0;
+  m_isPaused = false;
 }
 
 void CCurlFile::ClearRequestHeaders()
@@ -1928,6 +1933,11 @@ void CCurlFile::SetRequestHeader(const std::string& header, long value)
   m_requestheaders[header] = std::to_string(value);
 }
 
+void CCurlFile::RemoveRequestHeader(const std::string& header)
+{
+  m_requestheaders.erase(header);
+}
+
 std::string CCurlFile::GetURL(void)
 {
   return m_url;
@@ -2022,12 +2032,11 @@ bool CCurlFile::GetCookies(const CURL &url, std::string &cookies)
   std::string cookiesStr;
   curl_slist* curlCookies;
   CURL_HANDLE* easyHandle;
-  CURLM* multiHandle;
 
   // get the cookies list
   g_curlInterface.easy_acquire(url.GetProtocol().c_str(),
                               url.GetHostName().c_str(),
-                              &easyHandle, &multiHandle);
+                              &easyHandle, NULL);
   if (CURLE_OK == g_curlInterface.easy_getinfo(easyHandle, CURLINFO_COOKIELIST, &curlCookies))
   {
     // iterate over each cookie and format it into an RFC 2109 formatted Set-Cookie string
@@ -2065,7 +2074,7 @@ bool CCurlFile::GetCookies(const CURL &url, std::string &cookies)
     g_curlInterface.slist_free_all(curlCookies);
 
     // release our handles
-    g_curlInterface.easy_release(&easyHandle, &multiHandle);
+    g_curlInterface.easy_release(&easyHandle, NULL);
 
     // if we have a non-empty cookie string, return it
     if (!cookiesStr.empty())
@@ -9,14 +9,16 @@
 #pragma once
 
 #include "IFile.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "utils/HttpHeader.h"
 #include "utils/RingBuffer.h"
 
+#include <atomic>
 #include <map>
 #include <string>
 
 typedef void CURL_HANDLE;
-typedef void CURLM;
 struct curl_slist;
 
 namespace XFILE
@@ -74,11 +76,13 @@ namespace XFILE
       void SetMimeType(const std::string& mimetype) { SetRequestHeader("Content-Type", mimetype); }
       void SetRequestHeader(const std::string& header, const std::string& value);
       void SetRequestHeader(const std::string& header, long value);
+      void RemoveRequestHeader(const std::string& header);
 
       void ClearRequestHeaders();
       void SetBufferSize(unsigned int size);
 
       const CHttpHeader& GetHttpHeader() const { return m_state->m_httpheader; }
+      long GetResponseCode() const { return m_httpresponse; }
       std::string GetURL(void);
       std::string GetRedirectURL();
 
@@ -96,14 +100,13 @@ namespace XFILE
           CReadState();
           ~CReadState();
           CURL_HANDLE* m_easyHandle;
-          CURLM* m_multiHandle;
 
           CRingBuffer m_buffer; // our ringhold buffer
           unsigned int m_bufferSize;
 
           char* m_overflowBuffer; // in the rare case we would overflow the above buffer
           unsigned int m_overflowSize; // size of the overflow buffer
-          int m_stillRunning; // Is background url fetch still in progress
+          std::atomic<int> m_stillRunning; // Is background url fetch still in progress
           bool m_cancelled;
           int64_t m_fileSize;
           int64_t m_filePos;
@@ -135,6 +138,19 @@ namespace XFILE
           void SetResume(void);
           long Connect(unsigned int size);
           void Disconnect();
+
+          // The transfer runs on the curl engine, see CCurlEngine
+          void StartTransfer();
+          void StopTransfer();
+          void OnTransferDone(int result);
+          void ResumeTransfer();
+
+          CCriticalSection m_stateSection; // Shared with the curl engine callbacks
+          CEvent m_dataEvent; // Set when data was received or the transfer is done
+          bool m_transferActive;
+          bool m_writePaused; // Transfer paused until there's room in the buffer
+          bool m_resultPending; // Transfer done, result not yet handled
+          int m_result; // CURLcode of the finished transfer
       };
 
     protected:
@@ -191,8 +207,6 @@ namespace XFILE
       char* m_overflowBuffer; // in the rare case we would overflow the above buffer
       unsigned int m_overflowSize = 0; // size of the overflow buffer
 
-      int  m_stillRunning; // Is background url fetch still in progress?
-
       typedef std::map<std::string, std::string> MAPHTTPHEADERS;
       MAPHTTPHEADERS m_requestheaders;
 
@@ -32,12 +32,10 @@ bool CDAVFile::Execute(const CURL& url)
 
   CLog::Log(LOGDEBUG, "CDAVFile::Execute({}) {}", fmt::ptr(this), m_url);
 
-  assert(!(!m_state->m_easyHandle ^ !m_state->m_multiHandle));
   if( m_state->m_easyHandle == NULL )
     g_curlInterface.easy_acquire(url2.GetProtocol().c_str(),
                                 url2.GetHostName().c_str(),
-                                &m_state->m_easyHandle,
-                                &m_state->m_multiHandle);
+                                &m_state->m_easyHandle, NULL);
 
   // setup common curl options
   SetCommonOptions(m_state);
@@ -8,6 +8,7 @@
 
 #include "DllLibCurl.h"
 
+#include "CurlEngine.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/log.h"
@@ -119,10 +120,15 @@ DllLibCurlGlobal::DllLibCurlGlobal()
   {
     CLog::Log(LOGERROR, "Error initializing libcurl");
   }
+
+  m_engine = std::make_unique<CCurlEngine>();
 }
 
 DllLibCurlGlobal::~DllLibCurlGlobal()
 {
+  // stop transfers before closing libcurl
+  m_engine.reset();
+
   // close libcurl
   curl_global_cleanup();
 }
@@ -10,6 +10,7 @@
 
 #include "threads/CriticalSection.h"
 
+#include <memory>
 #include <stdio.h>
 #include <string>
 #include <sys/time.h>
@@ -23,6 +24,7 @@
 
 namespace XCURL
 {
+class CCurlEngine;
 
 class DllLibCurl
 {
@@ -77,6 +79,9 @@ public:
   CURL_HANDLE* easy_duphandle(CURL_HANDLE* easy_handle) override;
   void CheckIdle();
 
+  /* engine driving all asynchronous transfers */
+  CCurlEngine& GetEngine() { return *m_engine; }
+
   /* overloaded load and unload with reference counter */
 
   /* structure holding a session info */
@@ -95,6 +100,9 @@ public:
 
   VEC_CURLSESSIONS m_sessions;
   CCriticalSection m_critSection;
+
+private:
+  std::unique_ptr<CCurlEngine> m_engine;
 };
 } // namespace XCURL
 
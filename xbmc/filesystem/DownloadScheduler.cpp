@@ -0,0 +1,373 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DownloadScheduler.h"
+
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "filesystem/CurlFile.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace XFILE;
+
+namespace
+{
+// Concurrent downloads per host, most sites throttle clients that open more
+constexpr unsigned int HOST_LIMIT = 4;
+
+// Concurrent prefetches, they share the per-host limits with all downloads
+constexpr unsigned int PREFETCH_JOBS = 8;
+
+constexpr uint64_t CACHE_SIZE = 256 * 1024 * 1024;
+
+// Prefetched responses the cache can't store are kept in memory up to this size
+constexpr size_t PREFETCHED_SIZE = 32 * 1024 * 1024;
+
+} // namespace
+
+class CDownloadScheduler::CPrefetchJob : public CJob
+{
+public:
+  CPrefetchJob(CDownloadScheduler& scheduler, const std::string& url)
+    : m_scheduler(scheduler), m_url(url)
+  {
+  }
+
+  bool DoWork() override
+  {
+    CCurlFile http;
+    HTTPResponse response;
+    return m_scheduler.Fetch(http, m_url, nullptr, Lane::SCAN, response, true);
+  }
+
+  const char* GetType() const override { return "prefetch"; }
+
+  bool operator==(const CJob* job) const override
+  {
+    if (strcmp(job->GetType(), GetType()) == 0)
+    {
+      const CPrefetchJob* prefetchJob = dynamic_cast<const CPrefetchJob*>(job);
+      if (prefetchJob && prefetchJob->m_url == m_url)
+        return true;
+    }
+    return false;
+  }
+
+private:
+  CDownloadScheduler& m_scheduler;
+  const std::string m_url;
+};
+
+CDownloadScheduler::CDownloadScheduler(const std::string& cachePath, unsigned int hostLimit)
+  : m_hostLimit(std::max(1u, hostLimit)),
+    m_cache(cachePath, CACHE_SIZE),
+    m_prefetchQueue(false, PREFETCH_JOBS, CJob::PRIORITY_LOW)
+{
+}
+
+CDownloadScheduler::~CDownloadScheduler() = default;
+
+CDownloadScheduler& CDownloadScheduler::GetInstance()
+{
+  static CDownloadScheduler scheduler(
+      URIUtils::AddFileToFolder(
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cachePath,
+          "httpcache"),
+      HOST_LIMIT);
+  return scheduler;
+}
+
+bool CDownloadScheduler::CanSchedule(const std::string& url)
+{
+  return URIUtils::IsProtocol(url, "http") || URIUtils::IsProtocol(url, "https");
+}
+
+bool CDownloadScheduler::Get(const std::string& url, Lane lane, HTTPResponse& response)
+{
+  CCurlFile http;
+  return Fetch(http, url, nullptr, lane, response);
+}
+
+bool CDownloadScheduler::Get(CCurlFile& http,
+                             const std::string& url,
+                             Lane lane,
+                             HTTPResponse& response)
+{
+  return Fetch(http, url, nullptr, lane, response);
+}
+
+bool CDownloadScheduler::Post(CCurlFile& http,
+                              const std::string& url,
+                              const std::string& postData,
+                              Lane lane,
+                              HTTPResponse& response)
+{
+  return Fetch(http, url, &postData, lane, response);
+}
+
+void CDownloadScheduler::Prefetch(const std::string& url)
+{
+  if (CanSchedule(url))
+    m_prefetchQueue.AddJob(new CPrefetchJob(*this, url));
+}
+
+bool CDownloadScheduler::Fetch(CCurlFile& http,
+                               const std::string& url,
+                               const std::string* postData,
+                               Lane lane,
+                               HTTPResponse& response,
+                               bool prefetch /* = false */)
+{
+  std::string key = url;
+  if (postData != nullptr)
+    key += "\nPOST\n" + *postData;
+
+  std::shared_ptr<Download> download;
+  bool coalesced = false;
+
+  {
+    CSingleLock lock(m_section);
+
+    auto it = m_downloads.find(key);
+    if (it != m_downloads.end())
+    {
+      download = it->second;
+      coalesced = true;
+
+      // Don't leave the user waiting behind scan downloads
+      if (lane == Lane::UI && download->lane != Lane::UI)
+      {
+        download->lane = Lane::UI;
+        m_hostCondition.notifyAll();
+      }
+    }
+    else
+    {
+      download = std::make_shared<Download>(lane);
+      download->prefetch = prefetch;
+      m_downloads.emplace(key, download);
+    }
+  }
+
+  if (coalesced)
+  {
+    download->done.Wait();
+
+    if (download->success)
+    {
+      response = download->response;
+      response.coalesced = true;
+    }
+    return download->success;
+  }
+
+  download->success = Transfer(http, url, postData, key, *download);
+  if (download->success)
+    response = download->response;
+
+  {
+    CSingleLock lock(m_section);
+    m_downloads.erase(key);
+  }
+
+  download->done.Set();
+
+  return download->success;
+}
+
+bool CDownloadScheduler::Transfer(CCurlFile& http,
+                                  const std::string& url,
+                                  const std::string* postData,
+                                  const std::string& key,
+                                  Download& download)
+{
+  HTTPResponse& response = download.response;
+  const bool cacheable = postData == nullptr;
+  const time_t now = time(nullptr);
+
+  // A prefetch that the cache couldn't store waits for the request it was made for
+  if (cacheable && FindPrefetched(key, download.prefetch ? nullptr : &response))
+    return true;
+
+  HTTPResponse cached;
+  const bool isCached = cacheable && m_cache.Lookup(key, cached);
+
+  if (isCached && cached.IsFresh(now))
+  {
+    response = std::move(cached);
+    return true;
+  }
+
+  if (isCached)
+  {
+    if (!cached.etag.empty())
+      http.SetRequestHeader("If-None-Match", cached.etag);
+    if (!cached.lastModified.empty())
+      http.SetRequestHeader("If-Modified-Since", cached.lastModified);
+  }
+
+  const std::string host = CURL(url).GetHostName();
+  std::string body;
+
+  AcquireConnection(host, download);
+  const bool success = Request(http, url, postData, body);
+  ReleaseConnection(host);
+
+  http.RemoveRequestHeader("If-None-Match");
+  http.RemoveRequestHeader("If-Modified-Since");
+
+  if (!success)
+    return false;
+
+  const CHttpHeader& header = http.GetHttpHeader();
+
+  bool noStore;
+  int maxAge;
+  CHTTPResponseCache::ParseHeaders(header.GetValue("cache-control"), header.GetValue("pragma"),
+                                   header.GetValue("expires"), header.GetValue("date"), noStore,
+                                   maxAge);
+
+  if (isCached && http.GetResponseCode() == 304)
+  {
+    CLog::Log(LOGDEBUG, "CDownloadScheduler::{} - <{}> not modified", __FUNCTION__,
+              CURL::GetRedacted(url));
+
+    response = std::move(cached);
+    response.storedTime = now;
+    response.maxAge = maxAge;
+    m_cache.Touch(key, response);
+    return true;
+  }
+
+  response.url = url;
+  response.body = std::move(body);
+  response.mimeType = http.GetProperty(FILE_PROPERTY_MIME_TYPE);
+  response.charset = http.GetProperty(FILE_PROPERTY_CONTENT_CHARSET);
+  response.etag = header.GetValue("etag");
+  response.lastModified = header.GetValue("last-modified");
+  response.storedTime = now;
+  response.maxAge = maxAge;
+  response.fromCache = false;
+
+  if (cacheable && !noStore && http.GetResponseCode() < 300 &&
+      (response.HasValidator() || maxAge > 0))
+    m_cache.Store(key, response);
+  else
+  {
+    if (isCached)
+      m_cache.Remove(key);
+
+    // Without this, the request that follows the prefetch downloads the response again
+    if (download.prefetch && cacheable && !noStore && http.GetResponseCode() < 300)
+      KeepPrefetched(key, response);
+  }
+
+  return true;
+}
+
+bool CDownloadScheduler::FindPrefetched(const std::string& key, HTTPResponse* response)
+{
+  CSingleLock lock(m_section);
+
+  auto it = std::find_if(m_prefetched.begin(), m_prefetched.end(),
+                         [&key](const std::pair<std::string, HTTPResponse>& prefetched) {
+                           return prefetched.first == key;
+                         });
+  if (it == m_prefetched.end())
+    return false;
+
+  if (response != nullptr)
+  {
+    *response = std::move(it->second);
+    response->fromCache = true;
+    m_prefetchedSize -= response->body.size();
+    m_prefetched.erase(it);
+  }
+
+  return true;
+}
+
+void CDownloadScheduler::KeepPrefetched(const std::string& key, const HTTPResponse& response)
+{
+  if (response.body.size() > PREFETCHED_SIZE)
+    return;
+
+  CSingleLock lock(m_section);
+
+  m_prefetched.emplace_back(key, response);
+  m_prefetchedSize += response.body.size();
+
+  // Drop the oldest, their requests most likely won't come anymore
+  while (m_prefetchedSize > PREFETCHED_SIZE)
+  {
+    m_prefetchedSize -= m_prefetched.front().second.body.size();
+    m_prefetched.pop_front();
+  }
+}
+
+bool CDownloadScheduler::Request(CCurlFile& http,
+                                 const std::string& url,
+                                 const std::string* postData,
+                                 std::string& body)
+{
+  return postData != nullptr ? http.Post(url, *postData, body) : http.Get(url, body);
+}
+
+void CDownloadScheduler::AcquireConnection(const std::string& host, const Download& download)
+{
+  CSingleLock lock(m_section);
+
+  Host& state = m_hosts[host];
+  state.waiting++;
+
+  bool waitingUI = false;
+  while (true)
+  {
+    const bool ui = download.lane == Lane::UI;
+    if (ui && !waitingUI)
+    {
+      state.waitingUI++;
+      waitingUI = true;
+    }
+
+    // Scan downloads keep a connection free and go after waiting UI downloads
+    if (ui && state.active < m_hostLimit)
+      break;
+    if (!ui && state.waitingUI == 0 && state.active < std::max(1u, m_hostLimit - 1))
+      break;
+
+    m_hostCondition.wait(lock);
+  }
+
+  if (waitingUI)
+    state.waitingUI--;
+  state.waiting--;
+  state.active++;
+}
+
+void CDownloadScheduler::ReleaseConnection(const std::string& host)
+{
+  CSingleLock lock(m_section);
+
+  auto it = m_hosts.find(host);
+  if (it == m_hosts.end())
+    return;
+
+  it->second.active--;
+  if (it->second.active == 0 && it->second.waiting == 0)
+    m_hosts.erase(it);
+
+  m_hostCondition.notifyAll();
+}
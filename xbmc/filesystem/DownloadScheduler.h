@@ -0,0 +1,168 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "HTTPResponseCache.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace XFILE
+{
+class CCurlFile;
+
+/*!
+ * \brief Schedules HTTP downloads of artwork and scraper pages
+ *
+ * Downloads from callers on any thread run in parallel, limited to a number
+ * of connections per host. Requests for content that is visible in the UI
+ * are given connections before library scan requests, and one connection to
+ * each host is kept free for them. Identical requests that are in progress
+ * at the same time are coalesced into one download.
+ *
+ * Responses are kept in a disk cache and revalidated with their ETag or
+ * Last-Modified header, so that unchanged content isn't transferred again.
+ */
+class CDownloadScheduler
+{
+public:
+  enum class Lane
+  {
+    UI, ///< Content that the user is waiting for
+    SCAN, ///< Library scans and other background work
+  };
+
+  /*!
+   * \param cachePath Folder of the response cache
+   * \param hostLimit Maximum number of concurrent downloads per host
+   */
+  CDownloadScheduler(const std::string& cachePath, unsigned int hostLimit);
+  virtual ~CDownloadScheduler();
+
+  static CDownloadScheduler& GetInstance();
+
+  /*!
+   * \brief Check if a URL is downloaded through the scheduler
+   */
+  static bool CanSchedule(const std::string& url);
+
+  /*!
+   * \brief Download a URL
+   *
+   * \param url The URL, which may contain protocol options like "|Referer=..."
+   * \param lane The lane to schedule the download in
+   * \param[out] response The response
+   * \return true on success, false on failure
+   */
+  bool Get(const std::string& url, Lane lane, HTTPResponse& response);
+
+  /*!
+   * \brief Download a URL with a configured CCurlFile
+   *
+   * The user agent, referer and request headers of the CCurlFile are used.
+   */
+  bool Get(CCurlFile& http, const std::string& url, Lane lane, HTTPResponse& response);
+
+  /*!
+   * \brief Post to a URL with a configured CCurlFile
+   *
+   * Responses to POST requests are coalesced, but not cached.
+   */
+  bool Post(CCurlFile& http,
+            const std::string& url,
+            const std::string& postData,
+            Lane lane,
+            HTTPResponse& response);
+
+  /*!
+   * \brief Download a URL into the cache in the background
+   *
+   * A following Get() for the URL is served from the cache, or waits for
+   * the prefetch to complete. Responses that the cache can't store, e.g.
+   * without a validator or lifetime, are kept in memory for the following
+   * Get() instead, as long as they fit.
+   */
+  void Prefetch(const std::string& url);
+
+protected:
+  /*!
+   * \brief Perform the request once a connection to the host is acquired
+   *
+   * Overridden by tests, which don't go to the network.
+   */
+  virtual bool Request(CCurlFile& http,
+                       const std::string& url,
+                       const std::string* postData,
+                       std::string& body);
+
+private:
+  struct Host
+  {
+    unsigned int active = 0;
+    unsigned int waiting = 0;
+    unsigned int waitingUI = 0;
+  };
+
+  struct Download
+  {
+    explicit Download(Lane lane) : lane(lane) {}
+
+    Lane lane; ///< Raised to UI when a UI request is coalesced into it
+    bool prefetch = false; ///< Started by Prefetch()
+    CEvent done{true};
+    bool success = false;
+    HTTPResponse response;
+  };
+
+  class CPrefetchJob;
+
+  bool Fetch(CCurlFile& http,
+             const std::string& url,
+             const std::string* postData,
+             Lane lane,
+             HTTPResponse& response,
+             bool prefetch = false);
+  bool Transfer(CCurlFile& http,
+                const std::string& url,
+                const std::string* postData,
+                const std::string& key,
+                Download& download);
+  /*!
+   * \brief Check for a prefetched response that wasn't stored in the cache
+   *
+   * \param[out] response If not null, receives the response, which is then removed
+   */
+  bool FindPrefetched(const std::string& key, HTTPResponse* response);
+  void KeepPrefetched(const std::string& key, const HTTPResponse& response);
+
+  void AcquireConnection(const std::string& host, const Download& download);
+  void ReleaseConnection(const std::string& host);
+
+  const unsigned int m_hostLimit;
+  CHTTPResponseCache m_cache;
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_hostCondition;
+  std::map<std::string, Host> m_hosts;
+  std::map<std::string, std::shared_ptr<Download>> m_downloads;
+
+  // Prefetched responses that the cache didn't store, oldest first
+  std::deque<std::pair<std::string, HTTPResponse>> m_prefetched;
+  size_t m_prefetchedSize = 0;
+
+  CJobQueue m_prefetchQueue;
+};
+} // namespace XFILE
@@ -0,0 +1,297 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "HTTPResponseCache.h"
+
+#include "FileItem.h"
+#include "XBDateTime.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/Digest.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace XFILE;
+using KODI::UTILITY::CDigest;
+
+namespace
+{
+// Freshness of a response without max-age, enough for a prefetched response
+// to be used by the request that follows it
+constexpr time_t DEFAULT_FRESHNESS = 60;
+
+// Fraction of the maximum size that is kept when trimming the cache
+constexpr uint64_t TRIM_PERCENT = 90;
+
+const std::string BODY_EXTENSION = ".body";
+const std::string HEADERS_EXTENSION = ".json";
+} // namespace
+
+bool HTTPResponse::IsFresh(time_t now) const
+{
+  const time_t lifetime = maxAge >= 0 ? maxAge : DEFAULT_FRESHNESS;
+  return now >= storedTime && now < storedTime + lifetime;
+}
+
+CHTTPResponseCache::CHTTPResponseCache(const std::string& cachePath, uint64_t maxSize)
+  : m_cachePath(cachePath), m_maxSize(maxSize)
+{
+}
+
+bool CHTTPResponseCache::Lookup(const std::string& key, HTTPResponse& response)
+{
+  CFile file;
+  auto_buffer buffer;
+  if (file.LoadFile(GetPath(key, HEADERS_EXTENSION), buffer) <= 0)
+    return false;
+
+  CVariant headers;
+  if (!CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), headers) ||
+      !headers.isObject())
+    return false;
+
+  // Guard against hash collisions
+  if (headers["key"].asString() != key)
+    return false;
+
+  buffer.clear();
+  const ssize_t size = file.LoadFile(GetPath(key, BODY_EXTENSION), buffer);
+  if (size < 0 || static_cast<uint64_t>(size) != headers["size"].asUnsignedInteger())
+    return false;
+
+  response.url = headers["url"].asString();
+  response.body.assign(buffer.get(), buffer.size());
+  response.mimeType = headers["mimetype"].asString();
+  response.charset = headers["charset"].asString();
+  response.etag = headers["etag"].asString();
+  response.lastModified = headers["lastmodified"].asString();
+  response.storedTime = static_cast<time_t>(headers["stored"].asInteger());
+  response.maxAge = static_cast<int>(headers["maxage"].asInteger(-1));
+  response.fromCache = true;
+
+  return true;
+}
+
+bool CHTTPResponseCache::Store(const std::string& key, const HTTPResponse& response)
+{
+  const std::string bodyPath = GetPath(key, BODY_EXTENSION);
+
+  struct __stat64 st;
+  const int64_t oldSize = CFile::Stat(bodyPath, &st) == 0 ? st.st_size : 0;
+
+  if (!WriteFile(bodyPath, response.body))
+    return false;
+
+  if (!WriteHeaders(key, response))
+  {
+    CFile::Delete(bodyPath);
+    UpdateSize(-oldSize);
+    return false;
+  }
+
+  UpdateSize(static_cast<int64_t>(response.body.size()) - oldSize);
+  return true;
+}
+
+bool CHTTPResponseCache::Touch(const std::string& key, const HTTPResponse& response)
+{
+  return WriteHeaders(key, response);
+}
+
+void CHTTPResponseCache::Remove(const std::string& key)
+{
+  const std::string bodyPath = GetPath(key, BODY_EXTENSION);
+
+  struct __stat64 st;
+  if (CFile::Stat(bodyPath, &st) == 0)
+  {
+    CFile::Delete(bodyPath);
+    UpdateSize(-st.st_size);
+  }
+
+  CFile::Delete(GetPath(key, HEADERS_EXTENSION));
+}
+
+void CHTTPResponseCache::ParseCacheControl(const std::string& value, bool& noStore, int& maxAge)
+{
+  noStore = false;
+  maxAge = -1;
+
+  for (std::string directive : StringUtils::Split(value, ","))
+  {
+    StringUtils::Trim(directive);
+    StringUtils::ToLower(directive);
+
+    if (directive == "no-store")
+      noStore = true;
+    else if (directive == "no-cache")
+      maxAge = 0;
+    else if (StringUtils::StartsWith(directive, "max-age=") && maxAge != 0)
+      maxAge = std::max(0, atoi(directive.c_str() + 8));
+  }
+}
+
+int CHTTPResponseCache::ParseExpires(const std::string& expires, const std::string& date)
+{
+  if (expires.empty())
+    return -1;
+
+  // Invalid dates like "0" mean that the response already expired
+  CDateTime expiresTime;
+  if (!expiresTime.SetFromRFC1123DateTime(expires))
+    return 0;
+
+  CDateTime dateTime;
+  if (date.empty() || !dateTime.SetFromRFC1123DateTime(date))
+    dateTime = CDateTime::GetUTCDateTime();
+
+  return std::max(0, (expiresTime - dateTime).GetSecondsTotal());
+}
+
+void CHTTPResponseCache::ParseHeaders(const std::string& cacheControl,
+                                      const std::string& pragma,
+                                      const std::string& expires,
+                                      const std::string& date,
+                                      bool& noStore,
+                                      int& maxAge)
+{
+  ParseCacheControl(cacheControl, noStore, maxAge);
+
+  if (maxAge < 0 && cacheControl.empty() && StringUtils::EqualsNoCase(pragma, "no-cache"))
+    maxAge = 0;
+
+  if (maxAge < 0)
+    maxAge = ParseExpires(expires, date);
+}
+
+std::string CHTTPResponseCache::GetPath(const std::string& key, const std::string& extension) const
+{
+  return URIUtils::AddFileToFolder(m_cachePath,
+                                   CDigest::Calculate(CDigest::Type::MD5, key) + extension);
+}
+
+bool CHTTPResponseCache::WriteFile(const std::string& path, const std::string& data)
+{
+  // Write to a temporary file first so that readers never see a partial file
+  const std::string tempPath = path + ".tmp";
+
+  CFile file;
+  if (!file.OpenForWrite(tempPath, true))
+  {
+    if (!CDirectory::Create(m_cachePath) || !file.OpenForWrite(tempPath, true))
+    {
+      CLog::Log(LOGERROR, "CHTTPResponseCache::{} - Unable to write {}", __FUNCTION__, tempPath);
+      return false;
+    }
+  }
+
+  const bool written =
+      file.Write(data.c_str(), data.size()) == static_cast<ssize_t>(data.size());
+  file.Close();
+
+  if (written)
+  {
+    CFile::Delete(path);
+    if (CFile::Rename(tempPath, path))
+      return true;
+  }
+
+  CFile::Delete(tempPath);
+  return false;
+}
+
+bool CHTTPResponseCache::WriteHeaders(const std::string& key, const HTTPResponse& response)
+{
+  CVariant headers(CVariant::VariantTypeObject);
+  headers["key"] = key;
+  headers["url"] = response.url;
+  headers["size"] = static_cast<uint64_t>(response.body.size());
+  headers["mimetype"] = response.mimeType;
+  headers["charset"] = response.charset;
+  headers["etag"] = response.etag;
+  headers["lastmodified"] = response.lastModified;
+  headers["stored"] = static_cast<int64_t>(response.storedTime);
+  headers["maxage"] = response.maxAge;
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(headers, json, true))
+    return false;
+
+  return WriteFile(GetPath(key, HEADERS_EXTENSION), json);
+}
+
+void CHTTPResponseCache::UpdateSize(int64_t delta)
+{
+  CSingleLock lock(m_sizeSection);
+
+  if (!m_sizeKnown)
+  {
+    // Scanning the folder counts the change already
+    Trim();
+    return;
+  }
+
+  if (delta < 0 && static_cast<uint64_t>(-delta) > m_size)
+    m_size = 0;
+  else
+    m_size += delta;
+
+  if (m_size > m_maxSize)
+    Trim();
+}
+
+void CHTTPResponseCache::Trim()
+{
+  CFileItemList items;
+  CDirectory::GetDirectory(m_cachePath, items, BODY_EXTENSION, DIR_FLAG_NO_FILE_DIRS);
+
+  m_size = 0;
+  for (int i = 0; i < items.Size(); i++)
+    m_size += items[i]->m_dwSize;
+  m_sizeKnown = true;
+
+  if (m_size <= m_maxSize)
+    return;
+
+  // Remove the least recently stored responses first
+  std::vector<CFileItemPtr> bodies(items.begin(), items.end());
+  std::sort(bodies.begin(), bodies.end(), [](const CFileItemPtr& a, const CFileItemPtr& b) {
+    return a->m_dateTime < b->m_dateTime;
+  });
+
+  const uint64_t targetSize = m_maxSize * TRIM_PERCENT / 100;
+  unsigned int removed = 0;
+
+  for (const CFileItemPtr& body : bodies)
+  {
+    if (m_size <= targetSize)
+      break;
+
+    std::string headersPath = body->GetPath();
+    URIUtils::RemoveExtension(headersPath);
+    headersPath += HEADERS_EXTENSION;
+
+    if (CFile::Delete(body->GetPath()))
+    {
+      CFile::Delete(headersPath);
+      m_size -= std::min<uint64_t>(m_size, body->m_dwSize);
+      removed++;
+    }
+  }
+
+  CLog::Log(LOGDEBUG, "CHTTPResponseCache::{} - Removed {} responses, {} bytes cached",
+            __FUNCTION__, removed, m_size);
+}
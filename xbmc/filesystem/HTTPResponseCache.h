@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <stdint.h>
+#include <string>
+#include <time.h>
+
+namespace XFILE
+{
+/*!
+ * \brief A downloaded HTTP response, as stored in the response cache
+ */
+struct HTTPResponse
+{
+  std::string url;
+  std::string body;
+  std::string mimeType;
+  std::string charset;
+
+  // Validators for conditional requests
+  std::string etag;
+  std::string lastModified;
+
+  time_t storedTime = 0; ///< When the response was fetched or last revalidated
+  int maxAge = -1; ///< Cache-Control max-age in seconds, -1 if not given
+
+  bool fromCache = false; ///< True if the body was served from the cache, not the network
+  bool coalesced = false; ///< True if the download was shared with an identical request
+
+  /*!
+   * \brief Check if the response can be used without asking the server
+   *
+   * Without an explicit max-age a response is only fresh for a short time,
+   * long enough for a prefetched response to be picked up by its consumer.
+   */
+  bool IsFresh(time_t now) const;
+
+  /*!
+   * \brief Check if the response can be revalidated with a conditional request
+   */
+  bool HasValidator() const { return !etag.empty() || !lastModified.empty(); }
+};
+
+/*!
+ * \brief Disk-backed cache of HTTP responses
+ *
+ * Responses are keyed by their request (URL and POST data) and stored as a
+ * body file and a small JSON file with the headers needed to revalidate them.
+ * The least recently stored responses are removed when the cache grows
+ * beyond its maximum size.
+ */
+class CHTTPResponseCache
+{
+public:
+  /*!
+   * \param cachePath Folder to store the responses in, created on first use
+   * \param maxSize Maximum size of all cached bodies in bytes
+   */
+  CHTTPResponseCache(const std::string& cachePath, uint64_t maxSize);
+
+  /*!
+   * \brief Load a cached response, including its body
+   */
+  bool Lookup(const std::string& key, HTTPResponse& response);
+
+  /*!
+   * \brief Store a response, replacing any previous one for the key
+   */
+  bool Store(const std::string& key, const HTTPResponse& response);
+
+  /*!
+   * \brief Update the headers of a response after it was revalidated
+   */
+  bool Touch(const std::string& key, const HTTPResponse& response);
+
+  /*!
+   * \brief Remove a cached response
+   */
+  void Remove(const std::string& key);
+
+  /*!
+   * \brief Parse a Cache-Control header value
+   *
+   * no-cache responses are stored with a max-age of 0, so that they are
+   * revalidated before every use.
+   *
+   * \param value The header value, e.g. "public, max-age=3600"
+   * \param[out] noStore True if the response must not be cached
+   * \param[out] maxAge The max-age in seconds, 0 for no-cache, -1 if not given
+   */
+  static void ParseCacheControl(const std::string& value, bool& noStore, int& maxAge);
+
+  /*!
+   * \brief Get the lifetime of a response from its Expires header
+   *
+   * \param expires The Expires header value
+   * \param date The Date header value, the current time is used if it's empty
+   * \return The lifetime in seconds, 0 if it expired or the value is invalid,
+   *         -1 if not given
+   */
+  static int ParseExpires(const std::string& expires, const std::string& date);
+
+  /*!
+   * \brief Get the caching policy of a response from its headers
+   *
+   * Cache-Control takes precedence over Expires, and Pragma: no-cache is
+   * only used without Cache-Control, as HTTP/1.0 servers send it.
+   *
+   * \param[out] noStore True if the response must not be cached
+   * \param[out] maxAge The lifetime in seconds, 0 to revalidate on every use,
+   *                    -1 if not given
+   */
+  static void ParseHeaders(const std::string& cacheControl,
+                           const std::string& pragma,
+                           const std::string& expires,
+                           const std::string& date,
+                           bool& noStore,
+                           int& maxAge);
+
+private:
+  std::string GetPath(const std::string& key, const std::string& extension) const;
+  bool WriteFile(const std::string& path, const std::string& data);
+  bool WriteHeaders(const std::string& key, const HTTPResponse& response);
+  void UpdateSize(int64_t delta);
+  void Trim();
+
+  const std::string m_cachePath;
+  const uint64_t m_maxSize;
+
+  CCriticalSection m_sizeSection;
+  bool m_sizeKnown = false;
+  uint64_t m_size = 0;
+};
+} // namespace XFILE
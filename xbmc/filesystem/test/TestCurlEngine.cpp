@@ -0,0 +1,299 @@
+/*
+ *  Copyright (C) 2015-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "URL.h"
+#include "filesystem/CurlEngine.h"
+#include "filesystem/CurlFile.h"
+#include "filesystem/File.h"
+#include "network/WebServer.h"
+#include "network/httprequesthandler/HTTPVfsHandler.h"
+#include "settings/MediaSourceSettings.h"
+#include "test/TestUtils.h"
+#include "threads/Event.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/auto_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XCURL;
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+#define WEBSERVER_HOST "localhost"
+
+#define SOURCE_PATH "xbmc/filesystem/test/"
+
+#define TEST_FILE "reffile.txt"
+
+#define TRANSFER_COUNT 8
+
+namespace
+{
+/*!
+ * \brief A transfer that collects the response body
+ */
+class CTestTransfer
+{
+public:
+  explicit CTestTransfer(const std::string& url)
+  {
+    m_easyHandle = curl_easy_init();
+    curl_easy_setopt(m_easyHandle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(m_easyHandle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(m_easyHandle, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(m_easyHandle, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(m_easyHandle, CURLOPT_WRITEDATA, this);
+  }
+
+  ~CTestTransfer() { curl_easy_cleanup(m_easyHandle); }
+
+  void Start(CCurlEngine& engine)
+  {
+    engine.AddTransfer(m_easyHandle, [this](CURLcode result) {
+      m_result = result;
+      m_doneEvent.Set();
+    });
+  }
+
+  bool WaitDone(std::chrono::milliseconds timeout = 10s) { return m_doneEvent.Wait(timeout); }
+
+  CURL_HANDLE* m_easyHandle;
+  std::string m_body;
+  CURLcode m_result = CURLE_OK;
+  std::atomic<bool> m_bPauseNextWrite{false};
+  CEvent m_pausedEvent;
+  std::atomic<CCurlEngine*> m_removeOnWrite{nullptr};
+  CEvent m_removedEvent;
+
+private:
+  static size_t WriteCallback(char* buffer, size_t size, size_t nitems, void* userp)
+  {
+    CTestTransfer* transfer = static_cast<CTestTransfer*>(userp);
+
+    if (transfer->m_bPauseNextWrite.exchange(false))
+    {
+      transfer->m_pausedEvent.Set();
+      return CURL_WRITEFUNC_PAUSE;
+    }
+
+    CCurlEngine* engine = transfer->m_removeOnWrite.exchange(nullptr);
+    if (engine != nullptr)
+    {
+      engine->RemoveTransfer(transfer->m_easyHandle);
+      transfer->m_removedEvent.Set();
+      return size * nitems;
+    }
+
+    transfer->m_body.append(buffer, size * nitems);
+    return size * nitems;
+  }
+
+  CEvent m_doneEvent;
+};
+} // namespace
+
+class TestCurlEngine : public testing::Test
+{
+protected:
+  TestCurlEngine() : m_sourcePath(XBMC_REF_FILE_PATH(SOURCE_PATH))
+  {
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<uint16_t> dist(49152, 65535);
+    m_webServerPort = dist(mt);
+
+    m_baseUrl = StringUtils::Format("http://" WEBSERVER_HOST ":{}", m_webServerPort);
+  }
+
+  ~TestCurlEngine() override = default;
+
+  void SetUp() override
+  {
+    CMediaSource source;
+    source.strName = "WebServer Share";
+    source.strPath = m_sourcePath;
+    source.vecPaths.push_back(m_sourcePath);
+    source.m_allowSharing = true;
+    source.m_iDriveType = CMediaSource::SOURCE_TYPE_LOCAL;
+    source.m_iLockMode = LOCK_MODE_EVERYONE;
+    source.m_ignore = true;
+
+    CMediaSourceSettings::GetInstance().AddShare("videos", source);
+
+    m_webServer.Start(m_webServerPort, "", "");
+    m_webServer.RegisterRequestHandler(&m_vfsHandler);
+  }
+
+  void TearDown() override
+  {
+    if (m_webServer.IsStarted())
+      m_webServer.Stop();
+
+    m_webServer.UnregisterRequestHandler(&m_vfsHandler);
+
+    CMediaSourceSettings::GetInstance().Clear();
+  }
+
+  std::string GetUrlOfTestFile(const std::string& testFile)
+  {
+    std::string path = URIUtils::AddFileToFolder(m_sourcePath, testFile);
+    path = CURL::Encode(path);
+    path = URIUtils::AddFileToFolder("vfs", path);
+
+    return URIUtils::AddFileToFolder(m_baseUrl, path);
+  }
+
+  std::string GetContentsOfTestFile(const std::string& testFile)
+  {
+    auto_buffer buffer;
+    CFile file;
+    if (file.LoadFile(URIUtils::AddFileToFolder(m_sourcePath, testFile), buffer) <= 0)
+      return "";
+
+    return std::string(buffer.get(), buffer.size());
+  }
+
+  CWebServer m_webServer;
+  uint16_t m_webServerPort;
+  std::string m_baseUrl;
+  std::string const m_sourcePath;
+  CHTTPVfsHandler m_vfsHandler;
+};
+
+TEST_F(TestCurlEngine, ConcurrentTransfers)
+{
+  const std::string expected = GetContentsOfTestFile(TEST_FILE);
+  ASSERT_FALSE(expected.empty());
+
+  CCurlEngine engine;
+
+  std::vector<std::unique_ptr<CTestTransfer>> transfers;
+  for (unsigned int i = 0; i < TRANSFER_COUNT; i++)
+  {
+    transfers.emplace_back(std::make_unique<CTestTransfer>(GetUrlOfTestFile(TEST_FILE)));
+    engine.Share(transfers.back()->m_easyHandle);
+  }
+
+  // All transfers run at the same time on the engine's thread
+  for (auto& transfer : transfers)
+    transfer->Start(engine);
+
+  for (auto& transfer : transfers)
+  {
+    ASSERT_TRUE(transfer->WaitDone());
+    EXPECT_EQ(transfer->m_result, CURLE_OK);
+    EXPECT_EQ(transfer->m_body, expected);
+  }
+
+  EXPECT_EQ(engine.GetTransferCount(), 0u);
+}
+
+TEST_F(TestCurlEngine, PauseAndUnpause)
+{
+  const std::string expected = GetContentsOfTestFile(TEST_FILE);
+  ASSERT_FALSE(expected.empty());
+
+  CCurlEngine engine;
+
+  CTestTransfer transfer(GetUrlOfTestFile(TEST_FILE));
+  transfer.m_bPauseNextWrite = true;
+  transfer.Start(engine);
+
+  ASSERT_TRUE(transfer.m_pausedEvent.Wait(10s));
+  EXPECT_EQ(engine.GetTransferCount(), 1u);
+
+  engine.Unpause(transfer.m_easyHandle);
+
+  ASSERT_TRUE(transfer.WaitDone());
+  EXPECT_EQ(transfer.m_result, CURLE_OK);
+  EXPECT_EQ(transfer.m_body, expected);
+}
+
+TEST_F(TestCurlEngine, RemoveTransfer)
+{
+  CCurlEngine engine;
+
+  CTestTransfer transfer(GetUrlOfTestFile(TEST_FILE));
+  transfer.m_bPauseNextWrite = true;
+  transfer.Start(engine);
+
+  ASSERT_TRUE(transfer.m_pausedEvent.Wait(10s));
+
+  // No callbacks are invoked after removing the transfer
+  engine.RemoveTransfer(transfer.m_easyHandle);
+  EXPECT_EQ(engine.GetTransferCount(), 0u);
+  EXPECT_FALSE(transfer.WaitDone(500ms));
+}
+
+TEST_F(TestCurlEngine, RemoveTransferFromCallback)
+{
+  const std::string expected = GetContentsOfTestFile(TEST_FILE);
+  ASSERT_FALSE(expected.empty());
+
+  CCurlEngine engine;
+
+  CTestTransfer transfer(GetUrlOfTestFile(TEST_FILE));
+  transfer.m_removeOnWrite = &engine;
+  transfer.Start(engine);
+
+  ASSERT_TRUE(transfer.m_removedEvent.Wait(10s));
+  EXPECT_EQ(engine.GetTransferCount(), 0u);
+  EXPECT_FALSE(transfer.WaitDone(500ms));
+  EXPECT_TRUE(transfer.m_body.empty());
+
+  // The easy handle can be used again
+  transfer.Start(engine);
+  ASSERT_TRUE(transfer.WaitDone());
+  EXPECT_EQ(transfer.m_result, CURLE_OK);
+  EXPECT_EQ(transfer.m_body, expected);
+}
+
+TEST_F(TestCurlEngine, StopFailsTransfers)
+{
+  CCurlEngine engine;
+
+  CTestTransfer transfer(GetUrlOfTestFile(TEST_FILE));
+  transfer.m_bPauseNextWrite = true;
+  transfer.Start(engine);
+
+  ASSERT_TRUE(transfer.m_pausedEvent.Wait(10s));
+
+  engine.Stop();
+
+  ASSERT_TRUE(transfer.WaitDone());
+  EXPECT_EQ(transfer.m_result, CURLE_ABORTED_BY_CALLBACK);
+}
+
+TEST_F(TestCurlEngine, CurlFileRead)
+{
+  const std::string expected = GetContentsOfTestFile(TEST_FILE);
+  ASSERT_FALSE(expected.empty());
+
+  // Small buffer so that the transfer pauses while the file is read
+  CCurlFile file;
+  file.SetBufferSize(64);
+  ASSERT_TRUE(file.Open(CURL(GetUrlOfTestFile(TEST_FILE))));
+
+  std::string body;
+  char buffer[100];
+  ssize_t read;
+  while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    body.append(buffer, read);
+
+  EXPECT_EQ(read, 0);
+  EXPECT_EQ(body, expected);
+
+  file.Close();
+}
@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/DownloadScheduler.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Holds requests until the test lets them complete, instead of going to the network
+class CTestDownloadScheduler : public CDownloadScheduler
+{
+public:
+  CTestDownloadScheduler(const std::string& cachePath, unsigned int hostLimit)
+    : CDownloadScheduler(cachePath, hostLimit)
+  {
+  }
+
+  ~CTestDownloadScheduler() override
+  {
+    Complete(1000);
+    for (std::thread& thread : m_threads)
+      thread.join();
+  }
+
+  // Start a download on its own thread
+  void Start(const std::string& url, Lane lane)
+  {
+    m_threads.emplace_back([this, url, lane]() {
+      HTTPResponse response;
+      const bool success = Get(url, lane, response);
+
+      CSingleLock lock(m_section);
+      if (success)
+        m_responses.emplace_back(response);
+      m_condition.notifyAll();
+    });
+  }
+
+  // Let a number of the running requests complete
+  void Complete(unsigned int count)
+  {
+    CSingleLock lock(m_section);
+    m_completions += count;
+    m_condition.notifyAll();
+  }
+
+  bool WaitForRequests(size_t count)
+  {
+    CSingleLock lock(m_section);
+    return Wait(lock, [this, count]() { return m_requests.size() >= count; });
+  }
+
+  bool WaitForResponses(size_t count)
+  {
+    CSingleLock lock(m_section);
+    return Wait(lock, [this, count]() { return m_responses.size() >= count; });
+  }
+
+  std::vector<std::string> GetRequests()
+  {
+    CSingleLock lock(m_section);
+    return m_requests;
+  }
+
+  std::vector<HTTPResponse> GetResponses()
+  {
+    CSingleLock lock(m_section);
+    return std::vector<HTTPResponse>(m_responses.begin(), m_responses.end());
+  }
+
+protected:
+  bool Request(CCurlFile& http,
+               const std::string& url,
+               const std::string* postData,
+               std::string& body) override
+  {
+    CSingleLock lock(m_section);
+    m_requests.emplace_back(url);
+    m_condition.notifyAll();
+
+    while (m_completions == 0)
+      m_condition.wait(lock);
+    m_completions--;
+
+    body = url;
+    return true;
+  }
+
+private:
+  bool Wait(CSingleLock& lock, const std::function<bool()>& done)
+  {
+    const auto end = std::chrono::steady_clock::now() + 5s;
+    while (!done())
+    {
+      if (std::chrono::steady_clock::now() >= end)
+        return false;
+      m_condition.wait(lock, 100ms);
+    }
+    return true;
+  }
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_condition;
+  unsigned int m_completions = 0;
+  std::vector<std::string> m_requests;
+  std::list<HTTPResponse> m_responses;
+  std::vector<std::thread> m_threads;
+};
+} // namespace
+
+class TestDownloadScheduler : public testing::Test
+{
+protected:
+  TestDownloadScheduler()
+    : m_cachePath(URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                            "TestDownloadScheduler"))
+  {
+  }
+
+  void TearDown() override { CDirectory::RemoveRecursive(m_cachePath); }
+
+  const std::string m_cachePath;
+};
+
+TEST_F(TestDownloadScheduler, HostLimit)
+{
+  CTestDownloadScheduler scheduler(m_cachePath, 2);
+
+  scheduler.Start("http://a/1", CDownloadScheduler::Lane::UI);
+  scheduler.Start("http://a/2", CDownloadScheduler::Lane::UI);
+  scheduler.Start("http://a/3", CDownloadScheduler::Lane::UI);
+  scheduler.Start("http://b/1", CDownloadScheduler::Lane::UI);
+
+  // Other hosts aren't held up by a busy host
+  ASSERT_TRUE(scheduler.WaitForRequests(3));
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(scheduler.GetRequests().size(), 3u);
+
+  // A connection that is released is used by the waiting request, at most one of
+  // the completed requests is the one to the other host
+  scheduler.Complete(2);
+  ASSERT_TRUE(scheduler.WaitForRequests(4));
+  EXPECT_TRUE(StringUtils::StartsWith(scheduler.GetRequests()[3], "http://a/"));
+
+  scheduler.Complete(2);
+  EXPECT_TRUE(scheduler.WaitForResponses(4));
+}
+
+TEST_F(TestDownloadScheduler, ScanKeepsConnectionFree)
+{
+  CTestDownloadScheduler scheduler(m_cachePath, 2);
+
+  scheduler.Start("http://a/scan1", CDownloadScheduler::Lane::SCAN);
+  ASSERT_TRUE(scheduler.WaitForRequests(1));
+
+  // The second connection is only for UI requests
+  scheduler.Start("http://a/scan2", CDownloadScheduler::Lane::SCAN);
+  scheduler.Start("http://a/ui1", CDownloadScheduler::Lane::UI);
+  ASSERT_TRUE(scheduler.WaitForRequests(2));
+  EXPECT_EQ(scheduler.GetRequests()[1], "http://a/ui1");
+
+  // Waiting UI requests go before waiting scan requests
+  scheduler.Start("http://a/ui2", CDownloadScheduler::Lane::UI);
+  std::this_thread::sleep_for(100ms);
+  scheduler.Complete(1);
+  ASSERT_TRUE(scheduler.WaitForRequests(3));
+  EXPECT_EQ(scheduler.GetRequests()[2], "http://a/ui2");
+
+  scheduler.Complete(3);
+  EXPECT_TRUE(scheduler.WaitForResponses(4));
+  EXPECT_EQ(scheduler.GetRequests().back(), "http://a/scan2");
+}
+
+TEST_F(TestDownloadScheduler, UIRequestRaisesScanDownload)
+{
+  CTestDownloadScheduler scheduler(m_cachePath, 2);
+
+  scheduler.Start("http://a/scan1", CDownloadScheduler::Lane::SCAN);
+  ASSERT_TRUE(scheduler.WaitForRequests(1));
+  scheduler.Start("http://a/scan2", CDownloadScheduler::Lane::SCAN);
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(scheduler.GetRequests().size(), 1u);
+
+  // Joining the waiting scan download moves it to the UI lane
+  scheduler.Start("http://a/scan2", CDownloadScheduler::Lane::UI);
+  ASSERT_TRUE(scheduler.WaitForRequests(2));
+  EXPECT_EQ(scheduler.GetRequests()[1], "http://a/scan2");
+
+  scheduler.Complete(2);
+  EXPECT_TRUE(scheduler.WaitForResponses(3));
+  EXPECT_EQ(scheduler.GetRequests().size(), 2u);
+}
+
+TEST_F(TestDownloadScheduler, Coalesce)
+{
+  CTestDownloadScheduler scheduler(m_cachePath, 4);
+
+  scheduler.Start("http://a/image.jpg", CDownloadScheduler::Lane::UI);
+  ASSERT_TRUE(scheduler.WaitForRequests(1));
+  scheduler.Start("http://a/image.jpg", CDownloadScheduler::Lane::UI);
+  std::this_thread::sleep_for(100ms);
+
+  scheduler.Complete(1);
+  ASSERT_TRUE(scheduler.WaitForResponses(2));
+  EXPECT_EQ(scheduler.GetRequests().size(), 1u);
+
+  // Only the request that joined the download is coalesced, neither came from the cache
+  const std::vector<HTTPResponse> responses = scheduler.GetResponses();
+  EXPECT_EQ(responses[0].body, "http://a/image.jpg");
+  EXPECT_EQ(responses[1].body, "http://a/image.jpg");
+  EXPECT_FALSE(responses[0].fromCache);
+  EXPECT_FALSE(responses[1].fromCache);
+  EXPECT_NE(responses[0].coalesced, responses[1].coalesced);
+}
+
+TEST_F(TestDownloadScheduler, PrefetchKeepsUncacheableResponse)
+{
+  CTestDownloadScheduler scheduler(m_cachePath, 4);
+
+  // The test responses have no validator or lifetime, so the cache doesn't store them
+  scheduler.Prefetch("http://a/image.jpg");
+  ASSERT_TRUE(scheduler.WaitForRequests(1));
+  scheduler.Complete(1);
+  std::this_thread::sleep_for(100ms);
+
+  scheduler.Start("http://a/image.jpg", CDownloadScheduler::Lane::SCAN);
+  ASSERT_TRUE(scheduler.WaitForResponses(1));
+  EXPECT_EQ(scheduler.GetRequests().size(), 1u);
+  EXPECT_EQ(scheduler.GetResponses()[0].body, "http://a/image.jpg");
+  EXPECT_TRUE(scheduler.GetResponses()[0].fromCache);
+
+  // The prefetched response is only used once
+  scheduler.Start("http://a/image.jpg", CDownloadScheduler::Lane::SCAN);
+  ASSERT_TRUE(scheduler.WaitForRequests(2));
+  scheduler.Complete(1);
+  ASSERT_TRUE(scheduler.WaitForResponses(2));
+  EXPECT_FALSE(scheduler.GetResponses()[1].fromCache);
+}
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/HTTPResponseCache.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/URIUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+class TestHTTPResponseCache : public testing::Test
+{
+protected:
+  TestHTTPResponseCache()
+    : m_cachePath(URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                            "TestHTTPResponseCache"))
+  {
+  }
+
+  void TearDown() override { CDirectory::RemoveRecursive(m_cachePath); }
+
+  static HTTPResponse CreateResponse(const std::string& body)
+  {
+    HTTPResponse response;
+    response.url = "http://localhost/image.jpg";
+    response.body = body;
+    response.mimeType = "image/jpeg";
+    response.etag = "\"1234\"";
+    response.lastModified = "Tue, 15 Nov 1994 12:45:26 GMT";
+    response.storedTime = 1000;
+    response.maxAge = 3600;
+    return response;
+  }
+
+  const std::string m_cachePath;
+};
+
+TEST_F(TestHTTPResponseCache, StoreAndLookup)
+{
+  CHTTPResponseCache cache(m_cachePath, 1024 * 1024);
+
+  const HTTPResponse stored = CreateResponse("content");
+  EXPECT_TRUE(cache.Store("key", stored));
+
+  HTTPResponse response;
+  ASSERT_TRUE(cache.Lookup("key", response));
+  EXPECT_EQ(response.url, stored.url);
+  EXPECT_EQ(response.body, stored.body);
+  EXPECT_EQ(response.mimeType, stored.mimeType);
+  EXPECT_EQ(response.etag, stored.etag);
+  EXPECT_EQ(response.lastModified, stored.lastModified);
+  EXPECT_EQ(response.storedTime, stored.storedTime);
+  EXPECT_EQ(response.maxAge, stored.maxAge);
+  EXPECT_TRUE(response.fromCache);
+
+  EXPECT_FALSE(cache.Lookup("other key", response));
+}
+
+TEST_F(TestHTTPResponseCache, TouchAndRemove)
+{
+  CHTTPResponseCache cache(m_cachePath, 1024 * 1024);
+
+  HTTPResponse stored = CreateResponse("content");
+  ASSERT_TRUE(cache.Store("key", stored));
+
+  stored.storedTime = 2000;
+  EXPECT_TRUE(cache.Touch("key", stored));
+
+  HTTPResponse response;
+  ASSERT_TRUE(cache.Lookup("key", response));
+  EXPECT_EQ(response.storedTime, 2000);
+  EXPECT_EQ(response.body, "content");
+
+  cache.Remove("key");
+  EXPECT_FALSE(cache.Lookup("key", response));
+}
+
+TEST_F(TestHTTPResponseCache, Trim)
+{
+  CHTTPResponseCache cache(m_cachePath, 100);
+
+  ASSERT_TRUE(cache.Store("first", CreateResponse(std::string(60, 'a'))));
+  ASSERT_TRUE(cache.Store("second", CreateResponse(std::string(60, 'b'))));
+
+  // The cache only has room for one of them
+  HTTPResponse response;
+  const bool first = cache.Lookup("first", response);
+  const bool second = cache.Lookup("second", response);
+  EXPECT_NE(first, second);
+}
+
+TEST_F(TestHTTPResponseCache, IsFresh)
+{
+  HTTPResponse response = CreateResponse("content");
+
+  EXPECT_TRUE(response.IsFresh(response.storedTime));
+  EXPECT_TRUE(response.IsFresh(response.storedTime + 3599));
+  EXPECT_FALSE(response.IsFresh(response.storedTime + 3600));
+
+  response.maxAge = 0;
+  EXPECT_FALSE(response.IsFresh(response.storedTime));
+
+  // Without max-age a response is fresh for a short while
+  response.maxAge = -1;
+  EXPECT_TRUE(response.IsFresh(response.storedTime));
+  EXPECT_FALSE(response.IsFresh(response.storedTime + 24 * 60 * 60));
+}
+
+TEST_F(TestHTTPResponseCache, ParseCacheControl)
+{
+  bool noStore;
+  int maxAge;
+
+  CHTTPResponseCache::ParseCacheControl("", noStore, maxAge);
+  EXPECT_FALSE(noStore);
+  EXPECT_EQ(maxAge, -1);
+
+  CHTTPResponseCache::ParseCacheControl("public, Max-Age=3600", noStore, maxAge);
+  EXPECT_FALSE(noStore);
+  EXPECT_EQ(maxAge, 3600);
+
+  CHTTPResponseCache::ParseCacheControl("no-cache, max-age=3600", noStore, maxAge);
+  EXPECT_FALSE(noStore);
+  EXPECT_EQ(maxAge, 0);
+
+  CHTTPResponseCache::ParseCacheControl("private, no-store", noStore, maxAge);
+  EXPECT_TRUE(noStore);
+}
+
+TEST_F(TestHTTPResponseCache, ParseExpires)
+{
+  const std::string date = "Tue, 15 Nov 1994 12:45:26 GMT";
+
+  EXPECT_EQ(CHTTPResponseCache::ParseExpires("", date), -1);
+  EXPECT_EQ(CHTTPResponseCache::ParseExpires("Tue, 15 Nov 1994 13:45:26 GMT", date), 3600);
+
+  // Dates in the past and invalid dates have expired already
+  EXPECT_EQ(CHTTPResponseCache::ParseExpires("Tue, 15 Nov 1994 11:45:26 GMT", date), 0);
+  EXPECT_EQ(CHTTPResponseCache::ParseExpires("0", date), 0);
+}
+
+TEST_F(TestHTTPResponseCache, ParseHeaders)
+{
+  const std::string date = "Tue, 15 Nov 1994 12:45:26 GMT";
+  const std::string expires = "Tue, 15 Nov 1994 13:45:26 GMT";
+  bool noStore;
+  int maxAge;
+
+  CHTTPResponseCache::ParseHeaders("", "", "", "", noStore, maxAge);
+  EXPECT_FALSE(noStore);
+  EXPECT_EQ(maxAge, -1);
+
+  CHTTPResponseCache::ParseHeaders("", "", expires, date, noStore, maxAge);
+  EXPECT_EQ(maxAge, 3600);
+
+  // Cache-Control takes precedence over Expires
+  CHTTPResponseCache::ParseHeaders("max-age=60", "", expires, date, noStore, maxAge);
+  EXPECT_EQ(maxAge, 60);
+
+  CHTTPResponseCache::ParseHeaders("no-cache", "", expires, date, noStore, maxAge);
+  EXPECT_FALSE(noStore);
+  EXPECT_EQ(maxAge, 0);
+
+  // Pragma is only used by servers that don't send Cache-Control
+  CHTTPResponseCache::ParseHeaders("", "no-cache", expires, date, noStore, maxAge);
+  EXPECT_EQ(maxAge, 0);
+
+  CHTTPResponseCache::ParseHeaders("public", "no-cache", expires, date, noStore, maxAge);
+  EXPECT_EQ(maxAge, 3600);
+}
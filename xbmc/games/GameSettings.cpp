@@ -25,6 +25,7 @@ const std::string SETTING_GAMES_SHOW_OSD_HELP = "gamesgeneral.showosdhelp";
 const std::string SETTING_GAMES_ENABLEAUTOSAVE = "gamesgeneral.enableautosave";
 const std::string SETTING_GAMES_ENABLEREWIND = "gamesgeneral.enablerewind";
 const std::string SETTING_GAMES_REWINDTIME = "gamesgeneral.rewindtime";
+const std::string SETTING_GAMES_REWINDMEMORY = "gamesgeneral.rewindmemory";
 } // namespace
 
 CGameSettings::CGameSettings()
@@ -34,6 +35,7 @@ CGameSettings::CGameSettings()
   m_settings->RegisterCallback(this, {
                                          SETTING_GAMES_ENABLEREWIND,
                                          SETTING_GAMES_REWINDTIME,
+                                         SETTING_GAMES_REWINDMEMORY,
                                      });
 }
 
@@ -85,6 +87,13 @@ unsigned int CGameSettings::MaxRewindTimeSec()
   return static_cast<unsigned int>(std::max(rewindTimeSec, 0));
 }
 
+unsigned int CGameSettings::MaxRewindMemoryMB()
+{
+  int rewindMemoryMB = m_settings->GetInt(SETTING_GAMES_REWINDMEMORY);
+
+  return static_cast<unsigned int>(std::max(rewindMemoryMB, 0));
+}
+
 void CGameSettings::OnSettingChanged(const std::shared_ptr<const CSetting>& setting)
 {
   if (setting == nullptr)
@@ -92,7 +101,8 @@ void CGameSettings::OnSettingChanged(const std::shared_ptr<const CSetting>& sett
 
   const std::string& settingId = setting->GetId();
 
-  if (settingId == SETTING_GAMES_ENABLEREWIND || settingId == SETTING_GAMES_REWINDTIME)
+  if (settingId == SETTING_GAMES_ENABLEREWIND || settingId == SETTING_GAMES_REWINDTIME ||
+      settingId == SETTING_GAMES_REWINDMEMORY)
   {
     SetChanged();
     NotifyObservers(ObservableMessageSettingsChanged);
@@ -477,7 +477,7 @@ void CGameClient::CloseFile()
   }
 }
 
-void CGameClient::RunFrame()
+void CGameClient::RunFrame(bool bPresentAudio /* = true */, bool bPresentVideo /* = true */)
 {
   IGameInputCallback* input;
 
@@ -493,6 +493,9 @@ void CGameClient::RunFrame()
 
   if (m_bIsPlaying)
   {
+    m_bPresentAudio = bPresentAudio;
+    m_bPresentVideo = bPresentVideo;
+
     try
     {
       LogError(m_struct.toAddon->RunFrame(&m_struct), "RunFrame()");
@@ -501,6 +504,9 @@ void CGameClient::RunFrame()
     {
       LogException("RunFrame()");
     }
+
+    m_bPresentAudio = true;
+    m_bPresentVideo = true;
   }
 }
 
@@ -625,6 +631,27 @@ void CGameClient::cb_add_stream_data(KODI_HANDLE kodiInstance,
   if (packet == nullptr)
     return;
 
+  CGameClient* gameClient = static_cast<CGameClient*>(kodiInstance);
+  if (gameClient == nullptr)
+    return;
+
+  // Drop the output of frames that are emulated but not presented
+  switch (packet->type)
+  {
+    case GAME_STREAM_AUDIO:
+      if (!gameClient->m_bPresentAudio)
+        return;
+      break;
+    case GAME_STREAM_VIDEO:
+    case GAME_STREAM_SW_FRAMEBUFFER:
+    case GAME_STREAM_HW_FRAMEBUFFER:
+      if (!gameClient->m_bPresentVideo)
+        return;
+      break;
+    default:
+      break;
+  }
+
   IGameClientStream* gameClientStream = static_cast<IGameClientStream*>(stream);
   if (gameClientStream == nullptr)
     return;
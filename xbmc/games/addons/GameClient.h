@@ -136,7 +136,7 @@ public:
   size_t GetSerializeSize() const { return m_serializeSize; }
   double GetFrameRate() const { return m_framerate; }
   double GetSampleRate() const { return m_samplerate; }
-  void RunFrame();
+  void RunFrame(bool bPresentAudio = true, bool bPresentVideo = true);
 
   // Access memory
   size_t SerializeSize() const { return m_serializeSize; }
@@ -208,6 +208,8 @@ private:
   double m_framerate = 0.0; // Video frame rate (fps)
   double m_samplerate = 0.0; // Audio sample rate (Hz)
   GAME_REGION m_region; // Region of the loaded game
+  std::atomic_bool m_bPresentAudio{true}; // False while running frames that aren't heard
+  std::atomic_bool m_bPresentVideo{true}; // False while running frames that aren't shown
 
   // In-game saves
   std::unique_ptr<CGameClientInGameSaves> m_inGameSaves;
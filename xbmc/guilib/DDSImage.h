@@ -26,7 +26,18 @@ public:
 
   bool ReadFile(const std::string &file);
 
+  /*! \brief Write an uncompressed ARGB image that can be uploaded without decoding
+   \param outputFile the file to write
+   \param width width of the image
+   \param height height of the image
+   \param pitch pitch of the source image
+   \param brga pixels of the source image, in BGRA byte order
+   \return true on success, false on failure
+   */
+  bool Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga);
+
 private:
+  bool WriteFile(const std::string &file) const;
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
   static const char *GetFourCC(unsigned int format);
 
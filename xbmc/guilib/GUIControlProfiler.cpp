@@ -12,8 +12,23 @@
 #include "utils/TimeUtils.h"
 #include "utils/XBMCTinyXML.h"
 
+#include <algorithm>
+#include <atomic>
+
 bool CGUIControlProfiler::m_bIsRunning = false;
 
+namespace
+{
+// nesting of condition evaluations on this thread, and the start of the outermost one
+thread_local unsigned int conditionDepth = 0;
+thread_local int64_t conditionStart = 0;
+
+// profiling session the nesting belongs to. An evaluation that began before the profiler
+// stopped never ends, so the nesting of other threads is discarded when the next session starts.
+std::atomic<unsigned int> sessionCount{0};
+thread_local unsigned int conditionSession = 0;
+} // namespace
+
 CGUIControlProfilerItem::CGUIControlProfilerItem(CGUIControlProfiler *pProfiler, CGUIControlProfilerItem *pParent, CGUIControl *pControl)
 : m_pProfiler(pProfiler), m_pParent(pParent), m_pControl(pControl), m_visTime(0), m_renderTime(0), m_i64VisStart(0), m_i64RenderStart(0)
 {
@@ -241,6 +256,11 @@ void CGUIControlProfiler::Start(void)
   m_bIsRunning = true;
   m_pLastItem = NULL;
   m_ItemHead.Reset(this);
+  m_conditionCount = 0;
+  m_conditionTime = 0;
+  m_conditionFrameTime = 0;
+  m_conditionMaxFrameTime = 0;
+  sessionCount++;
 }
 
 void CGUIControlProfiler::BeginVisibility(CGUIControl *pControl)
@@ -267,6 +287,28 @@ void CGUIControlProfiler::EndRender(CGUIControl *pControl)
   item->EndRender();
 }
 
+void CGUIControlProfiler::BeginCondition(void)
+{
+  const unsigned int session = sessionCount;
+  if (conditionSession != session)
+  {
+    conditionSession = session;
+    conditionDepth = 0;
+  }
+
+  m_conditionCount++;
+  if (conditionDepth++ == 0)
+    conditionStart = CurrentHostCounter();
+}
+
+void CGUIControlProfiler::EndCondition(void)
+{
+  // began before the profiler was started
+  if (conditionSession != sessionCount || conditionDepth == 0 || --conditionDepth > 0)
+    return;
+  m_conditionFrameTime += (unsigned int)(m_fPerfScale * (CurrentHostCounter() - conditionStart));
+}
+
 CGUIControlProfilerItem *CGUIControlProfiler::FindOrAddControl(CGUIControl *pControl)
 {
   if (m_pLastItem)
@@ -298,6 +340,10 @@ CGUIControlProfilerItem *CGUIControlProfiler::FindOrAddControl(CGUIControl *pCon
 void CGUIControlProfiler::EndFrame(void)
 {
   m_iFrameCount++;
+  const unsigned int conditionFrameTime = m_conditionFrameTime.exchange(0);
+  m_conditionTime += conditionFrameTime;
+  m_conditionMaxFrameTime = std::max(m_conditionMaxFrameTime.load(), conditionFrameTime);
+
   if (m_iFrameCount >= m_iMaxFrameCount)
   {
     const unsigned int dwSize = m_ItemHead.m_vecChildren.size();
@@ -329,6 +375,18 @@ bool CGUIControlProfiler::SaveResults(void)
   root->SetAttribute("timeunit", "ms");
   doc.LinkEndChild(root);
 
+  // Note time is stored in 1/100 milliseconds but reported in ms
+  TiXmlElement *conditions = new TiXmlElement("conditions");
+  str = std::to_string(m_conditionCount);
+  conditions->SetAttribute("evaluations", str.c_str());
+  str = std::to_string(m_conditionTime / 100);
+  conditions->SetAttribute("time", str.c_str());
+  str = StringUtils::Format("{:.2f}", m_iFrameCount ? m_conditionTime / (100.0f * m_iFrameCount) : 0.0f);
+  conditions->SetAttribute("frametime", str.c_str());
+  str = StringUtils::Format("{:.2f}", m_conditionMaxFrameTime / 100.0f);
+  conditions->SetAttribute("maxframetime", str.c_str());
+  root->LinkEndChild(conditions);
+
   m_ItemHead.SaveToXML(root);
   return doc.SaveFile(m_strOutputFile);
 }
@@ -10,6 +10,7 @@
 
 #include "GUIControl.h"
 
+#include <atomic>
 #include <vector>
 
 class CGUIControlProfiler;
@@ -57,12 +58,19 @@ public:
   void EndVisibility(CGUIControl *pControl);
   void BeginRender(CGUIControl *pControl);
   void EndRender(CGUIControl *pControl);
+  /*! \brief Time the evaluation of a skin condition
+   Nested evaluations (the bools of an expression) are counted but not timed separately.
+   */
+  void BeginCondition(void);
+  void EndCondition(void);
   int GetMaxFrameCount(void) const { return m_iMaxFrameCount; };
   void SetMaxFrameCount(int iMaxFrameCount) { m_iMaxFrameCount = iMaxFrameCount; };
   void SetOutputFile(const std::string &strOutputFile) { m_strOutputFile = strOutputFile; };
   const std::string &GetOutputFile(void) const { return m_strOutputFile; };
   bool SaveResults(void);
   unsigned int GetTotalTime(void) const { return m_ItemHead.GetTotalTime(); };
+  /*! \brief Get the time spent evaluating skin conditions, in 1/100 ms */
+  unsigned int GetConditionTime(void) const { return m_conditionTime; };
 
   float m_fPerfScale;
 private:
@@ -79,10 +87,18 @@ private:
   std::string m_strOutputFile;
   int m_iMaxFrameCount = 200;
   int m_iFrameCount = 0;
+
+  // conditions are also evaluated outside the GUI thread, e.g. by scripts
+  std::atomic<unsigned int> m_conditionCount{0};
+  std::atomic<unsigned int> m_conditionTime{0};
+  std::atomic<unsigned int> m_conditionFrameTime{0};
+  std::atomic<unsigned int> m_conditionMaxFrameTime{0};
 };
 
 #define GUIPROFILER_VISIBILITY_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginVisibility(x); }
 #define GUIPROFILER_VISIBILITY_END(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndVisibility(x); }
 #define GUIPROFILER_RENDER_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginRender(x); }
 #define GUIPROFILER_RENDER_END(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndRender(x); }
+#define GUIPROFILER_CONDITION_BEGIN() { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginCondition(); }
+#define GUIPROFILER_CONDITION_END() { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndCondition(); }
 
@@ -53,6 +53,20 @@ class CGUIFontCacheImpl
       }
       return hashMap.end();
     }
+    HashIter Erase(HashIter it)
+    {
+      auto range = ageMap.equal_range(it->second->m_lastUsedMillis);
+      for (auto ageit = range.first; ageit != range.second; ++ageit)
+      {
+        if (ageit->second == it)
+        {
+          ageMap.erase(ageit);
+          break;
+        }
+      }
+      delete it->second;
+      return hashMap.erase(it);
+    }
     void UpdateAge(HashIter it, size_t millis)
     {
       auto range = ageMap.equal_range(it->second->m_lastUsedMillis);
@@ -82,8 +96,10 @@ public:
                 const std::vector<UTILS::Color> &colors, const vecText &text,
                 uint32_t alignment, float maxPixelWidth,
                 bool scrolling,
-                unsigned int nowMillis, bool &dirtyCache);
+                unsigned int nowMillis, bool &dirtyCache,
+                std::vector<int>*& textureLines);
   void Flush();
+  void InvalidateTextureLine(int textureLine);
 };
 
 template<class Position, class Value>
@@ -108,6 +124,7 @@ void CGUIFontCacheEntry<Position, Value>::Assign(const CGUIFontCacheKey<Position
   m_key.m_scaleY = key.m_scaleY;
   m_lastUsedMillis = nowMillis;
   m_value.clear();
+  m_textureLines.clear();
 }
 
 template<class Position, class Value>
@@ -127,12 +144,14 @@ Value &CGUIFontCache<Position, Value>::Lookup(Position &pos,
                                               const std::vector<UTILS::Color> &colors, const vecText &text,
                                               uint32_t alignment, float maxPixelWidth,
                                               bool scrolling,
-                                              unsigned int nowMillis, bool &dirtyCache)
+                                              unsigned int nowMillis, bool &dirtyCache,
+                                              std::vector<int>*& textureLines)
 {
   if (m_impl == nullptr)
     m_impl = new CGUIFontCacheImpl<Position, Value>(this);
 
-  return m_impl->Lookup(pos, colors, text, alignment, maxPixelWidth, scrolling, nowMillis, dirtyCache);
+  return m_impl->Lookup(pos, colors, text, alignment, maxPixelWidth, scrolling, nowMillis,
+                        dirtyCache, textureLines);
 }
 
 template<class Position, class Value>
@@ -140,7 +159,8 @@ Value &CGUIFontCacheImpl<Position, Value>::Lookup(Position &pos,
                                                   const std::vector<UTILS::Color> &colors, const vecText &text,
                                                   uint32_t alignment, float maxPixelWidth,
                                                   bool scrolling,
-                                                  unsigned int nowMillis, bool &dirtyCache)
+                                                  unsigned int nowMillis, bool &dirtyCache,
+                                                  std::vector<int>*& textureLines)
 {
   const CGUIFontCacheKey<Position> key(pos,
                                        const_cast<std::vector<UTILS::Color> &>(colors), const_cast<vecText &>(text),
@@ -167,7 +187,9 @@ Value &CGUIFontCacheImpl<Position, Value>::Lookup(Position &pos,
       entry = new CGUIFontCacheEntry<Position, Value>(*m_parent, key, nowMillis);
     else
       entry->Assign(key, nowMillis);
-    return m_list.Insert(hashgen(key), entry)->second->m_value;
+    entry = m_list.Insert(hashgen(key), entry)->second;
+    textureLines = &entry->m_textureLines;
+    return entry->m_value;
   }
   else
   {
@@ -180,6 +202,7 @@ Value &CGUIFontCacheImpl<Position, Value>::Lookup(Position &pos,
     m_list.UpdateAge(i, nowMillis);
 
     dirtyCache = false;
+    textureLines = &i->second->m_textureLines;
     return i->second->m_value;
   }
 }
@@ -196,19 +219,40 @@ void CGUIFontCacheImpl<Position, Value>::Flush()
   m_list.Flush();
 }
 
+template<class Position, class Value>
+void CGUIFontCache<Position, Value>::InvalidateTextureLine(int textureLine)
+{
+  m_impl->InvalidateTextureLine(textureLine);
+}
+
+template<class Position, class Value>
+void CGUIFontCacheImpl<Position, Value>::InvalidateTextureLine(int textureLine)
+{
+  for (auto it = m_list.hashMap.begin(); it != m_list.hashMap.end();)
+  {
+    const std::vector<int>& lines = it->second->m_textureLines;
+    if (std::find(lines.begin(), lines.end(), textureLine) != lines.end())
+      it = m_list.Erase(it);
+    else
+      ++it;
+  }
+}
+
 template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::CGUIFontCache(
     CGUIFontTTF& font);
 template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::~CGUIFontCache();
 template CGUIFontCacheEntry<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::~CGUIFontCacheEntry();
-template CGUIFontCacheStaticValue &CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Lookup(CGUIFontCacheStaticPosition &, const std::vector<UTILS::Color> &, const vecText &, uint32_t, float, bool, unsigned int, bool &);
+template CGUIFontCacheStaticValue &CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Lookup(CGUIFontCacheStaticPosition &, const std::vector<UTILS::Color> &, const vecText &, uint32_t, float, bool, unsigned int, bool &, std::vector<int>*&);
 template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Flush();
+template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::InvalidateTextureLine(int);
 
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::CGUIFontCache(
     CGUIFontTTF& font);
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::~CGUIFontCache();
 template CGUIFontCacheEntry<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::~CGUIFontCacheEntry();
-template CGUIFontCacheDynamicValue &CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Lookup(CGUIFontCacheDynamicPosition &, const std::vector<UTILS::Color> &, const vecText &, uint32_t, float, bool, unsigned int, bool &);
+template CGUIFontCacheDynamicValue &CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Lookup(CGUIFontCacheDynamicPosition &, const std::vector<UTILS::Color> &, const vecText &, uint32_t, float, bool, unsigned int, bool &, std::vector<int>*&);
 template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Flush();
+template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::InvalidateTextureLine(int);
 
 void CVertexBuffer::clear()
 {
@@ -67,6 +67,7 @@ struct CGUIFontCacheEntry
   TransformMatrix m_matrix;
   unsigned int m_lastUsedMillis;
   Value m_value;
+  std::vector<int> m_textureLines; // glyph texture lines that m_value refers to
 
   CGUIFontCacheEntry(const CGUIFontCache<Position, Value> &cache, const CGUIFontCacheKey<Position> &key, unsigned int nowMillis) :
     m_cache(cache),
@@ -139,8 +140,12 @@ public:
                 const std::vector<UTILS::Color> &colors, const vecText &text,
                 uint32_t alignment, float maxPixelWidth,
                 bool scrolling,
-                unsigned int nowMillis, bool &dirtyCache);
+                unsigned int nowMillis, bool &dirtyCache,
+                std::vector<int>*& textureLines);
   void Flush();
+
+  /*! \brief drop the entries whose vertices refer to glyphs on the given texture line */
+  void InvalidateTextureLine(int textureLine);
 };
 
 struct CGUIFontCacheStaticPosition
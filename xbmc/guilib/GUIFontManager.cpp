@@ -275,6 +275,22 @@ void GUIFontManager::FreeFontFile(CGUIFontTTF* pFont)
   }
 }
 
+void GUIFontManager::GetCharacterCacheStats(unsigned int& numChars,
+                                            unsigned int& usedLines,
+                                            unsigned int& totalLines,
+                                            unsigned int& evictedLines) const
+{
+  numChars = usedLines = totalLines = evictedLines = 0;
+  for (const CGUIFontTTF* pFont : m_vecFontFiles)
+  {
+    const CGUIFontTTF::CharacterCacheStats stats = pFont->GetCharacterCacheStats();
+    numChars += stats.numChars;
+    usedLines += stats.usedLines;
+    totalLines += stats.totalLines;
+    evictedLines += stats.evictedLines;
+  }
+}
+
 CGUIFontTTF* GUIFontManager::GetFontFile(const std::string& strFileName)
 {
   for (int i = 0; i < (int)m_vecFontFiles.size(); ++i)
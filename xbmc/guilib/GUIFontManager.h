@@ -66,6 +66,17 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTF* pFont);
 
+  /*! \brief sum up the glyph cache occupancy of all loaded font files
+   \param numChars [out] number of cached glyphs
+   \param usedLines [out] glyph texture lines holding at least one glyph
+   \param totalLines [out] glyph texture lines allocated
+   \param evictedLines [out] glyph texture lines recycled so far
+   */
+  void GetCharacterCacheStats(unsigned int& numChars,
+                              unsigned int& usedLines,
+                              unsigned int& totalLines,
+                              unsigned int& evictedLines) const;
+
   static void SettingOptionsFontsFiller(const std::shared_ptr<const CSetting>& setting,
                                         std::vector<StringSettingOption>& list,
                                         std::string& current,
@@ -173,6 +173,8 @@ CGUIFontTTF::CGUIFontTTF(const std::string& strFileName)
   m_ellipsesWidth = m_height = 0.0f;
   m_color = 0;
   m_nTexture = 0;
+  m_drawCount = 0;
+  m_evictedLines = 0;
 
   m_renderSystem = CServiceBroker::GetRenderSystem();
 }
@@ -212,6 +214,9 @@ void CGUIFontTTF::ClearCharacterCache()
   m_posX = m_textureWidth;
   m_posY = -(int)GetTextureLineHeight();
   m_textureHeight = 0;
+  m_textureLines.clear();
+  m_staticCache.Flush();
+  m_dynamicCache.Flush();
 }
 
 void CGUIFontTTF::Clear()
@@ -226,6 +231,8 @@ void CGUIFontTTF::Clear()
   m_posX = 0;
   m_posY = 0;
   m_nestedBeginCount = 0;
+  m_textureLines.clear();
+  m_evictedLines = 0;
 
   if (m_face)
     g_freeTypeLibrary.ReleaseFont(m_face);
@@ -308,6 +315,8 @@ bool CGUIFontTTF::Load(
 
   m_maxChars = 0;
   m_numChars = 0;
+  m_textureLines.clear();
+  m_evictedLines = 0;
 
   m_strFilename = strFilename;
 
@@ -368,6 +377,10 @@ void CGUIFontTTF::DrawTextInternal(float x,
 
   Begin();
 
+  // glyphs used by this text are stamped with the current count so they can't be evicted
+  // while the text is laid out
+  m_drawCount++;
+
   uint32_t rawAlignment = alignment;
   bool dirtyCache(false);
   bool hardwareClipping = m_renderSystem->ScissorsCanEffectClipping();
@@ -379,6 +392,7 @@ void CGUIFontTTF::DrawTextInternal(float x,
                                               CServiceBroker::GetWinSystem()->GetGfxContext().ScaleFinalYCoord(x, y),
                                               CServiceBroker::GetWinSystem()->GetGfxContext().ScaleFinalZCoord(x, y));
   }
+  std::vector<int>* textureLines = nullptr;
   CVertexBuffer unusedVertexBuffer;
   CVertexBuffer &vertexBuffer = hardwareClipping ?
       m_dynamicCache.Lookup(dynamicPos,
@@ -386,7 +400,7 @@ void CGUIFontTTF::DrawTextInternal(float x,
                             alignment, maxPixelWidth,
                             scrolling,
                             XbmcThreads::SystemClockMillis(),
-                            dirtyCache) :
+                            dirtyCache, textureLines) :
       unusedVertexBuffer;
   std::shared_ptr<std::vector<SVertex> > tempVertices = std::make_shared<std::vector<SVertex> >();
   std::shared_ptr<std::vector<SVertex> > &vertices = hardwareClipping ?
@@ -396,7 +410,7 @@ void CGUIFontTTF::DrawTextInternal(float x,
                            alignment, maxPixelWidth,
                            scrolling,
                            XbmcThreads::SystemClockMillis(),
-                           dirtyCache));
+                           dirtyCache, textureLines));
   if (dirtyCache)
   {
     // save the origin, which is scaled separately
@@ -459,8 +473,13 @@ void CGUIFontTTF::DrawTextInternal(float x,
     // are not currently cached and cause the texture to be enlarged, which
     // would invalidate the texture coordinates.
     std::queue<Character> characters;
+    std::vector<int> usedLines;
     if (alignment & XBFONT_TRUNCATED)
-      GetCharacter(L'.');
+    {
+      Character* period = GetCharacter(L'.');
+      if (period && period->textureLine >= 0)
+        usedLines.push_back(period->textureLine);
+    }
     for (const auto& pos : text)
     {
       Character* ch = GetCharacter(pos);
@@ -471,6 +490,8 @@ void CGUIFontTTF::DrawTextInternal(float x,
         continue;
       }
       characters.push(*ch);
+      if (ch->textureLine >= 0)
+        usedLines.push_back(ch->textureLine);
 
       if (maxPixelWidth > 0 &&
           cursorX + ((alignment & XBFONT_TRUNCATED) ? ch->advance + 3 * m_ellipsesWidth : 0) > maxPixelWidth)
@@ -478,6 +499,8 @@ void CGUIFontTTF::DrawTextInternal(float x,
       cursorX += ch->advance;
     }
     cursorX = 0;
+    std::sort(usedLines.begin(), usedLines.end());
+    usedLines.erase(std::unique(usedLines.begin(), usedLines.end()), usedLines.end());
 
     for (const auto& pos : text)
     {
@@ -537,9 +560,10 @@ void CGUIFontTTF::DrawTextInternal(float x,
                                                           rawAlignment, maxPixelWidth,
                                                           scrolling,
                                                           XbmcThreads::SystemClockMillis(),
-                                                          dirtyCache);
+                                                          dirtyCache, textureLines);
       CVertexBuffer newVertexBuffer = CreateVertexBuffer(*tempVertices);
       vertexBuffer = newVertexBuffer;
+      *textureLines = std::move(usedLines);
       m_vertexTrans.emplace_back(0, 0, 0, &vertexBuffer,
                                  CServiceBroker::GetWinSystem()->GetGfxContext().GetClipRegion());
     }
@@ -550,13 +574,18 @@ void CGUIFontTTF::DrawTextInternal(float x,
                            rawAlignment, maxPixelWidth,
                            scrolling,
                            XbmcThreads::SystemClockMillis(),
-                           dirtyCache) = *static_cast<CGUIFontCacheStaticValue *>(&tempVertices);
+                           dirtyCache, textureLines) = *static_cast<CGUIFontCacheStaticValue *>(&tempVertices);
+      *textureLines = std::move(usedLines);
       /* Append the new vertices to the set collected since the first Begin() call */
       m_vertex.insert(m_vertex.end(), tempVertices->begin(), tempVertices->end());
     }
   }
   else
   {
+    // the cached vertices are drawn, so their glyphs are in use as well
+    for (int line : *textureLines)
+      m_textureLines[line].lastUsed = m_drawCount;
+
     if (hardwareClipping)
       m_vertexTrans.emplace_back(dynamicPos.m_x, dynamicPos.m_y, dynamicPos.m_z, &vertexBuffer,
                                  CServiceBroker::GetWinSystem()->GetGfxContext().GetClipRegion());
@@ -629,7 +658,12 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr)
   {
     character_t ch = (style << 8) | letter;
     if (ch < LOOKUPTABLE_SIZE && m_charquick[ch])
-      return m_charquick[ch];
+    {
+      Character* cached = m_charquick[ch];
+      if (cached->textureLine >= 0)
+        m_textureLines[cached->textureLine].lastUsed = m_drawCount;
+      return cached;
+    }
   }
 
   // letters are stored based on style and letter
@@ -645,40 +679,25 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr)
     else if (ch < m_char[mid].letterAndStyle)
       high = mid - 1;
     else
-      return &m_char[mid];
-  }
-  // if we get to here, then low is where we should insert the new character
-
-  // increase the size of the buffer if we need it
-  if (m_numChars >= m_maxChars)
-  { // need to increase the size of the buffer
-    Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
-    if (m_char)
     {
-      memcpy(newTable, m_char, low * sizeof(Character));
-      memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-      delete[] m_char;
+      if (m_char[mid].textureLine >= 0)
+        m_textureLines[m_char[mid].textureLine].lastUsed = m_drawCount;
+      return &m_char[mid];
     }
-    m_char = newTable;
-    m_maxChars += CHAR_CHUNK;
-
-  }
-  else
-  { // just move the data along as necessary
-    memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
   }
+
   // render the character to our texture
   // must End() as we can't render text to our texture during a Begin(), End() block
+  Character newChar;
   unsigned int nestedBeginCount = m_nestedBeginCount;
   m_nestedBeginCount = 1;
   if (nestedBeginCount) End();
-  if (!CacheCharacter(letter, style, m_char + low))
+  if (!CacheCharacter(letter, style, &newChar))
   { // unable to cache character - try clearing them all out and starting over
     CLog::Log(LOGDEBUG, "{}: Unable to cache character.  Clearing character cache of {} characters",
               __FUNCTION__, m_numChars);
     ClearCharacterCache();
-    low = 0;
-    if (!CacheCharacter(letter, style, m_char + low))
+    if (!CacheCharacter(letter, style, &newChar))
     {
       CLog::Log(LOGERROR, "{}: Unable to cache character (out of memory?)", __FUNCTION__);
       if (nestedBeginCount) Begin();
@@ -689,18 +708,145 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr)
   if (nestedBeginCount) Begin();
   m_nestedBeginCount = nestedBeginCount;
 
-  // fixup quick access
+  // caching may have evicted characters, so look up where the new one belongs again
+  low = 0;
+  high = m_numChars - 1;
+  while (low <= high)
+  {
+    int mid = (low + high) >> 1;
+    if (ch > m_char[mid].letterAndStyle)
+      low = mid + 1;
+    else
+      high = mid - 1;
+  }
+
+  // increase the size of the buffer if we need it
+  if (m_numChars >= m_maxChars)
+  { // need to increase the size of the buffer
+    Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
+    if (m_char)
+    {
+      memcpy(newTable, m_char, low * sizeof(Character));
+      memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
+      delete[] m_char;
+    }
+    m_char = newTable;
+    m_maxChars += CHAR_CHUNK;
+
+  }
+  else
+  { // just move the data along as necessary
+    memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
+  }
+  m_char[low] = newChar;
+  m_numChars++;
+
+  UpdateCharQuickLookup();
+
+  return m_char + low;
+}
+
+void CGUIFontTTF::UpdateCharQuickLookup()
+{
   memset(m_charquick, 0, sizeof(m_charquick));
-  for(int i=0;i<m_numChars;i++)
+  for (int i = 0; i < m_numChars; i++)
   {
     if ((m_char[i].letterAndStyle & 0xffff) < 255)
     {
       character_t ch = ((m_char[i].letterAndStyle & 0xffff0000) >> 8) | (m_char[i].letterAndStyle & 0xff);
-      m_charquick[ch] = m_char+i;
+      m_charquick[ch] = m_char + i;
     }
   }
+}
 
-  return m_char + low;
+bool CGUIFontTTF::NextTextureLine()
+{
+  const unsigned int lineHeight = GetTextureLineHeight();
+  const unsigned int newLineY = m_textureLines.size() * lineHeight;
+
+  m_posX = 0;
+
+  if (newLineY + lineHeight >= m_textureHeight)
+  {
+    // create the new larger texture
+    unsigned int newHeight = newLineY + lineHeight;
+    // check for max height
+    if (newHeight > m_renderSystem->GetMaxTextureSize())
+    {
+      CLog::Log(LOGDEBUG, "{}: New cache texture is too large ({} > {} pixels long)",
+                __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
+      // the texture can't grow any further - reuse the least recently used line instead
+      return EvictTextureLine();
+    }
+
+    CTexture* newTexture = ReallocTexture(newHeight);
+    if (newTexture == NULL)
+    {
+      CLog::Log(LOGDEBUG, "{}: Failed to allocate new texture of height {}", __FUNCTION__,
+                newHeight);
+      return false;
+    }
+    m_texture = newTexture;
+  }
+
+  m_posY = newLineY;
+  m_textureLines.push_back({m_drawCount, 0});
+  return true;
+}
+
+bool CGUIFontTTF::EvictTextureLine()
+{
+  // pick the line whose glyphs were used least recently, skipping any that hold
+  // glyphs of the text currently being laid out
+  int victim = -1;
+  for (unsigned int i = 0; i < m_textureLines.size(); i++)
+  {
+    if (m_textureLines[i].lastUsed == m_drawCount)
+      continue;
+    if (victim < 0 || m_textureLines[i].lastUsed < m_textureLines[victim].lastUsed)
+      victim = i;
+  }
+  if (victim < 0 || !m_texture)
+    return false;
+
+  // drop the characters stored on that line
+  int numChars = 0;
+  for (int i = 0; i < m_numChars; i++)
+  {
+    if (m_char[i].textureLine != victim)
+      m_char[numChars++] = m_char[i];
+  }
+  CLog::Log(LOGDEBUG, "{}: Evicting {} characters from texture line {}", __FUNCTION__,
+            m_numChars - numChars, victim);
+  m_numChars = numChars;
+  UpdateCharQuickLookup();
+
+  // drop the cached vertices that reference the evicted glyphs
+  m_staticCache.InvalidateTextureLine(victim);
+  m_dynamicCache.InvalidateTextureLine(victim);
+
+  const unsigned int lineHeight = GetTextureLineHeight();
+  m_posX = 0;
+  m_posY = victim * lineHeight;
+  ClearTextureRows(m_posY, std::min(m_posY + lineHeight, m_textureHeight));
+
+  m_textureLines[victim] = {m_drawCount, 0};
+  m_evictedLines++;
+  return true;
+}
+
+CGUIFontTTF::CharacterCacheStats CGUIFontTTF::GetCharacterCacheStats() const
+{
+  CharacterCacheStats stats;
+  stats.numChars = m_numChars;
+  stats.totalLines = m_textureLines.size();
+  stats.evictedLines = m_evictedLines;
+  for (const auto& line : m_textureLines)
+  {
+    if (line.numChars > 0)
+      stats.usedLines++;
+  }
+  return stats;
 }
 
 bool CGUIFontTTF::CacheCharacter(wchar_t letter, uint32_t style, Character* ch)
@@ -750,36 +896,14 @@ bool CGUIFontTTF::CacheCharacter(wchar_t letter, uint32_t style, Character* ch)
     // check we have enough room for the character.
     // cast-fest is here to avoid warnings due to freeetype version differences (signedness of width).
     if (static_cast<int>(m_posX + bitGlyph->left + bitmap.width) > static_cast<int>(m_textureWidth))
-    { // no space - gotta drop to the next line (which means creating a new texture and copying it across)
-      m_posX = 0;
-      m_posY += GetTextureLineHeight();
-      if (bitGlyph->left < 0)
-        m_posX += -bitGlyph->left;
-
-      if(m_posY + GetTextureLineHeight() >= m_textureHeight)
+    { // no space - gotta drop to the next line (which may mean creating a new texture and copying it across)
+      if (!NextTextureLine())
       {
-        // create the new larger texture
-        unsigned int newHeight = m_posY + GetTextureLineHeight();
-        // check for max height
-        if (newHeight > m_renderSystem->GetMaxTextureSize())
-        {
-          CLog::Log(LOGDEBUG, "{}: New cache texture is too large ({} > {} pixels long)",
-                    __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
-          return false;
-        }
-
-        CTexture* newTexture = NULL;
-        newTexture = ReallocTexture(newHeight);
-        if(newTexture == NULL)
-        {
-          FT_Done_Glyph(glyph);
-          CLog::Log(LOGDEBUG, "{}: Failed to allocate new texture of height {}", __FUNCTION__,
-                    newHeight);
-          return false;
-        }
-        m_texture = newTexture;
+        FT_Done_Glyph(glyph);
+        return false;
       }
+      if (bitGlyph->left < 0)
+        m_posX += -bitGlyph->left;
     }
 
     if(m_texture == NULL)
@@ -799,6 +923,7 @@ bool CGUIFontTTF::CacheCharacter(wchar_t letter, uint32_t style, Character* ch)
   ch->bottom = ch->top + bitmap.rows;
   ch->advance =
       static_cast<float>(MathUtils::round_int(static_cast<double>(m_face->glyph->advance.x) / 64));
+  ch->textureLine = isEmptyGlyph ? -1 : static_cast<int>(m_posY / GetTextureLineHeight());
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -811,8 +936,11 @@ bool CGUIFontTTF::CacheCharacter(wchar_t letter, uint32_t style, Character* ch)
     CopyCharToTexture(bitGlyph, x1, y1, x2, y2);
 
     m_posX += spacing_between_characters_in_texture + (unsigned short)std::max(ch->right - ch->left + ch->offsetX, ch->advance);
+
+    TextureLine& line = m_textureLines[ch->textureLine];
+    line.lastUsed = m_drawCount;
+    line.numChars++;
   }
-  m_numChars++;
 
   // free the glyph
   FT_Done_Glyph(glyph);
@@ -85,6 +85,16 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief occupancy of the glyph cache texture, reported in the debug overlay */
+  struct CharacterCacheStats
+  {
+    unsigned int numChars = 0; // glyphs currently cached
+    unsigned int usedLines = 0; // texture lines holding at least one glyph
+    unsigned int totalLines = 0; // texture lines allocated so far
+    unsigned int evictedLines = 0; // texture lines recycled since the font was loaded
+  };
+  CharacterCacheStats GetCharacterCacheStats() const;
+
 protected:
   explicit CGUIFontTTF(const std::string& strFileName);
 
@@ -94,6 +104,7 @@ protected:
     float left, top, right, bottom;
     float advance;
     character_t letterAndStyle;
+    int textureLine; // line of the texture holding the glyph, -1 if it has no pixels
   };
   void AddReference();
   void RemoveReference();
@@ -116,9 +127,18 @@ protected:
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
+  void UpdateCharQuickLookup();
+
+  /*! \brief move the write position to the start of a fresh texture line.
+   Grows the texture while it is below the maximum texture size, otherwise
+   recycles the least recently used line.
+   */
+  bool NextTextureLine();
+  bool EvictTextureLine();
 
   virtual CTexture* ReallocTexture(unsigned int& newHeight) = 0;
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
+  virtual void ClearTextureRows(unsigned int y1, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
 
   // modifying glyphs
@@ -138,6 +158,15 @@ protected:
   unsigned int GetTextureLineHeight() const;
   static const unsigned int spacing_between_characters_in_texture;
 
+  struct TextureLine
+  {
+    unsigned int lastUsed; // value of m_drawCount when a glyph on this line was last used
+    unsigned int numChars;
+  };
+  std::vector<TextureLine> m_textureLines;
+  unsigned int m_drawCount;          // bumped for each DrawTextInternal() call
+  unsigned int m_evictedLines;
+
   UTILS::Color m_color;
 
   Character *m_char;                 // our characters
@@ -47,6 +47,7 @@ public:
 protected:
   CTexture* ReallocTexture(unsigned int& newHeight) override;
   bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
+  void ClearTextureRows(unsigned int y1, unsigned int y2) override;
   void DeleteHardwareTexture() override;
 
 private:
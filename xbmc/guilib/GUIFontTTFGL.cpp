@@ -384,6 +384,24 @@ bool CGUIFontTTFGL::CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1,
     target += m_texture->GetPitch();
   }
 
+  MarkRowsUpdated(y1, y2);
+
+  return true;
+}
+
+void CGUIFontTTFGL::ClearTextureRows(unsigned int y1, unsigned int y2)
+{
+  if (!m_texture || y2 <= y1)
+    return;
+
+  memset(m_texture->GetPixels() + y1 * m_texture->GetPitch(), 0,
+         (y2 - y1) * m_texture->GetPitch());
+
+  MarkRowsUpdated(y1, y2);
+}
+
+void CGUIFontTTFGL::MarkRowsUpdated(unsigned int y1, unsigned int y2)
+{
   switch (m_textureStatus)
   {
   case TEXTURE_UPDATED:
@@ -411,8 +429,6 @@ bool CGUIFontTTFGL::CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1,
   default:
     break;
   }
-
-  return true;
 }
 
 void CGUIFontTTFGL::DeleteHardwareTexture()
@@ -32,11 +32,14 @@ public:
 protected:
   CTexture* ReallocTexture(unsigned int& newHeight) override;
   bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
+  void ClearTextureRows(unsigned int y1, unsigned int y2) override;
   void DeleteHardwareTexture() override;
 
   static GLuint m_elementArrayHandle;
 
 private:
+  void MarkRowsUpdated(unsigned int y1, unsigned int y2);
+
   unsigned int m_updateY1;
   unsigned int m_updateY2;
 
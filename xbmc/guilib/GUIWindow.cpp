@@ -33,6 +33,8 @@
 
 using namespace KODI::MESSAGING;
 
+std::atomic<unsigned int> CGUIWindow::m_lastPropertiesVersion{0};
+
 bool CGUIWindow::icompare::operator()(const std::string &s1, const std::string &s2) const
 {
   return StringUtils::CompareNoCase(s1, s2) < 0;
@@ -1026,6 +1028,7 @@ void CGUIWindow::SetProperty(const std::string &strKey, const CVariant &value)
 {
   CSingleLock lock(*this);
   m_mapProperties[strKey] = value;
+  m_propertiesVersion = ++m_lastPropertiesVersion;
 }
 
 CVariant CGUIWindow::GetProperty(const std::string &strKey) const
@@ -1042,6 +1045,7 @@ void CGUIWindow::ClearProperties()
 {
   CSingleLock lock(*this);
   m_mapProperties.clear();
+  m_propertiesVersion = ++m_lastPropertiesVersion;
 }
 
 void CGUIWindow::SetRunActionsManually()
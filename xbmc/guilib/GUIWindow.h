@@ -20,6 +20,7 @@
 
 class CFileItem; typedef std::shared_ptr<CFileItem> CFileItemPtr;
 
+#include <atomic>
 #include <limits.h>
 #include <map>
 #include <vector>
@@ -185,6 +186,13 @@ public:
    */
   void ClearProperties();
 
+  /*! \brief Get the version of the properties of this window
+   The version changes whenever a property is set or cleared. Versions are never reused, so a
+   window that is destroyed and created again doesn't repeat the version of its predecessor.
+   \sa SetProperty, ClearProperties
+   */
+  unsigned int GetPropertiesVersion() const { return m_propertiesVersion; }
+
 #ifdef _DEBUG
   void DumpTextureUse() override;
 #endif
@@ -285,6 +293,8 @@ protected:
 
 private:
   std::map<std::string, CVariant, icompare> m_mapProperties;
+  std::atomic<unsigned int> m_propertiesVersion{0};
+  static std::atomic<unsigned int> m_lastPropertiesVersion;
   std::map<INFO::InfoPtr, bool> m_xmlIncludeConditions; ///< \brief used to store conditions used to resolve includes for this window
 };
 
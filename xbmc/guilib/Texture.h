@@ -84,6 +84,7 @@ public:
   virtual void LoadToGPU() = 0;
   virtual void BindToUnit(unsigned int unit) = 0;
 
+  unsigned int GetFormat() const { return m_format; }
   unsigned char* GetPixels() const { return m_pixels; }
   unsigned int GetPitch() const { return GetPitch(m_textureWidth); }
   unsigned int GetRows() const { return GetRows(m_textureHeight); }
@@ -393,6 +393,26 @@ bool CGUIControlsGUIInfo::GetLabel(std::string& value, const CFileItem *item, in
   return false;
 }
 
+bool CGUIControlsGUIInfo::GetLabelVersion(unsigned int& version, int contextWindow, const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    case WINDOW_PROPERTY:
+    {
+      const CGUIWindow* window =
+          CServiceBroker::GetGUI()->GetWindowManager().GetWindow(info.GetData1());
+      if (window)
+      {
+        version = window->GetPropertiesVersion();
+        return true;
+      }
+      break;
+    }
+  }
+
+  return false;
+}
+
 bool CGUIControlsGUIInfo::GetInt(int& value, const CGUIListItem *gitem, int contextWindow, const CGUIInfo &info) const
 {
   switch (info.m_info)
@@ -33,6 +33,11 @@ public:
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
 
+  /*! \brief Get the version of a window property label
+   \sa CGUIInfoProviders::GetLabelVersion
+   */
+  bool GetLabelVersion(unsigned int& version, int contextWindow, const CGUIInfo &info) const;
+
   void SetNextWindow(int windowID) { m_nextWindowID = windowID; };
   void SetPreviousWindow(int windowID) { m_prevWindowID = windowID; };
 
@@ -49,12 +49,22 @@ const std::string &CGUIInfoLabel::GetLabel(int contextWindow, bool preferImage,
     {
       if (portion.m_info)
       {
+        // versioned infos only need fetching once they changed. The fallback is only filled
+        // when fetching, so always fetch if the caller wants it.
+        unsigned int version = 0;
+        const bool versioned = portion.m_versioned && !fallback &&
+                               infoMgr.GetLabelVersion(version, portion.m_info, contextWindow);
+        if (versioned && portion.IsCurrent(version, contextWindow, preferImage))
+          continue;
+
         std::string infoLabel;
         if (preferImage)
           infoLabel = infoMgr.GetImage(portion.m_info, contextWindow, fallback);
         if (infoLabel.empty())
           infoLabel = infoMgr.GetLabel(portion.m_info, contextWindow, fallback);
         needsUpdate |= portion.NeedsUpdate(infoLabel);
+        if (versioned)
+          portion.SetVersion(version, contextWindow, preferImage);
       }
     }
   }
@@ -267,7 +277,8 @@ void CGUIInfoLabel::Parse(const std::string &label, int context)
             prefix = params[1];
           if (params.size() > 2)
             postfix = params[2];
-          m_info.emplace_back(info, prefix, postfix, format == FORMATESCINFO || format == FORMATESCVAR);
+          m_info.emplace_back(info, prefix, postfix, format == FORMATESCINFO || format == FORMATESCVAR,
+                              info && infoMgr.IsLabelVersioned(info));
         }
         // and delete it from our work string
         work.erase(0, pos2 + 1);
@@ -285,7 +296,8 @@ void CGUIInfoLabel::Parse(const std::string &label, int context)
     m_info.emplace_back(0, work, "");
 }
 
-CGUIInfoLabel::CInfoPortion::CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped /*= false */):
+CGUIInfoLabel::CInfoPortion::CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped /*= false */, bool versioned /*= false */):
+  m_versioned(versioned),
   m_prefix(prefix),
   m_postfix(postfix)
 {
@@ -300,6 +312,8 @@ CGUIInfoLabel::CInfoPortion::CInfoPortion(int info, const std::string &prefix, c
 
 bool CGUIInfoLabel::CInfoPortion::NeedsUpdate(const std::string &label) const
 {
+  // the label may now come from a listitem or another context, so forget its version
+  m_hasVersion = false;
   if (m_label != label)
   {
     m_label = label;
@@ -308,6 +322,20 @@ bool CGUIInfoLabel::CInfoPortion::NeedsUpdate(const std::string &label) const
   return false;
 }
 
+bool CGUIInfoLabel::CInfoPortion::IsCurrent(unsigned int version, int contextWindow, bool preferImage) const
+{
+  return m_hasVersion && m_version == version && m_versionContext == contextWindow &&
+         m_versionPreferImage == preferImage;
+}
+
+void CGUIInfoLabel::CInfoPortion::SetVersion(unsigned int version, int contextWindow, bool preferImage) const
+{
+  m_hasVersion = true;
+  m_version = version;
+  m_versionContext = contextWindow;
+  m_versionPreferImage = preferImage;
+}
+
 std::string CGUIInfoLabel::CInfoPortion::Get() const
 {
   if (!m_info)
@@ -115,13 +115,28 @@ private:
   class CInfoPortion
   {
   public:
-    CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped = false);
+    CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped = false, bool versioned = false);
     bool NeedsUpdate(const std::string &label) const;
     std::string Get() const;
+
+    /*! \brief whether the label is still valid for the given info version
+     \sa SetVersion
+     */
+    bool IsCurrent(unsigned int version, int contextWindow, bool preferImage) const;
+    /*! \brief remember the info version the label was fetched for
+     \sa IsCurrent
+     */
+    void SetVersion(unsigned int version, int contextWindow, bool preferImage) const;
+
     int m_info;
+    bool m_versioned; ///< whether the info may be versioned, resolved once when parsing the label
   private:
     bool m_escaped;
     mutable std::string m_label;
+    mutable bool m_hasVersion = false;
+    mutable unsigned int m_version = 0;
+    mutable int m_versionContext = 0;
+    mutable bool m_versionPreferImage = false;
     std::string m_prefix;
     std::string m_postfix;
   };
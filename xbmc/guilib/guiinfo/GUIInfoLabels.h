@@ -306,6 +306,7 @@
 #define RETROPLAYER_VIDEO_FILTER      330
 #define RETROPLAYER_STRETCH_MODE      331
 #define RETROPLAYER_VIDEO_ROTATION    332
+#define RETROPLAYER_RUN_AHEAD         333
 
 #define CONTAINER_HAS_PARENT_ITEM    341
 #define CONTAINER_CAN_FILTER         342
@@ -709,6 +710,13 @@
 #define PLAYER_PROCESS_AUDIOCHANNELS (PLAYER_PROCESS + 9)
 #define PLAYER_PROCESS_AUDIOSAMPLERATE (PLAYER_PROCESS + 10)
 #define PLAYER_PROCESS_AUDIOBITSPERSAMPLE (PLAYER_PROCESS + 11)
+#define PLAYER_PROCESS_FRAMETIME (PLAYER_PROCESS + 12)
+#define PLAYER_PROCESS_FRAMETIMEP99 (PLAYER_PROCESS + 13)
+#define PLAYER_PROCESS_EMULATIONTIME (PLAYER_PROCESS + 14)
+#define PLAYER_PROCESS_AUDIODELAY (PLAYER_PROCESS + 15)
+#define PLAYER_PROCESS_DROPPEDFRAMES (PLAYER_PROCESS + 16)
+#define PLAYER_PROCESS_DUPLICATEDFRAMES (PLAYER_PROCESS + 17)
+#define PLAYER_PROCESS_VIDEOTHREADING (PLAYER_PROCESS + 18)
 
 #define WINDOW_PROPERTY             9993
 #define WINDOW_IS_VISIBLE           9995
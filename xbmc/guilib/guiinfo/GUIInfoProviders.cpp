@@ -8,6 +8,8 @@
 
 #include "guilib/guiinfo/GUIInfoProviders.h"
 
+#include "guilib/guiinfo/GUIInfo.h"
+#include "guilib/guiinfo/GUIInfoLabels.h"
 #include "guilib/guiinfo/IGUIInfoProvider.h"
 
 #include <algorithm>
@@ -93,6 +95,33 @@ bool CGUIInfoProviders::GetLabel(std::string& value, const CFileItem *item, int
   return false;
 }
 
+bool CGUIInfoProviders::IsLabelVersioned(const CGUIInfo &info)
+{
+  switch (info.m_info)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING:
+      return true;
+    case WINDOW_PROPERTY:
+      // properties of the active window depend on which window is active, so poll those
+      return info.GetData1() != 0;
+  }
+  return false;
+}
+
+bool CGUIInfoProviders::GetLabelVersion(unsigned int& version, int contextWindow, const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING:
+      return m_skinGUIInfo.GetLabelVersion(version, contextWindow, info);
+    case WINDOW_PROPERTY:
+      return m_guiControlsGUIInfo.GetLabelVersion(version, contextWindow, info);
+  }
+  return false;
+}
+
 bool CGUIInfoProviders::GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const
 {
   for (const auto& provider : m_providers)
@@ -77,6 +77,25 @@ public:
    */
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const;
 
+  /*!
+   * @brief Whether a GUIInfoManager label string may be versioned. Only skin settings and the
+   * properties of an explicit window are. Callers resolve this once per label.
+   * @param info The GUI info (label id + additional data).
+   * @return True if the label may be versioned, false if it always has to be polled.
+   */
+  static bool IsLabelVersioned(const CGUIInfo &info);
+
+  /*!
+   * @brief Get the version of a GUIInfoManager label string. The version changes whenever the
+   * value of the label may have changed, allowing callers to keep using the value they already
+   * have instead of polling it.
+   * @param version Will be filled with the version.
+   * @param contextWindow The context window. Can be 0.
+   * @param info The GUI info (label id + additional data).
+   * @return True if the label is versioned, false if it has to be polled.
+   */
+  bool GetLabelVersion(unsigned int& version, int contextWindow, const CGUIInfo &info) const;
+
   /*!
    * @brief Get a GUIInfoManager integer value from one of the registered providers.
    * @param value Will be filled with the requested value.
@@ -69,6 +69,12 @@ bool CGamesGUIInfo::GetLabel(std::string& value, const CFileItem *item, int cont
       value = std::to_string(rotationDegCCW);
       return true;
     }
+    case RETROPLAYER_RUN_AHEAD:
+    {
+      const unsigned int runAheadFrames = CMediaSettings::GetInstance().GetCurrentGameSettings().RunAheadFrames();
+      value = std::to_string(runAheadFrames);
+      return true;
+    }
     default:
       break;
   }
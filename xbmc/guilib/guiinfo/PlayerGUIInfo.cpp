@@ -313,6 +313,9 @@ bool CPlayerGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case PLAYER_PROCESS_VIDEODECODER:
       value = CServiceBroker::GetDataCacheCore().GetVideoDecoderName();
       return true;
+    case PLAYER_PROCESS_VIDEOTHREADING:
+      value = CServiceBroker::GetDataCacheCore().GetVideoDecoderThreading();
+      return true;
     case PLAYER_PROCESS_DEINTMETHOD:
       value = CServiceBroker::GetDataCacheCore().GetVideoDeintMethod();
       return true;
@@ -343,6 +346,24 @@ bool CPlayerGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case PLAYER_PROCESS_AUDIOBITSPERSAMPLE:
       value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetAudioBitsPerSample());
       return true;
+    case PLAYER_PROCESS_FRAMETIME:
+      value = StringUtils::Format("{:.2f}", CServiceBroker::GetDataCacheCore().GetFrameTime());
+      return true;
+    case PLAYER_PROCESS_FRAMETIMEP99:
+      value = StringUtils::Format("{:.2f}", CServiceBroker::GetDataCacheCore().GetFrameTimeP99());
+      return true;
+    case PLAYER_PROCESS_EMULATIONTIME:
+      value = StringUtils::Format("{:.2f}", CServiceBroker::GetDataCacheCore().GetEmulationTime());
+      return true;
+    case PLAYER_PROCESS_AUDIODELAY:
+      value = StringUtils::Format("{:.0f}", CServiceBroker::GetDataCacheCore().GetAudioDelay());
+      return true;
+    case PLAYER_PROCESS_DROPPEDFRAMES:
+      value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetDroppedFrames());
+      return true;
+    case PLAYER_PROCESS_DUPLICATEDFRAMES:
+      value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetDuplicatedFrames());
+      return true;
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // PLAYLIST_*
@@ -77,6 +77,19 @@ bool CSkinGUIInfo::GetLabel(std::string& value, const CFileItem *item, int conte
   return false;
 }
 
+bool CSkinGUIInfo::GetLabelVersion(unsigned int& version, int contextWindow, const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING:
+      version = ADDON::CSkinInfo::GetSettingsVersion();
+      return true;
+  }
+
+  return false;
+}
+
 bool CSkinGUIInfo::GetInt(int& value, const CGUIListItem *gitem, int contextWindow, const CGUIInfo &info) const
 {
   return false;
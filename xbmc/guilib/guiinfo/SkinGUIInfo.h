@@ -30,6 +30,11 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+
+  /*! \brief Get the version of a skin setting label
+   \sa CGUIInfoProviders::GetLabelVersion
+   */
+  bool GetLabelVersion(unsigned int& version, int contextWindow, const CGUIInfo &info) const;
 };
 
 } // namespace GUIINFO
@@ -22,6 +22,7 @@
 #include "pvr/channels/PVRChannel.h"
 #include "pvr/guilib/PVRGUIActions.h"
 #include "pvr/recordings/PVRRecording.h"
+#include "settings/GameSettings.h"
 #include "settings/MediaSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -383,6 +384,17 @@ static int PlayerControl(const std::vector<std::string>& params)
   {
     g_application.OnAction(CAction(ACTION_PLAYER_RESET));
   }
+  else if (paramlow == "runahead")
+  {
+    CGameSettings& currentSettings = CMediaSettings::GetInstance().GetCurrentGameSettings();
+
+    const unsigned int runAheadFrames =
+        (currentSettings.RunAheadFrames() + 1) % (CGameSettings::MAX_RUN_AHEAD_FRAMES + 1);
+
+    // The player remembers the choice for the game that is playing
+    currentSettings.SetRunAheadFrames(runAheadFrames);
+    currentSettings.NotifyObservers(ObservableMessageSettingsChanged);
+  }
 
   return 0;
 }
@@ -596,6 +608,7 @@ static int Seek(const std::vector<std::string>& params)
 ///     | Partymode(path to .xsp) | Partymode for *.xsp-file               | Partymode for *.xsp-file    |             |
 ///     | ShowVideoMenu           | Shows the DVD/BR menu if available     | none                        |             |
 ///     | FrameAdvance(n) ***     | Advance video by _n_ frames            | none                        | Kodi v18    |
+///     | RunAhead                | Cycles the frames games run ahead      | none                        | Kodi v20    |
 ///     <br>
 ///     '*' = For these controls\, the PlayerControl built-in function can make use of the 'notify'-parameter. For example: PlayerControl(random\, notify)
 ///     <br>
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -35,14 +36,29 @@ public:
   {
     if (item && m_listItemDependent)
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+    else if (!IsFresh())
     {
+      const bool value = m_value;
       Update(NULL);
+      if (m_value != value)
+        m_valueVersion++;
       m_refreshCounter = m_parentRefreshCounter;
     }
     return m_value;
   }
 
+  /*! \brief Whether the cached value is up to date, i.e. Get() without a listitem won't update it
+   */
+  bool IsFresh() const
+  {
+    return m_refreshCounter == m_parentRefreshCounter && m_refreshCounter != 0;
+  }
+
+  /*! \brief Get the number of times the cached value has changed
+   Expressions use this to track whether any of the bools they depend on changed.
+   */
+  unsigned int GetValueVersion() const { return m_valueVersion; }
+
   bool operator==(const InfoBool &right) const
   {
     return (m_context == right.m_context &&
@@ -76,6 +92,7 @@ protected:
 private:
   unsigned int m_refreshCounter;
   unsigned int &m_parentRefreshCounter;
+  std::atomic<unsigned int> m_valueVersion{0}; ///< read by the expressions of other threads
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
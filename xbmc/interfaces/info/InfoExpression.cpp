@@ -11,8 +11,11 @@
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIControlProfiler.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <iterator>
 #include <list>
 #include <memory>
 #include <stack>
@@ -26,7 +29,9 @@ void InfoSingle::Initialize()
 
 void InfoSingle::Update(const CGUIListItem *item)
 {
+  GUIPROFILER_CONDITION_BEGIN();
   m_value = CServiceBroker::GetGUI()->GetInfoManager().GetBool(m_condition, m_context, item);
+  GUIPROFILER_CONDITION_END();
 }
 
 void InfoExpression::Initialize()
@@ -34,23 +39,82 @@ void InfoExpression::Initialize()
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression {}", m_expression);
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_expression_tree = std::make_shared<InfoLeaf>(RegisterOperand("false"), false);
   }
+  Compile(m_expression_tree);
+  // the tree is only needed to build the program
+  m_expression_tree.reset();
+}
+
+InfoPtr InfoExpression::RegisterOperand(const std::string &operand)
+{
+  return CServiceBroker::GetGUI()->GetInfoManager().Register(operand, m_context);
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  CSingleLock lock(m_dependenciesSection);
+
+  // listitem dependent expressions give a different value for each item, so always evaluate those
+  if (!m_listItemDependent && !DependenciesChanged())
+    return;
+
+  GUIPROFILER_CONDITION_BEGIN();
+  m_dependencies.clear();
+  bool value = false;
+  const unsigned int size = m_program.size();
+  for (unsigned int i = 0; i < size;)
+  {
+    const Instruction &instruction = m_program[i];
+    if (instruction.m_info)
+    {
+      value = instruction.m_invert ^ instruction.m_info->Get(item);
+      if (!m_listItemDependent)
+        m_dependencies.emplace_back(instruction.m_info, instruction.m_info->GetValueVersion());
+    }
+    if ((instruction.m_jump == JUMP_IF_TRUE && value) ||
+        (instruction.m_jump == JUMP_IF_FALSE && !value))
+      i = instruction.m_target;
+    else
+      i++;
+  }
+  m_value = value;
+  GUIPROFILER_CONDITION_END();
+}
+
+bool InfoExpression::DependenciesChanged() const
+{
+  /* The value only depends on the bools read during the last evaluation, as the
+   * others were skipped by short-circuiting. If those have already been updated
+   * and all kept their value, so has the expression. Bools that aren't up to date
+   * yet are simply updated by running the program again.
+   */
+  if (m_dependencies.empty())
+    return true;
+
+  for (const auto& dependency : m_dependencies)
+  {
+    if (!dependency.first->IsFresh() || dependency.first->GetValueVersion() != dependency.second)
+      return true;
+  }
+  return false;
+}
+
+void InfoExpression::Compile(const InfoSubexpressionPtr &tree)
+{
+  m_program.clear();
+  m_infos.clear();
+  m_dependencies.clear();
+  tree->Compile(m_program, m_infos);
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
- * formation of groups of associative nodes. These groups are then reordered at
- * evaluation time such that nodes whose value renders the evaluation of the
- * remainder of the group unnecessary tend to be evaluated first (these are
- * true nodes for OR subexpressions, or false nodes for AND subexpressions).
- * The end effect is to minimise the number of leaf nodes that need to be
- * evaluated in order to determine the value of the expression. The runtime
- * adaptability has the advantage of not being customised for any particular skin.
+ * formation of groups of associative nodes. Each group is then compiled into
+ * the evaluations of its children, where every child but the last jumps to the
+ * end of the group as soon as its value decides the value of the group (true
+ * for OR subexpressions, false for AND subexpressions). The end effect is to
+ * minimise the number of leaf nodes that need to be evaluated in order to
+ * determine the value of the expression, without walking the tree.
  *
  * The modifications to the expression at parse time fall into two groups:
  * 1) Moving logical NOTs so that they are only applied to leaf nodes.
@@ -61,9 +125,11 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+unsigned int InfoExpression::InfoLeaf::Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &infos) const
 {
-  return m_invert ^ m_info->Get(item);
+  infos.push_back(m_info);
+  program.push_back({m_info.get(), m_invert, JUMP_NONE, 0});
+  return program.size() - 1;
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -86,27 +152,25 @@ void InfoExpression::InfoAssociativeGroup::Merge(const std::shared_ptr<InfoAssoc
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+unsigned int InfoExpression::InfoAssociativeGroup::Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &infos) const
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
-   */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  std::vector<unsigned int> exits;
+  for (auto it = m_children.begin(); it != m_children.end(); ++it)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
-    {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
-    }
+    const unsigned int last = (*it)->Compile(program, infos);
+    // the last child doesn't need to jump, its value is the value of the group
+    if (std::next(it) != m_children.end())
+      exits.push_back(last);
+  }
+
+  const unsigned int end = program.size();
+  program.push_back({nullptr, false, JUMP_NONE, 0});
+  for (unsigned int exit : exits)
+  {
+    program[exit].m_jump = m_type == NODE_AND ? JUMP_IF_FALSE : JUMP_IF_TRUE;
+    program[exit].m_target = end;
   }
-  return use_and ^ result;
+  return end;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -208,8 +272,6 @@ bool InfoExpression::Parse(const std::string &expression)
   bool after_binaryoperator = true;
   int bracket_count = 0;
 
-  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
-
   char c;
   // Skip leading whitespace - don't want it to count as an operand if that's all there is
   while (isspace((unsigned char)(c=*s)))
@@ -236,7 +298,7 @@ bool InfoExpression::Parse(const std::string &expression)
       }
       if (!operand.empty())
       {
-        InfoPtr info = infoMgr.Register(operand, m_context);
+        InfoPtr info = RegisterOperand(operand);
         if (!info)
         {
           CLog::Log(LOGERROR, "Bad operand '{}'", operand);
@@ -287,7 +349,7 @@ bool InfoExpression::Parse(const std::string &expression)
   }
   if (!operand.empty())
   {
-    InfoPtr info = infoMgr.Register(operand, m_context);
+    InfoPtr info = RegisterOperand(operand);
     if (!info)
     {
       CLog::Log(LOGERROR, "Bad operand '{}'", operand);
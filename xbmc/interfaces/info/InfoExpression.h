@@ -9,6 +9,7 @@
 #pragma once
 
 #include "InfoBool.h"
+#include "threads/CriticalSection.h"
 
 #include <list>
 #include <stack>
@@ -34,6 +35,9 @@ private:
 };
 
 /*! \brief Class to wrap active boolean expressions
+ The expression is parsed into a tree and then compiled into a flat program of
+ leaf evaluations and short-circuit jumps. The bools read by the last evaluation
+ are tracked, so the program only runs again once one of them changed value.
  */
 class InfoExpression : public InfoBool
 {
@@ -45,6 +49,14 @@ public:
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+
+protected:
+  /*! \brief Get the bool for an operand of the expression
+   \param operand the condition to register
+   \return the bool, or an empty pointer if the operand is invalid
+   */
+  virtual InfoPtr RegisterOperand(const std::string &operand);
+
 private:
   typedef enum
   {
@@ -63,12 +75,33 @@ private:
     NODE_OR,
   } node_type_t;
 
+  typedef enum
+  {
+    JUMP_NONE,
+    JUMP_IF_TRUE,
+    JUMP_IF_FALSE,
+  } jump_type_t;
+
+  // A single step of the compiled expression
+  struct Instruction
+  {
+    InfoBool *m_info;       ///< bool to evaluate, or nullptr to keep the current value (end of a group)
+    bool m_invert;          ///< whether to invert the value of m_info
+    jump_type_t m_jump;     ///< condition on the resulting value to jump to m_target
+    unsigned int m_target;  ///< instruction to continue at when jumping
+  };
+
   // An abstract base class for nodes in the expression tree
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
+    /*! \brief Append the instructions evaluating this node to the program
+     \param program the program to append to
+     \param infos [out] the bools referenced by the program
+     \return index of the last instruction, whose value is the value of this node
+     */
+    virtual unsigned int Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &infos) const = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -79,7 +112,7 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(std::move(info)), m_invert(invert){};
-    bool Evaluate(const CGUIListItem *item) override;
+    unsigned int Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &infos) const override;
     node_type_t Type() const override { return NODE_LEAF; };
   private:
     InfoPtr m_info;
@@ -93,7 +126,7 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(const std::shared_ptr<InfoAssociativeGroup>& other);
-    bool Evaluate(const CGUIListItem *item) override;
+    unsigned int Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &infos) const override;
     node_type_t Type() const override { return m_type; };
   private:
     node_type_t m_type;
@@ -103,7 +136,14 @@ private:
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
+  void Compile(const InfoSubexpressionPtr &tree);
+  bool DependenciesChanged() const;
+
   InfoSubexpressionPtr m_expression_tree;
+  std::vector<Instruction> m_program;
+  std::vector<InfoPtr> m_infos;  ///< keeps the bools referenced by m_program alive
+  std::vector<std::pair<const InfoBool*, unsigned int>> m_dependencies; ///< bools read by the last evaluation and their value version
+  CCriticalSection m_dependenciesSection; ///< evaluations may run on threads other than the GUI thread
 };
 
 };
@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIListItem.h"
+#include "interfaces/info/InfoExpression.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace INFO;
+
+namespace
+{
+
+// A condition whose value is set by the test
+class CTestBool : public InfoBool
+{
+public:
+  CTestBool(const std::string& expression, unsigned int& refreshCounter, bool listItemDependent)
+    : InfoBool(expression, 0, refreshCounter)
+  {
+    m_listItemDependent = listItemDependent;
+  }
+
+  void Update(const CGUIListItem* item) override
+  {
+    updates++;
+    m_value = value;
+  }
+
+  // Change the cached value without the bool noticing, to tell whether an expression reads it
+  void SetCachedValue(bool cachedValue) { m_value = cachedValue; }
+
+  bool value = false;
+  int updates = 0;
+};
+
+// An expression whose operands are test bools, registered on first use
+class CTestExpression : public InfoExpression
+{
+public:
+  CTestExpression(const std::string& expression, unsigned int& refreshCounter)
+    : InfoExpression(expression, 0, refreshCounter), m_refreshCounter(refreshCounter)
+  {
+  }
+
+  CTestBool& Operand(const std::string& operand)
+  {
+    auto& info = m_operands[operand];
+    if (!info)
+      info = std::make_shared<CTestBool>(operand, m_refreshCounter,
+                                         operand.compare(0, 8, "listitem") == 0);
+    return *info;
+  }
+
+protected:
+  InfoPtr RegisterOperand(const std::string& operand) override
+  {
+    if (operand == "bad")
+      return InfoPtr();
+    Operand(operand);
+    return m_operands[operand];
+  }
+
+private:
+  unsigned int& m_refreshCounter;
+  std::map<std::string, std::shared_ptr<CTestBool>> m_operands;
+};
+
+} // namespace
+
+class TestInfoExpression : public ::testing::Test
+{
+protected:
+  std::unique_ptr<CTestExpression> Parse(const std::string& expression)
+  {
+    auto info = std::make_unique<CTestExpression>(expression, refreshCounter);
+    info->Initialize();
+    return info;
+  }
+
+  void NextFrame() { refreshCounter++; }
+
+  unsigned int refreshCounter = 1;
+};
+
+TEST_F(TestInfoExpression, Evaluate)
+{
+  struct
+  {
+    std::string expression;
+    bool (*expected)(bool a, bool b, bool c);
+  } cases[] = {
+      {"a+b", [](bool a, bool b, bool c) { return a && b; }},
+      {"a|b", [](bool a, bool b, bool c) { return a || b; }},
+      {"!a", [](bool a, bool b, bool c) { return !a; }},
+      {"a+b|c", [](bool a, bool b, bool c) { return (a && b) || c; }},
+      {"a+[b|c]", [](bool a, bool b, bool c) { return a && (b || c); }},
+      {"![a+b]|c", [](bool a, bool b, bool c) { return !(a && b) || c; }},
+      {"[a|b]+!c", [](bool a, bool b, bool c) { return (a || b) && !c; }},
+      {"![a|!b]+c", [](bool a, bool b, bool c) { return !(a || !b) && c; }},
+      {"[a+b]|[b+c]|[a+c]",
+       [](bool a, bool b, bool c) { return (a && b) || (b && c) || (a && c); }},
+  };
+
+  for (const auto& test : cases)
+  {
+    auto info = Parse(test.expression);
+    for (int values = 0; values < 8; values++)
+    {
+      const bool a = values & 1;
+      const bool b = values & 2;
+      const bool c = values & 4;
+      info->Operand("a").value = a;
+      info->Operand("b").value = b;
+      info->Operand("c").value = c;
+      NextFrame();
+      EXPECT_EQ(test.expected(a, b, c), info->Get())
+          << test.expression << " with a=" << a << " b=" << b << " c=" << c;
+    }
+  }
+}
+
+TEST_F(TestInfoExpression, ShortCircuits)
+{
+  auto orInfo = Parse("a|b");
+  orInfo->Operand("a").value = true;
+  EXPECT_TRUE(orInfo->Get());
+  EXPECT_EQ(0, orInfo->Operand("b").updates);
+
+  auto andInfo = Parse("a+b");
+  andInfo->Operand("a").value = false;
+  EXPECT_FALSE(andInfo->Get());
+  EXPECT_EQ(0, andInfo->Operand("b").updates);
+}
+
+TEST_F(TestInfoExpression, SkipsUnchangedDependencies)
+{
+  auto info = Parse("a+b");
+  CTestBool& a = info->Operand("a");
+  CTestBool& b = info->Operand("b");
+  a.value = true;
+  b.value = true;
+  EXPECT_TRUE(info->Get());
+
+  // both operands were already updated this frame and kept their value
+  NextFrame();
+  a.Get();
+  b.Get();
+  a.SetCachedValue(false);
+  EXPECT_TRUE(info->Get());
+
+  // an operand that isn't up to date yet makes the expression run
+  NextFrame();
+  a.value = false;
+  EXPECT_FALSE(info->Get());
+}
+
+TEST_F(TestInfoExpression, ReevaluatesChangedDependencies)
+{
+  auto info = Parse("a+b");
+  CTestBool& a = info->Operand("a");
+  a.value = true;
+  info->Operand("b").value = true;
+  EXPECT_TRUE(info->Get());
+
+  NextFrame();
+  a.value = false;
+  a.Get();
+  EXPECT_FALSE(info->Get());
+}
+
+TEST_F(TestInfoExpression, TracksOperandsOfLastEvaluation)
+{
+  auto info = Parse("a+b");
+  CTestBool& a = info->Operand("a");
+  CTestBool& b = info->Operand("b");
+  b.value = true;
+  EXPECT_FALSE(info->Get());
+  EXPECT_EQ(0, b.updates);
+
+  // b wasn't read, but has to be once a changed
+  NextFrame();
+  a.value = true;
+  a.Get();
+  EXPECT_TRUE(info->Get());
+  EXPECT_EQ(1, b.updates);
+}
+
+TEST_F(TestInfoExpression, InvalidExpressionIsFalse)
+{
+  for (const char* expression : {"a+", "[a|b", "a]", "a+bad"})
+  {
+    auto info = Parse(expression);
+    info->Operand("a").value = true;
+    info->Operand("b").value = true;
+    EXPECT_FALSE(info->Get()) << expression;
+  }
+}
+
+TEST_F(TestInfoExpression, ListItemDependentAlwaysEvaluates)
+{
+  auto info = Parse("listitem.a+b");
+  EXPECT_TRUE(info->ListItemDependent());
+
+  CGUIListItem item;
+  CTestBool& listItem = info->Operand("listitem.a");
+  listItem.value = true;
+  info->Operand("b").value = true;
+  EXPECT_TRUE(info->Get(&item));
+
+  // no new frame, the value is different for each item
+  listItem.value = false;
+  EXPECT_FALSE(info->Get(&item));
+}
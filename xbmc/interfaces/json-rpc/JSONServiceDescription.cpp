@@ -243,7 +243,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.StartPlaybackTrace",                      CXBMCOperations::StartPlaybackTrace },
+  { "XBMC.StopPlaybackTrace",                       CXBMCOperations::StopPlaybackTrace }
 };
 
 JSONSchemaTypeDefinition::JSONSchemaTypeDefinition()
@@ -9,8 +9,10 @@
 #include "XBMCOperations.h"
 
 #include "ServiceBroker.h"
+#include "XBDateTime.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "utils/PlaybackTracer.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -85,3 +87,25 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::StartPlaybackTrace(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CPlaybackTracer::Start();
+  return ACK;
+}
+
+JSONRPC_STATUS CXBMCOperations::StopPlaybackTrace(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CPlaybackTracer::Stop();
+
+  const std::string file = "special://temp/playbacktrace-" +
+                           CDateTime::GetCurrentDateTime().GetAsSaveString() + ".json";
+
+  unsigned int events;
+  if (!CPlaybackTracer::Dump(file, events))
+    return InternalError;
+
+  result["file"] = file;
+  result["events"] = events;
+  return OK;
+}
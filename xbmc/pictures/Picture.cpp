@@ -18,6 +18,7 @@
 #include "filesystem/File.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
+#include "guilib/DDSImage.h"
 #include "guilib/Texture.h"
 #include "guilib/imagefactory.h"
 
@@ -56,6 +57,12 @@ bool CPicture::CreateThumbnailFromSurface(const unsigned char *buffer, int width
 {
   CLog::Log(LOGDEBUG, "cached image '{}' size {}x{}", CURL::GetRedacted(thumbFile), width, height);
 
+  if (URIUtils::HasExtension(thumbFile, ".dds"))
+  { // uncompressed, ready to be uploaded as is
+    CDDSImage dds;
+    return dds.Create(thumbFile, width, height, stride, buffer);
+  }
+
   unsigned char *thumb = NULL;
   unsigned int thumbsize=0;
   IImage* pImage = ImageFactory::CreateLoader(thumbFile);
@@ -192,15 +199,18 @@ bool CPicture::CacheTexture(CTexture* texture,
                             uint32_t& dest_height,
                             const std::string& dest,
                             CPictureScalingAlgorithm::Algorithm
-                                scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
+                                scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */,
+                            const std::string& ddsDest /* = "" */)
 {
   return CacheTexture(texture->GetPixels(), texture->GetWidth(), texture->GetHeight(), texture->GetPitch(),
-                      texture->GetOrientation(), dest_width, dest_height, dest, scalingAlgorithm);
+                      texture->GetOrientation(), dest_width, dest_height, dest, scalingAlgorithm,
+                      ddsDest);
 }
 
 bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, uint32_t pitch, int orientation,
   uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
-  CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */,
+  const std::string &ddsDest /* = "" */)
 {
   const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
 
@@ -246,6 +256,8 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
         if (!orientation || OrientateImage(buffer, dest_width, dest_height, orientation))
         {
           success = CreateThumbnailFromSurface((unsigned char*)buffer, dest_width, dest_height, dest_width * 4, dest);
+          if (success && !ddsDest.empty())
+            success = CreateThumbnailFromSurface((unsigned char*)buffer, dest_width, dest_height, dest_width * 4, ddsDest);
         }
       }
       delete[] buffer;
@@ -256,7 +268,9 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
   { // no orientation needed
     dest_width = width;
     dest_height = height;
-    return CreateThumbnailFromSurface(pixels, width, height, pitch, dest);
+    if (!CreateThumbnailFromSurface(pixels, width, height, pitch, dest))
+      return false;
+    return ddsDest.empty() || CreateThumbnailFromSurface(pixels, width, height, pitch, ddsDest);
   }
   return false;
 }
@@ -45,6 +45,7 @@ public:
    \param dest_width [in/out] maximum width in pixels of cached version - replaced with actual cached width
    \param dest_height [in/out] maximum height in pixels of cached version - replaced with actual cached height
    \param dest the output cache file
+   \param ddsDest if not empty, also save the cached version as an uncompressed .dds to this file
    \return true if successful, false otherwise
    */
   static bool CacheTexture(
@@ -52,10 +53,12 @@ public:
       uint32_t& dest_width,
       uint32_t& dest_height,
       const std::string& dest,
-      CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
+      CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm,
+      const std::string& ddsDest = "");
   static bool CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, uint32_t pitch, int orientation,
     uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
-    CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
+    CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm,
+    const std::string &ddsDest = "");
 
 private:
   static void GetScale(unsigned int width, unsigned int height, unsigned int &out_width, unsigned int &out_height);
@@ -131,6 +131,7 @@ void CPVRClient::ResetProperties(int iClientId /* = PVR_INVALID_CLIENT_ID */)
 
   m_struct.toKodi->kodiInstance = this;
   m_struct.toKodi->TransferEpgEntry = cb_transfer_epg_entry;
+  m_struct.toKodi->TransferEpgEntryChange = cb_transfer_epg_entry_change;
   m_struct.toKodi->TransferChannelEntry = cb_transfer_channel_entry;
   m_struct.toKodi->TransferTimerEntry = cb_transfer_timer_entry;
   m_struct.toKodi->TransferRecordingEntry = cb_transfer_recording_entry;
@@ -692,6 +693,58 @@ PVR_ERROR CPVRClient::GetEPGForChannel(int iChannelUid, CPVREpg* epg, time_t sta
       m_clientCapabilities.SupportsEPG());
 }
 
+PVR_ERROR CPVRClient::GetEPGChangesForChannel(int iChannelUid,
+                                              CPVREpg* epg,
+                                              time_t start,
+                                              time_t end,
+                                              const std::string& strSinceToken,
+                                              std::string& strNewToken)
+{
+  // a token that is not valid anymore is expected, e.g. after the backend was restarted, and
+  // must not be logged as an error of the add-on
+  bool bTokenRejected = false;
+
+  const PVR_ERROR error = DoAddonCall(
+      __func__,
+      [this, iChannelUid, epg, start, end, &strSinceToken, &strNewToken,
+       &bTokenRejected](const AddonInstance* addon)
+      {
+        ADDON_HANDLE_STRUCT handle = {};
+        handle.callerAddress = this;
+        handle.dataAddress = epg;
+
+        int iPVRTimeCorrection =
+            CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection;
+
+        char strToken[EPG_SYNC_TOKEN_STRING_LENGTH] = {};
+        const PVR_ERROR error = addon->toAddon->GetEPGChangesForChannel(
+            addon, &handle, iChannelUid, start ? start - iPVRTimeCorrection : 0,
+            end ? end - iPVRTimeCorrection : 0, strSinceToken.c_str(), strToken,
+            sizeof(strToken));
+        if (error == PVR_ERROR_NO_ERROR)
+          strNewToken = strToken;
+
+        if (error == PVR_ERROR_INVALID_PARAMETERS && !strSinceToken.empty())
+        {
+          bTokenRejected = true;
+          return PVR_ERROR_NO_ERROR;
+        }
+
+        return error;
+      },
+      // add-ons built against older API versions do not provide this function
+      m_clientCapabilities.SupportsEPG() && m_struct.toAddon->GetEPGChangesForChannel);
+
+  if (bTokenRejected)
+  {
+    CLog::LogFC(LOGDEBUG, LOGEPG, "Add-on '{}' rejected the EPG sync token of channel {}",
+                GetFriendlyName(), iChannelUid);
+    return PVR_ERROR_INVALID_PARAMETERS;
+  }
+
+  return error;
+}
+
 PVR_ERROR CPVRClient::SetEPGMaxPastDays(int iPastDays)
 {
   return DoAddonCall(
@@ -1761,6 +1814,27 @@ void CPVRClient::cb_transfer_epg_entry(void* kodiInstance,
   });
 }
 
+void CPVRClient::cb_transfer_epg_entry_change(void* kodiInstance,
+                                              const ADDON_HANDLE handle,
+                                              const EPG_TAG* epgentry,
+                                              EPG_EVENT_STATE newState)
+{
+  HandleAddonCallback(__func__, kodiInstance, [&](CPVRClient* client) {
+    if (!handle || !epgentry)
+    {
+      CLog::LogF(LOGERROR, "Invalid callback parameter(s)");
+      return;
+    }
+
+    // transfer this change to the epg
+    CPVREpg* epg = static_cast<CPVREpg*>(handle->dataAddress);
+    if (newState == EPG_EVENT_DELETED)
+      epg->DeleteEntry(epgentry, client->GetID());
+    else
+      epg->UpdateEntry(epgentry, client->GetID());
+  });
+}
+
 void CPVRClient::cb_transfer_channel_entry(void* kodiInstance,
                                            const ADDON_HANDLE handle,
                                            const PVR_CHANNEL* channel)
@@ -479,6 +479,25 @@ public:
    */
   PVR_ERROR GetEPGForChannel(int iChannelUid, CPVREpg* epg, time_t start, time_t end);
 
+  /*!
+   * @brief Request the changes of an EPG table for a channel since a previous request.
+   * @param iChannelUid The UID of the channel to get the EPG changes for.
+   * @param epg The table to write the data to.
+   * @param start The start time to use.
+   * @param end The end time to use.
+   * @param strSinceToken The token returned by the previous request or empty to get all events.
+   * @param strNewToken The token identifying the state of the table after this request.
+   * @return PVR_ERROR_NO_ERROR if the changes have been fetched successfully,
+   * PVR_ERROR_NOT_IMPLEMENTED if the client does not support incremental EPG updates,
+   * PVR_ERROR_INVALID_PARAMETERS if the client rejected the token.
+   */
+  PVR_ERROR GetEPGChangesForChannel(int iChannelUid,
+                                    CPVREpg* epg,
+                                    time_t start,
+                                    time_t end,
+                                    const std::string& strSinceToken,
+                                    std::string& strNewToken);
+
   /*!
    * @brief Tell the client the past time frame to use when notifying epg events back
    * to Kodi.
@@ -1128,6 +1147,18 @@ private:
                                     const ADDON_HANDLE handle,
                                     const EPG_TAG* entry);
 
+  /*!
+   * @brief Transfer a changed EPG tag from the add-on to Kodi
+   * @param kodiInstance Pointer to Kodi's CPVRClient class
+   * @param handle The handle parameter that Kodi used when requesting the EPG changes
+   * @param entry The entry to transfer to Kodi
+   * @param newState The new state of the entry
+   */
+  static void cb_transfer_epg_entry_change(void* kodiInstance,
+                                           const ADDON_HANDLE handle,
+                                           const EPG_TAG* entry,
+                                           EPG_EVENT_STATE newState);
+
   /*!
    * @brief Transfer a channel entry from the add-on to Kodi
    * @param kodiInstance Pointer to Kodi's CPVRClient class
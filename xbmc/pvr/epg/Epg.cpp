@@ -68,6 +68,9 @@ void CPVREpg::Clear()
 {
   CSingleLock lock(m_critSection);
   m_tags.Clear();
+
+  // next update must fetch all events
+  m_syncState.Reset();
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -171,6 +174,9 @@ bool CPVREpg::UpdateEntries(const CPVREpg& epg)
   /* copy over tags */
   m_tags.UpdateEntries(epg.m_tags);
 
+  /* take over the state of the sync the tags were fetched with */
+  m_syncState = epg.m_syncState;
+
   /* update the last scan time of this table */
   m_lastScanTime = CDateTime::GetUTCDateTime();
   m_bUpdateLastScanTime = true;
@@ -205,6 +211,17 @@ bool CPVREpg::UpdateEntry(const EPG_TAG* data, int iClientId)
   return !IsTagExpired(tag) && m_tags.UpdateEntry(tag);
 }
 
+bool CPVREpg::DeleteEntry(const EPG_TAG* data, int iClientId)
+{
+  if (!data)
+    return false;
+
+  const std::shared_ptr<CPVREpgInfoTag> tag =
+      std::make_shared<CPVREpgInfoTag>(*data, iClientId, m_channelData, m_iEpgID);
+
+  return m_tags.DeleteEntry(tag);
+}
+
 bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_STATE newState)
 {
   bool bRet = true;
@@ -263,6 +280,7 @@ bool CPVREpg::Update(time_t start,
     if (!m_lastScanTime.IsValid())
     {
       database->GetLastEpgScanTime(m_iEpgID, &m_lastScanTime);
+      database->GetEpgSyncState(m_iEpgID, m_syncState);
 
       if (!m_lastScanTime.IsValid())
       {
@@ -297,6 +315,7 @@ bool CPVREpg::Update(time_t start,
     {
       tmpEpg = std::make_shared<CPVREpg>(m_iEpgID, m_strName, m_strScraperName, m_channelData,
                                          std::shared_ptr<CPVREpgDatabase>());
+      tmpEpg->m_syncState = m_syncState;
     }
   }
 
@@ -348,7 +367,7 @@ bool CPVREpg::QueuePersistQuery(const std::shared_ptr<CPVREpgDatabase>& database
     m_tags.QueuePersistQuery();
 
   if (m_bUpdateLastScanTime)
-    database->QueuePersistLastEpgScanTimeQuery(m_iEpgID, m_lastScanTime);
+    database->QueuePersistLastEpgScanTimeQuery(m_iEpgID, m_lastScanTime, m_syncState);
 
   m_bChanged = false;
   m_bUpdateLastScanTime = false;
@@ -392,6 +411,39 @@ CDateTime CPVREpg::GetLastDate() const
   return m_tags.GetLastEndTime();
 }
 
+namespace
+{
+
+class CEpgClientSyncSource : public IPVREpgSyncSource
+{
+public:
+  CEpgClientSyncSource(CPVRClient& client, int iChannelUid, CPVREpg* epg)
+    : m_client(client), m_iChannelUid(iChannelUid), m_epg(epg)
+  {
+  }
+
+  PVR_ERROR GetEPG(time_t start, time_t end) override
+  {
+    return m_client.GetEPGForChannel(m_iChannelUid, m_epg, start, end);
+  }
+
+  PVR_ERROR GetEPGChanges(time_t start,
+                          time_t end,
+                          const std::string& strSinceToken,
+                          std::string& strNewToken) override
+  {
+    return m_client.GetEPGChangesForChannel(m_iChannelUid, m_epg, start, end, strSinceToken,
+                                            strNewToken);
+  }
+
+private:
+  CPVRClient& m_client;
+  const int m_iChannelUid;
+  CPVREpg* m_epg;
+};
+
+} // unnamed namespace
+
 bool CPVREpg::UpdateFromScraper(time_t start, time_t end, bool bForceUpdate)
 {
   if (m_strScraperName.empty())
@@ -426,7 +478,8 @@ bool CPVREpg::UpdateFromScraper(time_t start, time_t end, bool bForceUpdate)
       {
         CLog::LogFC(LOGDEBUG, LOGEPG, "Updating EPG for channel '{}' from client '{}'",
                     m_channelData->ChannelName(), m_channelData->ClientId());
-        return (client->GetEPGForChannel(m_channelData->UniqueClientChannelId(), this, start, end) == PVR_ERROR_NO_ERROR);
+        CEpgClientSyncSource source(*client, m_channelData->UniqueClientChannelId(), this);
+        return (CPVREpgSync::Update(source, start, end, m_syncState) == PVR_ERROR_NO_ERROR);
       }
     }
     else
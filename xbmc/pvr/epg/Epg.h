@@ -10,6 +10,7 @@
 
 #include "XBDateTime.h"
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "pvr/epg/EpgSync.h"
 #include "pvr/epg/EpgTagsContainer.h"
 #include "threads/CriticalSection.h"
 #include "utils/EventStream.h"
@@ -171,6 +172,14 @@ namespace PVR
      */
     bool UpdateEntry(const EPG_TAG* data, int iClientId);
 
+    /*!
+     * @brief Delete an entry from this EPG.
+     * @param data The tag to delete.
+     * @param iClientId The id of the pvr client this event belongs to.
+     * @return True if it was deleted successfully, false otherwise.
+     */
+    bool DeleteEntry(const EPG_TAG* data, int iClientId);
+
     /*!
      * @brief Update an entry in this EPG.
      * @param tag The tag to update.
@@ -318,6 +327,7 @@ namespace PVR
     CDateTime m_lastScanTime; /*!< the last time the EPG has been updated */
     mutable CCriticalSection m_critSection; /*!< critical section for changes in this table */
     bool m_bUpdateLastScanTime = false;
+    PVREpgSyncState m_syncState; /*!< the state of the incremental sync with the client */
     std::shared_ptr<CPVREpgChannelData> m_channelData;
     CPVREpgTagsContainer m_tags;
 
@@ -25,6 +25,8 @@
 #include "threads/SystemClock.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -99,9 +101,59 @@ void CEpgTagStateChange::Deliver()
   epg->UpdateEntry(m_epgtag, m_state);
 }
 
+class CEpgWriter : private CThread
+{
+public:
+  explicit CEpgWriter(CPVREpgContainer& owner) : CThread("EPGWriter"), m_owner(owner) {}
+  ~CEpgWriter() override { Stop(); }
+
+  void Start()
+  {
+    Create();
+    SetPriority(GetMinPriority());
+  }
+
+  void Stop() { StopThread(); }
+
+  /*!
+   * @brief Wake up the writer to persist pending changes now.
+   */
+  void Trigger() { m_triggerEvent.Set(); }
+
+private:
+  void Process() override;
+
+  CPVREpgContainer& m_owner;
+  CEvent m_triggerEvent;
+};
+
+void CEpgWriter::Process()
+{
+  // persist changes at least once a minute, even if nobody asked for it
+  static constexpr auto PERSIST_INTERVAL = 60s;
+  static constexpr unsigned int PERSIST_TIMESLICE = 1000; // ms
+
+  while (!m_bStop)
+  {
+    if (AbortableWait(m_triggerEvent, PERSIST_INTERVAL) == WAIT_INTERRUPTED)
+      break;
+
+    while (!m_bStop && !m_owner.InterruptUpdate())
+    {
+      m_owner.PersistAll(PERSIST_TIMESLICE);
+
+      // go on with the remaining channels, if any. db and epg locks are released in between.
+      CSingleLock lock(m_owner.m_critSection);
+      if (m_owner.m_persistStats.iBacklog == 0)
+        break;
+    }
+  }
+}
+
 CPVREpgContainer::CPVREpgContainer() :
   CThread("EPGUpdater"),
   m_database(new CPVREpgDatabase),
+  m_writer(new CEpgWriter(*this)),
   m_settings({
     CSettings::SETTING_EPG_EPGUPDATE,
     CSettings::SETTING_EPG_FUTURE_DAYSTODISPLAY,
@@ -154,12 +206,15 @@ void CPVREpgContainer::Start()
     Create();
     SetPriority(-1);
 
+    m_writer->Start();
+
     m_bStarted = true;
   }
 }
 
 void CPVREpgContainer::Stop()
 {
+  m_writer->Stop();
   StopThread();
 
   {
@@ -269,62 +324,70 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
     for (const auto& epg : m_epgIdToEpgMap)
     {
       if (epg.second && epg.second->NeedsSave())
-      {
-        // Note: We need to obtain a lock for every epg instance before we can lock
-        //       the epg db. This order is important. Otherwise deadlocks may occur.
-        epg.second->Lock();
         changedEpgs.emplace_back(epg.second);
-      }
     }
   }
 
+  if (changedEpgs.empty())
+    return true;
+
   bool bReturn = true;
+  size_t iChannels = 0;
+  size_t iQueries = 0;
 
-  if (!changedEpgs.empty())
+  const auto start = std::chrono::steady_clock::now();
+  XbmcThreads::EndTime processTimeslice(iMaxTimeslice);
+  for (const auto& epg : changedEpgs)
   {
-    // Note: We must lock the db the whole time, otherwise races may occur.
-    database->Lock();
-
-    XbmcThreads::EndTime processTimeslice(iMaxTimeslice);
-    for (const auto& epg : changedEpgs)
-    {
-      if (!processTimeslice.IsTimePast())
-      {
-        CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: Persisting events for channel '{}'...",
-                    epg->GetChannelData()->ChannelName());
+    if (processTimeslice.IsTimePast())
+      break;
 
-        bReturn &= epg->QueuePersistQuery(database);
+    // Note: We need to obtain the lock for the epg instance before we can lock the epg db. This
+    //       order is important. Otherwise deadlocks may occur.
+    epg->Lock();
+    database->Lock();
 
-        size_t queryCount = database->GetInsertQueriesCount() + database->GetDeleteQueriesCount();
-        if (queryCount > EPG_COMMIT_QUERY_COUNT_LIMIT)
-        {
-          CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committing {} queries in loop.",
-                      queryCount);
-          database->CommitDeleteQueries();
-          database->CommitInsertQueries();
-          CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committed {} queries in loop.", queryCount);
-        }
-      }
+    CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: Persisting events for channel '{}'...",
+                epg->GetChannelData()->ChannelName());
 
-      epg->Unlock();
-    }
+    bReturn &= epg->QueuePersistQuery(database);
+    iQueries += database->GetInsertQueriesCount() + database->GetDeleteQueriesCount();
 
-    if (bReturn)
-    {
-      database->CommitDeleteQueries();
-      database->CommitInsertQueries();
-    }
+    // The epg's changes are queued now. Readers of this epg needing data from the db will wait
+    // for the db lock, thus there is no need to block them while the queries are executed.
+    epg->Unlock();
 
+    // Note: We must lock the db until the queries are committed, otherwise races may occur.
+    bReturn &= database->CommitPersistQueries();
     database->Unlock();
+
+    ++iChannels;
   }
 
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  const size_t iBacklog = changedEpgs.size() - iChannels;
+
+  CSingleLock lock(m_critSection);
+  m_persistStats.iChannels += iChannels;
+  m_persistStats.iQueries += iQueries;
+  m_persistStats.duration += duration;
+  m_persistStats.iBacklog = iBacklog;
+
+  CLog::LogFC(LOGDEBUG, LOGEPG,
+              "EPG Container: Persisted {} channels with {} queries in {} ms ({} queries/s), {} "
+              "channels left. Total: {} channels, {} queries in {} ms.",
+              iChannels, iQueries, duration.count(),
+              iQueries * 1000 / std::max<int64_t>(duration.count(), 1), iBacklog,
+              m_persistStats.iChannels, m_persistStats.iQueries,
+              m_persistStats.duration.count());
+
   return bReturn;
 }
 
 void CPVREpgContainer::Process()
 {
   time_t iNow = 0;
-  time_t iLastSave = 0;
   time_t iLastEpgCleanup = 0;
   bool bUpdateEpg = true;
   bool bHasPendingUpdates = false;
@@ -385,8 +448,13 @@ void CPVREpgContainer::Process()
           if (processTimeslice.IsTimePast() || m_epgTagChanges.empty())
           {
             if (iProcessed > 0)
+            {
               CLog::LogFC(LOGDEBUG, LOGEPG, "Processed {} queued epg event changes.", iProcessed);
 
+              // the changes get persisted in the background
+              m_writer->Trigger();
+            }
+
             break;
           }
 
@@ -427,17 +495,11 @@ void CPVREpgContainer::Process()
       }
     }
 
-    /* check for changes that need to be saved every 60 seconds */
-    if ((iNow - iLastSave > 60) && !InterruptUpdate())
-    {
-      PersistAll(1000);
-      iLastSave = iNow;
-    }
-
     CThread::Sleep(1000ms);
   }
 
   // store data on exit
+  m_writer->Stop();
   CLog::Log(LOGINFO, "EPG Container: Persisting unsaved events...");
   PersistAll(std::numeric_limits<unsigned int>::max());
   CLog::Log(LOGINFO, "EPG Container: Persisting events done");
@@ -609,6 +671,10 @@ bool CPVREpgContainer::RemoveOldEntries()
   for (const auto& epgEntry : epgs)
     epgEntry.second->Cleanup(cleanupTime);
 
+  const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
+  if (database)
+    database->DeleteUnusedSearchWords();
+
   CSingleLock lock(m_critSection);
   CDateTime::GetCurrentDateTime().GetAsUTCDateTime().GetAsTime(m_iLastEpgCleanup);
 
@@ -769,6 +835,9 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
                     bOnlyPending))
     {
       iUpdatedTables++;
+
+      // let the writer persist the changes while the next tables get updated
+      m_writer->Trigger();
     }
     else if (!epg->IsValid())
     {
@@ -17,6 +17,8 @@
 #include "utils/EventStream.h"
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
@@ -28,6 +30,7 @@ namespace PVR
 {
   class CEpgUpdateRequest;
   class CEpgTagStateChange;
+  class CEpgWriter;
   class CPVREpg;
   class CPVREpgChannelData;
   class CPVREpgDatabase;
@@ -40,6 +43,7 @@ namespace PVR
   class CPVREpgContainer : private CThread
   {
     friend class CPVREpgDatabase;
+    friend class CEpgWriter;
 
   public:
     /*!
@@ -238,7 +242,8 @@ namespace PVR
     void WaitForUpdateFinish();
 
     /*!
-     * @brief Call Persist() on each table
+     * @brief Call Persist() on each table. The changes of each table are written in a single
+     *        transaction. Tables left over when the timeslice is exceeded are reported as backlog.
      * @param iMaxTimeslice time in milliseconds for max processing. Return after this time
      *        even if not all data was persisted, unless value is -1
      * @return True when they all were persisted, false otherwise.
@@ -290,6 +295,16 @@ namespace PVR
                         const std::shared_ptr<CPVREpgDatabase>& database);
 
     std::shared_ptr<CPVREpgDatabase> m_database; /*!< the EPG database */
+    std::unique_ptr<CEpgWriter> m_writer; /*!< the thread persisting EPG changes */
+
+    struct PersistStats
+    {
+      uint64_t iChannels = 0; /*!< number of tables persisted */
+      uint64_t iQueries = 0; /*!< number of queries executed to persist the tables */
+      std::chrono::milliseconds duration{0}; /*!< time spent persisting the tables */
+      size_t iBacklog = 0; /*!< number of changed tables left over by the last run */
+    };
+    mutable PersistStats m_persistStats; /*!< metrics of the EPG writer */
 
     bool m_bIsUpdating = false; /*!< true while an update is running */
     std::atomic<bool> m_bIsInitialising = {
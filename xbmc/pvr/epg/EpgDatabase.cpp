@@ -13,14 +13,20 @@
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchData.h"
+#include "pvr/epg/EpgSearchIndex.h"
+#include "pvr/epg/EpgSync.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace dbiplus;
@@ -100,7 +106,32 @@ void CPVREpgDatabase::CreateTables()
   CLog::LogFC(LOGDEBUG, LOGEPG, "Creating table 'lastepgscan'");
   m_pDS->exec("CREATE TABLE lastepgscan ("
         "idEpg integer primary key, "
-        "sLastScan varchar(20)"
+        "sLastScan varchar(20), "
+        "sSyncToken varchar(255), "
+        "iSyncEnd integer"
+      ")"
+  );
+
+  CreateSearchIndexTables();
+}
+
+void CPVREpgDatabase::CreateSearchIndexTables()
+{
+  // Note: SQLite only uses an index for the LIKE lookup of the suffixes if it is case insensitive
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Creating table 'epgwords'");
+  m_pDS->exec(PrepareSQL("CREATE TABLE epgwords ("
+        "sSuffix varchar(128) COLLATE NOCASE, "
+        "sWord   varchar(128), "
+        "PRIMARY KEY (sSuffix, sWord)"
+      ")")
+  );
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Creating table 'epgtagwords'");
+  m_pDS->exec("CREATE TABLE epgtagwords ("
+        "sWord      varchar(128), "
+        "idEpg      integer, "
+        "iStartTime integer, "
+        "iWeight    integer"
       ")"
   );
 }
@@ -112,6 +143,9 @@ void CPVREpgDatabase::CreateAnalytics()
   CSingleLock lock(m_critSection);
   m_pDS->exec("CREATE UNIQUE INDEX idx_epg_idEpg_iStartTime on epgtags(idEpg, iStartTime desc);");
   m_pDS->exec("CREATE INDEX idx_epg_iEndTime on epgtags(iEndTime);");
+  m_pDS->exec("CREATE INDEX idx_epgtagwords_sWord on epgtagwords(sWord);");
+  m_pDS->exec(
+      "CREATE INDEX idx_epgtagwords_idEpg_iStartTime on epgtagwords(idEpg, iStartTime);");
 }
 
 void CPVREpgDatabase::UpdateTables(int iVersion)
@@ -258,6 +292,43 @@ void CPVREpgDatabase::UpdateTables(int iVersion)
     m_pDS->exec("DROP TABLE epgtags");
     m_pDS->exec("ALTER TABLE epgtags_new RENAME TO epgtags");
   }
+
+  if (iVersion < 15)
+  {
+    m_pDS->exec("ALTER TABLE lastepgscan ADD sSyncToken varchar(255)");
+    m_pDS->exec("ALTER TABLE lastepgscan ADD iSyncEnd integer");
+  }
+
+  if (iVersion < 16)
+  {
+    // the index of version 14 and 15 has no suffixes
+    if (iVersion >= 14)
+    {
+      m_pDS->exec("DROP TABLE epgwords");
+      m_pDS->exec("DROP TABLE epgtagwords");
+    }
+
+    CreateSearchIndexTables();
+
+    // index the stored tags
+    m_pDS->query(
+        "SELECT idEpg, iStartTime, sTitle, sEpisodeName, sPlotOutline, sPlot FROM epgtags");
+    while (!m_pDS->eof())
+    {
+      const std::map<std::string, int> words = CPVREpgSearchIndex::GetWords(
+          m_pDS->fv("sTitle").get_asString(), m_pDS->fv("sEpisodeName").get_asString(),
+          m_pDS->fv("sPlotOutline").get_asString(), m_pDS->fv("sPlot").get_asString());
+
+      for (const auto& strQuery :
+           GetSearchIndexInsertQueries(m_pDS->fv("idEpg").get_asInt(),
+                                       static_cast<time_t>(m_pDS->fv("iStartTime").get_asInt()),
+                                       words))
+        m_pDS2->exec(strQuery);
+
+      m_pDS->next();
+    }
+    m_pDS->close();
+  }
 }
 
 bool CPVREpgDatabase::DeleteEpg()
@@ -270,6 +341,8 @@ bool CPVREpgDatabase::DeleteEpg()
   bReturn = DeleteValues("epg") || bReturn;
   bReturn = DeleteValues("epgtags") || bReturn;
   bReturn = DeleteValues("lastepgscan") || bReturn;
+  bReturn = DeleteValues("epgtagwords") || bReturn;
+  bReturn = DeleteValues("epgwords") || bReturn;
 
   return bReturn;
 }
@@ -307,6 +380,10 @@ bool CPVREpgDatabase::QueueDeleteTagQuery(const CPVREpgInfoTag& tag)
   filter.AppendWhere(PrepareSQL("idBroadcast = %u", tag.DatabaseID()));
 
   std::string strQuery;
+  BuildSQL("DELETE FROM epgtagwords",
+           Filter(GetSearchIndexWhere(tag.EpgID(), filter.where)), strQuery);
+  QueueDeleteQuery(strQuery);
+
   BuildSQL(PrepareSQL("DELETE FROM %s ", "epgtags"), filter, strQuery);
   return QueueDeleteQuery(strQuery);
 }
@@ -496,6 +573,15 @@ CDateTime ConvertLocalTimeToUTC(const CDateTime& local)
   return CDateTime(mktime(tms));
 }
 
+// Max number of EPG tags written or deleted by a single multi-row query
+constexpr size_t PERSIST_ROWS_PER_QUERY = 100;
+
+constexpr const char* PERSIST_TAGS_QUERY =
+    "REPLACE INTO epgtags (idEpg, iStartTime, iEndTime, sTitle, sPlotOutline, sPlot, "
+    "sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, sIconPath, iGenreType, "
+    "iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, iSeriesId, iEpisodeId, "
+    "iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid, idBroadcast) VALUES ";
+
 class CSearchTermConverter
 {
 public:
@@ -519,6 +605,29 @@ public:
     return result;
   }
 
+  /*!
+   * @brief Get the words to look up in the search index to find the candidates for this search
+   * term, one for every term of the search.
+   * @param words Filled with the words to look up.
+   * @return False if the search term cannot be answered from the index, true otherwise.
+   */
+  bool GetIndexLookupWords(std::vector<std::string>& words) const
+  {
+    // negations need the whole table
+    if (m_bHasNegation || m_terms.empty())
+      return false;
+
+    for (const auto& term : m_terms)
+    {
+      std::string strWord;
+      if (!CPVREpgSearchIndex::GetLookupWord(term, strWord))
+        return false;
+
+      words.emplace_back(strWord);
+    }
+    return true;
+  }
+
 private:
   void Parse(const std::string& strSearchTerm)
   {
@@ -538,6 +647,7 @@ private:
         std::string strDummy;
         GetAndCutNextTerm(strParsedSearchTerm, strDummy);
         strFragment += " NOT ";
+        m_bHasNegation = true;
         bNextOR = false;
       }
       else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
@@ -562,6 +672,8 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strTerm);
         if (!strTerm.empty())
         {
+          m_terms.emplace_back(strTerm);
+
           if (bNextOR && !m_fragments.empty())
             strFragment += " OR "; // default operator
 
@@ -614,6 +726,8 @@ private:
   }
 
   std::vector<std::string> m_fragments;
+  std::vector<std::string> m_terms;
+  bool m_bHasNegation = false;
 };
 
 } // unnamed namespace
@@ -673,9 +787,35 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   {
     const CSearchTermConverter conv(searchData.m_strSearchTerm);
 
+    // Use the search index to find the candidates and their rank. The candidates get verified by
+    // the where clause below.
+    std::vector<std::string> words;
+    if (conv.GetIndexLookupWords(words))
+    {
+      std::string strWords;
+      for (const auto& word : words)
+      {
+        if (!strWords.empty())
+          strWords += " OR ";
+        strWords += PrepareSQL("(sSuffix LIKE '%s%%')", word.c_str());
+      }
+
+      strQuery = "SELECT epgtags.* FROM epgtags "
+                 "JOIN (SELECT idEpg AS idHitEpg, iStartTime AS iHitStartTime, "
+                 "SUM(iWeight) AS iRank FROM epgtagwords "
+                 "WHERE sWord IN (SELECT sWord FROM epgwords WHERE " + strWords + ") "
+                 "GROUP BY idEpg, iStartTime) AS hits "
+                 "ON idEpg = idHitEpg AND iStartTime = iHitStartTime";
+      filter.AppendOrder("iRank DESC");
+    }
+
     // title
     std::string strWhere = conv.ToSQL("sTitle");
 
+    // episode name
+    strWhere += " OR ";
+    strWhere += conv.ToSQL("sEpisodeName");
+
     // plot outline
     strWhere += " OR ";
     strWhere += conv.ToSQL("sPlotOutline");
@@ -958,12 +1098,59 @@ bool CPVREpgDatabase::QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(int iEpgID,
                                 static_cast<unsigned int>(maxStart)));
 
   std::string strQuery;
+  if (BuildSQL("DELETE FROM epgtagwords", Filter(GetSearchIndexWhere(iEpgID, filter.where)),
+               strQuery))
+    QueueDeleteQuery(strQuery);
+
   if (BuildSQL("DELETE FROM epgtags", filter, strQuery))
     return QueueDeleteQuery(strQuery);
 
   return false;
 }
 
+bool CPVREpgDatabase::QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
+    int iEpgID, const std::vector<std::pair<CDateTime, CDateTime>>& ranges)
+{
+  CSingleLock lock(m_critSection);
+
+  bool bReturn = true;
+  for (size_t i = 0; i < ranges.size(); i += PERSIST_ROWS_PER_QUERY)
+  {
+    const size_t iEnd = std::min(i + PERSIST_ROWS_PER_QUERY, ranges.size());
+
+    std::string strRanges;
+    for (size_t j = i; j < iEnd; ++j)
+    {
+      time_t minEnd;
+      ranges[j].first.GetAsTime(minEnd);
+
+      time_t maxStart;
+      ranges[j].second.GetAsTime(maxStart);
+
+      if (j > i)
+        strRanges += " OR ";
+
+      strRanges += PrepareSQL("(iEndTime >= %u AND iStartTime <= %u)",
+                              static_cast<unsigned int>(minEnd),
+                              static_cast<unsigned int>(maxStart));
+    }
+
+    Filter filter;
+    filter.AppendWhere(PrepareSQL("idEpg = %u", iEpgID));
+    filter.AppendWhere("(" + strRanges + ")");
+
+    std::string strQuery;
+    if (BuildSQL("DELETE FROM epgtagwords", Filter(GetSearchIndexWhere(iEpgID, filter.where)),
+                 strQuery))
+      QueueDeleteQuery(strQuery);
+
+    if (!BuildSQL("DELETE FROM epgtags", filter, strQuery) || !QueueDeleteQuery(strQuery))
+      bReturn = false;
+  }
+
+  return bReturn;
+}
+
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetAllEpgTags(int iEpgID)
 {
   CSingleLock lock(m_critSection);
@@ -990,6 +1177,34 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetAllEpgTags(int
   return {};
 }
 
+std::vector<std::pair<time_t, time_t>> CPVREpgDatabase::GetAllEpgTagTimes(int iEpgID)
+{
+  CSingleLock lock(m_critSection);
+  const std::string strQuery = PrepareSQL(
+      "SELECT iStartTime, iEndTime FROM epgtags WHERE idEpg = %u ORDER BY iStartTime;", iEpgID);
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      std::vector<std::pair<time_t, time_t>> times;
+      times.reserve(m_pDS->num_rows());
+      while (!m_pDS->eof())
+      {
+        times.emplace_back(static_cast<time_t>(m_pDS->fv(0).get_asInt()),
+                           static_cast<time_t>(m_pDS->fv(1).get_asInt()));
+        m_pDS->next();
+      }
+      m_pDS->close();
+      return times;
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load tag times for EPG ({})", iEpgID);
+    }
+  }
+  return {};
+}
+
 bool CPVREpgDatabase::GetLastEpgScanTime(int iEpgId, CDateTime* lastScan)
 {
   bool bReturn = false;
@@ -1011,11 +1226,43 @@ bool CPVREpgDatabase::GetLastEpgScanTime(int iEpgId, CDateTime* lastScan)
   return bReturn;
 }
 
-bool CPVREpgDatabase::QueuePersistLastEpgScanTimeQuery(int iEpgId, const CDateTime& lastScanTime)
+bool CPVREpgDatabase::GetEpgSyncState(int iEpgId, PVREpgSyncState& state)
 {
+  state.Reset();
+
   CSingleLock lock(m_critSection);
-  std::string strQuery = PrepareSQL("REPLACE INTO lastepgscan(idEpg, sLastScan) VALUES (%u, '%s');",
-      iEpgId, lastScanTime.GetAsDBDateTime().c_str());
+  const std::string strQuery =
+      PrepareSQL("SELECT sSyncToken, iSyncEnd FROM lastepgscan WHERE idEpg = %u", iEpgId);
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      if (!m_pDS->eof())
+      {
+        state.strToken = m_pDS->fv("sSyncToken").get_asString();
+        state.end = static_cast<time_t>(m_pDS->fv("iSyncEnd").get_asInt64());
+      }
+      m_pDS->close();
+      return true;
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load EPG sync state from the database");
+    }
+  }
+  return false;
+}
+
+bool CPVREpgDatabase::QueuePersistLastEpgScanTimeQuery(int iEpgId,
+                                                       const CDateTime& lastScanTime,
+                                                       const PVREpgSyncState& syncState)
+{
+  CSingleLock lock(m_critSection);
+  std::string strQuery = PrepareSQL(
+      "REPLACE INTO lastepgscan(idEpg, sLastScan, sSyncToken, iSyncEnd) "
+      "VALUES (%u, '%s', '%s', %lld);",
+      iEpgId, lastScanTime.GetAsDBDateTime().c_str(), syncState.strToken.c_str(),
+      static_cast<long long>(syncState.end));
 
   return QueueInsertQuery(strQuery);
 }
@@ -1079,6 +1326,7 @@ bool CPVREpgDatabase::DeleteEpgTags(int iEpgId, const CDateTime& maxEndTime)
   CSingleLock lock(m_critSection);
   filter.AppendWhere(
       PrepareSQL("idEpg = %u AND iEndTime < %u", iEpgId, static_cast<unsigned int>(iMaxEndTime)));
+  DeleteValues("epgtagwords", Filter(GetSearchIndexWhere(iEpgId, filter.where)));
   return DeleteValues("epgtags", filter);
 }
 
@@ -1088,6 +1336,7 @@ bool CPVREpgDatabase::DeleteEpgTags(int iEpgId)
 
   CSingleLock lock(m_critSection);
   filter.AppendWhere(PrepareSQL("idEpg = %u", iEpgId));
+  DeleteValues("epgtagwords", filter);
   return DeleteValues("epgtags", filter);
 }
 
@@ -1099,10 +1348,43 @@ bool CPVREpgDatabase::QueueDeleteEpgTags(int iEpgId)
   filter.AppendWhere(PrepareSQL("idEpg = %u", iEpgId));
 
   std::string strQuery;
+  BuildSQL("DELETE FROM epgtagwords", filter, strQuery);
+  QueueDeleteQuery(strQuery);
+
   BuildSQL(PrepareSQL("DELETE FROM %s ", "epgtags"), filter, strQuery);
   return QueueDeleteQuery(strQuery);
 }
 
+std::string CPVREpgDatabase::GetPersistValues(const CPVREpgInfoTag& tag)
+{
+  time_t iStartTime, iEndTime;
+  tag.StartAsUTC().GetAsTime(iStartTime);
+  tag.EndAsUTC().GetAsTime(iEndTime);
+
+  std::string sFirstAired;
+  if (tag.FirstAired().IsValid())
+    sFirstAired = tag.FirstAired().GetAsW3CDate();
+
+  /* Only store the genre string when needed */
+  std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING || tag.GenreSubType() == EPG_GENRE_USE_STRING) ? tag.DeTokenize(tag.Genre()) : "";
+
+  // new tags get their id assigned by the database
+  const std::string strBroadcastId =
+      tag.DatabaseID() < 0 ? "NULL" : std::to_string(tag.DatabaseID());
+
+  return PrepareSQL(
+      "(%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', '%s', "
+      "%i, %i, %i, %i, %i, '%s', %i, '%s', %i, %s)",
+      tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
+      tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
+      tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
+      tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
+      tag.IMDBNumber().c_str(), tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(),
+      strGenre.c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
+      tag.Flags(), tag.SeriesLink().c_str(), tag.UniqueBroadcastID(), strBroadcastId.c_str());
+}
+
 bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
 {
   if (tag.EpgID() <= 0)
@@ -1111,57 +1393,171 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
     return false;
   }
 
-  time_t iStartTime, iEndTime;
-  tag.StartAsUTC().GetAsTime(iStartTime);
-  tag.EndAsUTC().GetAsTime(iEndTime);
+  CSingleLock lock(m_critSection);
 
-  std::string sFirstAired;
-  if (tag.FirstAired().IsValid())
-    sFirstAired = tag.FirstAired().GetAsW3CDate();
+  QueuePersistSearchIndexQuery(tag);
+  return QueueInsertQuery(PERSIST_TAGS_QUERY + GetPersistValues(tag) + ";");
+}
+
+bool CPVREpgDatabase::QueuePersistQuery(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  CSingleLock lock(m_critSection);
 
-  int iBroadcastId = tag.DatabaseID();
+  bool bReturn = true;
   std::string strQuery;
+  size_t iRows = 0;
 
-  /* Only store the genre string when needed */
-  std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING || tag.GenreSubType() == EPG_GENRE_USE_STRING) ? tag.DeTokenize(tag.Genre()) : "";
+  for (const auto& tag : tags)
+  {
+    if (tag->EpgID() <= 0)
+    {
+      CLog::LogF(LOGERROR, "Tag '{}' does not have a valid table", tag->Title());
+      bReturn = false;
+      continue;
+    }
+
+    strQuery += (iRows == 0) ? PERSIST_TAGS_QUERY : ", ";
+    strQuery += GetPersistValues(*tag);
+
+    QueuePersistSearchIndexQuery(*tag);
+
+    if (++iRows == PERSIST_ROWS_PER_QUERY)
+    {
+      bReturn &= QueueInsertQuery(strQuery + ";");
+      strQuery.clear();
+      iRows = 0;
+    }
+  }
 
+  if (iRows > 0)
+    bReturn &= QueueInsertQuery(strQuery + ";");
+
+  return bReturn;
+}
+
+bool CPVREpgDatabase::CommitPersistQueries()
+{
   CSingleLock lock(m_critSection);
 
-  if (iBroadcastId < 0)
+  if (!m_pDB || !m_pDS || !m_pDS2)
+    return false;
+
+  // Note: delete queries must be committed before insert queries. Both run in one transaction,
+  //       the datasets don't start their own.
+  BeginTransaction();
+  m_pDS->set_autocommit(false);
+  m_pDS2->set_autocommit(false);
+
+  bool bReturn = CommitDeleteQueries();
+
+  // a failing dataset rolls back the transaction, the inserts must not run without it
+  if (!bReturn)
+    m_pDS2->clear_insert_sql();
+
+  bReturn = CommitInsertQueries() && bReturn;
+
+  m_pDS->set_autocommit(true);
+  m_pDS2->set_autocommit(true);
+
+  if (bReturn)
+    return CommitTransaction();
+
+  RollbackTransaction();
+
+  // don't run the failed queries again with the next channel
+  m_pDS->clear_delete_sql();
+  m_pDS2->clear_insert_sql();
+  return false;
+}
+
+std::string CPVREpgDatabase::GetSearchIndexWhere(int iEpgId, const std::string& strTagsWhere)
+{
+  return PrepareSQL("idEpg = %u AND iStartTime IN (SELECT iStartTime FROM epgtags WHERE idEpg = %u "
+                    "AND (",
+                    iEpgId, iEpgId) +
+         strTagsWhere + "))";
+}
+
+void CPVREpgDatabase::QueuePersistSearchIndexQuery(const CPVREpgInfoTag& tag)
+{
+  time_t iStartTime;
+  tag.StartAsUTC().GetAsTime(iStartTime);
+
+  // Note: delete queries get committed before insert queries, so this drops the entries of a
+  //       previous version of the tag before the new ones get written.
+  QueueDeleteQuery(PrepareSQL("DELETE FROM epgtagwords WHERE idEpg = %u AND iStartTime = %u",
+                              tag.EpgID(), static_cast<unsigned int>(iStartTime)));
+
+  if (tag.DatabaseID() >= 0)
   {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
-        tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(), tag.SeriesLink().c_str(),
-        tag.UniqueBroadcastID());
+    // drop the index entries of the stored tag, its start time might have changed
+    std::string strDeleteQuery;
+    BuildSQL("DELETE FROM epgtagwords",
+             Filter(GetSearchIndexWhere(tag.EpgID(),
+                                        PrepareSQL("idBroadcast = %u", tag.DatabaseID()))),
+             strDeleteQuery);
+    QueueDeleteQuery(strDeleteQuery);
   }
-  else
+
+  for (const auto& strQuery :
+       GetSearchIndexInsertQueries(tag.EpgID(), iStartTime,
+                                   CPVREpgSearchIndex::GetWords(tag.Title(), tag.EpisodeName(),
+                                                                tag.PlotOutline(), tag.Plot())))
+    QueueInsertQuery(strQuery);
+}
+
+std::vector<std::string> CPVREpgDatabase::GetSearchIndexInsertQueries(
+    int iEpgId, time_t iStartTime, const std::map<std::string, int>& words)
+{
+  if (words.empty())
+    return {};
+
+  // long words that only differ after the truncation are the same word in the index
+  std::map<std::string, int> indexWords;
+  std::set<std::pair<std::string, std::string>> suffixes;
+  for (const auto& word : words)
+  {
+    const std::string strIndexWord = CPVREpgSearchIndex::GetIndexWord(word.first);
+    indexWords[strIndexWord] += word.second;
+
+    for (const auto& suffix : CPVREpgSearchIndex::GetSuffixes(word.first))
+      suffixes.emplace(suffix, strIndexWord);
+  }
+
+  std::vector<std::string> queries;
+
+  if (!suffixes.empty())
   {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', %i, %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
-        tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(), tag.SeriesLink().c_str(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    std::string strWordsQuery = "REPLACE INTO epgwords (sSuffix, sWord) VALUES ";
+    for (auto it = suffixes.cbegin(); it != suffixes.cend(); ++it)
+    {
+      if (it != suffixes.cbegin())
+        strWordsQuery += ", ";
+      strWordsQuery += PrepareSQL("('%s', '%s')", it->first.c_str(), it->second.c_str());
+    }
+    queries.emplace_back(strWordsQuery);
   }
 
-  QueueInsertQuery(strQuery);
-  return true;
+  std::string strTagWordsQuery =
+      "INSERT INTO epgtagwords (sWord, idEpg, iStartTime, iWeight) VALUES ";
+  for (auto it = indexWords.cbegin(); it != indexWords.cend(); ++it)
+  {
+    if (it != indexWords.cbegin())
+      strTagWordsQuery += ", ";
+    strTagWordsQuery += PrepareSQL("('%s', %u, %u, %i)", it->first.c_str(), iEpgId,
+                                   static_cast<unsigned int>(iStartTime), it->second);
+  }
+  queries.emplace_back(strTagWordsQuery);
+
+  return queries;
+}
+
+bool CPVREpgDatabase::DeleteUnusedSearchWords()
+{
+  CSingleLock lock(m_critSection);
+  return DeleteValues("epgwords",
+                      Filter("NOT EXISTS (SELECT 1 FROM epgtagwords "
+                             "WHERE epgtagwords.sWord = epgwords.sWord)"));
 }
 
 int CPVREpgDatabase::GetLastEPGId()
@@ -11,7 +11,11 @@
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
+#include <ctime>
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 class CDateTime;
@@ -22,6 +26,7 @@ namespace PVR
   class CPVREpgInfoTag;
 
   struct PVREpgSearchData;
+  struct PVREpgSyncState;
 
   /** The EPG database */
 
@@ -65,7 +70,7 @@ namespace PVR
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
      */
-    int GetSchemaVersion() const override { return 13; }
+    int GetSchemaVersion() const override { return 16; }
 
     /*!
      * @brief Get the default sqlite database filename.
@@ -109,6 +114,13 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetAllEpgTags(int iEpgID);
 
+    /*!
+     * @brief Get start and end times of all tags for a given EPG id.
+     * @param iEpgID The ID of the EPG.
+     * @return The pairs of start and end time (UTC), ordered by start time.
+     */
+    std::vector<std::pair<time_t, time_t>> GetAllEpgTagTimes(int iEpgID);
+
     /*!
      * @brief Get the start time of the first tag in this EPG.
      * @param iEpgID The ID of the EPG.
@@ -220,6 +232,16 @@ namespace PVR
                                                      const CDateTime& minEndTime,
                                                      const CDateTime& maxStartTime);
 
+    /*!
+     * @brief Write the queries to delete all EPG tags in any of the given ranges of min end time
+     * and max start time to db query queue, using one query per batch of ranges.
+     * @param iEpgID The ID of the EPG for the tags to delete.
+     * @param ranges Pairs of min end time and max start time for the tags to delete.
+     * @return True if the queries were queued successfully, false otherwise.
+     */
+    bool QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
+        int iEpgID, const std::vector<std::pair<CDateTime, CDateTime>>& ranges);
+
     /*!
      * @brief Get the last stored EPG scan time.
      * @param iEpgId The table to update the time for. Use 0 for a global value.
@@ -229,12 +251,24 @@ namespace PVR
     bool GetLastEpgScanTime(int iEpgId, CDateTime* lastScan);
 
     /*!
-     * @brief Write the query to update the last scan time for the given EPG to db query queue.
+     * @brief Get the stored state of the incremental sync of the given EPG with its client.
+     * @param iEpgId The table to get the state for.
+     * @param state The state. Reset if it wasn't found.
+     * @return True if the state was fetched successfully, false otherwise.
+     */
+    bool GetEpgSyncState(int iEpgId, PVREpgSyncState& state);
+
+    /*!
+     * @brief Write the query to update the last scan time and the sync state for the given EPG to
+     * db query queue.
      * @param iEpgId The table to update the time for.
      * @param lastScanTime The time to write to the database.
+     * @param syncState The sync state to write to the database.
      * @return True on success, false otherwise.
      */
-    bool QueuePersistLastEpgScanTimeQuery(int iEpgId, const CDateTime& lastScanTime);
+    bool QueuePersistLastEpgScanTimeQuery(int iEpgId,
+                                          const CDateTime& lastScanTime,
+                                          const PVREpgSyncState& syncState);
 
     /*!
      * @brief Write the query to delete the last scan time for the given EPG to db query queue.
@@ -280,6 +314,27 @@ namespace PVR
      */
     bool QueuePersistQuery(const CPVREpgInfoTag& tag);
 
+    /*!
+     * @brief Write the queries to persist the given EPG tags to db query queue, using multi-row
+     * queries.
+     * @param tags The tags to persist.
+     * @return True on success, false otherwise.
+     */
+    bool QueuePersistQuery(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
+    /*!
+     * @brief Commit all queued delete queries, then all queued insert queries, in a single
+     *        transaction.
+     * @return True on success, false otherwise.
+     */
+    bool CommitPersistQueries();
+
+    /*!
+     * @brief Erase all words from the search index that are no longer referenced by any EPG tag.
+     * @return True if the words were removed successfully, false otherwise.
+     */
+    bool DeleteUnusedSearchWords();
+
     /*!
      * @return Last EPG id in the database
      */
@@ -308,6 +363,43 @@ namespace PVR
 
     std::shared_ptr<CPVREpgInfoTag> CreateEpgTag(const std::unique_ptr<dbiplus::Dataset>& pDS);
 
+    /*!
+     * @brief Create the tables of the EPG search index.
+     */
+    void CreateSearchIndexTables();
+
+    /*!
+     * @brief Build the where clause selecting the search index entries of the given EPG tags.
+     * @param iEpgId The ID of the EPG the tags belong to.
+     * @param strTagsWhere The where clause selecting the tags from table 'epgtags'.
+     * @return The where clause for table 'epgtagwords'.
+     */
+    std::string GetSearchIndexWhere(int iEpgId, const std::string& strTagsWhere);
+
+    /*!
+     * @brief Write the queries to add the given EPG tag to the search index to db query queue.
+     * @param tag The tag to index.
+     */
+    void QueuePersistSearchIndexQuery(const CPVREpgInfoTag& tag);
+
+    /*!
+     * @brief Build the queries to add the words of an EPG tag to the search index.
+     * @param iEpgId The ID of the EPG the tag belongs to.
+     * @param iStartTime The start time of the tag.
+     * @param words The words of the tag and their weights, see CPVREpgSearchIndex::GetWords.
+     * @return The queries, empty if there are no words.
+     */
+    std::vector<std::string> GetSearchIndexInsertQueries(int iEpgId,
+                                                         time_t iStartTime,
+                                                         const std::map<std::string, int>& words);
+
+    /*!
+     * @brief Build the values of the query persisting the given EPG tag.
+     * @param tag The tag.
+     * @return The values, enclosed in parentheses.
+     */
+    std::string GetPersistValues(const CPVREpgInfoTag& tag);
+
     CCriticalSection m_critSection;
   };
 }
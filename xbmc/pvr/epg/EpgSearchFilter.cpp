@@ -108,7 +108,8 @@ bool CPVREpgSearchFilter::MatchSearchTerm(const std::shared_ptr<CPVREpgInfoTag>&
     {
       CTextSearch search(m_searchData.m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
 
-      bReturn = search.Search(tag->Title()) || search.Search(tag->PlotOutline()) ||
+      bReturn = search.Search(tag->Title()) || search.Search(tag->EpisodeName()) ||
+                search.Search(tag->PlotOutline()) ||
                 (m_searchData.m_bSearchInDescription && search.Search(tag->Plot()));
     }
   }
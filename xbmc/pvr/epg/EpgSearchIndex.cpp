@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSearchIndex.h"
+
+#include "utils/StringUtils.h"
+
+#include <vector>
+
+using namespace PVR;
+
+namespace
+{
+
+// Characters separating the words of a text
+constexpr const char* WORD_SEPARATORS = " \t\r\n\f\v";
+
+// Weights used to rank the search results
+constexpr int WEIGHT_TITLE = 4;
+constexpr int WEIGHT_EPISODE_NAME = 2;
+constexpr int WEIGHT_PLOT = 1;
+
+std::vector<std::string> SplitWords(const std::string& strText)
+{
+  std::vector<std::string> words;
+
+  size_t start = strText.find_first_not_of(WORD_SEPARATORS);
+  while (start != std::string::npos)
+  {
+    size_t end = strText.find_first_of(WORD_SEPARATORS, start);
+    if (end == std::string::npos)
+      end = strText.size();
+
+    words.emplace_back(strText.substr(start, end - start));
+    start = strText.find_first_not_of(WORD_SEPARATORS, end);
+  }
+
+  return words;
+}
+
+bool IsContinuationByte(char c)
+{
+  return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+std::string TruncateWord(const std::string& strWord, size_t start)
+{
+  size_t length = strWord.size() - start;
+  if (length > CPVREpgSearchIndex::MAX_WORD_LENGTH)
+  {
+    // don't cut an UTF-8 sequence
+    length = CPVREpgSearchIndex::MAX_WORD_LENGTH;
+    while (length > 0 && IsContinuationByte(strWord[start + length]))
+      --length;
+  }
+
+  return strWord.substr(start, length);
+}
+
+// Case folding matches the LIKE of SQLite, which ignores the case of ASCII characters only
+std::string NormalizeWord(std::string strWord)
+{
+  StringUtils::ToLower(strWord);
+  return strWord;
+}
+
+void AddWords(const std::string& strText, int iWeight, std::map<std::string, int>& words)
+{
+  for (const auto& word : SplitWords(strText))
+    words[NormalizeWord(word)] += iWeight;
+}
+
+} // unnamed namespace
+
+std::map<std::string, int> CPVREpgSearchIndex::GetWords(const std::string& strTitle,
+                                                        const std::string& strEpisodeName,
+                                                        const std::string& strPlotOutline,
+                                                        const std::string& strPlot)
+{
+  std::map<std::string, int> words;
+  AddWords(strTitle, WEIGHT_TITLE, words);
+  AddWords(strEpisodeName, WEIGHT_EPISODE_NAME, words);
+  AddWords(strPlotOutline, WEIGHT_PLOT, words);
+  AddWords(strPlot, WEIGHT_PLOT, words);
+  return words;
+}
+
+std::string CPVREpgSearchIndex::GetIndexWord(const std::string& strWord)
+{
+  return TruncateWord(strWord, 0);
+}
+
+std::set<std::string> CPVREpgSearchIndex::GetSuffixes(const std::string& strWord)
+{
+  std::set<std::string> suffixes;
+  for (size_t start = 0; start + MIN_LOOKUP_LENGTH <= strWord.size(); ++start)
+  {
+    if (!IsContinuationByte(strWord[start]))
+      suffixes.emplace(TruncateWord(strWord, start));
+  }
+  return suffixes;
+}
+
+bool CPVREpgSearchIndex::GetLookupWord(const std::string& strTerm, std::string& strWord)
+{
+  // LIKE wildcards may span multiple words and escapes differ between the database backends
+  if (strTerm.find_first_of("%_\\") != std::string::npos)
+    return false;
+
+  const std::vector<std::string> pieces = SplitWords(strTerm);
+  if (pieces.empty())
+    return false;
+
+  // Every piece is a part of a word of the matching texts, so the longest of them is the most
+  // selective lookup that still finds every match
+  auto longest = pieces.cbegin();
+  for (auto it = pieces.cbegin(); it != pieces.cend(); ++it)
+  {
+    if (it->size() > longest->size())
+      longest = it;
+  }
+
+  // shorter suffixes aren't indexed, longer pieces are looked up by their start
+  if (longest->size() < MIN_LOOKUP_LENGTH)
+    return false;
+
+  strWord = NormalizeWord(GetIndexWord(*longest));
+  return true;
+}
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace PVR
+{
+
+/*!
+ * @brief Tokenizer of the EPG search index. The index maps the words of the texts of an EPG tag
+ * to the tag, and the suffixes of the words to the words. A search looks up the words with a
+ * suffix starting with a word of the search term, i.e. the words containing it, to find the
+ * candidate tags, which are then verified against the full term.
+ */
+class CPVREpgSearchIndex
+{
+public:
+  /*!
+   * @brief The maximum length of an indexed word in bytes. Longer words are truncated.
+   */
+  static constexpr size_t MAX_WORD_LENGTH = 128;
+
+  /*!
+   * @brief The minimum length of a lookup word in bytes. Shorter suffixes are not indexed.
+   */
+  static constexpr size_t MIN_LOOKUP_LENGTH = 3;
+
+  /*!
+   * @brief Get the words to index for the texts of an EPG tag.
+   * @param strTitle The title.
+   * @param strEpisodeName The episode name.
+   * @param strPlotOutline The plot outline.
+   * @param strPlot The plot.
+   * @return The words and their weights. A word gets the sum of the weights of the texts it is
+   * contained in, title 4, episode name 2, plot outline and plot 1 each. The words are not
+   * truncated.
+   */
+  static std::map<std::string, int> GetWords(const std::string& strTitle,
+                                             const std::string& strEpisodeName,
+                                             const std::string& strPlotOutline,
+                                             const std::string& strPlot);
+
+  /*!
+   * @brief Get the word to store in the index for a word of a text.
+   * @param strWord The word.
+   * @return The word, truncated to MAX_WORD_LENGTH.
+   */
+  static std::string GetIndexWord(const std::string& strWord);
+
+  /*!
+   * @brief Get the suffixes to store in the index for a word of a text.
+   * @param strWord The word.
+   * @return The suffixes starting at every character of the word, truncated to MAX_WORD_LENGTH.
+   * Suffixes shorter than MIN_LOOKUP_LENGTH are left out.
+   */
+  static std::set<std::string> GetSuffixes(const std::string& strWord);
+
+  /*!
+   * @brief Get the word to look up in the index for a term of a search. Every text containing the
+   * term contains a word with a suffix starting with the lookup word.
+   * @param strTerm The term.
+   * @param strWord The lookup word.
+   * @return False if the term cannot be looked up in the index, true otherwise.
+   */
+  static bool GetLookupWord(const std::string& strTerm, std::string& strWord);
+};
+
+} // namespace PVR
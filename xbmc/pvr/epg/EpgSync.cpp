@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSync.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+PVR_ERROR CPVREpgSync::Update(IPVREpgSyncSource& source,
+                              time_t start,
+                              time_t end,
+                              PVREpgSyncState& state)
+{
+  if (state.IsValid() && state.end > start)
+  {
+    std::string strNewToken;
+    PVR_ERROR error =
+        source.GetEPGChanges(start, std::min(state.end, end), state.strToken, strNewToken);
+    if (error == PVR_ERROR_NO_ERROR && !strNewToken.empty())
+    {
+      // fetch the events of the part of the time frame that was not synced before
+      if (end > state.end)
+        error = source.GetEPG(state.end, end);
+
+      if (error == PVR_ERROR_NO_ERROR)
+      {
+        state.strToken = strNewToken;
+        state.end = std::max(state.end, end);
+      }
+      else
+      {
+        state.Reset();
+      }
+      return error;
+    }
+
+    if (error != PVR_ERROR_INVALID_PARAMETERS && error != PVR_ERROR_NOT_IMPLEMENTED &&
+        error != PVR_ERROR_NO_ERROR)
+    {
+      state.Reset();
+      return error;
+    }
+
+    CLog::LogFC(LOGDEBUG, LOGEPG, "Change token rejected, fetching the whole time frame");
+  }
+
+  state.Reset();
+
+  // fetch the whole time frame, obtaining a token for the next update if supported
+  std::string strNewToken;
+  PVR_ERROR error = source.GetEPGChanges(start, end, "", strNewToken);
+  if (error == PVR_ERROR_NOT_IMPLEMENTED)
+    return source.GetEPG(start, end);
+
+  if (error == PVR_ERROR_NO_ERROR)
+  {
+    state.strToken = strNewToken;
+    state.end = end;
+  }
+  return error;
+}
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_general.h"
+
+#include <ctime>
+#include <string>
+
+namespace PVR
+{
+
+/*!
+ * @brief The state of the incremental sync of an EPG with its PVR client.
+ */
+struct PVREpgSyncState
+{
+  std::string strToken; /*!< the change token returned by the client, empty if not synced yet */
+  time_t end = 0; /*!< the end of the time frame covered by the token */
+
+  bool IsValid() const { return !strToken.empty(); }
+  void Reset() { *this = {}; }
+};
+
+/*!
+ * @brief The EPG data source used for the sync, usually a PVR client serving one channel.
+ */
+class IPVREpgSyncSource
+{
+public:
+  virtual ~IPVREpgSyncSource() = default;
+
+  /*!
+   * @brief Fetch all events in the given time frame.
+   * @param start The start of the time frame.
+   * @param end The end of the time frame.
+   * @return PVR_ERROR_NO_ERROR on success, the error otherwise.
+   */
+  virtual PVR_ERROR GetEPG(time_t start, time_t end) = 0;
+
+  /*!
+   * @brief Fetch the events in the given time frame changed since the state identified by a token.
+   * @param start The start of the time frame.
+   * @param end The end of the time frame.
+   * @param strSinceToken The token of a previous call or empty to fetch all events.
+   * @param strNewToken The token identifying the state after this call.
+   * @return PVR_ERROR_NO_ERROR on success, PVR_ERROR_NOT_IMPLEMENTED if the source does not
+   * support incremental updates, PVR_ERROR_INVALID_PARAMETERS if the token is not valid anymore.
+   */
+  virtual PVR_ERROR GetEPGChanges(time_t start,
+                                  time_t end,
+                                  const std::string& strSinceToken,
+                                  std::string& strNewToken) = 0;
+};
+
+class CPVREpgSync
+{
+public:
+  /*!
+   * @brief Bring an EPG up to date for the given time frame. Fetches only the changes since the
+   * last sync if the source supports it and the token is still valid, plus the events in the part
+   * of the time frame not covered by the last sync. Falls back to fetching the whole time frame.
+   * @param source The source to fetch the events from.
+   * @param start The start of the time frame.
+   * @param end The end of the time frame.
+   * @param state The state of the last sync, updated on success. Reset on failure.
+   * @return PVR_ERROR_NO_ERROR on success, the error otherwise.
+   */
+  static PVR_ERROR Update(IPVREpgSyncSource& source,
+                          time_t start,
+                          time_t end,
+                          PVREpgSyncState& state);
+};
+
+} // namespace PVR
@@ -19,6 +19,18 @@ using namespace PVR;
 namespace
 {
 const CDateTimeSpan ONE_SECOND(0, 0, 0, 1);
+
+time_t ToTime(const CDateTime& dateTime)
+{
+  time_t time = 0;
+  dateTime.GetAsTime(time);
+  return time;
+}
+
+CDateTime FromTime(time_t time)
+{
+  return time > 0 ? CDateTime(time) : CDateTime();
+}
 }
 
 CPVREpgTagsContainer::CPVREpgTagsContainer(int iEpgID,
@@ -38,6 +50,8 @@ void CPVREpgTagsContainer::SetEpgID(int iEpgID)
   m_iEpgID = iEpgID;
   for (const auto& tag : m_changedTags)
     tag.second->SetEpgID(iEpgID);
+
+  m_bTimelineIndexLoaded = false;
 }
 
 void CPVREpgTagsContainer::SetChannelData(const std::shared_ptr<CPVREpgChannelData>& data)
@@ -130,16 +144,30 @@ bool FixOverlap(const std::shared_ptr<CPVREpgInfoTag>& previousTag,
 
 bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
 {
-  if (tags.m_changedTags.empty())
+  if (tags.m_changedTags.empty() && tags.m_deletedTags.empty())
     return false;
 
+  // apply deletions reported by an incremental update first, events may have been replaced
+  for (const auto& tagsEntry : tags.m_deletedTags)
+  {
+    const std::shared_ptr<CPVREpgInfoTag> existingTag =
+        GetTag(tagsEntry.second->UniqueBroadcastID());
+    if (existingTag)
+      DeleteEntry(existingTag);
+  }
+
+  if (tags.m_changedTags.empty())
+    return true;
+
   if (m_database)
   {
     const CDateTime minEventEnd = (*tags.m_changedTags.cbegin()).second->StartAsUTC() + ONE_SECOND;
     const CDateTime maxEventStart = (*tags.m_changedTags.crbegin()).second->EndAsUTC();
 
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> existingTags =
-        m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> existingTags;
+    if (GetTimelineIndex().HasEventsBetween(ToTime(minEventEnd), ToTime(maxEventStart)))
+      existingTags =
+          m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
 
     if (!m_changedTags.empty())
     {
@@ -320,7 +348,10 @@ void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
   }
 
   if (m_database)
+  {
     m_database->DeleteEpgTags(m_iEpgID, time);
+    m_timelineIndex.EraseEndedBefore(ToTime(time));
+  }
 }
 
 void CPVREpgTagsContainer::Clear()
@@ -334,18 +365,28 @@ bool CPVREpgTagsContainer::IsEmpty() const
     return false;
 
   if (m_database)
-    return !m_database->GetFirstStartTime(m_iEpgID).IsValid();
+    return GetTimelineIndex().IsEmpty();
 
   return true;
 }
 
+const CPVREpgTimelineIndex& CPVREpgTagsContainer::GetTimelineIndex() const
+{
+  if (!m_bTimelineIndexLoaded)
+  {
+    m_timelineIndex.Reset(m_database->GetAllEpgTagTimes(m_iEpgID));
+    m_bTimelineIndexLoaded = true;
+  }
+  return m_timelineIndex;
+}
+
 std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetTag(const CDateTime& startTime) const
 {
   const auto it = m_changedTags.find(startTime);
   if (it != m_changedTags.cend())
     return (*it).second;
 
-  if (m_database)
+  if (m_database && GetTimelineIndex().HasEvent(ToTime(startTime)))
     return CreateEntry(m_database->GetEpgTagByStartTime(m_iEpgID, startTime));
 
   return {};
@@ -399,7 +440,7 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetTagBetween(const CDateT
     }
   }
 
-  if (m_database)
+  if (m_database && GetTimelineIndex().HasEventWithin(ToTime(start), ToTime(end)))
   {
     const std::vector<std::shared_ptr<CPVREpgInfoTag>> tags =
         CreateEntries(m_database->GetEpgTagsByMinStartMaxEndTime(m_iEpgID, start, end));
@@ -445,8 +486,9 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
   if (m_database)
   {
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    const CPVREpgTimelineIndex& index = GetTimelineIndex();
 
-    if (!m_changedTags.empty() && !m_database->GetFirstStartTime(m_iEpgID).IsValid())
+    if (!m_changedTags.empty() && index.IsEmpty())
     {
       // nothing in the db yet. take what we have in memory.
       for (const auto& tag : m_changedTags)
@@ -460,7 +502,9 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     }
     else
     {
-      tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
+      // only ask the db if it has anything in the requested range
+      if (index.HasEventsBetween(ToTime(minEventEnd), ToTime(maxEventStart)))
+        tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
 
       if (!m_changedTags.empty())
       {
@@ -501,11 +545,11 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     if (result.empty())
     {
       // create single gap tag
-      CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+      CDateTime maxEnd = FromTime(index.GetMaxEndTime(ToTime(minEventEnd)));
       if (!maxEnd.IsValid() || maxEnd < timelineStart)
         maxEnd = timelineStart;
 
-      CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+      CDateTime minStart = FromTime(index.GetMinStartTime(ToTime(maxEventStart)));
       if (!minStart.IsValid() || minStart > timelineEnd)
         minStart = timelineEnd;
 
@@ -516,7 +560,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.front()->StartAsUTC() > minEventEnd)
       {
         // prepend gap tag
-        CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+        CDateTime maxEnd = FromTime(index.GetMaxEndTime(ToTime(minEventEnd)));
         if (!maxEnd.IsValid() || maxEnd < timelineStart)
           maxEnd = timelineStart;
 
@@ -526,7 +570,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.back()->EndAsUTC() < maxEventStart)
       {
         // append gap tag
-        CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+        CDateTime minStart = FromTime(index.GetMinStartTime(ToTime(maxEventStart)));
         if (!minStart.IsValid() || minStart > timelineEnd)
           minStart = timelineEnd;
 
@@ -545,7 +589,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetAllTags()
   if (m_database)
   {
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-    if (!m_changedTags.empty() && !m_database->GetFirstStartTime(m_iEpgID).IsValid())
+    if (!m_changedTags.empty() && GetTimelineIndex().IsEmpty())
     {
       // nothing in the db yet. take what we have in memory.
       for (const auto& tag : m_changedTags)
@@ -582,7 +626,7 @@ CDateTime CPVREpgTagsContainer::GetFirstStartTime() const
 
   if (m_database)
   {
-    const CDateTime dbResult = m_database->GetFirstStartTime(m_iEpgID);
+    const CDateTime dbResult = FromTime(GetTimelineIndex().GetFirstStartTime());
     if (!result.IsValid() || (dbResult.IsValid() && dbResult < result))
       result = dbResult;
   }
@@ -599,7 +643,7 @@ CDateTime CPVREpgTagsContainer::GetLastEndTime() const
 
   if (m_database)
   {
-    const CDateTime dbResult = m_database->GetLastEndTime(m_iEpgID);
+    const CDateTime dbResult = FromTime(GetTimelineIndex().GetLastEndTime());
     if (result.IsValid() || (dbResult.IsValid() && dbResult > result))
       result = dbResult;
   }
@@ -622,21 +666,34 @@ void CPVREpgTagsContainer::QueuePersistQuery()
                 m_changedTags.size(), m_deletedTags.size());
 
     for (const auto& tag : m_deletedTags)
-      m_database->QueueDeleteTagQuery(*tag.second);
+    {
+      if (m_database->QueueDeleteTagQuery(*tag.second))
+        m_timelineIndex.Erase(ToTime(tag.second->StartAsUTC()));
+    }
 
     m_deletedTags.clear();
 
     FixOverlappingEvents(m_changedTags);
 
+    std::vector<std::pair<CDateTime, CDateTime>> conflictingRanges;
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    conflictingRanges.reserve(m_changedTags.size());
+    tags.reserve(m_changedTags.size());
+
     for (const auto& tag : m_changedTags)
     {
       // remove any conflicting events from database before persisting the new event
-      m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
-          m_iEpgID, tag.second->StartAsUTC() + ONE_SECOND, tag.second->EndAsUTC() - ONE_SECOND);
+      conflictingRanges.emplace_back(tag.second->StartAsUTC() + ONE_SECOND,
+                                     tag.second->EndAsUTC() - ONE_SECOND);
+      tags.emplace_back(tag.second);
 
-      tag.second->QueuePersistQuery(m_database);
+      if (m_bTimelineIndexLoaded)
+        m_timelineIndex.Insert(ToTime(tag.second->StartAsUTC()), ToTime(tag.second->EndAsUTC()));
     }
 
+    m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(m_iEpgID, conflictingRanges);
+    m_database->QueuePersistQuery(tags);
+
     m_changedTags.clear();
 
     m_database->Unlock();
@@ -648,5 +705,8 @@ void CPVREpgTagsContainer::QueueDelete()
   if (m_database)
     m_database->QueueDeleteEpgTags(m_iEpgID);
 
+  m_timelineIndex.Clear();
+  m_bTimelineIndexLoaded = true;
+
   Clear();
 }
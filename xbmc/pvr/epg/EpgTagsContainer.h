@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/epg/EpgTimelineIndex.h"
 
 #include <map>
 #include <memory>
@@ -206,6 +207,12 @@ private:
   void FixOverlappingEvents(std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
   void FixOverlappingEvents(std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>>& tags) const;
 
+  /*!
+   * @brief Get the timeline index of the persisted tags, load it from the database if needed.
+   * @return The index.
+   */
+  const CPVREpgTimelineIndex& GetTimelineIndex() const;
+
   int m_iEpgID = 0;
   std::shared_ptr<CPVREpgChannelData> m_channelData;
   const std::shared_ptr<CPVREpgDatabase> m_database;
@@ -213,6 +220,9 @@ private:
 
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_changedTags;
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_deletedTags;
+
+  mutable CPVREpgTimelineIndex m_timelineIndex;
+  mutable bool m_bTimelineIndexLoaded = false;
 };
 
 } // namespace PVR
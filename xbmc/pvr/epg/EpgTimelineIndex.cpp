@@ -0,0 +1,147 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgTimelineIndex.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+void CPVREpgTimelineIndex::Reset(std::vector<std::pair<time_t, time_t>> events)
+{
+  m_events.clear();
+  m_events.reserve(events.size());
+  m_maxDuration = 0;
+
+  for (const auto& event : events)
+  {
+    m_events.push_back({event.first, event.second});
+    m_maxDuration = std::max(m_maxDuration, event.second - event.first);
+  }
+}
+
+void CPVREpgTimelineIndex::Clear()
+{
+  m_events.clear();
+  m_maxDuration = 0;
+}
+
+std::vector<CPVREpgTimelineIndex::Event>::const_iterator CPVREpgTimelineIndex::LowerBound(
+    time_t start) const
+{
+  return std::lower_bound(m_events.cbegin(), m_events.cend(), start,
+                          [](const Event& event, time_t time) { return event.start < time; });
+}
+
+time_t CPVREpgTimelineIndex::GetFirstStartTime() const
+{
+  return m_events.empty() ? 0 : m_events.front().start;
+}
+
+time_t CPVREpgTimelineIndex::GetLastEndTime() const
+{
+  time_t result = 0;
+  for (auto it = m_events.crbegin(); it != m_events.crend(); ++it)
+  {
+    // no event starting before this one can end after the result
+    if (it->start + m_maxDuration <= result)
+      break;
+
+    result = std::max(result, it->end);
+  }
+  return result;
+}
+
+bool CPVREpgTimelineIndex::HasEvent(time_t start) const
+{
+  const auto it = LowerBound(start);
+  return it != m_events.cend() && it->start == start;
+}
+
+bool CPVREpgTimelineIndex::HasEventsBetween(time_t minEnd, time_t maxStart) const
+{
+  for (auto it = LowerBound(minEnd - m_maxDuration); it != m_events.cend() && it->start <= maxStart;
+       ++it)
+  {
+    if (it->end >= minEnd)
+      return true;
+  }
+  return false;
+}
+
+bool CPVREpgTimelineIndex::HasEventWithin(time_t minStart, time_t maxEnd) const
+{
+  for (auto it = LowerBound(minStart); it != m_events.cend() && it->start <= maxEnd; ++it)
+  {
+    if (it->end <= maxEnd)
+      return true;
+  }
+  return false;
+}
+
+time_t CPVREpgTimelineIndex::GetMinStartTime(time_t minStart) const
+{
+  const auto it = LowerBound(minStart + 1);
+  return it != m_events.cend() ? it->start : 0;
+}
+
+time_t CPVREpgTimelineIndex::GetMaxEndTime(time_t maxEnd) const
+{
+  time_t result = 0;
+  bool bFound = false;
+
+  // events ending at or before maxEnd must also start at or before maxEnd
+  for (auto it = LowerBound(maxEnd + 1); it != m_events.cbegin();)
+  {
+    --it;
+
+    // no event starting before this one can end after the result
+    if (bFound && it->start + m_maxDuration <= result)
+      break;
+
+    if (it->end <= maxEnd && (!bFound || it->end > result))
+    {
+      result = it->end;
+      bFound = true;
+    }
+  }
+  return result;
+}
+
+void CPVREpgTimelineIndex::Insert(time_t start, time_t end)
+{
+  // Same semantics as the database: erase all events overlapping the new one, then replace any
+  // event with the same start time.
+  const auto first = m_events.begin() + (LowerBound(start + 1 - m_maxDuration) - m_events.cbegin());
+  const auto last = m_events.begin() + (LowerBound(std::max(end, start + 1)) - m_events.cbegin());
+  m_events.erase(std::remove_if(first, last,
+                                [start, end](const Event& event) {
+                                  return (event.end > start && event.start < end) ||
+                                         event.start == start;
+                                }),
+                 last);
+
+  m_events.insert(m_events.begin() + (LowerBound(start) - m_events.cbegin()), {start, end});
+  m_maxDuration = std::max(m_maxDuration, end - start);
+}
+
+void CPVREpgTimelineIndex::Erase(time_t start)
+{
+  const auto it = LowerBound(start);
+  if (it != m_events.cend() && it->start == start)
+    m_events.erase(it);
+}
+
+void CPVREpgTimelineIndex::EraseEndedBefore(time_t time)
+{
+  // events ending before the given time must also start before it
+  const auto last = m_events.begin() + (LowerBound(time) - m_events.cbegin());
+  m_events.erase(std::remove_if(m_events.begin(), last,
+                                [time](const Event& event) { return event.end < time; }),
+                 last);
+}
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+
+/*!
+ * @brief Compact, start time ordered index of the events of one EPG. It holds start and end times
+ * only and answers the time range queries needed to build EPG timelines in O(log n), so that the
+ * database only needs to be asked for the event data actually displayed.
+ */
+class CPVREpgTimelineIndex
+{
+public:
+  /*!
+   * @brief Replace the contents of the index.
+   * @param events Pairs of start and end time, ordered by start time.
+   */
+  void Reset(std::vector<std::pair<time_t, time_t>> events);
+
+  /*!
+   * @brief Remove all events from the index.
+   */
+  void Clear();
+
+  /*!
+   * @brief Check whether the index contains any events.
+   * @return True if the index is empty, false otherwise.
+   */
+  bool IsEmpty() const { return m_events.empty(); }
+
+  /*!
+   * @brief Get the number of events in the index.
+   * @return The number of events.
+   */
+  size_t Size() const { return m_events.size(); }
+
+  /*!
+   * @brief Get the start time of the first event.
+   * @return The time or 0 if the index is empty.
+   */
+  time_t GetFirstStartTime() const;
+
+  /*!
+   * @brief Get the end time of the last ending event.
+   * @return The time or 0 if the index is empty.
+   */
+  time_t GetLastEndTime() const;
+
+  /*!
+   * @brief Check whether an event with the given start time exists.
+   * @param start The start time.
+   * @return True if such an event exists, false otherwise.
+   */
+  bool HasEvent(time_t start) const;
+
+  /*!
+   * @brief Check whether an event exists that ends at or after minEnd and starts at or before
+   * maxStart.
+   * @param minEnd The minimum end time.
+   * @param maxStart The maximum start time.
+   * @return True if such an event exists, false otherwise.
+   */
+  bool HasEventsBetween(time_t minEnd, time_t maxStart) const;
+
+  /*!
+   * @brief Check whether an event exists that starts at or after minStart and ends at or before
+   * maxEnd.
+   * @param minStart The minimum start time.
+   * @param maxEnd The maximum end time.
+   * @return True if such an event exists, false otherwise.
+   */
+  bool HasEventWithin(time_t minStart, time_t maxEnd) const;
+
+  /*!
+   * @brief Get the earliest start time after the given time.
+   * @param minStart The time.
+   * @return The start time or 0 if no event starts after the given time.
+   */
+  time_t GetMinStartTime(time_t minStart) const;
+
+  /*!
+   * @brief Get the latest end time at or before the given time.
+   * @param maxEnd The time.
+   * @return The end time or 0 if no event ends at or before the given time.
+   */
+  time_t GetMaxEndTime(time_t maxEnd) const;
+
+  /*!
+   * @brief Add an event, replacing all events it overlaps and any event with the same start time.
+   * @param start The start time of the event.
+   * @param end The end time of the event.
+   */
+  void Insert(time_t start, time_t end);
+
+  /*!
+   * @brief Remove the event with the given start time.
+   * @param start The start time.
+   */
+  void Erase(time_t start);
+
+  /*!
+   * @brief Remove all events that ended before the given time.
+   * @param time The time.
+   */
+  void EraseEndedBefore(time_t time);
+
+private:
+  struct Event
+  {
+    time_t start;
+    time_t end;
+  };
+
+  std::vector<Event>::const_iterator LowerBound(time_t start) const;
+
+  std::vector<Event> m_events;
+  time_t m_maxDuration = 0; // upper bound for the duration of the events, used to limit range scans
+};
+
+} // namespace PVR
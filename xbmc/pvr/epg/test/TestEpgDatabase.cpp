@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "filesystem/SpecialProtocol.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchData.h"
+#include "settings/AdvancedSettings.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int EPG_ID = 1;
+
+std::shared_ptr<CPVREpgInfoTag> CreateTag(unsigned int iUid,
+                                          const char* strTitle,
+                                          const char* strEpisodeName,
+                                          const char* strPlot)
+{
+  EPG_TAG data = {};
+  data.iUniqueBroadcastId = iUid;
+  data.startTime = 1600000000 + iUid * 3600;
+  data.endTime = data.startTime + 3600;
+  data.strTitle = strTitle;
+  data.strEpisodeName = strEpisodeName;
+  data.strPlot = strPlot;
+  data.iGenreType = EPG_GENRE_USE_STRING;
+  data.strGenreDescription = "Test";
+  return std::make_shared<CPVREpgInfoTag>(data, -1, nullptr, EPG_ID);
+}
+} // unnamed namespace
+
+class TestEpgDatabase : public ::testing::Test
+{
+protected:
+  DatabaseSettings settings;
+  CPVREpgDatabase database;
+
+  void SetUp() override
+  {
+    settings.type = "sqlite3";
+    settings.name = "testepg";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+
+    ASSERT_TRUE(database.Connect("testepg", settings, true));
+    database.DeleteEpg();
+
+    ASSERT_TRUE(database.QueuePersistQuery(
+        {CreateTag(1, "Doctor Who", "", "The doctor travels in time."),
+         CreateTag(2, "The News", "Late edition", "News of the day."),
+         CreateTag(3, "Football", "", "Doctor Who star visits a match."),
+         CreateTag(4, "Sports", "Doctors in sports", "")}));
+    ASSERT_TRUE(database.CommitPersistQueries());
+  }
+
+  void TearDown() override
+  {
+    database.DeleteEpg();
+    database.Close();
+  }
+
+  std::vector<std::string> Search(const std::string& strTerm, bool bSearchInDescription)
+  {
+    PVREpgSearchData searchData;
+    searchData.m_strSearchTerm = strTerm;
+    searchData.m_bSearchInDescription = bSearchInDescription;
+    searchData.m_startDateTime.SetDateTime(2000, 1, 1, 0, 0, 0);
+    searchData.m_endDateTime.SetDateTime(2100, 1, 1, 0, 0, 0);
+
+    std::vector<std::string> titles;
+    for (const auto& tag : database.GetEpgTags(searchData))
+      titles.emplace_back(tag->Title());
+    return titles;
+  }
+};
+
+TEST_F(TestEpgDatabase, SearchTitle)
+{
+  EXPECT_EQ(Search("who", false), std::vector<std::string>({"Doctor Who"}));
+  EXPECT_EQ(Search("NEWS", false), std::vector<std::string>({"The News"}));
+}
+
+TEST_F(TestEpgDatabase, SearchEpisodeName)
+{
+  EXPECT_EQ(Search("late", false), std::vector<std::string>({"The News"}));
+}
+
+TEST_F(TestEpgDatabase, SearchPartOfWord)
+{
+  // "Doctors" starts with the term, "Doctor Who" contains it as a word
+  EXPECT_EQ(Search("doctor", false), std::vector<std::string>({"Doctor Who", "Sports"}));
+
+  // like without the index, the term may be any part of a word
+  EXPECT_EQ(Search("ball", false), std::vector<std::string>({"Football"}));
+  EXPECT_EQ(Search("OOTB", false), std::vector<std::string>({"Football"}));
+}
+
+TEST_F(TestEpgDatabase, SearchShortTerm)
+{
+  // too short for the index, answered by scanning the tags
+  EXPECT_EQ(Search("ws", false), std::vector<std::string>({"The News"}));
+}
+
+TEST_F(TestEpgDatabase, SearchRanked)
+{
+  // title before episode name before plot
+  EXPECT_EQ(Search("doctor", true),
+            std::vector<std::string>({"Doctor Who", "Sports", "Football"}));
+}
+
+TEST_F(TestEpgDatabase, SearchPhrase)
+{
+  // the phrase is verified against the texts, the index only finds the candidates
+  EXPECT_EQ(Search("\"ctor who\"", true),
+            std::vector<std::string>({"Doctor Who", "Football"}));
+  EXPECT_TRUE(Search("\"who doctor\"", true).empty());
+}
+
+TEST_F(TestEpgDatabase, SearchWithoutIndex)
+{
+  // wildcards are answered by scanning the tags
+  EXPECT_EQ(Search("oo%ball", false), std::vector<std::string>({"Football"}));
+}
+
+TEST_F(TestEpgDatabase, SearchAfterDelete)
+{
+  const auto tag = database.GetEpgTagByUniqueBroadcastID(EPG_ID, 2);
+  ASSERT_NE(tag, nullptr);
+  ASSERT_TRUE(database.QueueDeleteTagQuery(*tag));
+  ASSERT_TRUE(database.CommitPersistQueries());
+
+  EXPECT_TRUE(Search("news", false).empty());
+}
+
+TEST_F(TestEpgDatabase, PersistIsAtomic)
+{
+  const auto tag = database.GetEpgTagByUniqueBroadcastID(EPG_ID, 2);
+  ASSERT_NE(tag, nullptr);
+  ASSERT_TRUE(database.QueueDeleteTagQuery(*tag));
+  ASSERT_TRUE(database.QueueInsertQuery("INSERT INTO missingtable (iValue) VALUES (1)"));
+  EXPECT_FALSE(database.CommitPersistQueries());
+
+  // the delete was rolled back with the failed insert
+  EXPECT_NE(database.GetEpgTagByUniqueBroadcastID(EPG_ID, 2), nullptr);
+  EXPECT_EQ(Search("news", false), std::vector<std::string>({"The News"}));
+
+  // and the failed queries are gone
+  EXPECT_TRUE(database.CommitPersistQueries());
+}
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgSearchIndex.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+TEST(TestEpgSearchIndex, GetWords)
+{
+  const auto words = CPVREpgSearchIndex::GetWords("Doctor Who", "", " The\tDoctor\n falls ", "");
+
+  EXPECT_EQ(words.size(), 4U);
+  EXPECT_EQ(words.at("doctor"), 5);
+  EXPECT_EQ(words.at("who"), 4);
+  EXPECT_EQ(words.at("the"), 1);
+  EXPECT_EQ(words.at("falls"), 1);
+}
+
+TEST(TestEpgSearchIndex, GetWordsWeights)
+{
+  const auto words = CPVREpgSearchIndex::GetWords("news", "news", "news", "news");
+
+  ASSERT_EQ(words.size(), 1U);
+  EXPECT_EQ(words.at("news"), 8);
+}
+
+TEST(TestEpgSearchIndex, GetWordsEmpty)
+{
+  EXPECT_TRUE(CPVREpgSearchIndex::GetWords("", " ", "\t", "").empty());
+}
+
+TEST(TestEpgSearchIndex, GetWordsKeepsNonAscii)
+{
+  const auto words = CPVREpgSearchIndex::GetWords("\xC3\x84RGER", "", "", "");
+
+  ASSERT_EQ(words.size(), 1U);
+  EXPECT_EQ(words.begin()->first, "\xC3\x84rger");
+}
+
+TEST(TestEpgSearchIndex, GetIndexWordTruncatesLongWords)
+{
+  // 'a' followed by two byte sequences, the limit falls into the middle of one of them
+  std::string strWord("a");
+  while (strWord.size() < 2 * CPVREpgSearchIndex::MAX_WORD_LENGTH)
+    strWord += "\xC3\xA4";
+
+  const std::string strIndexWord = CPVREpgSearchIndex::GetIndexWord(strWord);
+  EXPECT_EQ(strIndexWord.size(), CPVREpgSearchIndex::MAX_WORD_LENGTH - 1);
+  EXPECT_EQ(strIndexWord, strWord.substr(0, CPVREpgSearchIndex::MAX_WORD_LENGTH - 1));
+
+  EXPECT_EQ(CPVREpgSearchIndex::GetIndexWord("doctor"), "doctor");
+}
+
+TEST(TestEpgSearchIndex, GetSuffixes)
+{
+  EXPECT_EQ(CPVREpgSearchIndex::GetSuffixes("doctor"),
+            std::set<std::string>({"doctor", "octor", "ctor", "tor"}));
+  EXPECT_TRUE(CPVREpgSearchIndex::GetSuffixes("tv").empty());
+}
+
+TEST(TestEpgSearchIndex, GetSuffixesKeepsCharacters)
+{
+  // the suffixes start at characters, not in the middle of a two byte sequence
+  EXPECT_EQ(CPVREpgSearchIndex::GetSuffixes("\xC3\xA4rger"),
+            std::set<std::string>({"\xC3\xA4rger", "rger", "ger"}));
+}
+
+TEST(TestEpgSearchIndex, GetSuffixesTruncatesLongWords)
+{
+  const std::string strWord(2 * CPVREpgSearchIndex::MAX_WORD_LENGTH, 'x');
+  const auto suffixes = CPVREpgSearchIndex::GetSuffixes(strWord);
+
+  ASSERT_FALSE(suffixes.empty());
+  EXPECT_EQ(suffixes.begin()->size(), CPVREpgSearchIndex::MIN_LOOKUP_LENGTH);
+  EXPECT_EQ(suffixes.rbegin()->size(), CPVREpgSearchIndex::MAX_WORD_LENGTH);
+}
+
+TEST(TestEpgSearchIndex, GetLookupWordSingleWord)
+{
+  std::string strWord;
+  EXPECT_TRUE(CPVREpgSearchIndex::GetLookupWord("Doctor", strWord));
+  EXPECT_EQ(strWord, "doctor");
+}
+
+TEST(TestEpgSearchIndex, GetLookupWordPhrase)
+{
+  // any piece is a part of a word, the longest one is looked up
+  std::string strWord;
+  EXPECT_TRUE(CPVREpgSearchIndex::GetLookupWord("octorlongword who", strWord));
+  EXPECT_EQ(strWord, "octorlongword");
+
+  EXPECT_TRUE(CPVREpgSearchIndex::GetLookupWord("the doctor wh", strWord));
+  EXPECT_EQ(strWord, "doctor");
+}
+
+TEST(TestEpgSearchIndex, GetLookupWordUnsupported)
+{
+  std::string strWord;
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("", strWord));
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("  ", strWord));
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("50%", strWord));
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("a_b", strWord));
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("a\\b", strWord));
+
+  // shorter than the indexed suffixes
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("tv", strWord));
+  EXPECT_FALSE(CPVREpgSearchIndex::GetLookupWord("a tv", strWord));
+}
+
+TEST(TestEpgSearchIndex, GetLookupWordMatchesSuffix)
+{
+  // a long search word in the middle of a longer word finds one of its suffixes
+  const std::string strTerm(2 * CPVREpgSearchIndex::MAX_WORD_LENGTH, 'x');
+  const auto suffixes = CPVREpgSearchIndex::GetSuffixes("foo" + strTerm + "bar");
+
+  std::string strWord;
+  ASSERT_TRUE(CPVREpgSearchIndex::GetLookupWord(strTerm, strWord));
+  EXPECT_TRUE(std::any_of(suffixes.begin(), suffixes.end(), [&strWord](const std::string& suffix) {
+    return suffix.compare(0, strWord.size(), strWord) == 0;
+  }));
+}
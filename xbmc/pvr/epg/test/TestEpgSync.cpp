@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgSync.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+// Stub of a PVR client serving the EPG of one channel, recording the requests made by Kodi.
+class CStubEpgSource : public IPVREpgSyncSource
+{
+public:
+  struct Request
+  {
+    time_t start;
+    time_t end;
+    std::string strSinceToken; // "-" for full fetches
+  };
+
+  PVR_ERROR GetEPG(time_t start, time_t end) override
+  {
+    m_requests.push_back({start, end, "-"});
+    return m_fullError;
+  }
+
+  PVR_ERROR GetEPGChanges(time_t start,
+                          time_t end,
+                          const std::string& strSinceToken,
+                          std::string& strNewToken) override
+  {
+    m_requests.push_back({start, end, strSinceToken});
+
+    if (!m_bSupportsChanges)
+      return PVR_ERROR_NOT_IMPLEMENTED;
+
+    if (!strSinceToken.empty() && strSinceToken != m_strValidToken)
+      return PVR_ERROR_INVALID_PARAMETERS;
+
+    strNewToken = m_strNextToken;
+    return PVR_ERROR_NO_ERROR;
+  }
+
+  bool m_bSupportsChanges = true;
+  std::string m_strValidToken = "1";
+  std::string m_strNextToken = "2";
+  PVR_ERROR m_fullError = PVR_ERROR_NO_ERROR;
+  std::vector<Request> m_requests;
+};
+} // unnamed namespace
+
+TEST(TestEpgSync, FallsBackToFullFetch)
+{
+  CStubEpgSource source;
+  source.m_bSupportsChanges = false;
+  PVREpgSyncState state;
+
+  EXPECT_EQ(CPVREpgSync::Update(source, 100, 200, state), PVR_ERROR_NO_ERROR);
+
+  ASSERT_EQ(source.m_requests.size(), 2u);
+  EXPECT_EQ(source.m_requests[1].strSinceToken, "-");
+  EXPECT_EQ(source.m_requests[1].start, 100);
+  EXPECT_EQ(source.m_requests[1].end, 200);
+  EXPECT_FALSE(state.IsValid());
+}
+
+TEST(TestEpgSync, InitialSyncObtainsToken)
+{
+  CStubEpgSource source;
+  PVREpgSyncState state;
+
+  EXPECT_EQ(CPVREpgSync::Update(source, 100, 200, state), PVR_ERROR_NO_ERROR);
+
+  ASSERT_EQ(source.m_requests.size(), 1u);
+  EXPECT_EQ(source.m_requests[0].strSinceToken, "");
+  EXPECT_EQ(state.strToken, "2");
+  EXPECT_EQ(state.end, 200);
+}
+
+TEST(TestEpgSync, IncrementalSync)
+{
+  CStubEpgSource source;
+  PVREpgSyncState state;
+  state.strToken = "1";
+  state.end = 200;
+
+  EXPECT_EQ(CPVREpgSync::Update(source, 150, 260, state), PVR_ERROR_NO_ERROR);
+
+  // changes of the synced part, then all events of the new part of the time frame
+  ASSERT_EQ(source.m_requests.size(), 2u);
+  EXPECT_EQ(source.m_requests[0].strSinceToken, "1");
+  EXPECT_EQ(source.m_requests[0].start, 150);
+  EXPECT_EQ(source.m_requests[0].end, 200);
+  EXPECT_EQ(source.m_requests[1].strSinceToken, "-");
+  EXPECT_EQ(source.m_requests[1].start, 200);
+  EXPECT_EQ(source.m_requests[1].end, 260);
+  EXPECT_EQ(state.strToken, "2");
+  EXPECT_EQ(state.end, 260);
+}
+
+TEST(TestEpgSync, RejectedTokenTriggersFullSync)
+{
+  CStubEpgSource source;
+  PVREpgSyncState state;
+  state.strToken = "0";
+  state.end = 200;
+
+  EXPECT_EQ(CPVREpgSync::Update(source, 100, 200, state), PVR_ERROR_NO_ERROR);
+
+  ASSERT_EQ(source.m_requests.size(), 2u);
+  EXPECT_EQ(source.m_requests[1].strSinceToken, "");
+  EXPECT_EQ(state.strToken, "2");
+}
+
+TEST(TestEpgSync, OutdatedStateTriggersFullSync)
+{
+  CStubEpgSource source;
+  PVREpgSyncState state;
+  state.strToken = "1";
+  state.end = 100;
+
+  EXPECT_EQ(CPVREpgSync::Update(source, 150, 250, state), PVR_ERROR_NO_ERROR);
+
+  ASSERT_EQ(source.m_requests.size(), 1u);
+  EXPECT_EQ(source.m_requests[0].strSinceToken, "");
+  EXPECT_EQ(state.end, 250);
+}
+
+TEST(TestEpgSync, FailureResetsState)
+{
+  CStubEpgSource source;
+  source.m_fullError = PVR_ERROR_SERVER_ERROR;
+  PVREpgSyncState state;
+  state.strToken = "1";
+  state.end = 200;
+
+  EXPECT_EQ(CPVREpgSync::Update(source, 100, 300, state), PVR_ERROR_SERVER_ERROR);
+  EXPECT_FALSE(state.IsValid());
+}
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgTimelineIndex.h"
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+CPVREpgTimelineIndex CreateIndex()
+{
+  CPVREpgTimelineIndex index;
+  index.Reset({{100, 200}, {200, 300}, {400, 1000}, {1000, 1100}});
+  return index;
+}
+} // unnamed namespace
+
+TEST(TestEpgTimelineIndex, Empty)
+{
+  CPVREpgTimelineIndex index;
+
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_EQ(index.GetFirstStartTime(), 0);
+  EXPECT_EQ(index.GetLastEndTime(), 0);
+  EXPECT_FALSE(index.HasEventsBetween(0, 1000));
+  EXPECT_EQ(index.GetMinStartTime(0), 0);
+  EXPECT_EQ(index.GetMaxEndTime(1000), 0);
+}
+
+TEST(TestEpgTimelineIndex, FirstAndLast)
+{
+  const CPVREpgTimelineIndex index = CreateIndex();
+
+  EXPECT_FALSE(index.IsEmpty());
+  EXPECT_EQ(index.Size(), 4u);
+  EXPECT_EQ(index.GetFirstStartTime(), 100);
+  EXPECT_EQ(index.GetLastEndTime(), 1100);
+}
+
+TEST(TestEpgTimelineIndex, HasEvent)
+{
+  const CPVREpgTimelineIndex index = CreateIndex();
+
+  EXPECT_TRUE(index.HasEvent(200));
+  EXPECT_FALSE(index.HasEvent(250));
+}
+
+TEST(TestEpgTimelineIndex, HasEventsBetween)
+{
+  const CPVREpgTimelineIndex index = CreateIndex();
+
+  // the long event starting at 400 covers the whole range
+  EXPECT_TRUE(index.HasEventsBetween(500, 600));
+  // gap between 300 and 400
+  EXPECT_FALSE(index.HasEventsBetween(301, 399));
+  // bounds are inclusive
+  EXPECT_TRUE(index.HasEventsBetween(300, 300));
+  EXPECT_TRUE(index.HasEventsBetween(350, 400));
+  EXPECT_FALSE(index.HasEventsBetween(1101, 2000));
+}
+
+TEST(TestEpgTimelineIndex, HasEventWithin)
+{
+  const CPVREpgTimelineIndex index = CreateIndex();
+
+  EXPECT_TRUE(index.HasEventWithin(150, 300));
+  EXPECT_FALSE(index.HasEventWithin(150, 299));
+  EXPECT_FALSE(index.HasEventWithin(300, 999));
+}
+
+TEST(TestEpgTimelineIndex, MinStartMaxEnd)
+{
+  const CPVREpgTimelineIndex index = CreateIndex();
+
+  EXPECT_EQ(index.GetMinStartTime(200), 400);
+  EXPECT_EQ(index.GetMinStartTime(1000), 0);
+  EXPECT_EQ(index.GetMaxEndTime(999), 300);
+  EXPECT_EQ(index.GetMaxEndTime(1000), 1000);
+  EXPECT_EQ(index.GetMaxEndTime(99), 0);
+}
+
+TEST(TestEpgTimelineIndex, InsertReplacesOverlappingEvents)
+{
+  CPVREpgTimelineIndex index = CreateIndex();
+
+  index.Insert(150, 250);
+
+  EXPECT_EQ(index.Size(), 3u);
+  EXPECT_FALSE(index.HasEvent(100));
+  EXPECT_FALSE(index.HasEvent(200));
+  EXPECT_TRUE(index.HasEvent(150));
+  EXPECT_EQ(index.GetMinStartTime(150), 400);
+
+  // adjacent events do not overlap
+  index.Insert(250, 400);
+  EXPECT_EQ(index.Size(), 4u);
+  EXPECT_EQ(index.GetMaxEndTime(300), 250);
+}
+
+TEST(TestEpgTimelineIndex, InsertReplacesSameStart)
+{
+  CPVREpgTimelineIndex index = CreateIndex();
+
+  index.Insert(1000, 1000);
+
+  EXPECT_EQ(index.Size(), 4u);
+  EXPECT_EQ(index.GetLastEndTime(), 1000);
+}
+
+TEST(TestEpgTimelineIndex, Erase)
+{
+  CPVREpgTimelineIndex index = CreateIndex();
+
+  index.Erase(400);
+  index.Erase(401);
+
+  EXPECT_EQ(index.Size(), 3u);
+  EXPECT_FALSE(index.HasEventsBetween(500, 600));
+
+  index.EraseEndedBefore(1000);
+  EXPECT_EQ(index.Size(), 1u);
+  EXPECT_EQ(index.GetFirstStartTime(), 1000);
+
+  index.Clear();
+  EXPECT_TRUE(index.IsEmpty());
+}
@@ -15,17 +15,165 @@
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 using namespace PVR;
 
 static const unsigned int GRID_START_PADDING = 30; // minutes
 
+class CGUIEPGGridContainerModel::CTimelinePrefetcher
+  : public std::enable_shared_from_this<CTimelinePrefetcher>
+{
+public:
+  /*!
+   * @brief Fetch the timelines of the given channels in the background, unless already done.
+   * @param channels The channels, along with their index in the grid.
+   * @param gridStart The start of the grid.
+   * @param gridEnd The end of the grid.
+   * @param firstBlock The first block to fetch the timelines for.
+   * @param lastBlock The last block to fetch the timelines for.
+   * @param minEventEnd The minimum end time of the events to fetch.
+   * @param maxEventStart The maximum start time of the events to fetch.
+   */
+  void Request(const std::vector<std::pair<int, std::shared_ptr<CPVRChannel>>>& channels,
+               const CDateTime& gridStart,
+               const CDateTime& gridEnd,
+               int firstBlock,
+               int lastBlock,
+               const CDateTime& minEventEnd,
+               const CDateTime& maxEventStart)
+  {
+    std::vector<std::pair<int, std::shared_ptr<CPVRChannel>>> missing;
+    unsigned int generation;
+    {
+      CSingleLock lock(m_critSection);
+
+      if (firstBlock != m_firstBlock || lastBlock != m_lastBlock)
+      {
+        // timelines fetched for other blocks are of no use anymore
+        m_timelines.clear();
+        m_pending.clear();
+        m_firstBlock = firstBlock;
+        m_lastBlock = lastBlock;
+        ++m_generation;
+      }
+
+      for (const auto& channel : channels)
+      {
+        if (m_timelines.find(channel.first) == m_timelines.end() &&
+            m_pending.insert(channel.first).second)
+          missing.emplace_back(channel);
+      }
+
+      generation = m_generation;
+    }
+
+    if (missing.empty())
+      return;
+
+    const std::weak_ptr<CTimelinePrefetcher> weakThis = shared_from_this();
+    CJobManager::GetInstance().Submit([weakThis, missing, generation, gridStart, gridEnd,
+                                       minEventEnd, maxEventStart]() {
+      for (const auto& channel : missing)
+      {
+        const std::shared_ptr<CTimelinePrefetcher> prefetcher = weakThis.lock();
+        if (!prefetcher || !prefetcher->IsCurrent(generation))
+          return;
+
+        prefetcher->Store(generation, channel.first,
+                          channel.second->GetEPGTimeline(gridStart, gridEnd, minEventEnd,
+                                                         maxEventStart));
+      }
+    });
+  }
+
+  /*!
+   * @brief Hand out the prefetched timeline of a channel.
+   * @param iChannel The index of the channel.
+   * @param firstBlock The first block the timeline is needed for.
+   * @param lastBlock The last block the timeline is needed for.
+   * @return The timeline or an empty vector if it was not prefetched for the given blocks.
+   */
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> Take(int iChannel, int firstBlock, int lastBlock)
+  {
+    CSingleLock lock(m_critSection);
+
+    if (firstBlock != m_firstBlock || lastBlock != m_lastBlock)
+      return {};
+
+    const auto it = m_timelines.find(iChannel);
+    if (it == m_timelines.end())
+      return {};
+
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags = std::move((*it).second);
+    m_timelines.erase(it);
+    m_pending.erase(iChannel);
+    return tags;
+  }
+
+  /*!
+   * @brief Drop the prefetched timelines of all channels outside the given range.
+   * @param firstChannel The first channel to keep.
+   * @param lastChannel The last channel to keep.
+   */
+  void Purge(int firstChannel, int lastChannel)
+  {
+    CSingleLock lock(m_critSection);
+
+    for (auto it = m_timelines.begin(); it != m_timelines.end();)
+    {
+      if ((*it).first < firstChannel || (*it).first > lastChannel)
+        it = m_timelines.erase(it);
+      else
+        ++it;
+    }
+
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+      if (*it < firstChannel || *it > lastChannel)
+        it = m_pending.erase(it);
+      else
+        ++it;
+    }
+  }
+
+private:
+  bool IsCurrent(unsigned int generation)
+  {
+    CSingleLock lock(m_critSection);
+    return generation == m_generation;
+  }
+
+  void Store(unsigned int generation,
+             int iChannel,
+             std::vector<std::shared_ptr<CPVREpgInfoTag>> tags)
+  {
+    CSingleLock lock(m_critSection);
+
+    if (generation != m_generation || m_pending.erase(iChannel) == 0 || tags.empty())
+      return;
+
+    m_timelines[iChannel] = std::move(tags);
+  }
+
+  CCriticalSection m_critSection;
+  std::unordered_map<int, std::vector<std::shared_ptr<CPVREpgInfoTag>>> m_timelines;
+  std::unordered_set<int> m_pending;
+  int m_firstBlock = -1;
+  int m_lastBlock = -1;
+  unsigned int m_generation = 0;
+};
+
 void CGUIEPGGridContainerModel::SetInvalid()
 {
   for (const auto& gridItem : m_gridIndex)
@@ -44,17 +192,27 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateGapItem(int iChannel
                                      m_channelItems[iChannel]->GetPVRChannelGroupMemberInfoTag());
 }
 
-std::vector<std::shared_ptr<CPVREpgInfoTag>> CGUIEPGGridContainerModel::GetEPGTimeline(
-    int iChannel, const CDateTime& minEventEnd, const CDateTime& maxEventStart) const
+void CGUIEPGGridContainerModel::GetEPGTimelineRange(const CDateTime& minEventEnd,
+                                                    const CDateTime& maxEventStart,
+                                                    CDateTime& min,
+                                                    CDateTime& max) const
 {
-  CDateTime min = minEventEnd - CDateTimeSpan(0, 0, MINSPERBLOCK, 0) + CDateTimeSpan(0, 0, 0, 1);
-  CDateTime max = maxEventStart + CDateTimeSpan(0, 0, MINSPERBLOCK, 0);
+  min = minEventEnd - CDateTimeSpan(0, 0, MINSPERBLOCK, 0) + CDateTimeSpan(0, 0, 0, 1);
+  max = maxEventStart + CDateTimeSpan(0, 0, MINSPERBLOCK, 0);
 
   if (min < m_gridStart)
     min = m_gridStart;
 
   if (max > m_gridEnd)
     max = m_gridEnd;
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CGUIEPGGridContainerModel::GetEPGTimeline(
+    int iChannel, const CDateTime& minEventEnd, const CDateTime& maxEventStart) const
+{
+  CDateTime min;
+  CDateTime max;
+  GetEPGTimelineRange(minEventEnd, maxEventStart, min, max);
 
   return m_channelItems[iChannel]->GetPVRChannelInfoTag()->GetEPGTimeline(m_gridStart, m_gridEnd,
                                                                           min, max);
@@ -77,6 +235,7 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
   }
 
   m_fBlockSize = fBlockSize;
+  m_prefetcher = std::make_shared<CTimelinePrefetcher>();
 
   ////////////////////////////////////////////////////////////////////////
   // Create channel items
@@ -151,8 +310,11 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel
   const int firstBlock = iBlock < m_firstActiveBlock ? iBlock : m_firstActiveBlock;
   const int lastBlock = iBlock > m_lastActiveBlock ? iBlock : m_lastActiveBlock;
 
-  const auto tags =
-      GetEPGTimeline(iChannel, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock));
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags =
+      m_prefetcher->Take(iChannel, firstBlock, lastBlock);
+  if (tags.empty())
+    tags =
+        GetEPGTimeline(iChannel, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock));
 
   const int firstResultBlock = GetFirstEventBlock(tags.front());
   const int lastResultBlock = GetLastEventBlock(tags.back());
@@ -517,69 +679,78 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
   // clear the grid. it will be recreated on-demand.
   m_gridIndex.clear();
 
-  bool newChannels = false;
-
-  if (channelsChanged)
+  // purge epg tags for inactive channels and trim the epg tags of active channels to the active
+  // blocks. epg tags for channels and blocks entering the viewport will be fetched on-demand.
+  for (auto it = m_epgItems.begin(); it != m_epgItems.end();)
   {
-    // purge epg tags for inactive channels
-    for (auto it = m_epgItems.begin(); it != m_epgItems.end();)
+    if ((*it).first < firstChannel || (*it).first > lastChannel ||
+        (blocksChanged && !TrimEpgTags((*it).second, firstBlock, lastBlock)))
     {
-      if ((*it).first < firstChannel || (*it).first > lastChannel)
-      {
-        it = m_epgItems.erase(it);
-        continue; // next channel
-      }
-      ++it;
+      it = m_epgItems.erase(it);
+      continue; // next channel
     }
-
-    newChannels = (firstChannel < m_firstActiveChannel) || (lastChannel > m_lastActiveChannel);
+    ++it;
   }
 
-  if (blocksChanged || newChannels)
-  {
-    // clear and refetch epg tags for active channels
-    const CDateTime maxEnd = GetStartTimeForBlock(firstBlock);
-    const CDateTime minStart = GetStartTimeForBlock(lastBlock);
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-    for (int i = firstChannel; i <= lastChannel; ++i)
-    {
-      auto it = m_epgItems.find(i);
-      if (it == m_epgItems.end())
-        it = m_epgItems.insert({i, EpgTags()}).first;
+  m_firstActiveChannel = firstChannel;
+  m_lastActiveChannel = lastChannel;
+  m_firstActiveBlock = firstBlock;
+  m_lastActiveBlock = lastBlock;
 
-      if (blocksChanged || i < m_firstActiveChannel || i > m_lastActiveChannel)
-      {
-        EpgTags& epgTags = (*it).second;
+  PrefetchEpgTags();
 
-        (*it).second.tags.clear();
+  return true;
+}
 
-        tags = GetEPGTimeline(i, maxEnd, minStart);
-        const int firstResultBlock = GetFirstEventBlock(tags.front());
-        const int lastResultBlock = GetLastEventBlock(tags.back());
-        if (firstResultBlock > lastResultBlock)
-          continue;
+bool CGUIEPGGridContainerModel::TrimEpgTags(EpgTags& epgTags, int iFirstBlock, int iLastBlock) const
+{
+  auto& tags = epgTags.tags;
+
+  const auto first = std::find_if(tags.begin(), tags.end(),
+                                  [this, iFirstBlock](const std::shared_ptr<CFileItem>& item) {
+                                    return GetLastEventBlock(item->GetEPGInfoTag()) >= iFirstBlock;
+                                  });
+  const auto last = std::find_if(first, tags.end(),
+                                 [this, iLastBlock](const std::shared_ptr<CFileItem>& item) {
+                                   return GetFirstEventBlock(item->GetEPGInfoTag()) > iLastBlock;
+                                 });
+  if (first == last)
+    return false; // nothing left
+
+  tags.erase(last, tags.end());
+  tags.erase(tags.begin(), first);
+
+  epgTags.firstBlock = GetFirstEventBlock(tags.front()->GetEPGInfoTag());
+  epgTags.lastBlock = GetLastEventBlock(tags.back()->GetEPGInfoTag());
+  return true;
+}
 
-        epgTags.firstBlock = firstResultBlock;
-        epgTags.lastBlock = lastResultBlock;
+void CGUIEPGGridContainerModel::PrefetchEpgTags() const
+{
+  // prefetch one page of channels before and after the active channels
+  const int pageSize = m_lastActiveChannel - m_firstActiveChannel + 1;
+  const int firstChannel = std::max(m_firstActiveChannel - pageSize, 0);
+  const int lastChannel = std::min(m_lastActiveChannel + pageSize, GetLastChannel());
 
-        for (const auto& tag : tags)
-        {
-          if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
-            continue;
+  m_prefetcher->Purge(firstChannel, lastChannel);
 
-          epgTags.tags.emplace_back(std::make_shared<CFileItem>(
-              tag, m_channelItems[i]->GetPVRChannelGroupMemberInfoTag()));
-        }
-      }
-    }
+  std::vector<std::pair<int, std::shared_ptr<CPVRChannel>>> channels;
+  for (int i = firstChannel; i <= lastChannel; ++i)
+  {
+    if (m_epgItems.find(i) == m_epgItems.end())
+      channels.emplace_back(i, m_channelItems[i]->GetPVRChannelInfoTag());
   }
 
-  m_firstActiveChannel = firstChannel;
-  m_lastActiveChannel = lastChannel;
-  m_firstActiveBlock = firstBlock;
-  m_lastActiveBlock = lastBlock;
+  if (channels.empty())
+    return;
 
-  return true;
+  CDateTime min;
+  CDateTime max;
+  GetEPGTimelineRange(GetStartTimeForBlock(m_firstActiveBlock),
+                      GetStartTimeForBlock(m_lastActiveBlock), min, max);
+
+  m_prefetcher->Request(channels, m_gridStart, m_gridEnd, m_firstActiveBlock, m_lastActiveBlock,
+                        min, max);
 }
 
 void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
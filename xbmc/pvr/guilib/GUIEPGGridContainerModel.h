@@ -116,6 +116,10 @@ namespace PVR
     std::shared_ptr<CFileItem> CreateGapItem(int iChannel) const;
     std::shared_ptr<CFileItem> GetItem(int iChannel, int iBlock) const;
 
+    void GetEPGTimelineRange(const CDateTime& minEventEnd,
+                             const CDateTime& maxEventStart,
+                             CDateTime& min,
+                             CDateTime& max) const;
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEPGTimeline(
         int iChannel, const CDateTime& minEventEnd, const CDateTime& maxEventStart) const;
 
@@ -134,9 +138,15 @@ namespace PVR
                                           int iBlock) const;
     std::shared_ptr<CFileItem> GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const;
     std::shared_ptr<CFileItem> GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const;
+    bool TrimEpgTags(EpgTags& epgTags, int iFirstBlock, int iLastBlock) const;
+    void PrefetchEpgTags() const;
 
     mutable EpgTagsMap m_epgItems;
 
+    // fetches the timelines of the channels next to the active ones in the background
+    class CTimelinePrefetcher;
+    std::shared_ptr<CTimelinePrefetcher> m_prefetcher;
+
     CDateTime m_gridStart;
     CDateTime m_gridEnd;
 
@@ -13,6 +13,9 @@
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "utils/RegExp.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
 
 using namespace PVR;
 
@@ -178,25 +181,53 @@ bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>
   if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
       m_timerRule->m_bFullTextEpgSearch)
   {
-    if (!m_textSearch)
-    {
-      m_textSearch.reset(new CRegExp(true /* case insensitive */));
-      m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
-    }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0 ||
-           m_textSearch->RegFind(epgTag->EpisodeName()) >= 0 ||
-           m_textSearch->RegFind(epgTag->PlotOutline()) >= 0 ||
-           m_textSearch->RegFind(epgTag->Plot()) >= 0;
+    return MatchText(epgTag->Title()) ||
+           MatchText(epgTag->EpisodeName()) ||
+           MatchText(epgTag->PlotOutline()) ||
+           MatchText(epgTag->Plot());
   }
   else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
   {
-    if (!m_textSearch)
+    return MatchText(epgTag->Title());
+  }
+  else
+    return true;
+}
+
+bool CPVRTimerRuleMatcher::MatchText(const std::string& text) const
+{
+  if (!m_textSearch && !m_literalSearch)
+  {
+    const std::string& strSearch = m_timerRule->m_strEpgSearchString;
+
+    // Most rules search for plain ASCII text. Match those with a simple case-insensitive
+    // substring search instead of running the regular expression engine for every tag.
+    const bool bIsLiteral =
+        strSearch.find_first_of("\\^$.|?*+()[]{}") == std::string::npos &&
+        std::none_of(strSearch.cbegin(), strSearch.cend(),
+                     [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+    if (bIsLiteral)
+    {
+      m_literalSearch.reset(new std::string(strSearch));
+      StringUtils::ToLower(*m_literalSearch);
+    }
+    else
     {
       m_textSearch.reset(new CRegExp(true /* case insensitive */));
-      m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
+      m_textSearch->RegComp(strSearch);
     }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0;
   }
-  else
-    return true;
+
+  if (m_literalSearch)
+  {
+    if (m_literalSearch->empty())
+      return true;
+
+    return std::search(text.cbegin(), text.cend(), m_literalSearch->cbegin(),
+                       m_literalSearch->cend(), [](char c1, char c2) {
+                         return (c1 >= 'A' && c1 <= 'Z' ? c1 - 'A' + 'a' : c1) == c2;
+                       }) != text.cend();
+  }
+
+  return m_textSearch->RegFind(text) >= 0;
 }
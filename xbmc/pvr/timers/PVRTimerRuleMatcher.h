@@ -11,6 +11,7 @@
 #include "XBDateTime.h"
 
 #include <memory>
+#include <string>
 
 class CRegExp;
 
@@ -39,9 +40,11 @@ namespace PVR
     bool MatchEnd(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchDayOfWeek(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
+    bool MatchText(const std::string& text) const;
 
     const std::shared_ptr<CPVRTimerInfoTag> m_timerRule;
     CDateTime m_start;
     mutable std::unique_ptr<CRegExp> m_textSearch;
+    mutable std::unique_ptr<std::string> m_literalSearch; // lower case search string w/o regex
   };
 }
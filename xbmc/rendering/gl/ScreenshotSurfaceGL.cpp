@@ -12,6 +12,7 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "threads/SingleLock.h"
+#include "utils/ImageKernels.h"
 #include "utils/Screenshot.h"
 #include "windowing/GraphicContext.h"
 
@@ -58,8 +59,8 @@ bool CScreenshotSurfaceGL::Capture()
 
   // make a new buffer and copy the read image to it with the Y axis inverted
   m_buffer = new unsigned char[m_stride * m_height];
-  for (int y = 0; y < m_height; y++)
-    memcpy(m_buffer + y * m_stride, surface.data() + (m_height - y - 1) * m_stride, m_stride);
+  CImageKernels::CopyPlane(m_buffer, m_stride, surface.data() + (m_height - 1) * m_stride,
+                           -m_stride, m_stride, m_height);
 
   return m_buffer != nullptr;
 }
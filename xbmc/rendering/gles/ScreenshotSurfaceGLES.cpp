@@ -12,6 +12,7 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "threads/SingleLock.h"
+#include "utils/ImageKernels.h"
 #include "utils/Screenshot.h"
 #include "windowing/GraphicContext.h"
 
@@ -55,18 +56,10 @@ bool CScreenshotSurfaceGLES::Capture()
   glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(surface.data()));
 
   //make a new buffer and copy the read image to it with the Y axis inverted
+  //we need to save in BGRA order so swap RGBA -> BGRA
   m_buffer = new unsigned char[m_stride * m_height];
-  for (int y = 0; y < m_height; y++)
-  {
-    // we need to save in BGRA order so XOR Swap RGBA -> BGRA
-    unsigned char* swap_pixels = surface.data() + (m_height - y - 1) * m_stride;
-    for (int x = 0; x < m_width; x++, swap_pixels += 4)
-    {
-      std::swap(swap_pixels[0], swap_pixels[2]);
-    }
-
-    memcpy(m_buffer + y * m_stride, surface.data() + (m_height - y - 1) * m_stride, m_stride);
-  }
+  CImageKernels::SwapRedBlue(m_buffer, m_stride, surface.data() + (m_height - 1) * m_stride,
+                             -m_stride, m_width, m_height);
 
   return m_buffer != nullptr;
 }
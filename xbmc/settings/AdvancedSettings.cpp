@@ -155,6 +155,9 @@ void CAdvancedSettings::Initialize()
   m_videoFpsDetect = 1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
+  m_videoProbeCache = true;
+  m_videoSeekIndex = true;
+  m_videoAdaptiveThreading = true;
 
   m_videoDefaultLatency = 0.0;
 
@@ -257,6 +260,7 @@ void CAdvancedSettings::Initialize()
 
   m_fanartRes = 1080;
   m_imageRes = 720;
+  m_imageCacheDDS = false;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
 
   m_sambaclienttimeout = 30;
@@ -400,6 +404,7 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiLargeTextureUploadsPerFrame = 2;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -721,6 +726,12 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
+    // reuse the probe results of files that were played before
+    XMLUtils::GetBoolean(pElement, "probecache", m_videoProbeCache);
+    // remember the keyframes of files that are seeked by bisecting them
+    XMLUtils::GetBoolean(pElement, "seekindex", m_videoSeekIndex);
+    // choose the threading of software decoders per stream and adjust it while decoding
+    XMLUtils::GetBoolean(pElement, "adaptivethreading", m_videoAdaptiveThreading);
 
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
@@ -1059,6 +1070,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
   XMLUtils::GetUInt(pRootElement, "fanartres", m_fanartRes, 0, 9999);
   XMLUtils::GetUInt(pRootElement, "imageres", m_imageRes, 0, 9999);
+  XMLUtils::GetBoolean(pRootElement, "imagecachedds", m_imageCacheDDS);
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
@@ -1218,6 +1230,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetInt(pElement, "largetextureuploadsperframe", m_guiLargeTextureUploadsPerFrame,
+                     0, 100);
   }
 
   std::string seekSteps;
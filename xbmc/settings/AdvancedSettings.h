@@ -173,6 +173,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int  m_videoFpsDetect;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    bool m_videoProbeCache = true;
+    bool m_videoSeekIndex = true;
+    bool m_videoAdaptiveThreading = true;
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -219,6 +222,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     unsigned int m_fanartRes; ///< \brief the maximal resolution to cache fanart at (assumes 16x9)
     unsigned int m_imageRes;  ///< \brief the maximal resolution to cache images at (assumes 16x9)
+    bool m_imageCacheDDS; ///< \brief whether to keep an uncompressed .dds copy of cached images for loading without decoding
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
 
     int m_sambaclienttimeout;
@@ -335,6 +339,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    int m_guiLargeTextureUploadsPerFrame; ///< max background loaded textures uploaded per frame, 0 for no limit
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
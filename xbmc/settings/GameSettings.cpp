@@ -26,6 +26,7 @@ void CGameSettings::Reset()
   m_videoFilter.clear();
   m_stretchMode = RETRO::STRETCHMODE::Normal;
   m_rotationDegCCW = 0;
+  m_runAheadFrames = 0;
 }
 
 bool CGameSettings::operator==(const CGameSettings &rhs) const
@@ -61,3 +62,15 @@ void CGameSettings::SetRotationDegCCW(unsigned int rotation)
     SetChanged();
   }
 }
+
+void CGameSettings::SetRunAheadFrames(unsigned int runAheadFrames)
+{
+  if (runAheadFrames > MAX_RUN_AHEAD_FRAMES)
+    runAheadFrames = MAX_RUN_AHEAD_FRAMES;
+
+  if (runAheadFrames != m_runAheadFrames)
+  {
+    m_runAheadFrames = runAheadFrames;
+    SetChanged();
+  }
+}
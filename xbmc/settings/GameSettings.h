@@ -36,9 +36,19 @@ public:
   unsigned int RotationDegCCW() const { return m_rotationDegCCW; }
   void SetRotationDegCCW(unsigned int rotation);
 
+  // Number of frames emulated ahead of the displayed frame, 0 to disable
+  unsigned int RunAheadFrames() const { return m_runAheadFrames; }
+  void SetRunAheadFrames(unsigned int runAheadFrames);
+
+  static constexpr unsigned int MAX_RUN_AHEAD_FRAMES = 4;
+
 private:
   // Video settings
   std::string m_videoFilter;
   KODI::RETRO::STRETCHMODE m_stretchMode;
   unsigned int m_rotationDegCCW;
+
+  // Latency settings of the current game, not copied or compared with the
+  // video settings, see CMediaSettings::GetGameRunAheadFrames()
+  unsigned int m_runAheadFrames = 0;
 };
@@ -31,6 +31,7 @@
 #include "video/VideoDatabase.h"
 #include "video/VideoLibraryQueue.h"
 
+#include <cstdlib>
 #include <limits.h>
 #include <string>
 
@@ -141,6 +142,28 @@ bool CMediaSettings::Load(const TiXmlNode *settings)
       m_defaultGameSettings.SetRotationDegCCW(static_cast<unsigned int>(rotation));
   }
 
+  // Run-ahead is chosen per game
+  m_gameRunAheadFrames.clear();
+  pElement = settings->FirstChildElement("gamerunahead");
+  if (pElement != nullptr)
+  {
+    for (const TiXmlElement* pGame = pElement->FirstChildElement("game"); pGame != nullptr;
+         pGame = pGame->NextSiblingElement("game"))
+    {
+      const char* gameClient = pGame->Attribute("client");
+      const char* gameFileName = pGame->Attribute("file");
+      const TiXmlNode* pValue = pGame->FirstChild();
+      if (gameClient == nullptr || gameFileName == nullptr || pValue == nullptr)
+        continue;
+
+      const int runAheadFrames = std::atoi(pValue->Value());
+      if (runAheadFrames > 0 &&
+          runAheadFrames <= static_cast<int>(CGameSettings::MAX_RUN_AHEAD_FRAMES))
+        m_gameRunAheadFrames[std::make_pair(gameClient, gameFileName)] =
+            static_cast<unsigned int>(runAheadFrames);
+    }
+  }
+
   // mymusic settings
   pElement = settings->FirstChildElement("mymusic");
   if (pElement != NULL)
@@ -247,6 +270,22 @@ bool CMediaSettings::Save(TiXmlNode *settings) const
   XMLUtils::SetString(pNode, "stretchmode", sm);
   XMLUtils::SetInt(pNode, "rotation", m_defaultGameSettings.RotationDegCCW());
 
+  // Run-ahead per game
+  TiXmlElement gameRunAheadNode("gamerunahead");
+  pNode = settings->InsertEndChild(gameRunAheadNode);
+  if (pNode == nullptr)
+    return false;
+
+  for (const auto& game : m_gameRunAheadFrames)
+  {
+    TiXmlElement gameNode("game");
+    gameNode.SetAttribute("client", game.first.first.c_str());
+    gameNode.SetAttribute("file", game.first.second.c_str());
+    TiXmlText value(std::to_string(game.second));
+    gameNode.InsertEndChild(value);
+    pNode->InsertEndChild(gameNode);
+  }
+
   // mymusic
   pNode = settings->FirstChild("mymusic");
   if (pNode == NULL)
@@ -404,3 +443,37 @@ std::string CMediaSettings::GetWatchedContent(const std::string &content)
 
   return content;
 }
+
+unsigned int CMediaSettings::GetGameRunAheadFrames(const std::string& gameClient,
+                                                   const std::string& gameFileName) const
+{
+  CSingleLock lock(m_critical);
+  auto it = m_gameRunAheadFrames.find(std::make_pair(gameClient, gameFileName));
+  if (it != m_gameRunAheadFrames.end())
+    return it->second;
+
+  return 0;
+}
+
+bool CMediaSettings::SetGameRunAheadFrames(const std::string& gameClient,
+                                           const std::string& gameFileName,
+                                           unsigned int runAheadFrames)
+{
+  CSingleLock lock(m_critical);
+  const auto key = std::make_pair(gameClient, gameFileName);
+  auto it = m_gameRunAheadFrames.find(key);
+
+  if (runAheadFrames == 0)
+  {
+    if (it == m_gameRunAheadFrames.end())
+      return false;
+    m_gameRunAheadFrames.erase(it);
+    return true;
+  }
+
+  if (it != m_gameRunAheadFrames.end() && it->second == runAheadFrames)
+    return false;
+
+  m_gameRunAheadFrames[key] = runAheadFrames;
+  return true;
+}
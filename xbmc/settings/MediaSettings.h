@@ -18,6 +18,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 
 #define VOLUME_DRC_MINIMUM 0    // 0dB
 #define VOLUME_DRC_MAXIMUM 6000 // 60dB
@@ -49,6 +50,27 @@ public:
   const CGameSettings& GetCurrentGameSettings() const { return m_currentGameSettings; }
   CGameSettings& GetCurrentGameSettings() { return m_currentGameSettings; }
 
+  /*! \brief Retrieve the number of run-ahead frames chosen for a game
+   \param gameClient ID of the game client
+   \param gameFileName file name of the game
+   \return the number of frames, 0 if run-ahead wasn't enabled for the game
+   \sa SetGameRunAheadFrames
+   */
+  unsigned int GetGameRunAheadFrames(const std::string& gameClient,
+                                     const std::string& gameFileName) const;
+
+  /*! \brief Remember the number of run-ahead frames for a game
+   Run-ahead depends on the game and the emulator, so it isn't part of the default game settings.
+   \param gameClient ID of the game client
+   \param gameFileName file name of the game
+   \param runAheadFrames number of frames, 0 to disable run-ahead
+   \return true if the value changed and the settings need saving
+   \sa GetGameRunAheadFrames
+   */
+  bool SetGameRunAheadFrames(const std::string& gameClient,
+                             const std::string& gameFileName,
+                             unsigned int runAheadFrames);
+
   /*! \brief Retrieve the watched mode for the given content type
    \param content Current content type
    \return the current watch mode for this content type, WATCH_MODE_ALL if the content type is unknown.
@@ -102,6 +124,9 @@ private:
   typedef std::map<std::string, WatchedMode> WatchedModes;
   WatchedModes m_watchedModes;
 
+  // Run-ahead frames by game client and game file name
+  std::map<std::pair<std::string, std::string>, unsigned int> m_gameRunAheadFrames;
+
   bool m_musicPlaylistRepeat;
   bool m_musicPlaylistShuffle;
   bool m_videoPlaylistRepeat;
@@ -53,6 +53,8 @@ public:
   bool IsCurrentThread() const;
   bool Join(std::chrono::milliseconds duration);
 
+  const std::string& GetName() const { return m_ThreadName; }
+
   inline static const std::thread::id GetCurrentThreadId()
   {
     return std::this_thread::get_id();
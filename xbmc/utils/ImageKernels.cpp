@@ -0,0 +1,521 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ImageKernels.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#define IMAGE_KERNELS_SSE2
+#elif defined(HAS_NEON) && (defined(__aarch64__) || defined(__arm__))
+#include <arm_neon.h>
+#define IMAGE_KERNELS_NEON
+#if defined(__arm__)
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#endif
+#endif
+
+namespace
+{
+/*!
+ * YUV to RGB in 16 bit fixed point, shared by all kernels so that they
+ * return the same pixels. The samples are scaled by 2^7 and the factors by
+ * 2^11, the upper half of their product is the result with two fractional
+ * bits.
+ */
+struct Coefficients
+{
+  int16_t yOffset;
+  int16_t y;
+  int16_t rv;
+  int16_t gu;
+  int16_t gv;
+  int16_t bu;
+};
+
+Coefficients GetCoefficients(CImageKernels::ColorMatrix matrix, bool limitedRange)
+{
+  double kr, kb;
+  switch (matrix)
+  {
+    case CImageKernels::ColorMatrix::BT601:
+      kr = 0.299;
+      kb = 0.114;
+      break;
+    case CImageKernels::ColorMatrix::BT2020:
+      kr = 0.2627;
+      kb = 0.0593;
+      break;
+    case CImageKernels::ColorMatrix::BT709:
+    default:
+      kr = 0.2126;
+      kb = 0.0722;
+      break;
+  }
+  const double kg = 1.0 - kr - kb;
+
+  const double yScale = limitedRange ? 255.0 / 219.0 : 1.0;
+  const double cScale = limitedRange ? 255.0 / 224.0 : 1.0;
+
+  const auto fixed = [](double value) { return static_cast<int16_t>(std::lround(value * 2048)); };
+
+  Coefficients coefficients;
+  coefficients.yOffset = limitedRange ? 16 : 0;
+  coefficients.y = fixed(yScale);
+  coefficients.rv = fixed(2.0 * (1.0 - kr) * cScale);
+  coefficients.gu = fixed(-2.0 * kb * (1.0 - kb) / kg * cScale);
+  coefficients.gv = fixed(-2.0 * kr * (1.0 - kr) / kg * cScale);
+  coefficients.bu = fixed(2.0 * (1.0 - kb) * cScale);
+  return coefficients;
+}
+
+inline int MulHi(int a, int b)
+{
+  return (a * b) >> 16;
+}
+
+inline uint8_t Clamp(int value)
+{
+  return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+//------------------------------------------------------------------------------
+// Scalar kernels, also used for the pixels after the last full SIMD block
+//------------------------------------------------------------------------------
+
+void ConvertRowC(const uint8_t* y,
+                 const uint8_t* u,
+                 const uint8_t* v,
+                 uint8_t* target,
+                 unsigned int x,
+                 unsigned int width,
+                 const Coefficients& c)
+{
+  for (; x < width; x++)
+  {
+    const int luma = MulHi((y[x] - c.yOffset) * 128, c.y);
+    const int cb = (u[x / 2] - 128) * 128;
+    const int cr = (v[x / 2] - 128) * 128;
+
+    uint8_t* pixel = target + x * 4;
+    pixel[0] = Clamp((luma + MulHi(cb, c.bu) + 2) >> 2);
+    pixel[1] = Clamp((luma + MulHi(cb, c.gu) + MulHi(cr, c.gv) + 2) >> 2);
+    pixel[2] = Clamp((luma + MulHi(cr, c.rv) + 2) >> 2);
+    pixel[3] = 0xFF;
+  }
+}
+
+void SwapRowC(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int width)
+{
+  for (; x < width; x++)
+  {
+    const uint8_t r = source[x * 4];
+    const uint8_t b = source[x * 4 + 2];
+    target[x * 4] = b;
+    target[x * 4 + 1] = source[x * 4 + 1];
+    target[x * 4 + 2] = r;
+    target[x * 4 + 3] = source[x * 4 + 3];
+  }
+}
+
+void DeinterleaveRowC(const uint8_t* uv, uint8_t* u, uint8_t* v, unsigned int x, unsigned int count)
+{
+  for (; x < count; x++)
+  {
+    u[x] = uv[x * 2];
+    v[x] = uv[x * 2 + 1];
+  }
+}
+
+// Keep the upper 8 bits of little endian 16 bit samples
+void NarrowRowC(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int count)
+{
+  for (; x < count; x++)
+    target[x] = source[x * 2 + 1];
+}
+
+//------------------------------------------------------------------------------
+// SSE2 kernels
+//------------------------------------------------------------------------------
+
+#if defined(IMAGE_KERNELS_SSE2)
+void ConvertRowSSE2(const uint8_t* y,
+                    const uint8_t* u,
+                    const uint8_t* v,
+                    uint8_t* target,
+                    unsigned int x,
+                    unsigned int width,
+                    const Coefficients& c)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha = _mm_set1_epi8(-1);
+  const __m128i round = _mm_set1_epi16(2);
+  const __m128i yOffset = _mm_set1_epi16(c.yOffset);
+  const __m128i chromaOffset = _mm_set1_epi16(128);
+  const __m128i cy = _mm_set1_epi16(c.y);
+  const __m128i crv = _mm_set1_epi16(c.rv);
+  const __m128i cgu = _mm_set1_epi16(c.gu);
+  const __m128i cgv = _mm_set1_epi16(c.gv);
+  const __m128i cbu = _mm_set1_epi16(c.bu);
+
+  // 16 pixels per iteration
+  for (; x + 16 <= width; x += 16)
+  {
+    const __m128i luma8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+    __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2));
+    __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2));
+    u8 = _mm_unpacklo_epi8(u8, u8);
+    v8 = _mm_unpacklo_epi8(v8, v8);
+
+    __m128i b[2];
+    __m128i g[2];
+    __m128i r[2];
+    for (int half = 0; half < 2; half++)
+    {
+      const __m128i y16 = half ? _mm_unpackhi_epi8(luma8, zero) : _mm_unpacklo_epi8(luma8, zero);
+      const __m128i u16 = half ? _mm_unpackhi_epi8(u8, zero) : _mm_unpacklo_epi8(u8, zero);
+      const __m128i v16 = half ? _mm_unpackhi_epi8(v8, zero) : _mm_unpacklo_epi8(v8, zero);
+
+      const __m128i luma = _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(y16, yOffset), 7), cy);
+      const __m128i cb = _mm_slli_epi16(_mm_sub_epi16(u16, chromaOffset), 7);
+      const __m128i cr = _mm_slli_epi16(_mm_sub_epi16(v16, chromaOffset), 7);
+
+      b[half] = _mm_add_epi16(_mm_add_epi16(luma, _mm_mulhi_epi16(cb, cbu)), round);
+      g[half] = _mm_add_epi16(
+          _mm_add_epi16(luma, _mm_add_epi16(_mm_mulhi_epi16(cb, cgu), _mm_mulhi_epi16(cr, cgv))),
+          round);
+      r[half] = _mm_add_epi16(_mm_add_epi16(luma, _mm_mulhi_epi16(cr, crv)), round);
+    }
+
+    const __m128i b8 = _mm_packus_epi16(_mm_srai_epi16(b[0], 2), _mm_srai_epi16(b[1], 2));
+    const __m128i g8 = _mm_packus_epi16(_mm_srai_epi16(g[0], 2), _mm_srai_epi16(g[1], 2));
+    const __m128i r8 = _mm_packus_epi16(_mm_srai_epi16(r[0], 2), _mm_srai_epi16(r[1], 2));
+
+    // Interleave to B, G, R, A bytes
+    const __m128i bgLow = _mm_unpacklo_epi8(b8, g8);
+    const __m128i bgHigh = _mm_unpackhi_epi8(b8, g8);
+    const __m128i raLow = _mm_unpacklo_epi8(r8, alpha);
+    const __m128i raHigh = _mm_unpackhi_epi8(r8, alpha);
+
+    __m128i* dst = reinterpret_cast<__m128i*>(target + x * 4);
+    _mm_storeu_si128(dst, _mm_unpacklo_epi16(bgLow, raLow));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(bgLow, raLow));
+    _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(bgHigh, raHigh));
+    _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(bgHigh, raHigh));
+  }
+
+  ConvertRowC(y, u, v, target, x, width, c);
+}
+
+void SwapRowSSE2(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int width)
+{
+  const __m128i maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+  const __m128i maskRB = _mm_set1_epi32(0x00FF00FF);
+
+  // 4 pixels per iteration
+  for (; x + 4 <= width; x += 4)
+  {
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+    const __m128i rb = _mm_and_si128(p, maskRB);
+    const __m128i swapped = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + x * 4),
+                     _mm_or_si128(_mm_and_si128(p, maskGA), swapped));
+  }
+
+  SwapRowC(source, target, x, width);
+}
+
+void DeinterleaveRowSSE2(
+    const uint8_t* uv, uint8_t* u, uint8_t* v, unsigned int x, unsigned int count)
+{
+  const __m128i mask = _mm_set1_epi16(0x00FF);
+
+  // 16 pairs per iteration
+  for (; x + 16 <= count; x += 16)
+  {
+    const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x * 2));
+    const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x * 2 + 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x),
+                     _mm_packus_epi16(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(v + x),
+                     _mm_packus_epi16(_mm_srli_epi16(p0, 8), _mm_srli_epi16(p1, 8)));
+  }
+
+  DeinterleaveRowC(uv, u, v, x, count);
+}
+
+void NarrowRowSSE2(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int count)
+{
+  // 16 samples per iteration
+  for (; x + 16 <= count; x += 16)
+  {
+    const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 2));
+    const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 2 + 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + x),
+                     _mm_packus_epi16(_mm_srli_epi16(p0, 8), _mm_srli_epi16(p1, 8)));
+  }
+
+  NarrowRowC(source, target, x, count);
+}
+#endif
+
+//------------------------------------------------------------------------------
+// NEON kernels
+//------------------------------------------------------------------------------
+
+#if defined(IMAGE_KERNELS_NEON)
+inline int16x8_t MulHiNEON(int16x8_t a, int16x8_t b)
+{
+  return vcombine_s16(vshrn_n_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), 16),
+                      vshrn_n_s32(vmull_s16(vget_high_s16(a), vget_high_s16(b)), 16));
+}
+
+void ConvertRowNEON(const uint8_t* y,
+                    const uint8_t* u,
+                    const uint8_t* v,
+                    uint8_t* target,
+                    unsigned int x,
+                    unsigned int width,
+                    const Coefficients& c)
+{
+  const int16x8_t round = vdupq_n_s16(2);
+  const int16x8_t yOffset = vdupq_n_s16(c.yOffset);
+  const int16x8_t chromaOffset = vdupq_n_s16(128);
+  const int16x8_t cy = vdupq_n_s16(c.y);
+  const int16x8_t crv = vdupq_n_s16(c.rv);
+  const int16x8_t cgu = vdupq_n_s16(c.gu);
+  const int16x8_t cgv = vdupq_n_s16(c.gv);
+  const int16x8_t cbu = vdupq_n_s16(c.bu);
+
+  // 16 pixels per iteration
+  for (; x + 16 <= width; x += 16)
+  {
+    const uint8x16_t luma8 = vld1q_u8(y + x);
+    const uint8x8_t u8 = vld1_u8(u + x / 2);
+    const uint8x8_t v8 = vld1_u8(v + x / 2);
+    const uint8x8x2_t uu = vzip_u8(u8, u8);
+    const uint8x8x2_t vv = vzip_u8(v8, v8);
+
+    for (int half = 0; half < 2; half++)
+    {
+      const int16x8_t y16 =
+          vreinterpretq_s16_u16(vmovl_u8(half ? vget_high_u8(luma8) : vget_low_u8(luma8)));
+      const int16x8_t u16 = vreinterpretq_s16_u16(vmovl_u8(uu.val[half]));
+      const int16x8_t v16 = vreinterpretq_s16_u16(vmovl_u8(vv.val[half]));
+
+      const int16x8_t luma = MulHiNEON(vshlq_n_s16(vsubq_s16(y16, yOffset), 7), cy);
+      const int16x8_t cb = vshlq_n_s16(vsubq_s16(u16, chromaOffset), 7);
+      const int16x8_t cr = vshlq_n_s16(vsubq_s16(v16, chromaOffset), 7);
+
+      const int16x8_t b = vaddq_s16(vaddq_s16(luma, MulHiNEON(cb, cbu)), round);
+      const int16x8_t g = vaddq_s16(
+          vaddq_s16(luma, vaddq_s16(MulHiNEON(cb, cgu), MulHiNEON(cr, cgv))), round);
+      const int16x8_t r = vaddq_s16(vaddq_s16(luma, MulHiNEON(cr, crv)), round);
+
+      uint8x8x4_t bgra;
+      bgra.val[0] = vqmovun_s16(vshrq_n_s16(b, 2));
+      bgra.val[1] = vqmovun_s16(vshrq_n_s16(g, 2));
+      bgra.val[2] = vqmovun_s16(vshrq_n_s16(r, 2));
+      bgra.val[3] = vdup_n_u8(0xFF);
+      vst4_u8(target + (x + half * 8) * 4, bgra);
+    }
+  }
+
+  ConvertRowC(y, u, v, target, x, width, c);
+}
+
+void SwapRowNEON(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int width)
+{
+  // 16 pixels per iteration
+  for (; x + 16 <= width; x += 16)
+  {
+    uint8x16x4_t pixels = vld4q_u8(source + x * 4);
+    const uint8x16_t r = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = r;
+    vst4q_u8(target + x * 4, pixels);
+  }
+
+  SwapRowC(source, target, x, width);
+}
+
+void DeinterleaveRowNEON(
+    const uint8_t* uv, uint8_t* u, uint8_t* v, unsigned int x, unsigned int count)
+{
+  // 16 pairs per iteration
+  for (; x + 16 <= count; x += 16)
+  {
+    const uint8x16x2_t pairs = vld2q_u8(uv + x * 2);
+    vst1q_u8(u + x, pairs.val[0]);
+    vst1q_u8(v + x, pairs.val[1]);
+  }
+
+  DeinterleaveRowC(uv, u, v, x, count);
+}
+
+void NarrowRowNEON(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int count)
+{
+  // 16 samples per iteration
+  for (; x + 16 <= count; x += 16)
+    vst1q_u8(target + x, vld2q_u8(source + x * 2).val[1]);
+
+  NarrowRowC(source, target, x, count);
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Dispatch
+//------------------------------------------------------------------------------
+
+struct Kernels
+{
+  void (*convertRow)(const uint8_t* y,
+                     const uint8_t* u,
+                     const uint8_t* v,
+                     uint8_t* target,
+                     unsigned int x,
+                     unsigned int width,
+                     const Coefficients& c);
+  void (*swapRow)(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int width);
+  void (*deinterleaveRow)(
+      const uint8_t* uv, uint8_t* u, uint8_t* v, unsigned int x, unsigned int count);
+  void (*narrowRow)(const uint8_t* source, uint8_t* target, unsigned int x, unsigned int count);
+};
+
+Kernels SelectKernels()
+{
+#if defined(IMAGE_KERNELS_SSE2)
+  return {ConvertRowSSE2, SwapRowSSE2, DeinterleaveRowSSE2, NarrowRowSSE2};
+#elif defined(IMAGE_KERNELS_NEON)
+#if defined(__arm__)
+  // NEON is optional on 32-bit ARM
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  if (!cpuInfo || (cpuInfo->GetCPUFeatures() & CPU_FEATURE_NEON) != CPU_FEATURE_NEON)
+    return {ConvertRowC, SwapRowC, DeinterleaveRowC, NarrowRowC};
+#endif
+  return {ConvertRowNEON, SwapRowNEON, DeinterleaveRowNEON, NarrowRowNEON};
+#else
+  return {ConvertRowC, SwapRowC, DeinterleaveRowC, NarrowRowC};
+#endif
+}
+
+const Kernels& GetKernels()
+{
+  static const Kernels kernels = SelectKernels();
+  return kernels;
+}
+} // namespace
+
+void CImageKernels::CopyPlane(uint8_t* target,
+                              int targetStride,
+                              const uint8_t* source,
+                              int sourceStride,
+                              unsigned int bytes,
+                              unsigned int rows)
+{
+  if (sourceStride == targetStride && sourceStride == static_cast<int>(bytes))
+  {
+    std::memcpy(target, source, static_cast<size_t>(bytes) * rows);
+    return;
+  }
+
+  for (unsigned int y = 0; y < rows; y++, source += sourceStride, target += targetStride)
+    std::memcpy(target, source, bytes);
+}
+
+void CImageKernels::SwapRedBlue(uint8_t* target,
+                                int targetStride,
+                                const uint8_t* source,
+                                int sourceStride,
+                                unsigned int width,
+                                unsigned int height)
+{
+  const Kernels& kernels = GetKernels();
+
+  // contiguous rows are swapped as one
+  if (sourceStride == targetStride && sourceStride == static_cast<int>(width * 4))
+  {
+    width *= height;
+    height = 1;
+  }
+
+  for (unsigned int y = 0; y < height; y++, source += sourceStride, target += targetStride)
+    kernels.swapRow(source, target, 0, width);
+}
+
+void CImageKernels::ConvertToBGRA(const YUVImage& image,
+                                  uint8_t* target,
+                                  int targetStride,
+                                  unsigned int width,
+                                  unsigned int height)
+{
+  if (image.width == 0 || image.height == 0 || width == 0 || height == 0)
+    return;
+
+  const Kernels& kernels = GetKernels();
+  const Coefficients coefficients = GetCoefficients(image.matrix, image.limitedRange);
+
+  const unsigned int chromaWidth = (image.width + 1) / 2;
+  const bool scaled = width != image.width || height != image.height;
+
+  // rows that have to be converted to 8 bit or split before converting them
+  std::vector<uint8_t> luma(image.format == YUVFormat::P010 ? image.width : 0);
+  std::vector<uint8_t> chroma(image.format != YUVFormat::YUV420P ? chromaWidth * 4 : 0);
+  std::vector<uint8_t> row(scaled ? image.width * 4 : 0);
+  std::vector<unsigned int> columns(scaled ? width : 0);
+
+  for (unsigned int x = 0; x < columns.size(); x++)
+    columns[x] = static_cast<unsigned int>(static_cast<uint64_t>(x) * image.width / width);
+
+  for (unsigned int y = 0; y < height; y++)
+  {
+    const unsigned int sourceY =
+        scaled ? static_cast<unsigned int>(static_cast<uint64_t>(y) * image.height / height) : y;
+    const uint8_t* yRow = image.planes[0] + static_cast<ptrdiff_t>(sourceY) * image.strides[0];
+    const uint8_t* uRow = image.planes[1] + static_cast<ptrdiff_t>(sourceY / 2) * image.strides[1];
+    const uint8_t* vRow = nullptr;
+
+    switch (image.format)
+    {
+      case YUVFormat::YUV420P:
+        vRow = image.planes[2] + static_cast<ptrdiff_t>(sourceY / 2) * image.strides[2];
+        break;
+      case YUVFormat::NV12:
+        kernels.deinterleaveRow(uRow, chroma.data(), chroma.data() + chromaWidth, 0, chromaWidth);
+        uRow = chroma.data();
+        vRow = chroma.data() + chromaWidth;
+        break;
+      case YUVFormat::P010:
+        kernels.narrowRow(yRow, luma.data(), 0, image.width);
+        kernels.narrowRow(uRow, chroma.data() + chromaWidth * 2, 0, chromaWidth * 2);
+        kernels.deinterleaveRow(chroma.data() + chromaWidth * 2, chroma.data(),
+                                chroma.data() + chromaWidth, 0, chromaWidth);
+        yRow = luma.data();
+        uRow = chroma.data();
+        vRow = chroma.data() + chromaWidth;
+        break;
+    }
+
+    uint8_t* targetRow = target + static_cast<ptrdiff_t>(y) * targetStride;
+
+    if (!scaled)
+    {
+      kernels.convertRow(yRow, uRow, vRow, targetRow, 0, width, coefficients);
+      continue;
+    }
+
+    kernels.convertRow(yRow, uRow, vRow, row.data(), 0, image.width, coefficients);
+    for (unsigned int x = 0; x < width; x++)
+      std::memcpy(targetRow + x * 4, row.data() + columns[x] * 4, 4);
+  }
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*!
+ * \brief CPU kernels to copy and convert the images of captures, screenshots
+ *        and video buffers
+ *
+ * The kernels use SSE2 or NEON if Kodi is built with them. On 32-bit ARM,
+ * NEON is only used if the CPU reports it. Strides may be negative to flip
+ * an image vertically while it is copied.
+ */
+class CImageKernels
+{
+public:
+  enum class YUVFormat
+  {
+    NV12, ///< 8 bit Y plane and interleaved UV plane
+    YUV420P, ///< 8 bit Y, U and V planes
+    P010, ///< like NV12 with 16 bit samples, the upper 10 bits are used
+  };
+
+  enum class ColorMatrix
+  {
+    BT601,
+    BT709,
+    BT2020,
+  };
+
+  struct YUVImage
+  {
+    YUVFormat format = YUVFormat::YUV420P;
+    ColorMatrix matrix = ColorMatrix::BT709;
+    bool limitedRange = true;
+    const uint8_t* planes[3] = {};
+    int strides[3] = {};
+    unsigned int width = 0;
+    unsigned int height = 0;
+  };
+
+  /*!
+   * \brief Copy the rows of a plane, in one piece if they are contiguous
+   *
+   * \param bytes Bytes of a row that are copied
+   */
+  static void CopyPlane(uint8_t* target,
+                        int targetStride,
+                        const uint8_t* source,
+                        int sourceStride,
+                        unsigned int bytes,
+                        unsigned int rows);
+
+  /*!
+   * \brief Copy RGBA pixels to BGRA or vice versa, source and target may be the same
+   */
+  static void SwapRedBlue(uint8_t* target,
+                          int targetStride,
+                          const uint8_t* source,
+                          int sourceStride,
+                          unsigned int width,
+                          unsigned int height);
+
+  /*!
+   * \brief Convert a 4:2:0 YUV image to BGRA with opaque alpha
+   *
+   * If the target is smaller than the image, the image is downscaled by
+   * taking the nearest pixel, only the rows that are sampled are converted.
+   */
+  static void ConvertToBGRA(const YUVImage& image,
+                            uint8_t* target,
+                            int targetStride,
+                            unsigned int width,
+                            unsigned int height);
+};
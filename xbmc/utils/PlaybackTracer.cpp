@@ -0,0 +1,294 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PlaybackTracer.h"
+
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <vector>
+
+std::atomic<bool> CPlaybackTracer::m_enabled{false};
+
+namespace
+{
+// Events kept per thread, must be a power of two
+constexpr uint64_t RING_SIZE = 16384;
+
+// All threads are shown in one process
+constexpr int TRACE_PID = 1;
+
+struct Event
+{
+  const char* category;
+  const char* name;
+  int64_t timestamp;
+  int64_t value;
+  char phase;
+};
+
+// Incremented by Start(), the rings move to a new trace when their thread records next
+std::atomic<uint64_t> traceGeneration{0};
+
+struct Ring
+{
+  uint64_t threadId = 0;
+  std::string threadName;
+  std::atomic<bool> exited{false};
+  std::atomic<uint64_t> head{0}; ///< number of events written by the thread
+  std::atomic<uint64_t> start{0}; ///< head at the first event of the trace
+  std::atomic<uint64_t> generation{0}; ///< trace that start belongs to
+  Event events[RING_SIZE];
+};
+
+struct Registry
+{
+  CCriticalSection section;
+  std::vector<std::shared_ptr<Ring>> rings;
+  std::set<std::string> names;
+};
+
+Registry& GetRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+// The ring of a thread is kept after the thread exits, so that its events
+// can still be dumped
+struct ThreadRing
+{
+  ~ThreadRing()
+  {
+    if (ring)
+      ring->exited = true;
+  }
+
+  std::shared_ptr<Ring> ring;
+};
+
+thread_local ThreadRing threadRing;
+
+Ring& GetThreadRing()
+{
+  if (!threadRing.ring)
+  {
+    auto ring = std::make_shared<Ring>();
+    ring->threadId = CThread::GetCurrentThreadNativeId();
+
+    const CThread* thread = CThread::GetCurrentThread();
+    if (thread)
+      ring->threadName = thread->GetName();
+
+    Registry& registry = GetRegistry();
+    CSingleLock lock(registry.section);
+    registry.rings.push_back(ring);
+    threadRing.ring = std::move(ring);
+  }
+
+  return *threadRing.ring;
+}
+
+CVariant ToVariant(const Event& event, uint64_t threadId)
+{
+  CVariant value(CVariant::VariantTypeObject);
+  value["name"] = event.name;
+  value["cat"] = event.category;
+  value["ph"] = std::string(1, event.phase);
+  value["ts"] = event.timestamp;
+  value["pid"] = TRACE_PID;
+  value["tid"] = threadId;
+
+  switch (event.phase)
+  {
+    case 'X':
+      value["dur"] = event.value;
+      break;
+    case 'i':
+      value["s"] = "t";
+      break;
+    case 'C':
+      value["args"]["value"] = event.value;
+      break;
+    default:
+      break;
+  }
+
+  return value;
+}
+} // namespace
+
+void CPlaybackTracer::Start()
+{
+  m_enabled = false;
+
+  Registry& registry = GetRegistry();
+  {
+    CSingleLock lock(registry.section);
+
+    registry.rings.erase(std::remove_if(registry.rings.begin(), registry.rings.end(),
+                                        [](const std::shared_ptr<Ring>& ring) {
+                                          return ring->exited.load();
+                                        }),
+                         registry.rings.end());
+
+    // the threads discard their events when they record the next one, as only
+    // they write to their rings
+    traceGeneration++;
+  }
+
+  m_enabled = true;
+
+  CLog::Log(LOGINFO, "CPlaybackTracer::{} - playback tracing started", __FUNCTION__);
+}
+
+void CPlaybackTracer::Stop()
+{
+  if (m_enabled.exchange(false))
+    CLog::Log(LOGINFO, "CPlaybackTracer::{} - playback tracing stopped", __FUNCTION__);
+}
+
+bool CPlaybackTracer::Dump(const std::string& file, unsigned int& events)
+{
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    Registry& registry = GetRegistry();
+    CSingleLock lock(registry.section);
+    rings = registry.rings;
+  }
+
+  CVariant traceEvents(CVariant::VariantTypeArray);
+  events = 0;
+
+  const uint64_t generation = traceGeneration.load(std::memory_order_acquire);
+
+  for (const auto& ring : rings)
+  {
+    // the thread didn't record anything since the trace was started
+    if (ring->generation.load(std::memory_order_acquire) != generation)
+      continue;
+
+    const uint64_t start = ring->start.load(std::memory_order_relaxed);
+    const uint64_t end = ring->head.load(std::memory_order_acquire);
+    const uint64_t begin = std::max(start, end > RING_SIZE ? end - RING_SIZE : 0);
+    if (begin == end)
+      continue;
+
+    std::vector<Event> copy;
+    copy.reserve(end - begin);
+    for (uint64_t i = begin; i < end; i++)
+      copy.push_back(ring->events[i & (RING_SIZE - 1)]);
+
+    // events that the thread overwrote while they were copied are dropped
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    const uint64_t first = head > RING_SIZE ? std::max(begin, head - RING_SIZE) : begin;
+
+    CVariant threadName(CVariant::VariantTypeObject);
+    threadName["name"] = "thread_name";
+    threadName["ph"] = "M";
+    threadName["pid"] = TRACE_PID;
+    threadName["tid"] = ring->threadId;
+    threadName["args"]["name"] =
+        ring->threadName.empty() ? std::to_string(ring->threadId) : ring->threadName;
+    traceEvents.push_back(threadName);
+
+    for (uint64_t i = first; i < end; i++)
+    {
+      traceEvents.push_back(ToVariant(copy[i - begin], ring->threadId));
+      events++;
+    }
+  }
+
+  CVariant trace(CVariant::VariantTypeObject);
+  trace["traceEvents"] = traceEvents;
+  trace["displayTimeUnit"] = "ms";
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(trace, json, true))
+    return false;
+
+  XFILE::CFile output;
+  if (!output.OpenForWrite(file, true) ||
+      output.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CPlaybackTracer::{} - unable to write {}", __FUNCTION__, file);
+    return false;
+  }
+
+  CLog::Log(LOGINFO, "CPlaybackTracer::{} - wrote {} events to {}", __FUNCTION__, events, file);
+  return true;
+}
+
+const char* CPlaybackTracer::Intern(const std::string& name)
+{
+  Registry& registry = GetRegistry();
+  CSingleLock lock(registry.section);
+  return registry.names.insert(name).first->c_str();
+}
+
+int64_t CPlaybackTracer::Now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void CPlaybackTracer::Complete(const char* category,
+                               const char* name,
+                               int64_t start,
+                               int64_t duration)
+{
+  if (IsEnabled())
+    Record(Phase::COMPLETE, category, name, start, duration);
+}
+
+void CPlaybackTracer::Instant(const char* category, const char* name)
+{
+  if (IsEnabled())
+    Record(Phase::INSTANT, category, name, Now(), 0);
+}
+
+void CPlaybackTracer::Counter(const char* category, const char* name, int64_t value)
+{
+  if (IsEnabled())
+    Record(Phase::COUNTER, category, name, Now(), value);
+}
+
+void CPlaybackTracer::Record(
+    Phase phase, const char* category, const char* name, int64_t timestamp, int64_t value)
+{
+  Ring& ring = GetThreadRing();
+
+  // only this thread writes to the ring, readers take the events up to head
+  const uint64_t head = ring.head.load(std::memory_order_relaxed);
+
+  // the first event since the trace was started, the events before belong to the previous one
+  const uint64_t generation = traceGeneration.load(std::memory_order_relaxed);
+  if (ring.generation.load(std::memory_order_relaxed) != generation)
+  {
+    ring.start.store(head, std::memory_order_relaxed);
+    ring.generation.store(generation, std::memory_order_release);
+  }
+
+  Event& event = ring.events[head & (RING_SIZE - 1)];
+  event.category = category;
+  event.name = name;
+  event.timestamp = timestamp;
+  event.value = value;
+  event.phase = static_cast<char>(phase);
+  ring.head.store(head + 1, std::memory_order_release);
+}
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+/*!
+ * \brief Records timestamped events of the playback pipeline
+ *
+ * Tracing is off by default and is started and stopped at runtime. While it
+ * runs, every thread writes its events into its own ring buffer without
+ * locking, so that tracing doesn't change the timing that is investigated.
+ * When it's off, an event costs a single relaxed atomic load.
+ *
+ * The events are written in the Chrome trace event format, which can be
+ * opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Names and categories of events must outlive the trace, use string literals
+ * or Intern() for names that are built at runtime.
+ */
+class CPlaybackTracer
+{
+public:
+  /*!
+   * \brief Records the time spent in a scope as one event
+   */
+  class CScope
+  {
+  public:
+    CScope(const char* category, const char* name)
+      : m_category(category), m_name(name), m_start(IsEnabled() ? Now() : -1)
+    {
+    }
+
+    ~CScope()
+    {
+      if (m_start >= 0)
+        Complete(m_category, m_name, m_start, Now() - m_start);
+    }
+
+  private:
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+
+    const char* m_category;
+    const char* m_name;
+    const int64_t m_start;
+  };
+
+  static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+  /*!
+   * \brief Discard all recorded events and start tracing
+   */
+  static void Start();
+
+  /*!
+   * \brief Stop tracing, the recorded events are kept until the next Start()
+   */
+  static void Stop();
+
+  /*!
+   * \brief Write the recorded events of all threads to a file
+   *
+   * \param file The file to write
+   * \param[out] events The number of events that were written
+   * \return true on success, false on failure
+   */
+  static bool Dump(const std::string& file, unsigned int& events);
+
+  /*!
+   * \brief Get a copy of a name that is kept for the lifetime of the process
+   */
+  static const char* Intern(const std::string& name);
+
+  /*!
+   * \brief Current time of the trace clock in microseconds
+   */
+  static int64_t Now();
+
+  /*!
+   * \brief Record an event that started at a time and lasted for a duration
+   */
+  static void Complete(const char* category, const char* name, int64_t start, int64_t duration);
+
+  /*!
+   * \brief Record an event without duration
+   */
+  static void Instant(const char* category, const char* name);
+
+  /*!
+   * \brief Record the value of a counter, e.g. the fill level of a queue
+   */
+  static void Counter(const char* category, const char* name, int64_t value);
+
+private:
+  enum class Phase : char
+  {
+    COMPLETE = 'X',
+    INSTANT = 'i',
+    COUNTER = 'C',
+  };
+
+  static void Record(Phase phase,
+                     const char* category,
+                     const char* name,
+                     int64_t timestamp,
+                     int64_t value);
+
+  static std::atomic<bool> m_enabled;
+};
+
+#define PLAYBACK_TRACE_CONCAT_(a, b) a##b
+#define PLAYBACK_TRACE_CONCAT(a, b) PLAYBACK_TRACE_CONCAT_(a, b)
+
+/*!
+ * \brief Record the time spent in the current scope
+ */
+#define PLAYBACK_TRACE_SCOPE(category, name) \
+  CPlaybackTracer::CScope PLAYBACK_TRACE_CONCAT(playbackTraceScope, __LINE__)(category, name)
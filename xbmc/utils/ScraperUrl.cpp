@@ -14,6 +14,7 @@
 #include "URL.h"
 #include "XMLUtils.h"
 #include "filesystem/CurlFile.h"
+#include "filesystem/DownloadScheduler.h"
 #include "filesystem/ZipFile.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -26,6 +27,7 @@
 #include <algorithm>
 #include <cstring>
 #include <sstream>
+#include <utility>
 
 CScraperUrl::CScraperUrl() : m_relevance(0.0), m_parsed(false)
 {
@@ -323,7 +325,7 @@ bool CScraperUrl::Get(const SUrlEntry& scrURL,
     }
   }
 
-  auto strHTML1 = strHTML;
+  XFILE::HTTPResponse response;
 
   if (scrURL.m_post)
   {
@@ -331,15 +333,17 @@ bool CScraperUrl::Get(const SUrlEntry& scrURL,
     strOptions = strOptions.substr(1);
     url.SetOptions("");
 
-    if (!http.Post(url.Get(), strOptions, strHTML1))
+    if (!XFILE::CDownloadScheduler::GetInstance().Post(
+            http, url.Get(), strOptions, XFILE::CDownloadScheduler::Lane::SCAN, response))
       return false;
   }
-  else if (!http.Get(url.Get(), strHTML1))
+  else if (!XFILE::CDownloadScheduler::GetInstance().Get(
+               http, url.Get(), XFILE::CDownloadScheduler::Lane::SCAN, response))
     return false;
 
-  strHTML = strHTML1;
+  strHTML = std::move(response.body);
 
-  const auto mimeType = http.GetProperty(XFILE::FILE_PROPERTY_MIME_TYPE);
+  const auto mimeType = response.mimeType;
   CMime::EFileType ftype = CMime::GetFileTypeFromMime(mimeType);
   if (ftype == CMime::FileTypeUnknown)
     ftype = CMime::GetFileTypeFromContent(strHTML);
@@ -360,7 +364,7 @@ bool CScraperUrl::Get(const SUrlEntry& scrURL,
                 scrURL.m_url);
   }
 
-  const auto reportedCharset = http.GetProperty(XFILE::FILE_PROPERTY_CONTENT_CHARSET);
+  const auto reportedCharset = response.charset;
   if (ftype == CMime::FileTypeHtml)
   {
     std::string realHtmlCharset, converted;
@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/ImageKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Odd sizes, so that the pixels after the last SIMD block are converted too
+constexpr unsigned int WIDTH = 53;
+constexpr unsigned int HEIGHT = 7;
+
+struct Planes
+{
+  std::vector<uint8_t> y;
+  std::vector<uint8_t> u;
+  std::vector<uint8_t> v;
+};
+
+Planes CreatePlanes()
+{
+  Planes planes;
+  planes.y.resize(WIDTH * HEIGHT);
+  planes.u.resize((WIDTH + 1) / 2 * (HEIGHT + 1) / 2);
+  planes.v.resize(planes.u.size());
+
+  for (size_t i = 0; i < planes.y.size(); i++)
+    planes.y[i] = static_cast<uint8_t>(i * 37);
+  for (size_t i = 0; i < planes.u.size(); i++)
+  {
+    planes.u[i] = static_cast<uint8_t>(i * 91 + 3);
+    planes.v[i] = static_cast<uint8_t>(i * 53 + 200);
+  }
+
+  return planes;
+}
+
+// BT.709 limited range in floating point
+void Reference(int y, int u, int v, int& r, int& g, int& b)
+{
+  const double luma = (y - 16) * 255.0 / 219.0;
+  const double cb = (u - 128) * 255.0 / 224.0;
+  const double cr = (v - 128) * 255.0 / 224.0;
+
+  const auto clamp = [](double value) {
+    return static_cast<int>(std::lround(std::min(255.0, std::max(0.0, value))));
+  };
+  r = clamp(luma + 1.5748 * cr);
+  g = clamp(luma - 0.1873 * cb - 0.4681 * cr);
+  b = clamp(luma + 1.8556 * cb);
+}
+
+void ExpectReference(const Planes& planes, const std::vector<uint8_t>& bgra)
+{
+  const unsigned int chromaWidth = (WIDTH + 1) / 2;
+  for (unsigned int y = 0; y < HEIGHT; y++)
+  {
+    for (unsigned int x = 0; x < WIDTH; x++)
+    {
+      int r, g, b;
+      Reference(planes.y[y * WIDTH + x], planes.u[y / 2 * chromaWidth + x / 2],
+                planes.v[y / 2 * chromaWidth + x / 2], r, g, b);
+
+      const uint8_t* pixel = bgra.data() + (y * WIDTH + x) * 4;
+      ASSERT_LE(std::abs(pixel[0] - b), 2) << "x " << x << " y " << y;
+      ASSERT_LE(std::abs(pixel[1] - g), 2) << "x " << x << " y " << y;
+      ASSERT_LE(std::abs(pixel[2] - r), 2) << "x " << x << " y " << y;
+      ASSERT_EQ(pixel[3], 0xFF);
+    }
+  }
+}
+} // namespace
+
+TEST(TestImageKernels, CopyPlane)
+{
+  std::vector<uint8_t> source(10 * 4);
+  for (size_t i = 0; i < source.size(); i++)
+    source[i] = static_cast<uint8_t>(i);
+
+  // crop the rows
+  std::vector<uint8_t> target(6 * 4);
+  CImageKernels::CopyPlane(target.data(), 6, source.data(), 10, 6, 4);
+  EXPECT_EQ(target[6], 10);
+  EXPECT_EQ(target[23], 35);
+
+  // flip
+  CImageKernels::CopyPlane(target.data(), 6, source.data() + 30, -10, 6, 4);
+  EXPECT_EQ(target[0], 30);
+  EXPECT_EQ(target[18], 0);
+}
+
+TEST(TestImageKernels, SwapRedBlue)
+{
+  std::vector<uint8_t> rgba(WIDTH * HEIGHT * 4);
+  for (size_t i = 0; i < rgba.size(); i++)
+    rgba[i] = static_cast<uint8_t>(i);
+
+  std::vector<uint8_t> bgra(rgba.size());
+  CImageKernels::SwapRedBlue(bgra.data(), WIDTH * 4, rgba.data(), WIDTH * 4, WIDTH, HEIGHT);
+  for (size_t i = 0; i < rgba.size(); i += 4)
+  {
+    ASSERT_EQ(bgra[i], rgba[i + 2]);
+    ASSERT_EQ(bgra[i + 1], rgba[i + 1]);
+    ASSERT_EQ(bgra[i + 2], rgba[i]);
+    ASSERT_EQ(bgra[i + 3], rgba[i + 3]);
+  }
+
+  // flipped and back
+  std::vector<uint8_t> flipped(rgba.size());
+  std::vector<uint8_t> restored(rgba.size());
+  CImageKernels::SwapRedBlue(flipped.data(), WIDTH * 4, bgra.data() + (HEIGHT - 1) * WIDTH * 4,
+                             -static_cast<int>(WIDTH * 4), WIDTH, HEIGHT);
+  CImageKernels::CopyPlane(restored.data(), WIDTH * 4, flipped.data() + (HEIGHT - 1) * WIDTH * 4,
+                           -static_cast<int>(WIDTH * 4), WIDTH * 4, HEIGHT);
+  EXPECT_EQ(restored, rgba);
+
+  // in place
+  CImageKernels::SwapRedBlue(restored.data(), WIDTH * 4, restored.data(), WIDTH * 4, WIDTH,
+                             HEIGHT);
+  EXPECT_EQ(restored, bgra);
+}
+
+TEST(TestImageKernels, ConvertYUV420P)
+{
+  const Planes planes = CreatePlanes();
+
+  CImageKernels::YUVImage image;
+  image.format = CImageKernels::YUVFormat::YUV420P;
+  image.planes[0] = planes.y.data();
+  image.planes[1] = planes.u.data();
+  image.planes[2] = planes.v.data();
+  image.strides[0] = WIDTH;
+  image.strides[1] = image.strides[2] = (WIDTH + 1) / 2;
+  image.width = WIDTH;
+  image.height = HEIGHT;
+
+  std::vector<uint8_t> bgra(WIDTH * HEIGHT * 4);
+  CImageKernels::ConvertToBGRA(image, bgra.data(), WIDTH * 4, WIDTH, HEIGHT);
+  ExpectReference(planes, bgra);
+}
+
+TEST(TestImageKernels, ConvertNV12AndP010)
+{
+  const Planes planes = CreatePlanes();
+  const unsigned int chromaWidth = (WIDTH + 1) / 2;
+
+  std::vector<uint8_t> uv(planes.u.size() * 2);
+  std::vector<uint16_t> y16(planes.y.size());
+  std::vector<uint16_t> uv16(uv.size());
+  for (size_t i = 0; i < planes.u.size(); i++)
+  {
+    uv[i * 2] = planes.u[i];
+    uv[i * 2 + 1] = planes.v[i];
+  }
+  // 10 bits in the upper bits, the lower bits must not change the result
+  for (size_t i = 0; i < y16.size(); i++)
+    y16[i] = static_cast<uint16_t>(planes.y[i] << 8 | 0xC0);
+  for (size_t i = 0; i < uv.size(); i++)
+    uv16[i] = static_cast<uint16_t>(uv[i] << 8 | 0x40);
+
+  CImageKernels::YUVImage image;
+  image.format = CImageKernels::YUVFormat::NV12;
+  image.planes[0] = planes.y.data();
+  image.planes[1] = uv.data();
+  image.strides[0] = WIDTH;
+  image.strides[1] = chromaWidth * 2;
+  image.width = WIDTH;
+  image.height = HEIGHT;
+
+  std::vector<uint8_t> bgra(WIDTH * HEIGHT * 4);
+  CImageKernels::ConvertToBGRA(image, bgra.data(), WIDTH * 4, WIDTH, HEIGHT);
+  ExpectReference(planes, bgra);
+
+  image.format = CImageKernels::YUVFormat::P010;
+  image.planes[0] = reinterpret_cast<const uint8_t*>(y16.data());
+  image.planes[1] = reinterpret_cast<const uint8_t*>(uv16.data());
+  image.strides[0] = WIDTH * 2;
+  image.strides[1] = chromaWidth * 4;
+
+  std::vector<uint8_t> bgra10(bgra.size());
+  CImageKernels::ConvertToBGRA(image, bgra10.data(), WIDTH * 4, WIDTH, HEIGHT);
+  EXPECT_EQ(bgra10, bgra);
+}
+
+TEST(TestImageKernels, ConvertColors)
+{
+  // black, white and red in BT.709 limited range
+  const uint8_t y[] = {16, 235, 63, 63};
+  const uint8_t u[] = {128, 102};
+  const uint8_t v[] = {128, 240};
+
+  CImageKernels::YUVImage image;
+  image.planes[0] = y;
+  image.planes[1] = u;
+  image.planes[2] = v;
+  image.strides[0] = 4;
+  image.strides[1] = image.strides[2] = 2;
+  image.width = 2;
+  image.height = 1;
+
+  uint8_t bgra[8];
+  CImageKernels::ConvertToBGRA(image, bgra, 8, 2, 1);
+  EXPECT_EQ(bgra[0], 0);
+  EXPECT_EQ(bgra[2], 0);
+  EXPECT_EQ(bgra[4], 255);
+  EXPECT_EQ(bgra[6], 255);
+
+  image.planes[0] = y + 2;
+  image.planes[1] = u + 1;
+  image.planes[2] = v + 1;
+  CImageKernels::ConvertToBGRA(image, bgra, 8, 2, 1);
+  EXPECT_LE(bgra[0], 2);
+  EXPECT_LE(bgra[1], 2);
+  EXPECT_GE(bgra[2], 253);
+}
+
+TEST(TestImageKernels, Downscale)
+{
+  const Planes planes = CreatePlanes();
+
+  CImageKernels::YUVImage image;
+  image.planes[0] = planes.y.data();
+  image.planes[1] = planes.u.data();
+  image.planes[2] = planes.v.data();
+  image.strides[0] = WIDTH;
+  image.strides[1] = image.strides[2] = (WIDTH + 1) / 2;
+  image.width = WIDTH;
+  image.height = HEIGHT;
+
+  std::vector<uint8_t> full(WIDTH * HEIGHT * 4);
+  CImageKernels::ConvertToBGRA(image, full.data(), WIDTH * 4, WIDTH, HEIGHT);
+
+  // every second row and column
+  constexpr unsigned int width = WIDTH / 2;
+  constexpr unsigned int height = HEIGHT / 2;
+  std::vector<uint8_t> scaled(width * height * 4);
+  CImageKernels::ConvertToBGRA(image, scaled.data(), width * 4, width, height);
+
+  for (unsigned int y = 0; y < height; y++)
+  {
+    for (unsigned int x = 0; x < width; x++)
+    {
+      const unsigned int sourceX = x * WIDTH / width;
+      const unsigned int sourceY = y * HEIGHT / height;
+      ASSERT_EQ(0, memcmp(scaled.data() + (y * width + x) * 4,
+                          full.data() + (sourceY * WIDTH + sourceX) * 4, 4));
+    }
+  }
+}
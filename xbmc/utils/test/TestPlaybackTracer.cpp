@@ -0,0 +1,165 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/PlaybackTracer.h"
+#include "utils/Variant.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const char* const CATEGORY = "test";
+
+CVariant DumpTrace(unsigned int& events)
+{
+  const std::string file =
+      CSpecialProtocol::TranslatePath("special://temp/") + "TestPlaybackTracer.json";
+  CVariant trace;
+
+  if (CPlaybackTracer::Dump(file, events))
+  {
+    XFILE::auto_buffer buffer;
+    XFILE::CFile input;
+    if (input.LoadFile(file, buffer) > 0)
+      CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), trace);
+    XFILE::CFile::Delete(file);
+  }
+
+  return trace;
+}
+
+// Count the events of this test with a phase
+unsigned int CountEvents(const CVariant& trace, const std::string& phase)
+{
+  unsigned int count = 0;
+  for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+  {
+    if ((*it)["cat"].asString() == CATEGORY && (*it)["ph"].asString() == phase)
+      count++;
+  }
+  return count;
+}
+} // namespace
+
+TEST(TestPlaybackTracer, Disabled)
+{
+  CPlaybackTracer::Start();
+  CPlaybackTracer::Stop();
+
+  {
+    PLAYBACK_TRACE_SCOPE(CATEGORY, "scope");
+  }
+  CPlaybackTracer::Instant(CATEGORY, "instant");
+
+  unsigned int events;
+  const CVariant trace = DumpTrace(events);
+  ASSERT_TRUE(trace.isObject());
+  EXPECT_EQ(CountEvents(trace, "X"), 0u);
+  EXPECT_EQ(CountEvents(trace, "i"), 0u);
+}
+
+TEST(TestPlaybackTracer, Events)
+{
+  CPlaybackTracer::Start();
+
+  {
+    PLAYBACK_TRACE_SCOPE(CATEGORY, "scope");
+  }
+  CPlaybackTracer::Instant(CATEGORY, "instant");
+  CPlaybackTracer::Counter(CATEGORY, CPlaybackTracer::Intern("counter"), 42);
+
+  std::thread thread([]() {
+    for (int i = 0; i < 10; i++)
+      CPlaybackTracer::Instant(CATEGORY, "thread");
+  });
+  thread.join();
+
+  CPlaybackTracer::Stop();
+
+  unsigned int events;
+  const CVariant trace = DumpTrace(events);
+  ASSERT_TRUE(trace.isObject());
+  EXPECT_GE(events, 13u);
+  EXPECT_EQ(CountEvents(trace, "X"), 1u);
+  EXPECT_EQ(CountEvents(trace, "i"), 11u);
+  EXPECT_EQ(CountEvents(trace, "C"), 1u);
+
+  for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+  {
+    if ((*it)["ph"].asString() == "C" && (*it)["cat"].asString() == CATEGORY)
+    {
+      EXPECT_EQ((*it)["name"].asString(), "counter");
+      EXPECT_EQ((*it)["args"]["value"].asInteger(), 42);
+    }
+  }
+}
+
+TEST(TestPlaybackTracer, RingOverflow)
+{
+  CPlaybackTracer::Start();
+
+  // only the most recent events are kept
+  for (int i = 0; i < 100000; i++)
+    CPlaybackTracer::Instant(CATEGORY, "overflow");
+
+  CPlaybackTracer::Stop();
+
+  unsigned int events;
+  const CVariant trace = DumpTrace(events);
+  ASSERT_TRUE(trace.isObject());
+  EXPECT_GT(CountEvents(trace, "i"), 0u);
+  EXPECT_LT(CountEvents(trace, "i"), 100000u);
+}
+
+TEST(TestPlaybackTracer, StartDiscardsEvents)
+{
+  std::atomic<bool> recorded{false};
+  std::atomic<bool> stop{false};
+
+  CPlaybackTracer::Start();
+  CPlaybackTracer::Instant(CATEGORY, "previous");
+
+  // a thread that keeps running, but doesn't record after the restart
+  std::thread thread([&recorded, &stop]() {
+    for (int i = 0; i < 10; i++)
+      CPlaybackTracer::Instant(CATEGORY, "previous");
+    recorded = true;
+
+    while (!stop)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  while (!recorded)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  CPlaybackTracer::Start();
+  CPlaybackTracer::Instant(CATEGORY, "current");
+  CPlaybackTracer::Stop();
+
+  unsigned int events;
+  const CVariant trace = DumpTrace(events);
+  stop = true;
+  thread.join();
+
+  ASSERT_TRUE(trace.isObject());
+  EXPECT_EQ(CountEvents(trace, "i"), 1u);
+}
+
+TEST(TestPlaybackTracer, Intern)
+{
+  const char* name = CPlaybackTracer::Intern("videoq");
+  EXPECT_STREQ(name, "videoq");
+  EXPECT_EQ(CPlaybackTracer::Intern(std::string("video") + "q"), name);
+}
@@ -14,6 +14,7 @@
 #include "TextureCache.h"
 #include "URL.h"
 #include "cores/VideoPlayer/DVDFileInfo.h"
+#include "cores/VideoPlayer/ThumbExtractionService.h"
 #include "cores/VideoSettings.h"
 #include "filesystem/Directory.h"
 #include "filesystem/DirectoryCache.h"
@@ -182,14 +183,14 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
-CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+CVideoThumbLoader::CVideoThumbLoader() : CThumbLoader()
 {
   m_videoDatabase = new CVideoDatabase();
 }
 
 CVideoThumbLoader::~CVideoThumbLoader()
 {
+  CThumbExtractionService::GetInstance().CancelJobs(this);
   StopThread();
   delete m_videoDatabase;
 }
@@ -498,7 +499,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
           SetupRarOptions(item,path);
 
         CThumbExtractor* extract = new CThumbExtractor(item, path, true, thumbURL);
-        AddJob(extract);
+        CThumbExtractionService::GetInstance().AddJob(extract, this);
 
         m_videoDatabase->Close();
         return true;
@@ -515,7 +516,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
       if (URIUtils::IsInRAR(item.GetPath()))
         SetupRarOptions(item,path);
       CThumbExtractor* extract = new CThumbExtractor(item,path,false);
-      AddJob(extract);
+      CThumbExtractionService::GetInstance().AddJob(extract, this);
     }
   }
 
@@ -746,7 +747,6 @@ void CVideoThumbLoader::OnJobComplete(unsigned int jobID, bool success, CJob* jo
     CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE_ITEM, 0, pItem);
     CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
   }
-  CJobQueue::OnJobComplete(jobID, success, job);
 }
 
 void CVideoThumbLoader::DetectAndAddMissingItemData(CFileItem &item)
@@ -56,7 +56,7 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
-class CVideoThumbLoader : public CThumbLoader, public CJobQueue
+class CVideoThumbLoader : public CThumbLoader, public IJobCallback
 {
 public:
   CVideoThumbLoader();
@@ -129,6 +129,10 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                    .GetFPS(),
                                strCores, ucAppName, dCPU, profiling);
 #endif
+    unsigned int numChars, usedLines, totalLines, evictedLines;
+    g_fontManager.GetCharacterCacheStats(numChars, usedLines, totalLines, evictedLines);
+    info += StringUtils::Format("\nFONTS: {} glyphs - {}/{} texture lines ({} evicted)", numChars,
+                                usedLines, totalLines, evictedLines);
   }
 
   // render the skin debug info